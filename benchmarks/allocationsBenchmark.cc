@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#define ALLOCATIONS_HOOKS
+#include <allocations.hpp>
+
+#include <config.hpp>
+#include <bot.hpp>
+#include <feed.hpp>
+#include <match.hpp>
+#include <pregen.hpp>
+#include <wallet.hpp>
+
+// Stages of the match-and-send path, each reports heap allocations per iteration (expected to be zero)
+
+static const std::string Input = "0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb";
+static const std::string Message = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"" + Input + "\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x46114844c27ec9\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+static const std::string Notification =
+  "{\"jsonrpc\":\"2.0\",\"method\":\"eth_subscription\",\"params\":{\"subscription\":\"0xcd0c3e8af590364c09d0fa6a1210faf5\",\"result\":{"
+  "\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"gas\":\"0x3d090\",\"gasPrice\":\"0x355176b200\",\"input\":\"" + Input + "\",\"nonce\":\"0x1a\","
+  "\"to\":\"0x7a250d5630b4cf539739df2c5dacb4c659f2488d\",\"value\":\"0x46114844c27ec9\"}}}";
+
+static const char TargetToken[] = "dac17f958d2ee523a2206206994597c13d831ec7";
+
+static Wallet<PreGen::Store<64, Config::Size::BloXrouteTransactionMessageString>> wallet;
+
+static void initWallet() {
+  if(wallet.address[0] != '\0') return;
+
+  wallet.init(Config::Wallets::List[0], TransactionDataBuilder::ConfigData.hex);
+
+  std::vector<std::uint64_t> gasPrices;
+  for(std::uint64_t i = 0; i < 32; i++) gasPrices.push_back((200 + i) * 1000000000);
+  PreGen::generateParallel(wallet.pregenTxs.back(), gasPrices, wallet.privateKey, [](Transaction &tx) { wallet.setFields(tx); }, 1);
+  wallet.pregenTxs.publish();
+}
+
+/**
+ * @brief Sink standing in for the feed, nothing is read from shared memory or handed to signers.
+ */
+struct Sink {
+  bool accepts(const char *, const Warm::Fees &) {
+    return true;
+  }
+
+  void send(const char *message, std::size_t length) {
+    benchmark::DoNotOptimize(message);
+    benchmark::DoNotOptimize(length);
+  }
+
+  bool isShared() {
+    return false;
+  }
+
+  std::size_t readShared(std::size_t, std::uint64_t, char *, std::uint64_t &) {
+    return 0;
+  }
+
+  bool offload(Pipeline::SignRequest &, char *, std::size_t &, Match::Outcome &) {
+    return false;
+  }
+};
+
+/**
+ * @brief Runs stage under allocation counting and reports allocations and allocated bytes per iteration.
+ */
+template<typename Stage>
+static void countAllocations(benchmark::State &state, Stage stage) {
+  Allocations::Counts counts;
+
+  {
+    Allocations::Scope scope;
+    for(auto _ : state) stage();
+    counts = scope.get();
+  }
+
+  state.counters["allocations"] = benchmark::Counter(counts.allocations, benchmark::Counter::kAvgIterations);
+  state.counters["bytes"] = benchmark::Counter(counts.bytes, benchmark::Counter::kAvgIterations);
+}
+
+static void normalize(benchmark::State &state) {
+  const Feed::Node::Filter filter { "7a250d5630B4cF539739dF2C5dAcb4c659F2488D", 1000000000000, UInt256(0), false };
+  char output[Config::Size::BloXrouteTransactionMessageString];
+
+  countAllocations(state, [&]() {
+    benchmark::DoNotOptimize(Feed::Node::normalize(Notification.c_str(), Notification.size(), filter, nullptr, output, sizeof(output)));
+  });
+}
+
+static void parse(benchmark::State &state) {
+  Warm::Fees fees;
+
+  countAllocations(state, [&]() {
+    if(BloXrouteMessageParser::validateTransaction(Message.c_str(), TargetToken)) Warm::extractFees(Message.c_str(), fees);
+    benchmark::DoNotOptimize(fees);
+  });
+}
+
+static void lookup(benchmark::State &state) {
+  initWallet();
+
+  countAllocations(state, [&]() {
+    wallet.arm();
+    if(wallet.claim()) benchmark::DoNotOptimize(wallet.pregenTxs.acquire()->lookup(229000000000, Config::TransactionPreGen::MissPolicy::NearestAbove, 1000000000));
+    wallet.pregenTxs.release();
+  });
+}
+
+static void sign(benchmark::State &state) {
+  initWallet();
+
+  countAllocations(state, [&]() {
+    benchmark::DoNotOptimize(PreGen::generate(wallet.tx, wallet.privateKey, 1000000000, wallet.message));
+  });
+}
+
+static void match(benchmark::State &state) {
+  initWallet();
+  Sink sink;
+  Telemetry::Metrics<8> telemetry;
+
+  countAllocations(state, [&]() {
+    Match::Result<1> result;
+    wallet.arm();
+    benchmark::DoNotOptimize(Match::process(Message.c_str(), TargetToken, &wallet, 1, true, sink, telemetry, result));
+    Match::release(&wallet, result, false);
+  });
+}
+
+static void advanceNonce(benchmark::State &state) {
+  initWallet();
+
+  countAllocations(state, [&]() {
+    wallet.advanceNonce();
+  });
+}
+
+BENCHMARK(normalize)->Name("HotPath::normalize");
+BENCHMARK(parse)->Name("HotPath::parse");
+BENCHMARK(lookup)->Name("HotPath::lookup");
+BENCHMARK(sign)->Name("HotPath::sign");
+BENCHMARK(match)->Name("HotPath::match");
+BENCHMARK(advanceNonce)->Name("HotPath::advanceNonce");
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <bot.hpp>
+#include <bundle.hpp>
+
+// Bundle submission: composing the request from the target and pregenerated transaction message, and its round trip
+// over keep-alive connection to loopback relay stand-in answering every request right away.
+
+static const std::string Target(480, 'f');
+static const std::string Message = std::string(BloXrouteMessageBuilder::TransactionPrefix) + std::string(440, 'e') + BloXrouteMessageBuilder::TransactionSuffix;
+
+static Bundle::Composer<Config::Size::BundleRequestBody> composer;
+
+static const char *compose(std::size_t &length) {
+  constexpr std::size_t PrefixLength = BloXrouteMessageBuilder::TransactionOffset;
+  constexpr std::size_t SuffixLength = sizeof(BloXrouteMessageBuilder::TransactionSuffix) - 1;
+  return composer.compose(Target.data(), Target.size(), Message.data() + PrefixLength, Message.size() - PrefixLength - SuffixLength, length);
+}
+
+static void composeRequest(benchmark::State &state) {
+  Bundle::Url url;
+  Bundle::parseUrl("https://rpc.beaverbuild.org/", url);
+  composer.init(url);
+
+  for(auto _ : state) {
+    std::size_t length;
+    const char *request = compose(length);
+    benchmark::DoNotOptimize(request);
+    benchmark::DoNotOptimize(length);
+  }
+}
+
+/**
+ * @brief Answers every request (counted by its blank line, bodies carry no CRLF) until the client disconnects.
+ */
+static void serveRelay(int fd) {
+  static constexpr char Response[] = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n{}";
+  int noDelay = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+  char buffer[8192];
+  std::string pending;
+  while(true) {
+    ssize_t count = recv(fd, buffer, sizeof(buffer), 0);
+    if(count <= 0) break;
+    pending.append(buffer, count);
+
+    std::size_t position;
+    while((position = pending.find("\r\n\r\n")) != std::string::npos) {
+      pending.erase(0, position + 4);
+      send(fd, Response, sizeof(Response) - 1, MSG_NOSIGNAL);
+    }
+  }
+  close(fd);
+}
+
+static void roundTrip(benchmark::State &state) {
+  int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addressLength = sizeof(address);
+  bind(listenFd, reinterpret_cast<sockaddr*>(&address), addressLength);
+  listen(listenFd, 1);
+  getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength);
+
+  std::thread server([listenFd]() { serveRelay(accept(listenFd, nullptr, nullptr)); });
+
+  Bundle::Relay relay;
+  std::string url = "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port)) + "/";
+  if(!relay.connect(url.c_str())) state.SkipWithError("Relay stand-in is not reachable");
+  composer.init(relay.getUrl());
+
+  for(auto _ : state) {
+    std::size_t length;
+    const char *request = compose(length);
+    relay.send(request, length);
+    while(relay.poll() == 0) {}
+  }
+
+  relay.close();
+  server.join();
+  close(listenFd);
+}
+
+BENCHMARK(composeRequest)->Name("Bundle::compose");
+BENCHMARK(roundTrip)->Name("Bundle::roundTrip/loopback")->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+
+#include <csignal>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/ec.h>
+#include <openssl/x509.h>
+
+#include <bot.hpp>
+#include <ktls.hpp>
+#include <websocket.hpp>
+
+// Send latency of pregenerated transaction frame over loopback TLS stand-in server (self-signed, draining on its own thread):
+// OpenSSL record encryption in user space, kernel TLS (plain send) and plaintext TCP as the lower bound.
+
+static SSL_CTX *serverContext() {
+  EVP_PKEY *key = EVP_EC_gen("P-256");
+  X509 *certificate = X509_new();
+  ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+  X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+  X509_gmtime_adj(X509_getm_notAfter(certificate), 3600);
+  X509_set_pubkey(certificate, key);
+
+  X509_NAME *name = X509_get_subject_name(certificate);
+  X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  X509_set_issuer_name(certificate, name);
+  X509_sign(certificate, key, EVP_sha256());
+
+  SSL_CTX *context = SSL_CTX_new(TLS_server_method());
+  SSL_CTX_use_certificate(context, certificate);
+  SSL_CTX_use_PrivateKey(context, key);
+
+  X509_free(certificate);
+  EVP_PKEY_free(key);
+  return context;
+}
+
+static void connectLoopback(int &clientFd, int &serverFd) {
+  int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addressLength = sizeof(address);
+  bind(listenFd, reinterpret_cast<sockaddr*>(&address), addressLength);
+  listen(listenFd, 1);
+  getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength);
+
+  clientFd = socket(AF_INET, SOCK_STREAM, 0);
+  connect(clientFd, reinterpret_cast<sockaddr*>(&address), addressLength);
+  serverFd = accept(listenFd, nullptr, nullptr);
+  close(listenFd);
+
+  int noDelay = 1;
+  setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+}
+
+/**
+ * @brief Masked text frame of transaction message, as the bot sends it.
+ */
+static std::string transactionFrame() {
+  std::string message = std::string(BloXrouteMessageBuilder::TransactionPrefix) + std::string(440, 'f') + BloXrouteMessageBuilder::TransactionSuffix;
+  const std::uint8_t maskKey[4] = { 0x37, 0xfa, 0x21, 0x3d };
+
+  char frame[Config::Size::BloXrouteTransactionMessageString + WebSocket::MaxHeaderLength];
+  std::size_t headerLength = WebSocket::encodeHeader(WebSocket::Text, message.size(), maskKey, frame);
+  WebSocket::mask(message.data(), message.size(), maskKey, frame + headerLength);
+  return std::string(frame, headerLength + message.size());
+}
+
+/**
+ * @brief Runs TLS server on its own thread, reading until the client shuts the connection down.
+ */
+static std::thread serveTLS(SSL_CTX *context, int fd) {
+  // Session tickets may be written after the client is gone
+  signal(SIGPIPE, SIG_IGN);
+
+  return std::thread([context, fd]() {
+    SSL *ssl = SSL_new(context);
+    SSL_set_fd(ssl, fd);
+
+    char buffer[1 << 16];
+    if(SSL_accept(ssl) == 1) while(SSL_read(ssl, buffer, sizeof(buffer)) > 0);
+
+    SSL_free(ssl);
+    close(fd);
+  });
+}
+
+static void sendOpenSSL(benchmark::State &state) {
+  int clientFd, serverFd;
+  connectLoopback(clientFd, serverFd);
+  SSL_CTX *serverCtx = serverContext();
+  std::thread server = serveTLS(serverCtx, serverFd);
+
+  SSL_CTX *context = SSL_CTX_new(TLS_client_method());
+  SSL *ssl = SSL_new(context);
+  SSL_set_fd(ssl, clientFd);
+  SSL_connect(ssl);
+
+  std::string frame = transactionFrame();
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(SSL_write(ssl, frame.data(), frame.size()));
+  }
+
+  shutdown(clientFd, SHUT_RDWR);
+  server.join();
+  SSL_free(ssl);
+  SSL_CTX_free(context);
+  SSL_CTX_free(serverCtx);
+  close(clientFd);
+}
+
+static void sendKernel(benchmark::State &state) {
+  int clientFd, serverFd;
+  connectLoopback(clientFd, serverFd);
+  SSL_CTX *serverCtx = serverContext();
+  std::thread server = serveTLS(serverCtx, serverFd);
+
+  KernelTLS::Session session;
+  bool offloaded = session.connect(clientFd, "localhost") == KernelTLS::Status::Offloaded;
+
+  std::string frame = transactionFrame();
+  if(offloaded) {
+    for(auto _ : state) {
+      benchmark::DoNotOptimize(send(clientFd, frame.data(), frame.size(), MSG_NOSIGNAL));
+    }
+  } else {
+    state.SkipWithError("Kernel TLS is unavailable");
+  }
+
+  shutdown(clientFd, SHUT_RDWR);
+  server.join();
+  SSL_CTX_free(serverCtx);
+  close(clientFd);
+}
+
+static void sendPlaintext(benchmark::State &state) {
+  int clientFd, serverFd;
+  connectLoopback(clientFd, serverFd);
+
+  std::thread server([serverFd]() {
+    char buffer[1 << 16];
+    while(recv(serverFd, buffer, sizeof(buffer), 0) > 0);
+    close(serverFd);
+  });
+
+  std::string frame = transactionFrame();
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(send(clientFd, frame.data(), frame.size(), MSG_NOSIGNAL));
+  }
+
+  shutdown(clientFd, SHUT_RDWR);
+  server.join();
+  close(clientFd);
+}
+
+BENCHMARK(sendOpenSSL)->Name("KernelTLS::send/openssl");
+BENCHMARK(sendKernel)->Name("KernelTLS::send/kernel");
+BENCHMARK(sendPlaintext)->Name("KernelTLS::send/plaintext");
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <config.hpp>
+#include <pregen.hpp>
+
+static PreGen::Store<Config::TransactionPreGen::Capacity, Config::Size::BloXrouteTransactionMessageString> store;
+
+static void fillStore() {
+  if(store.size() != 0) return;
+
+  for(
+    std::size_t gasPrice = Config::TransactionPreGen::GasPriceGweiFrom * Config::TransactionPreGen::GasPriceGweiDecimals; 
+    gasPrice <= Config::TransactionPreGen::GasPriceGweiTo * Config::TransactionPreGen::GasPriceGweiDecimals; 
+    gasPrice++
+  ) {
+    store.insert(gasPrice * (1000000000 / Config::TransactionPreGen::GasPriceGweiDecimals), "{}", 2);
+  }
+}
+
+static void find(benchmark::State &state) {
+  fillStore();
+
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(store.find(123450000000));
+  }
+}
+
+static void findAtOrAbove(benchmark::State &state) {
+  fillStore();
+
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(store.findAtOrAbove(123456789012, 1000000000));
+  }
+}
+
+static void generateParallel(benchmark::State &state) {
+  static PreGen::Store<1024, Config::Size::BloXrouteTransactionMessageString> parallelStore;
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer(Config::Transaction::PrivateKey, privateKey);
+
+  std::vector<std::uint64_t> gasPrices;
+  for(std::uint64_t i = 0; i < 1024; i++) gasPrices.push_back(100000000000 + i * 1000000);
+
+  auto setup = [](Transaction &tx) {
+    tx.setField(Transaction::Field::Nonce, Config::Transaction::Nonce);
+    tx.setField(Transaction::Field::GasLimit, Config::Transaction::GasLimit);
+    tx.setField(Transaction::Field::To, Config::Transaction::To);
+    tx.setField(Transaction::Field::Value, Config::Transaction::Value);
+    tx.setField(Transaction::Field::Data, "");
+  };
+
+  for(auto _ : state) {
+    PreGen::generateParallel(parallelStore, gasPrices, privateKey, setup, state.range(0));
+  }
+
+  state.SetItemsProcessed(state.iterations() * gasPrices.size());
+}
+
+using FullStore = PreGen::Store<Config::TransactionPreGen::Capacity, Config::Size::BloXrouteTransactionMessageString>;
+using FullCompactStore = PreGen::CompactStore<Config::TransactionPreGen::Capacity>;
+
+static FullStore sendStore;
+static FullCompactStore sendCompactStore;
+static std::vector<std::uint64_t> sendGasPrices;
+static std::vector<char> evictionBuffer;
+
+// Both layouts hold the same transactions signed for the whole configured gas price range
+static void fillSendStores() {
+  if(sendStore.size() != 0) return;
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer(Config::Transaction::PrivateKey, privateKey);
+
+  Transaction tx;
+  tx.setField(Transaction::Field::Nonce, Config::Transaction::Nonce);
+  tx.setField(Transaction::Field::GasLimit, Config::Transaction::GasLimit);
+  tx.setField(Transaction::Field::To, Config::Transaction::To);
+  tx.setField(Transaction::Field::Value, Config::Transaction::Value);
+  tx.setField(Transaction::Field::Data, TransactionDataBuilder::ConfigData.hex);
+
+  Utils::Byte transaction[Config::Size::TransactionRawBuffer];
+  char message[Config::Size::BloXrouteTransactionMessageString];
+  for(
+    std::size_t gasPrice = Config::TransactionPreGen::GasPriceGweiFrom * Config::TransactionPreGen::GasPriceGweiDecimals;
+    gasPrice <= Config::TransactionPreGen::GasPriceGweiTo * Config::TransactionPreGen::GasPriceGweiDecimals;
+    gasPrice++
+  ) {
+    std::uint64_t gasPriceWei = gasPrice * (1000000000 / Config::TransactionPreGen::GasPriceGweiDecimals);
+    std::size_t transactionLength = PreGen::sign(tx, privateKey, gasPriceWei, transaction);
+    sendStore.insert(gasPriceWei, message, BloXrouteMessageBuilder::buildTransaction(transaction, transactionLength, message));
+    sendCompactStore.insert(gasPriceWei, transaction, transactionLength);
+  }
+
+  // Observed gas prices are random within the range, so lookups do not walk the table in order
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<std::uint64_t> distribution(
+    Config::TransactionPreGen::GasPriceGweiFrom * 1000000000, Config::TransactionPreGen::GasPriceGweiTo * 1000000000
+  );
+  for(std::size_t i = 0; i < 4096; i++) sendGasPrices.push_back(distribution(random));
+
+  evictionBuffer.resize(64 * 1024 * 1024);
+}
+
+// Cold runs evict caches (writing buffer larger than the last level cache) before every lookup.
+// Only lookup and send are timed, manually, as pausing the benchmark timer costs more than the lookup itself.
+template<typename StoreType, typename Send>
+static void lookupToSend(benchmark::State &state, const StoreType &store, Send send) {
+  fillSendStores();
+
+  bool cold = state.range(0) != 0;
+  char frame[Config::Size::BloXrouteTransactionMessageString];
+  std::size_t i = 0;
+
+  for(auto _ : state) {
+    if(cold) {
+      memset(evictionBuffer.data(), static_cast<int>(i), evictionBuffer.size());
+      benchmark::ClobberMemory();
+    }
+
+    std::uint64_t gasPrice = sendGasPrices[i++ % sendGasPrices.size()];
+
+    auto start = std::chrono::steady_clock::now();
+    const auto *entry = store.lookup(gasPrice, Config::TransactionPreGen::MissPolicy::NearestAbove, Config::TransactionPreGen::MaxGasPriceBump);
+    benchmark::DoNotOptimize(send(*entry, frame));
+    benchmark::ClobberMemory();
+    auto end = std::chrono::steady_clock::now();
+
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+  }
+}
+
+// Sending copies the message into the outgoing frame
+static void storeLookupToSend(benchmark::State &state) {
+  lookupToSend(state, sendStore, [](const FullStore::EntryType &entry, char *frame) {
+    std::size_t length;
+    const char *message = sendStore.message(entry, frame, length);
+    memcpy(frame, message, length);
+    return length;
+  });
+}
+
+// Message is assembled straight into the outgoing frame
+static void compactStoreLookupToSend(benchmark::State &state) {
+  lookupToSend(state, sendCompactStore, [](const FullCompactStore::EntryType &entry, char *frame) {
+    return sendCompactStore.assemble(entry, frame);
+  });
+}
+
+static void feeGridLookup(benchmark::State &state) {
+  static PreGen::FeeGrid grid;
+  if(grid.size() == 0) {
+    grid.reset(
+      { Config::TransactionPreGen::DynamicFee::MaxFeeGweiFrom * 1000000000, 1000000000 / Config::TransactionPreGen::DynamicFee::MaxFeeGweiDecimals, Config::TransactionPreGen::DynamicFee::MaxFeeCount },
+      { Config::TransactionPreGen::DynamicFee::PriorityFeeGweiFrom * 1000000000, 1000000000 / Config::TransactionPreGen::DynamicFee::PriorityFeeGweiDecimals, Config::TransactionPreGen::DynamicFee::PriorityFeeCount },
+      8
+    );
+    for(std::size_t cell = 0; cell < grid.size(); cell++) grid.set(cell, "{}", 2);
+  }
+
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(grid.lookup(
+      123456789012, 1234567890,
+      Config::TransactionPreGen::MissPolicy::NearestAbove, Config::TransactionPreGen::MaxGasPriceBump, Config::TransactionPreGen::DynamicFee::MaxPriorityFeeBump
+    ));
+  }
+}
+
+BENCHMARK(find)->Name("PreGen::Store::find");
+BENCHMARK(findAtOrAbove)->Name("PreGen::Store::findAtOrAbove");
+BENCHMARK(storeLookupToSend)->Name("PreGen::Store::lookupToSend/hot")->Arg(0)->UseManualTime();
+BENCHMARK(compactStoreLookupToSend)->Name("PreGen::CompactStore::lookupToSend/hot")->Arg(0)->UseManualTime();
+BENCHMARK(storeLookupToSend)->Name("PreGen::Store::lookupToSend/cold")->Arg(1)->UseManualTime()->Iterations(2000);
+BENCHMARK(compactStoreLookupToSend)->Name("PreGen::CompactStore::lookupToSend/cold")->Arg(1)->UseManualTime()->Iterations(2000);
+BENCHMARK(feeGridLookup)->Name("PreGen::FeeGrid::lookup");
+BENCHMARK(generateParallel)->Name("PreGen::generateParallel")->Arg(1)->Arg(2)->Arg(4)->Arg(0)->UseRealTime()->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include <benchmark/benchmark.h>
+
+#include <queue.hpp>
+
+static void pushPop(benchmark::State &state) {
+  static SPSCQueue<std::uint64_t, 64> queue;
+  std::uint64_t item = 0;
+
+  for(auto _ : state) {
+    queue.push(item);
+    queue.pop(item);
+    benchmark::DoNotOptimize(item);
+  }
+}
+
+BENCHMARK(pushPop)->Name("SPSCQueue::pushPop");
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <config.hpp>
+#include <rules.hpp>
+
+// Per-message cost of the filter rules as their count grows: ranges of the target are intersected into
+// the same bounds, the rest are blacklisted senders searched in log2 steps
+
+static constexpr char Token[] = "dac17f958d2ee523a2206206994597c13d831ec7";
+static const std::string Message = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x46114844c27ec9\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+
+static constexpr std::size_t MaxRules = 256;
+static constexpr std::size_t FieldsVariants = 64;
+
+static std::vector<std::string> senders(std::size_t count) {
+  std::vector<std::string> output;
+  char address[41];
+  for(std::size_t i = 0; i < count; i++) {
+    snprintf(address, sizeof(address), "%016zx%016zx%08zx", i * 0x9e3779b97f4a7c15, ~i, i);
+    output.push_back(address);
+  }
+  return output;
+}
+
+static void accepts(benchmark::State &state) {
+  std::size_t count = state.range(0);
+  std::vector<std::string> addresses = senders(MaxRules + FieldsVariants);
+
+  // Ranges of the target and other tokens, blacklisted senders
+  std::vector<Config::Rules::Rule> list {
+    Config::Rules::minLiquidity(Token, 1e16),
+    Config::Rules::maxGasPrice("", 1000e9),
+    Config::Rules::tokenRatio(Token, 1e6, 1e30)
+  };
+  for(std::size_t i = list.size(); i < count; i++) {
+    list.push_back(i % 4 == 0 ? Config::Rules::maxGasPrice("cac17f958d2ee523a2206206994597c13d831ec7", 500e9) : Config::Rules::blacklist(addresses[i].c_str()));
+  }
+  list.resize(count);
+
+  static Rules::Program<MaxRules> program;
+  program.compile(list.data(), list.size(), Token);
+
+  // Accepted and rejected messages interleaved, so outcomes are not predictable
+  std::vector<Rules::Fields> fields(FieldsVariants);
+  Rules::extract(Message.c_str(), 0x355176b200, fields[0]);
+  for(std::size_t i = 0; i < FieldsVariants; i++) {
+    fields[i] = fields[0];
+    fields[i].values[Rules::GasPrice] = (i * 7919) % 3 == 0 ? 2000e9 : 200e9;
+    fields[i].sender = Rules::Key::fromHex(addresses[(i * 7919) % 5 == 0 ? i % count : MaxRules + i].c_str());
+  }
+
+  std::size_t i = 0, accepted = 0;
+  for(auto _ : state) {
+    accepted += program.accepts(fields[i++ % FieldsVariants]);
+  }
+
+  benchmark::DoNotOptimize(accepted);
+}
+
+static void extract(benchmark::State &state) {
+  Rules::Fields fields;
+
+  for(auto _ : state) {
+    Rules::extract(Message.c_str(), 0x355176b200, fields);
+    benchmark::DoNotOptimize(fields);
+  }
+}
+
+BENCHMARK(accepts)->Name("Rules::accepts")->Arg(1)->Arg(4)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK(extract)->Name("Rules::extract");
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <thread>
+
+#include <signer.hpp>
+
+using BenchmarkChannel = Signer::Channel<64, Config::Size::BloXrouteTransactionMessageString>;
+
+static const std::string BenchmarkName = "/uniswap-sniper-signer-benchmark-" + std::to_string(getpid());
+static constexpr char BenchmarkPrivateKey[] = "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318";
+
+static std::size_t echo(Transaction&, Pipeline::SignRequest&, char *output) {
+  output[0] = '\0';
+  return 1;
+}
+
+static std::size_t sign(Transaction &tx, Pipeline::SignRequest &request, char *output) {
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer(BenchmarkPrivateKey, privateKey);
+
+  tx.setField(Transaction::Field::Nonce, "1a");
+  tx.setField(Transaction::Field::GasLimit, "7C6D");
+  tx.setField(Transaction::Field::To, "F0109fC8DF283027b6285cc889F5aA624EaC1F55");
+
+  return PreGen::generate(tx, privateKey, request.gasPrice, output);
+}
+
+/**
+ * @brief Round trip over the channel to the signer thread serving it (busy-polling on both sides).
+ */
+template<typename Sign>
+static void roundTrip(benchmark::State &state, Sign serverSign) {
+  static BenchmarkChannel server, client;
+  std::atomic<bool> running { true };
+
+  server.create(BenchmarkName.c_str());
+  client.open(BenchmarkName.c_str());
+
+  std::thread signer([&]() { server.serve(1, running, serverSign); });
+  while(!client.isServing()) std::this_thread::yield();
+
+  Pipeline::SignRequest request {};
+  request.gasPrice = 100000000000;
+  char output[Config::Size::BloXrouteTransactionMessageString];
+
+  for(auto _ : state) {
+    ++request.receivedAt;
+    benchmark::DoNotOptimize(client.sign(request, output, 1000000000));
+  }
+
+  running.store(false);
+  signer.join();
+  BenchmarkChannel::unlink(BenchmarkName.c_str());
+}
+
+static void ipcRoundTrip(benchmark::State &state) {
+  roundTrip(state, echo);
+}
+
+static void remoteSign(benchmark::State &state) {
+  roundTrip(state, sign);
+}
+
+static void inlineSign(benchmark::State &state) {
+  Transaction tx;
+  Pipeline::SignRequest request {};
+  request.gasPrice = 100000000000;
+  char output[Config::Size::BloXrouteTransactionMessageString];
+
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(sign(tx, request, output));
+  }
+}
+
+BENCHMARK(ipcRoundTrip)->Name("Signer::ipcRoundTrip")->UseRealTime();
+BENCHMARK(remoteSign)->Name("Signer::remoteSign")->UseRealTime();
+BENCHMARK(inlineSign)->Name("Signer::inlineSign");
\ No newline at end of file
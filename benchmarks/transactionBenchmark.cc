@@ -4,6 +4,7 @@
 
 #define private public
 #include <transaction.hpp>
+#include <bot.hpp>
 
 static void keccak256(benchmark::State &state) {
   Transaction tx;
@@ -46,6 +47,87 @@ static void sign(benchmark::State &state) {
   }
 }
 
+static void setupMessageTransaction(Transaction &tx) {
+  tx.setField(Transaction::Field::Nonce, "1a");
+  tx.setField(Transaction::Field::GasPrice, "22ecb25c00");
+  tx.setField(Transaction::Field::GasLimit, "30d40");
+  tx.setField(Transaction::Field::To, "7a250d5630B4cF539739dF2C5dAcb4c659F2488D");
+  tx.setField(Transaction::Field::Data, TransactionDataBuilder::ConfigData.hex);
+  tx.setField(Transaction::Field::Value, "de0b6b3a7640000");
+}
+
+// Signed transaction is encoded to a buffer, hex encoded to a string and copied into the message
+static void signToMessageChain(benchmark::State &state) {
+  Transaction tx;
+  setupMessageTransaction(tx);
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  Utils::Byte transaction[Config::Size::TransactionRawBuffer];
+  char transactionString[Config::Size::TransactionRawBuffer * 2 + 1];
+  char message[Config::Size::BloXrouteTransactionMessageString];
+
+  for(auto _ : state) {
+    std::size_t transactionLength = tx.sign(privateKey, transaction);
+    Utils::bufferToHexString(transaction, transactionLength, transactionString, true);
+    benchmark::DoNotOptimize(BloXrouteMessageBuilder::buildTransaction(transactionString, message));
+  }
+}
+
+// Signed transaction is hex encoded right into prepared message
+static void signToMessageFused(benchmark::State &state) {
+  Transaction tx;
+  setupMessageTransaction(tx);
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  char message[Config::Size::BloXrouteTransactionMessageString];
+  BloXrouteMessageBuilder::prepareTransaction(message);
+
+  for(auto _ : state) {
+    std::size_t transactionStringLength = tx.signHex(privateKey, message + BloXrouteMessageBuilder::TransactionOffset);
+    benchmark::DoNotOptimize(BloXrouteMessageBuilder::sealTransaction(message, transactionStringLength));
+  }
+}
+
+// Encoding of already signed transaction only, without hashing and signing which dominate the above
+static void encodeMessageChain(benchmark::State &state) {
+  Transaction tx;
+  setupMessageTransaction(tx);
+
+  Utils::Byte transaction[Config::Size::TransactionRawBuffer];
+  char transactionString[Config::Size::TransactionRawBuffer * 2 + 1];
+  char message[Config::Size::BloXrouteTransactionMessageString];
+  tx.sign("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", transaction);
+
+  for(auto _ : state) {
+    std::size_t transactionLength = RLP::encodeList(tx.rlpInput, Transaction::LegacyFieldsCount, transaction);
+    Utils::bufferToHexString(transaction, transactionLength, transactionString, true);
+    benchmark::DoNotOptimize(BloXrouteMessageBuilder::buildTransaction(transactionString, message));
+  }
+}
+
+static void encodeMessageFused(benchmark::State &state) {
+  Transaction tx;
+  setupMessageTransaction(tx);
+
+  Utils::Byte transaction[Config::Size::TransactionRawBuffer];
+  char message[Config::Size::BloXrouteTransactionMessageString];
+  tx.sign("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", transaction);
+  BloXrouteMessageBuilder::prepareTransaction(message);
+
+  for(auto _ : state) {
+    std::size_t transactionStringLength = RLP::encodeListHex(tx.rlpInput, Transaction::LegacyFieldsCount, message + BloXrouteMessageBuilder::TransactionOffset);
+    benchmark::DoNotOptimize(BloXrouteMessageBuilder::sealTransaction(message, transactionStringLength));
+  }
+}
+
 BENCHMARK(keccak256)->Name("Transaction::keccak256");
 BENCHMARK(ecdsa)->Name("Transaction::ecdsa");
-BENCHMARK(sign)->Name("Transaction::sign");
\ No newline at end of file
+BENCHMARK(sign)->Name("Transaction::sign");
+BENCHMARK(signToMessageChain)->Name("Transaction::signToMessage/chain");
+BENCHMARK(signToMessageFused)->Name("Transaction::signToMessage/fused");
+BENCHMARK(encodeMessageChain)->Name("Transaction::encodeMessage/chain");
+BENCHMARK(encodeMessageFused)->Name("Transaction::encodeMessage/fused");
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include <bot.hpp>
+#include <transaction.hpp>
+#include <uniswap.hpp>
+
+static const char *message = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d71900000000000000000000000088acdd2a6425c3faae4bc9650fd7e27e0bebb7ab0000000000000000000000000000000000000000000000032b936327dd7ef24f0000000000000000000000000000000000000000000000032375c0e258b88e9b0000000000000000000000000000000000000000000000001b7a5f826f460000000000000000000000000000161d9b5d6e3ed8d9c1d36a7caf971901c60b922200000000000000000000000000000000000000000000000000000000605caa28\",\"gasPrice\":\"0x36b7176e00\",\"value\":\"0x1bc16d674ec80000\"}}}}";
+
+static void getAmountOut(benchmark::State &state) {
+  UInt256 amountIn = UInt256::fromHexString("de0b6b3a7640000");
+  UInt256 reserveIn = UInt256::fromHexString("1bc16d674ec80000");
+  UInt256 reserveOut = UInt256::fromHexString("32b936327dd7ef24f");
+
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(UniswapV2::getAmountOut(amountIn, reserveIn, reserveOut));
+  }
+}
+
+// Whole decision path: extract liquidity from message, price the swap and patch calldata
+static void patchAmountOutMin(benchmark::State &state) {
+  Transaction tx;
+  char data[TransactionDataBuilder::DataLength + 1];
+  TransactionDataBuilder::buildData("0", "88acdd2a6425c3faae4bc9650fd7e27e0bebb7ab", "f82d59152f33E6F65Aa4aE1a3B38eD2Ca1B7633b", data);
+  tx.setField(Transaction::Field::Data, data);
+
+  UInt256 value = UInt256::fromHexString("de0b6b3a7640000");
+
+  for(auto _ : state) {
+    char amountTokenDesiredStr[65];
+    char liquidityValueStr[65];
+
+    std::size_t amountTokenDesiredStrLength = BloXrouteMessageParser::extractAmountTokenDesired(message, amountTokenDesiredStr);
+    std::size_t liquidityValueStrLength = BloXrouteMessageParser::extractValue(message, liquidityValueStr);
+
+    UInt256 amountOutMin = UniswapV2::getAmountOutMin(
+      value,
+      UInt256::fromHexString(liquidityValueStr, liquidityValueStrLength),
+      UInt256::fromHexString(amountTokenDesiredStr, amountTokenDesiredStrLength),
+      1000
+    );
+
+    Utils::Byte amountOutMinBuffer[32];
+    amountOutMin.toBuffer(amountOutMinBuffer);
+    tx.patchField(Transaction::Field::Data, TransactionDataBuilder::AmountOutMinOffset, amountOutMinBuffer, 32);
+
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK(getAmountOut)->Name("UniswapV2::getAmountOut");
+BENCHMARK(patchAmountOutMin)->Name("UniswapV2::getAmountOutMin (decision path)");
\ No newline at end of file
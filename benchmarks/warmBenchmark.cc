@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <config.hpp>
+#include <bot.hpp>
+#include <pipeline.hpp>
+#include <pregen.hpp>
+#include <wallet.hpp>
+#include <warm.hpp>
+
+// Latency of the first match after the caches were evicted (as by the rest of the system between liquidity adds),
+// without and with a warming round before it
+
+static constexpr char Token[] = "dac17f958d2ee523a2206206994597c13d831ec7";
+static const std::string Input = "0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb";
+static const std::string Message = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"" + Input + "\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x46114844c27ec9\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+
+/**
+ * @brief Liquidity add of other token priced alike, observed by the warmer.
+ */
+static std::string otherMessage() {
+  std::string message = Message;
+  message.replace(BloXrouteMessageParser::TokenPosition, ABI::AddressLength, "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2");
+  return message;
+}
+
+static constexpr std::size_t EvictionSize = 32 << 20;
+
+using BenchmarkWallet = Wallet<PreGen::Store<64, Config::Size::BloXrouteTransactionMessageString>>;
+static BenchmarkWallet wallet;
+static Warm::Warmer<Config::Warm::LikelyCount> warmer;
+static char sink[Config::Size::BloXrouteTransactionMessageString];
+
+static void init() {
+  if(wallet.address[0] != '\0') return;
+
+  wallet.init(Config::Wallets::List[0], TransactionDataBuilder::ConfigData.hex);
+
+  std::vector<std::uint64_t> gasPrices;
+  for(std::uint64_t i = 0; i < 64; i++) gasPrices.push_back((200 + i) * 1000000000);
+  PreGen::generateParallel(wallet.pregenTxs.back(), gasPrices, wallet.privateKey, [](Transaction &tx) { wallet.setFields(tx); }, 1);
+  wallet.pregenTxs.publish();
+  wallet.arm();
+
+  warmer.init(Token, 200 * 1000000000ULL, 0, Config::Warm::BudgetMicroseconds * 1000ULL);
+  warmer.observe(otherMessage().c_str());
+}
+
+/**
+ * @brief Match-and-send path of the event loop up to the send, which is a copy into the sink.
+ */
+static void match(const char *message, bool sign) {
+  if(!BloXrouteMessageParser::validateTransaction(message, Token) || BloXrouteMessageParser::isDynamicFee(message)) return;
+
+  char gasPriceStr[Config::Size::TransactionQuantityBuffer * 2 + 1];
+  std::size_t gasPriceStrLength = BloXrouteMessageParser::extractGasPrice(message, gasPriceStr);
+  uint64_t gasPrice = 0;
+  std::from_chars(gasPriceStr, gasPriceStr + gasPriceStrLength, gasPrice, 16);
+
+  if(!wallet.isArmed()) return;
+
+  if(!sign) {
+    const auto *store = wallet.pregenTxs.acquire();
+    const auto *pregenTx = store->lookup(gasPrice, Config::TransactionPreGen::Policy, Config::TransactionPreGen::MaxGasPriceBump);
+    if(pregenTx != nullptr) {
+      std::size_t messageLength;
+      const char *pregenMessage = store->message(*pregenTx, wallet.message, messageLength);
+      memcpy(sink, pregenMessage, messageLength);
+    }
+    wallet.pregenTxs.release();
+    return;
+  }
+
+  std::size_t messageLength = PreGen::generatePrepared(wallet.tx, wallet.privateKey, gasPrice, wallet.message);
+  memcpy(sink, wallet.message, messageLength);
+}
+
+static void firstMatch(benchmark::State &state, bool warmed, bool sign) {
+  init();
+
+  std::unique_ptr<char[]> eviction(new char[EvictionSize]);
+  const std::string message = Message;
+
+  for(auto _ : state) {
+    // Rest of the system runs between liquidity adds
+    for(std::size_t i = 0; i < EvictionSize; i += 64) eviction[i] = static_cast<char>(i);
+    benchmark::ClobberMemory();
+
+    if(warmed) warmer.run(&wallet, 1, 1, true, true, Pipeline::now);
+
+    auto start = std::chrono::steady_clock::now();
+    match(message.c_str(), sign);
+    auto end = std::chrono::steady_clock::now();
+
+    benchmark::DoNotOptimize(sink);
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+  }
+
+  benchmark::DoNotOptimize(warmer.getChecksum());
+}
+
+static void firstMatchCold(benchmark::State &state) {
+  firstMatch(state, false, false);
+}
+
+static void firstMatchWarmed(benchmark::State &state) {
+  firstMatch(state, true, false);
+}
+
+static void firstSignCold(benchmark::State &state) {
+  firstMatch(state, false, true);
+}
+
+static void firstSignWarmed(benchmark::State &state) {
+  firstMatch(state, true, true);
+}
+
+BENCHMARK(firstMatchCold)->Name("Warm::firstMatch/cold")->UseManualTime()->Iterations(200)->Unit(benchmark::kMicrosecond);
+BENCHMARK(firstMatchWarmed)->Name("Warm::firstMatch/warmed")->UseManualTime()->Iterations(200)->Unit(benchmark::kMicrosecond);
+BENCHMARK(firstSignCold)->Name("Warm::firstMatch/cold/sign")->UseManualTime()->Iterations(200)->Unit(benchmark::kMicrosecond);
+BENCHMARK(firstSignWarmed)->Name("Warm::firstMatch/warmed/sign")->UseManualTime()->Iterations(200)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
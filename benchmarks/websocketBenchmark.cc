@@ -0,0 +1,203 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <bot.hpp>
+#include <websocket.hpp>
+
+#define ASIO_STANDALONE
+#include <websocketpp/config/asio_no_tls_client.hpp>
+#include <websocketpp/client.hpp>
+
+// Local replay harness: the benchmark thread is the server, replaying recorded addLiquidityETH stream message
+// over loopback; the client under test answers every message with transaction-sized message from its callback.
+// Time is the round trip, clientCpu the CPU time of the client thread per message (SQPOLL kernel thread excluded).
+
+static const std::string Message = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d71900000000000000000000000088acdd2a6425c3faae4bc9650fd7e27e0bebb7ab0000000000000000000000000000000000000000000000032b936327dd7ef24f0000000000000000000000000000000000000000000000032375c0e258b88e9b0000000000000000000000000000000000000000000000001b7a5f826f460000000000000000000000000000161d9b5d6e3ed8d9c1d36a7caf971901c60b922200000000000000000000000000000000000000000000000000000000605caa28\",\"gasPrice\":\"0x36b7176e00\",\"value\":\"0x1bc16d674ec80000\"}}}}";
+static const std::string Reply = std::string(BloXrouteMessageBuilder::TransactionPrefix) + std::string(440, 'f') + BloXrouteMessageBuilder::TransactionSuffix;
+
+using UringClient = WebSocket::Client<1 << 16, Config::Size::BloXrouteTransactionMessageString + WebSocket::MaxHeaderLength, 32>;
+static UringClient uringClient;
+
+struct BenchmarkWSConfig : public websocketpp::config::asio_client {
+  static const std::size_t connection_read_buffer_size = 1024;
+  static const bool enable_multithreading = false;
+};
+
+static bool readExact(int fd, char *output, std::size_t length) {
+  for(std::size_t read = 0; read < length;) {
+    ssize_t count = recv(fd, output + read, length - read, 0);
+    if(count <= 0) return false;
+    read += count;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Reads single frame of the client, returns its opcode.
+ */
+static int readFrame(int fd, char *buffer) {
+  if(!readExact(fd, buffer, 2)) return -1;
+
+  std::size_t lengthBits = buffer[1] & 0x7f;
+  std::size_t extra = (lengthBits == 126 ? 2 : lengthBits == 127 ? 8 : 0) + (buffer[1] & 0x80 ? 4 : 0);
+  if(!readExact(fd, buffer + 2, extra)) return -1;
+
+  WebSocket::Frame frame;
+  std::size_t headerLength = WebSocket::parseHeader(buffer, 2 + extra, frame);
+  if(headerLength == 0) return -1;
+  if(!readExact(fd, buffer + headerLength, frame.payloadLength)) return -1;
+
+  return frame.opcode;
+}
+
+/**
+ * @brief Accepts client (waiting up to a second) and answers its opening handshake.
+ */
+static int acceptUpgrade(int listenFd) {
+  pollfd pollFd { listenFd, POLLIN, 0 };
+  if(poll(&pollFd, 1, 1000) != 1) return -1;
+
+  int fd = accept(listenFd, nullptr, nullptr);
+  int noDelay = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+  std::string request;
+  char buffer[1024];
+  while(request.find("\r\n\r\n") == std::string::npos) {
+    ssize_t count = recv(fd, buffer, sizeof(buffer), 0);
+    if(count <= 0) {
+      close(fd);
+      return -1;
+    }
+    request.append(buffer, count);
+  }
+
+  std::size_t keyStart = strcasestr(request.c_str(), "Sec-WebSocket-Key: ") - request.c_str() + 19;
+  char accept[WebSocket::AcceptLength + 1];
+  WebSocket::acceptKey(request.c_str() + keyStart, accept);
+
+  std::string response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: " + std::string(accept) + "\r\n\r\n";
+  send(fd, response.data(), response.size(), 0);
+  return fd;
+}
+
+/**
+ * @brief Replays the message to the client run by the given function on its own thread, one round trip per iteration.
+ */
+template<typename RunClient>
+static void replay(benchmark::State &state, RunClient runClient) {
+  int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addressLength = sizeof(address);
+  bind(listenFd, reinterpret_cast<sockaddr*>(&address), addressLength);
+  listen(listenFd, 1);
+  getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength);
+
+  std::string url = "ws://127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+  std::thread client(runClient, url);
+
+  int fd = acceptUpgrade(listenFd);
+  close(listenFd);
+  if(fd == -1) {
+    client.join();
+    state.SkipWithError("Client did not connect");
+    return;
+  }
+
+  char header[WebSocket::MaxHeaderLength];
+  std::string frame = std::string(header, WebSocket::encodeHeader(WebSocket::Text, Message.size(), nullptr, header)) + Message;
+  static char buffer[1 << 16];
+
+  std::vector<double> roundTrips;
+  roundTrips.reserve(1 << 20);
+
+  clockid_t clientClock;
+  timespec cpuStart, cpuEnd;
+  pthread_getcpuclockid(client.native_handle(), &clientClock);
+  clock_gettime(clientClock, &cpuStart);
+
+  for(auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    send(fd, frame.data(), frame.size(), 0);
+    if(readFrame(fd, buffer) != WebSocket::Text) {
+      state.SkipWithError("Client did not reply");
+      break;
+    }
+    roundTrips.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+  }
+
+  clock_gettime(clientClock, &cpuEnd);
+
+  // Close handshake, the client replies and stops
+  std::string closeFrame = std::string(header, WebSocket::encodeHeader(WebSocket::Close, 2, nullptr, header)) + "\x03\xe8";
+  send(fd, closeFrame.data(), closeFrame.size(), 0);
+  while(readFrame(fd, buffer) > 0 && buffer[0] != static_cast<char>(0x80 | WebSocket::Close));
+  close(fd);
+  client.join();
+
+  if(roundTrips.empty()) return;
+
+  std::sort(roundTrips.begin(), roundTrips.end());
+  double cpu = (cpuEnd.tv_sec - cpuStart.tv_sec) * 1e9 + (cpuEnd.tv_nsec - cpuStart.tv_nsec);
+  state.counters["clientCpu"] = benchmark::Counter(cpu / roundTrips.size());
+  state.counters["p50"] = benchmark::Counter(roundTrips[roundTrips.size() / 2]);
+  state.counters["p99"] = benchmark::Counter(roundTrips[roundTrips.size() * 99 / 100]);
+}
+
+static void runUring(const std::string &url, bool sqPoll) {
+  if(!uringClient.connect(url.c_str(), nullptr, 60000, sqPoll)) return;
+
+  uringClient.run(
+    [](char *, std::size_t) { uringClient.send(Reply.data(), Reply.size()); },
+    []() {}
+  );
+}
+
+static void replayUring(benchmark::State &state) {
+  replay(state, [](const std::string &url) { runUring(url, false); });
+}
+
+static void replayUringSqPoll(benchmark::State &state) {
+  replay(state, [](const std::string &url) { runUring(url, true); });
+}
+
+static void replayWebsocketpp(benchmark::State &state) {
+  replay(state, [](const std::string &url) {
+    websocketpp::client<BenchmarkWSConfig> client;
+    client.init_asio();
+    client.clear_access_channels(websocketpp::log::alevel::all);
+    client.clear_error_channels(websocketpp::log::elevel::all);
+
+    client.set_message_handler([&client](websocketpp::connection_hdl connectionHdl, websocketpp::client<BenchmarkWSConfig>::message_ptr) {
+      client.send(connectionHdl, Reply.data(), Reply.size(), websocketpp::frame::opcode::text);
+    });
+
+    websocketpp::lib::error_code errorCode;
+    websocketpp::client<BenchmarkWSConfig>::connection_ptr connection = client.get_connection(url, errorCode);
+    if(errorCode || connection == nullptr) return;
+
+    client.connect(connection);
+    client.run();
+  });
+}
+
+BENCHMARK(replayUring)->Name("WebSocket::replay/uring")->UseRealTime();
+BENCHMARK(replayUringSqPoll)->Name("WebSocket::replay/uringSqPoll")->UseRealTime();
+BENCHMARK(replayWebsocketpp)->Name("WebSocket::replay/websocketpp")->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Compile-time ABI calldata templates of Uniswap V2 style router methods.
+ *
+ * Template is a hex string with constant words already filled in (selector, dynamic array offsets and lengths,
+ * wrapped native token in swap path, maximum deadline) and zeroed arguments, together with hex offsets of the arguments.
+ * Both are resolved at compile time, so filling template on the hot path is memcpy only.
+ * The same templates describe input of observed transactions, so parser positions are derived from them too.
+ *
+ * @see https://docs.soliditylang.org/en/latest/abi-spec.html
+ */
+namespace ABI {
+  /**
+   * @brief Length of method selector (hex chars).
+   */
+  inline constexpr std::size_t SelectorLength = 8;
+
+  /**
+   * @brief Length of ABI word (hex chars).
+   */
+  inline constexpr std::size_t WordLength = 64;
+
+  /**
+   * @brief Length of address (hex chars), addresses are right aligned in ABI words.
+   */
+  inline constexpr std::size_t AddressLength = 40;
+
+  /**
+   * @brief Offset of argument missing in template.
+   */
+  inline constexpr std::size_t NoOffset = SIZE_MAX;
+
+  /**
+   * @brief Method selectors (first 4 bytes of keccak256 of method signature).
+   */
+  namespace Selector {
+    inline constexpr char SwapExactETHForTokens[] = "7ff36ab5";
+    inline constexpr char SwapExactETHForTokensSupportingFeeOnTransferTokens[] = "b6f9de95";
+    inline constexpr char AddLiquidityETH[] = "f305d719";
+    inline constexpr char AddLiquidity[] = "e8e33700";
+    inline constexpr char RemoveLiquidityETH[] = "02751cec";
+    inline constexpr char RemoveLiquidityETHSupportingFeeOnTransferTokens[] = "af2979eb";
+    inline constexpr char SwapExactTokensForETH[] = "18cbafe5";
+    inline constexpr char SwapExactTokensForETHSupportingFeeOnTransferTokens[] = "791ac947";
+    inline constexpr char Approve[] = "095ea7b3";
+    inline constexpr char CreatePair[] = "c9c65396";
+  }
+
+  /**
+   * @brief Arguments that can be patched in or read from calldata.
+   */
+  enum Argument : std::size_t {
+    AmountOutMin,
+    Token,
+    To,
+    Deadline,
+    AmountTokenDesired,
+    TokenA,
+    TokenB,
+    AmountADesired,
+    AmountBDesired,
+    AmountIn,
+    Spender,
+    Amount,
+    ArgumentsCount
+  };
+
+  /**
+   * @brief Template word description.
+   */
+  struct Word {
+    Argument argument; // ArgumentsCount for constant words
+    const char *constant; // right aligned hex value, nullptr for no value
+    char fill; // character the rest of the word is filled with
+  };
+
+  /**
+   * @brief Patchable argument word, zero by default.
+   */
+  constexpr Word argument(Argument argument) {
+    return { argument, nullptr, '0' };
+  }
+
+  /**
+   * @brief Patchable argument word, maximum value by default.
+   */
+  constexpr Word maximum(Argument argument) {
+    return { argument, nullptr, 'f' };
+  }
+
+  /**
+   * @brief Constant word.
+   *
+   * @param value right aligned hex value, nullptr for zero word
+   */
+  constexpr Word constant(const char *value = nullptr) {
+    return { ArgumentsCount, value, '0' };
+  }
+
+  /**
+   * @brief Calldata template.
+   *
+   * @tparam Words number of ABI words following selector
+   */
+  template<std::size_t Words>
+  struct Template {
+    static constexpr std::size_t HexLength = SelectorLength + Words * WordLength;
+    static constexpr std::size_t Length = HexLength / 2;
+
+    char hex[HexLength + 1] = {};
+
+    /**
+     * @brief Hex offsets of argument words in calldata, NoOffset if template does not have the argument.
+     */
+    std::size_t offsets[ArgumentsCount] = {};
+
+    /**
+     * @brief Checks if template has given argument.
+     */
+    constexpr bool has(Argument argument) const {
+      return offsets[argument] != NoOffset;
+    }
+
+    /**
+     * @brief Returns hex offset of argument word.
+     */
+    constexpr std::size_t wordOffset(Argument argument) const {
+      return offsets[argument];
+    }
+
+    /**
+     * @brief Returns hex offset of address argument (right aligned in its word).
+     */
+    constexpr std::size_t addressOffset(Argument argument) const {
+      return offsets[argument] + WordLength - AddressLength;
+    }
+
+    /**
+     * @brief Returns byte offset of argument word in decoded calldata.
+     */
+    constexpr std::size_t byteOffset(Argument argument) const {
+      return offsets[argument] / 2;
+    }
+  };
+
+  /**
+   * @brief Builds calldata template at compile time.
+   *
+   * @param selector method selector (8 hex chars)
+   * @param words ABI words following selector
+   * @return calldata template
+   */
+  template<std::size_t Words>
+  constexpr Template<Words> build(const char *selector, const Word (&words)[Words]) {
+    Template<Words> result {};
+
+    for(std::size_t i = 0; i < ArgumentsCount; i++) {
+      result.offsets[i] = NoOffset;
+    }
+
+    for(std::size_t i = 0; i < SelectorLength; i++) {
+      result.hex[i] = selector[i];
+    }
+
+    for(std::size_t i = 0; i < Words; i++) {
+      std::size_t position = SelectorLength + i * WordLength;
+      std::size_t constantLength = words[i].constant == nullptr ? 0 : std::char_traits<char>::length(words[i].constant);
+
+      for(std::size_t j = 0; j < WordLength - constantLength; j++) {
+        result.hex[position + j] = words[i].fill;
+      }
+
+      for(std::size_t j = 0; j < constantLength; j++) {
+        result.hex[position + WordLength - constantLength + j] = words[i].constant[j];
+      }
+
+      if(words[i].argument != ArgumentsCount) {
+        result.offsets[words[i].argument] = position;
+      }
+    }
+
+    result.hex[Template<Words>::HexLength] = '\0';
+
+    return result;
+  }
+
+  /**
+   * @brief swapExactETHForTokens(uint amountOutMin, address[] path, address to, uint deadline) with path [wrappedNative, token] and maximum deadline.
+   * swapExactETHForTokensSupportingFeeOnTransferTokens has the same arguments.
+   *
+   * @param selector method selector
+   * @param wrappedNative wrapped native token address (path[0])
+   */
+  constexpr auto swapExactETHForTokens(const char *selector, const char *wrappedNative) {
+    return build(selector, {
+      argument(AmountOutMin),
+      constant("80"),
+      argument(To),
+      maximum(Deadline),
+      constant("2"),
+      constant(wrappedNative),
+      argument(Token),
+    });
+  }
+
+  /**
+   * @brief swapExactTokensForETH(uint amountIn, uint amountOutMin, address[] path, address to, uint deadline) with path [token, wrappedNative] and maximum deadline.
+   * swapExactTokensForETHSupportingFeeOnTransferTokens has the same arguments.
+   *
+   * @param selector method selector
+   * @param wrappedNative wrapped native token address (path[1])
+   */
+  constexpr auto swapExactTokensForETH(const char *selector, const char *wrappedNative) {
+    return build(selector, {
+      argument(AmountIn),
+      argument(AmountOutMin),
+      constant("a0"),
+      argument(To),
+      maximum(Deadline),
+      constant("2"),
+      argument(Token),
+      constant(wrappedNative),
+    });
+  }
+
+  /**
+   * @brief ERC-20 approve(address spender, uint256 amount) with maximum amount.
+   */
+  constexpr auto approve() {
+    return build(Selector::Approve, {
+      argument(Spender),
+      maximum(Amount),
+    });
+  }
+
+  /**
+   * @brief Factory createPair(address tokenA, address tokenB).
+   */
+  constexpr auto createPair() {
+    return build(Selector::CreatePair, {
+      argument(TokenA),
+      argument(TokenB),
+    });
+  }
+
+  /**
+   * @brief addLiquidityETH(address token, uint amountTokenDesired, uint amountTokenMin, uint amountETHMin, address to, uint deadline).
+   */
+  constexpr auto addLiquidityETH() {
+    return build(Selector::AddLiquidityETH, {
+      argument(Token),
+      argument(AmountTokenDesired),
+      constant(),
+      constant(),
+      constant(),
+      constant(),
+    });
+  }
+
+  /**
+   * @brief addLiquidity(address tokenA, address tokenB, uint amountADesired, uint amountBDesired, uint amountAMin, uint amountBMin, address to, uint deadline).
+   */
+  constexpr auto addLiquidity() {
+    return build(Selector::AddLiquidity, {
+      argument(TokenA),
+      argument(TokenB),
+      argument(AmountADesired),
+      argument(AmountBDesired),
+      constant(),
+      constant(),
+      constant(),
+      constant(),
+    });
+  }
+}
\ No newline at end of file
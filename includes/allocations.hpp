@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief Counting of heap allocations made by the current thread, used to guard the hot path against allocating.
+ *
+ * Hooks replacing malloc, calloc, realloc, aligned allocations and all forms of operator new are defined
+ * by the translation unit which defines ALLOCATIONS_HOOKS before including this header (exactly one per executable,
+ * glibc only). They forward to glibc allocator and count only on threads with an active Scope,
+ * so everything else in the executable is unaffected.
+ */
+namespace Allocations {
+  /**
+   * @brief Allocations counted in a scope.
+   */
+  struct Counts {
+    std::size_t allocations = 0;
+    std::size_t bytes = 0;
+  };
+
+  inline thread_local bool tracking = false;
+  inline thread_local Counts counts;
+
+  /**
+   * @brief Counts allocation if tracking on the current thread.
+   *
+   * @param size allocation size
+   */
+  inline void record(std::size_t size) {
+    if(!tracking) return;
+
+    ++counts.allocations;
+    counts.bytes += size;
+  }
+
+  /**
+   * @brief Counts allocations of the current thread for its lifetime, scopes do not nest.
+   */
+  class Scope {
+    public:
+
+    Scope() {
+      counts = Counts {};
+      tracking = true;
+    }
+
+    ~Scope() {
+      tracking = false;
+    }
+
+    Scope(const Scope&) = delete;
+    Scope &operator=(const Scope&) = delete;
+
+    /**
+     * @brief Returns allocations counted so far.
+     */
+    Counts get() const {
+      return counts;
+    }
+
+    /**
+     * @brief Returns allocations counted so far and starts counting from zero, used to split scope into stages.
+     */
+    Counts lap() {
+      Counts result = counts;
+      counts = Counts {};
+      return result;
+    }
+  };
+}
+
+#ifdef ALLOCATIONS_HOOKS
+  extern "C" {
+    void *__libc_malloc(std::size_t size);
+    void *__libc_calloc(std::size_t count, std::size_t size);
+    void *__libc_realloc(void *pointer, std::size_t size);
+    void *__libc_memalign(std::size_t alignment, std::size_t size);
+    void __libc_free(void *pointer);
+
+    void *malloc(std::size_t size) {
+      Allocations::record(size);
+      return __libc_malloc(size);
+    }
+
+    void *calloc(std::size_t count, std::size_t size) {
+      Allocations::record(count * size);
+      return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *pointer, std::size_t size) {
+      Allocations::record(size);
+      return __libc_realloc(pointer, size);
+    }
+
+    void *aligned_alloc(std::size_t alignment, std::size_t size) {
+      Allocations::record(size);
+      return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void **pointer, std::size_t alignment, std::size_t size) {
+      Allocations::record(size);
+      *pointer = __libc_memalign(alignment, size);
+      return *pointer == nullptr ? ENOMEM : 0;
+    }
+
+    void free(void *pointer) {
+      __libc_free(pointer);
+    }
+  }
+
+  void *operator new(std::size_t size) {
+    void *pointer = malloc(size == 0 ? 1 : size);
+    if(pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+  }
+
+  void *operator new[](std::size_t size) {
+    return operator new(size);
+  }
+
+  void *operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return malloc(size == 0 ? 1 : size);
+  }
+
+  void *operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return malloc(size == 0 ? 1 : size);
+  }
+
+  void *operator new(std::size_t size, std::align_val_t alignment) {
+    void *pointer = aligned_alloc(static_cast<std::size_t>(alignment), size == 0 ? 1 : size);
+    if(pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+  }
+
+  void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+  }
+
+  void operator delete(void *pointer) noexcept { free(pointer); }
+  void operator delete[](void *pointer) noexcept { free(pointer); }
+  void operator delete(void *pointer, std::size_t) noexcept { free(pointer); }
+  void operator delete[](void *pointer, std::size_t) noexcept { free(pointer); }
+  void operator delete(void *pointer, std::align_val_t) noexcept { free(pointer); }
+  void operator delete[](void *pointer, std::align_val_t) noexcept { free(pointer); }
+  void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { free(pointer); }
+  void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { free(pointer); }
+#endif
\ No newline at end of file
@@ -1,27 +1,71 @@
 #pragma once
 
+#include <abi.hpp>
+#include <config.hpp>
 #include <utils.hpp>
 
 /**
- * @brief Utilities to build transaction data to call swapExactETHForTokens on Uniswap V2 Rotuer 02 contract.
+ * @brief Utilities to build transaction data to call swapExactETHForTokens (or its fee on transfer variant) on selected router.
  * 
  * @see https://uniswap.org/docs/v2/smart-contracts/router02/#swapexactethfortokens
  */
 namespace TransactionDataBuilder {
   /**
-   * @brief Boilerplate transaction data.
+   * @brief Calldata template of the buy method.
    * 
-   * Boilerplate transaction data.
-   * Includes WETH token address as path[0] and maximum possible deadline.
+   * Includes wrapped native token address as path[0] and maximum possible deadline.
    * It is missing amountOutMin, path[1] and to values.
    */
-  inline constexpr char const * DataBoilerplate { "7ff36ab5000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000800000000000000000000000000000000000000000000000000000000000000000ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff0000000000000000000000000000000000000000000000000000000000000002000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc20000000000000000000000000000000000000000000000000000000000000000" };
+  inline constexpr auto Template = ABI::swapExactETHForTokens(
+    Config::Transaction::SwapExactETHForTokens::SupportingFeeOnTransferTokens
+      ? ABI::Selector::SwapExactETHForTokensSupportingFeeOnTransferTokens
+      : ABI::Selector::SwapExactETHForTokens,
+    Config::Router::Selected.WrappedNative
+  );
+
+  /**
+   * @brief Boilerplate transaction data.
+   * @see Template
+   */
+  inline constexpr char const * DataBoilerplate { Template.hex };
 
   /**
    * @brief Boilerplate transaction data length.
    * @see DataBoilerplate
    */
-  inline constexpr std::size_t DataLength { std::char_traits<char>::length(DataBoilerplate) };
+  inline constexpr std::size_t DataLength { Template.HexLength };
+
+  /**
+   * @brief Builds swapExactETHForTokens input data at compile time.
+   * Too long amountOutMin fails compilation.
+   * 
+   * @param amountOutMin minimum amount of output tokens (hex)
+   * @param targetTokenAddress address of output token (path[1])
+   * @param receiverAddress (to)
+   * @return filled calldata template
+   */
+  constexpr auto build(const char *amountOutMin, const char *targetTokenAddress, const char *receiverAddress) {
+    auto result = Template;
+    std::size_t amountOutMinLength = Utils::stringLength(amountOutMin);
+    std::size_t amountOutMinOffset = Template.wordOffset(ABI::AmountOutMin) + ABI::WordLength - amountOutMinLength;
+
+    for(std::size_t i = 0; i < amountOutMinLength; i++) result.hex[amountOutMinOffset + i] = amountOutMin[i];
+    for(std::size_t i = 0; i < ABI::AddressLength; i++) {
+      result.hex[Template.addressOffset(ABI::To) + i] = receiverAddress[i];
+      result.hex[Template.addressOffset(ABI::Token) + i] = targetTokenAddress[i];
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Transaction data built from Config::Transaction::SwapExactETHForTokens at compile time.
+   */
+  inline constexpr auto ConfigData = build(
+    Config::Transaction::SwapExactETHForTokens::AmountOutMin,
+    Config::Transaction::SwapExactETHForTokens::TokenAddress,
+    Config::Transaction::SwapExactETHForTokens::ReceiverAddress
+  );
 
   /**
    * @brief Builds swapExactETHForTokens input data.
@@ -37,18 +81,26 @@ namespace TransactionDataBuilder {
     std::size_t amountOutMinLength = strlen(amountOutMin);
 
     memcpy(output, DataBoilerplate, DataLength);
-    memcpy(output + 8 + 64 - amountOutMinLength, amountOutMin, amountOutMinLength);
-    memcpy(output + 8 + 3 * 64 - 40, receiverAddress, 40);
-    memcpy(output + 8 + 7 * 64 - 40, targetTokenAddress, 40);
+    memcpy(output + Template.wordOffset(ABI::AmountOutMin) + ABI::WordLength - amountOutMinLength, amountOutMin, amountOutMinLength);
+    memcpy(output + Template.addressOffset(ABI::To), receiverAddress, ABI::AddressLength);
+    memcpy(output + Template.addressOffset(ABI::Token), targetTokenAddress, ABI::AddressLength);
 
     output[DataLength] = '\0';
 
     return DataLength;
   }
+
+  /**
+   * @brief Byte offset of amountOutMin in decoded transaction data.
+   */
+  inline constexpr std::size_t AmountOutMinOffset = Template.byteOffset(ABI::AmountOutMin);
 }
 
 /**
  * @brief Utilities to parse incoming BloXroute messages.
+ *
+ * Observed transaction is either addLiquidityETH or token/wrapped native addLiquidity,
+ * input positions are taken from their calldata templates.
  */
 namespace BloXrouteMessageParser {
   /**
@@ -57,45 +109,376 @@ namespace BloXrouteMessageParser {
   inline constexpr std::size_t MethodPosition = 37;
 
   /**
-   * @brief Position of the token address in the message string.
+   * @brief Position of the input hex value (after 0x prefix) in the message string.
+   */
+  inline constexpr std::size_t InputPosition = 147;
+
+  /**
+   * @brief Calldata templates of observed methods.
+   */
+  inline constexpr auto AddLiquidityETH = ABI::addLiquidityETH();
+  inline constexpr auto AddLiquidity = ABI::addLiquidity();
+
+  /**
+   * @brief Position of the addLiquidityETH token address in the message string.
+   */
+  inline constexpr std::size_t TokenPosition = InputPosition + AddLiquidityETH.addressOffset(ABI::Token);
+
+  /**
+   * @brief Position of the addLiquidityETH amountTokenDesired hex value in the message string.
+   */
+  inline constexpr std::size_t AmountTokenDesiredPosition = InputPosition + AddLiquidityETH.wordOffset(ABI::AmountTokenDesired);
+
+  /**
+   * @brief Position right after the addLiquidityETH input hex value, where the other transaction fields start.
+   */
+  inline constexpr std::size_t InputEndPosition = InputPosition + AddLiquidityETH.HexLength;
+
+  /**
+   * @brief Position right after the addLiquidity input hex value.
+   */
+  inline constexpr std::size_t AddLiquidityInputEndPosition = InputPosition + AddLiquidity.HexLength;
+
+  /**
+   * @brief Distance from the input end to the gas price hex value (","gasPrice":"0x).
+   */
+  inline constexpr std::size_t GasPriceDistance = 16;
+
+  /**
+   * @brief Position of the addLiquidityETH gas price hex value in the message string.
+   */
+  inline constexpr std::size_t GasPricePosition = InputEndPosition + GasPriceDistance;
+
+  static_assert(TokenPosition == 179 && AmountTokenDesiredPosition == 219 && GasPricePosition == 555, "addLiquidityETH positions");
+
+  /**
+   * @brief Key preceding transaction value hex value, follows input in the message string.
    */
-  inline constexpr std::size_t TokenPosition = 179;
+  inline constexpr char ValueKey[] = "\"value\":\"0x";
 
   /**
-   * @brief Position of the gas price hex value in the message string.
+   * @brief Key preceding gasPrice hex value, follows input in the message string.
    */
-  inline constexpr std::size_t GasPricePosition = 555;
+  inline constexpr char GasPriceKey[] = "\"gasPrice\":\"0x";
 
   /**
-   * @brief Check if message is of "subscribe" method and regards specified token address.
+   * @brief Key preceding sender address, follows input in the message string.
+   */
+  inline constexpr char FromKey[] = "\"from\":\"0x";
+
+  /**
+   * @brief Key preceding nonce hex value, follows input in the message string.
+   */
+  inline constexpr char NonceKey[] = "\"nonce\":\"0x";
+
+  /**
+   * @brief Key preceding maxFeePerGas hex value of EIP-1559 transaction, follows input in the message string.
+   */
+  inline constexpr char MaxFeePerGasKey[] = "\"maxFeePerGas\":\"0x";
+
+  /**
+   * @brief Key preceding maxPriorityFeePerGas hex value of EIP-1559 transaction, follows input in the message string.
+   */
+  inline constexpr char MaxPriorityFeePerGasKey[] = "\"maxPriorityFeePerGas\":\"0x";
+
+  /**
+   * @brief Check if message is of "subscribe" method (is a transaction from the stream).
+   * 
+   * @param message input message
+   * @return boolean value if message is a transaction
+   */
+  inline bool isTransaction(const char *message) {
+    return memcmp(message + MethodPosition, "subscribe", 9) == 0;
+  }
+
+  /**
+   * @brief Check if transaction message is addLiquidityETH.
+   * 
+   * @param message input message
+   * @return boolean value if message is addLiquidityETH transaction
+   */
+  inline bool isAddLiquidityETH(const char *message) {
+    return memcmp(message + InputPosition, ABI::Selector::AddLiquidityETH, ABI::SelectorLength) == 0;
+  }
+
+  /**
+   * @brief Check if transaction message is addLiquidity.
+   * 
+   * @param message input message
+   * @return boolean value if message is addLiquidity transaction
+   */
+  inline bool isAddLiquidity(const char *message) {
+    return memcmp(message + InputPosition, ABI::Selector::AddLiquidity, ABI::SelectorLength) == 0;
+  }
+
+  /**
+   * @brief Position right after the input hex value of transaction message.
+   * 
+   * @param message input message
+   * @return input end position
+   */
+  inline std::size_t inputEndPosition(const char *message) {
+    return isAddLiquidity(message) ? AddLiquidityInputEndPosition : InputEndPosition;
+  }
+
+  /**
+   * @brief Check if the message holds the whole input of liquidity add (addLiquidityETH layout unless it is addLiquidity),
+   * so fields are read at their fixed positions within the message. Input of other length (any other method) is rejected.
+   * 
+   * @param message input message
+   * @return boolean value if input hex value ends at inputEndPosition()
+   */
+  inline bool isInputComplete(const char *message) {
+    std::size_t length = inputEndPosition(message) - InputPosition;
+    return
+         strnlen(message + InputPosition, length) == length
+      && memchr(message + InputPosition, '\"', length) == nullptr
+      && message[InputPosition + length] == '\"';
+  }
+
+  /**
+   * @brief Check if addLiquidity tokenA is wrapped native token (so tokenB is the target one).
+   * 
+   * @param message input message
+   * @param wrappedNativeAddress wrapped native token address
+   * @return boolean value if tokenA is wrapped native token
+   */
+  inline bool isWrappedNativeFirst(const char *message, const char *wrappedNativeAddress) {
+    return memcmp(message + InputPosition + AddLiquidity.addressOffset(ABI::TokenA), wrappedNativeAddress, ABI::AddressLength) == 0;
+  }
+
+  /**
+   * @brief Check if message is of "subscribe" method and adds liquidity of specified token,
+   * paired with wrapped native token in case of addLiquidity.
    * 
    * @param message input message
    * @param targetTokenAddress target token address to check against
+   * @param wrappedNativeAddress wrapped native token address
    * @return boolean value if message is valid and should be further processed
    */
-  inline bool validateTransaction(const char *message, const char *targetTokenAddress) {
-    return 
-         memcmp(message + MethodPosition, "subscribe", 9) == 0
-      && memcmp(message + TokenPosition, targetTokenAddress, 40) == 0;
+  inline bool validateTransaction(const char *message, const char *targetTokenAddress, const char *wrappedNativeAddress = Config::Router::Selected.WrappedNative) {
+    if(!isTransaction(message)) return false;
+    if(isAddLiquidityETH(message)) return memcmp(message + TokenPosition, targetTokenAddress, ABI::AddressLength) == 0 && isInputComplete(message);
+    if(!isAddLiquidity(message)) return false;
+
+    const char *tokenA = message + InputPosition + AddLiquidity.addressOffset(ABI::TokenA);
+    const char *tokenB = message + InputPosition + AddLiquidity.addressOffset(ABI::TokenB);
+
+    return (
+         (memcmp(tokenA, targetTokenAddress, ABI::AddressLength) == 0 && memcmp(tokenB, wrappedNativeAddress, ABI::AddressLength) == 0)
+      || (memcmp(tokenB, targetTokenAddress, ABI::AddressLength) == 0 && memcmp(tokenA, wrappedNativeAddress, ABI::AddressLength) == 0)
+    ) && isInputComplete(message);
   }
 
   /**
-   * @brief Extract gas price hex value from the message.
+   * @brief Check if message is removeLiquidityETH (or its fee on transfer variant) of specified token.
+   * Its input has the same layout as addLiquidityETH, with token as the first argument.
    * 
    * @param message input message
+   * @param targetTokenAddress target token address to check against
+   * @return boolean value if message removes liquidity of the token
+   */
+  inline bool isRemoveLiquidityETH(const char *message, const char *targetTokenAddress) {
+    return
+         isTransaction(message)
+      && (
+           memcmp(message + InputPosition, ABI::Selector::RemoveLiquidityETH, ABI::SelectorLength) == 0
+        || memcmp(message + InputPosition, ABI::Selector::RemoveLiquidityETHSupportingFeeOnTransferTokens, ABI::SelectorLength) == 0
+      )
+      && memcmp(message + TokenPosition, targetTokenAddress, ABI::AddressLength) == 0
+      && isInputComplete(message);
+  }
+
+  /**
+   * @brief Extract gas price hex value from the message.
+   * 
+   * @param message input message, has to hold complete liquidity add input (see isInputComplete)
    * @param output output gas price
-   * @return output gas price length
+   * @return output gas price length, 0 if it is unterminated or does not fit the output
    */
-  inline std::size_t extractGasPrice(const char *message, char *output) {
-    const char *gasPriceStart = message + GasPricePosition;
+  template<std::size_t OutputSize>
+  inline std::size_t extractGasPrice(const char *message, char (&output)[OutputSize]) {
+    const char *gasPriceStart = message + inputEndPosition(message) + GasPriceDistance;
     const char *gasPriceEnd = strchr(gasPriceStart, '\"');
-    std::size_t gasPriceLength = gasPriceEnd - gasPriceStart;
+    if(gasPriceEnd == nullptr || std::size_t(gasPriceEnd - gasPriceStart) >= OutputSize) {
+      output[0] = '\0';
+      return 0;
+    }
 
+    std::size_t gasPriceLength = gasPriceEnd - gasPriceStart;
     memcpy(output, gasPriceStart, gasPriceLength);
     output[gasPriceLength] = '\0';
 
     return gasPriceLength;
   }
+
+  /**
+   * @brief Extract amountTokenDesired hex value (ABI word, 64 chars) from addLiquidityETH input in the message,
+   * or desired amount of the target token from addLiquidity input.
+   * 
+   * @param message input message
+   * @param output output amountTokenDesired
+   * @param wrappedNativeAddress wrapped native token address
+   * @return output amountTokenDesired length
+   */
+  inline std::size_t extractAmountTokenDesired(const char *message, char *output, const char *wrappedNativeAddress = Config::Router::Selected.WrappedNative) {
+    std::size_t position = AmountTokenDesiredPosition;
+    if(isAddLiquidity(message)) {
+      position = InputPosition + AddLiquidity.wordOffset(isWrappedNativeFirst(message, wrappedNativeAddress) ? ABI::AmountBDesired : ABI::AmountADesired);
+    }
+
+    memcpy(output, message + position, ABI::WordLength);
+    output[ABI::WordLength] = '\0';
+
+    return ABI::WordLength;
+  }
+
+  /**
+   * @brief Extract hex value of the field from the message, searching from given position.
+   * 
+   * @param message input message
+   * @param key key preceding the value, including opening quote and 0x prefix
+   * @param output output value
+   * @param position position to search from, must be within the message
+   * @return output value length, 0 if message does not contain the field, it is unterminated or does not fit the output
+   */
+  template<std::size_t KeySize, std::size_t OutputSize>
+  inline std::size_t extractField(const char *message, const char (&key)[KeySize], char (&output)[OutputSize], std::size_t position) {
+    const char *valueStart = strstr(message + position, key);
+    const char *valueEnd = valueStart != nullptr ? strchr(valueStart + KeySize - 1, '\"') : nullptr;
+    if(valueEnd == nullptr || std::size_t(valueEnd - valueStart) - (KeySize - 1) >= OutputSize) {
+      output[0] = '\0';
+      return 0;
+    }
+
+    valueStart += KeySize - 1;
+    std::size_t valueLength = valueEnd - valueStart;
+
+    memcpy(output, valueStart, valueLength);
+    output[valueLength] = '\0';
+
+    return valueLength;
+  }
+
+  /**
+   * @brief Extract hex value of the field following input in the message.
+   * 
+   * @param message input message, has to hold complete liquidity add input (see isInputComplete)
+   * @param key key preceding the value, including opening quote and 0x prefix
+   * @param output output value
+   * @return output value length, 0 if message does not contain the field, it is unterminated or does not fit the output
+   */
+  template<std::size_t KeySize, std::size_t OutputSize>
+  inline std::size_t extractField(const char *message, const char (&key)[KeySize], char (&output)[OutputSize]) {
+    return extractField(message, key, output, inputEndPosition(message));
+  }
+
+  /**
+   * @brief Extract transaction value (msg.value) hex value from the message.
+   * 
+   * @param message input message
+   * @param output output value
+   * @return output value length, 0 if message does not contain value
+   */
+  template<std::size_t OutputSize>
+  inline std::size_t extractValue(const char *message, char (&output)[OutputSize]) {
+    return extractField(message, ValueKey, output);
+  }
+
+  /**
+   * @brief Extract liquidity added in wrapped native token: transaction value of addLiquidityETH,
+   * or desired amount of wrapped native token (ABI word, 64 chars) of addLiquidity.
+   * 
+   * @param message input message
+   * @param output output liquidity
+   * @param wrappedNativeAddress wrapped native token address
+   * @return output liquidity length, 0 if message does not contain value
+   */
+  template<std::size_t OutputSize>
+  inline std::size_t extractLiquidityETH(const char *message, char (&output)[OutputSize], const char *wrappedNativeAddress = Config::Router::Selected.WrappedNative) {
+    static_assert(OutputSize > ABI::WordLength, "Output fits ABI word");
+    if(!isAddLiquidity(message)) return extractValue(message, output);
+
+    std::size_t position = InputPosition + AddLiquidity.wordOffset(isWrappedNativeFirst(message, wrappedNativeAddress) ? ABI::AmountADesired : ABI::AmountBDesired);
+    memcpy(output, message + position, ABI::WordLength);
+    output[ABI::WordLength] = '\0';
+
+    return ABI::WordLength;
+  }
+
+  /**
+   * @brief Extract maxFeePerGas hex value of EIP-1559 transaction from the message.
+   * 
+   * @param message input message
+   * @param output output maxFeePerGas
+   * @return output maxFeePerGas length, 0 if message is not EIP-1559 transaction
+   */
+  template<std::size_t OutputSize>
+  inline std::size_t extractMaxFeePerGas(const char *message, char (&output)[OutputSize]) {
+    return extractField(message, MaxFeePerGasKey, output);
+  }
+
+  /**
+   * @brief Extract maxPriorityFeePerGas hex value of EIP-1559 transaction from the message.
+   * 
+   * @param message input message
+   * @param output output maxPriorityFeePerGas
+   * @return output maxPriorityFeePerGas length, 0 if message is not EIP-1559 transaction
+   */
+  template<std::size_t OutputSize>
+  inline std::size_t extractMaxPriorityFeePerGas(const char *message, char (&output)[OutputSize]) {
+    return extractField(message, MaxPriorityFeePerGasKey, output);
+  }
+
+  /**
+   * @brief Extract sender address (without 0x prefix) from the message, input can be of any method.
+   * 
+   * @param message input message
+   * @param output output address
+   * @return output address length, 0 if message does not contain sender
+   */
+  template<std::size_t OutputSize>
+  inline std::size_t extractFrom(const char *message, char (&output)[OutputSize]) {
+    return extractField(message, FromKey, output, InputPosition);
+  }
+
+  /**
+   * @brief Extract nonce hex value from the message, input can be of any method.
+   * 
+   * @param message input message
+   * @param output output nonce
+   * @return output nonce length, 0 if message does not contain nonce
+   */
+  template<std::size_t OutputSize>
+  inline std::size_t extractNonce(const char *message, char (&output)[OutputSize]) {
+    return extractField(message, NonceKey, output, InputPosition);
+  }
+
+  /**
+   * @brief Extract fee cap hex value from the message: maxFeePerGas of EIP-1559 transaction, gasPrice otherwise.
+   * Input can be of any method.
+   * 
+   * @param message input message
+   * @param output output fee cap
+   * @return output fee cap length, 0 if message does not contain any
+   */
+  template<std::size_t OutputSize>
+  inline std::size_t extractFeeCap(const char *message, char (&output)[OutputSize]) {
+    std::size_t outputLength = extractField(message, MaxFeePerGasKey, output, InputPosition);
+    if(outputLength != 0) return outputLength;
+
+    return extractField(message, GasPriceKey, output, InputPosition);
+  }
+
+  /**
+   * @brief Check if message contains EIP-1559 transaction (it has maxPriorityFeePerGas instead of gasPrice).
+   * 
+   * @param message input message, has to hold complete liquidity add input (see isInputComplete)
+   * @return boolean value if message is EIP-1559 transaction
+   */
+  inline bool isDynamicFee(const char *message) {
+    return strstr(message + inputEndPosition(message), MaxPriorityFeePerGasKey) != nullptr;
+  }
 }
 
 /**
@@ -103,21 +486,139 @@ namespace BloXrouteMessageParser {
  */
 namespace BloXrouteMessageBuilder {
   /**
-   * @brief Builds subscribe message.
+   * @brief Transaction fields included in stream messages, input has to be the first one.
+   */
+  inline constexpr char Include[] = "[\"tx_contents.input\",\"tx_contents.gas_price\",\"tx_contents.value\",\"tx_contents.max_fee_per_gas\",\"tx_contents.max_priority_fee_per_gas\",\"tx_contents.from\",\"tx_contents.nonce\"]";
+
+  /**
+   * @brief Transaction fields included in stream messages along with signed transaction (see Bundle::RawTransactionKey).
+   */
+  inline constexpr char IncludeRawTransaction[] = "[\"tx_contents.input\",\"tx_contents.gas_price\",\"tx_contents.value\",\"tx_contents.max_fee_per_gas\",\"tx_contents.max_priority_fee_per_gas\",\"tx_contents.from\",\"tx_contents.nonce\",\"raw_tx\"]";
+
+  /**
+   * @brief Maximum length of subscribe message, fits 512 byte buffers.
+   */
+  inline constexpr std::size_t SubscribeCapacity = 511;
+
+  /**
+   * @brief Builds subscribe message at compile time, listening for addLiquidityETH and addLiquidity transactions sent to the router.
+   * 
+   * @param routerAddress router address
+   * @param minimumLiquidityETH minimum addLiquidityETH transaction value
+   * @param maximumGasPrice maximum transactino gas price
+   * @param removeLiquidity listen for removeLiquidityETH transactions too
+   * @param rawTransaction include signed transactions
+   * @return subscribe message
+   */
+  constexpr Utils::FixedString<SubscribeCapacity> subscribe(const char *routerAddress, const char *minimumLiquidityETH, const char *maximumGasPrice, bool removeLiquidity = false, bool rawTransaction = false) {
+    Utils::FixedString<SubscribeCapacity> output;
+
+    output.append("{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":");
+    output.append(rawTransaction ? IncludeRawTransaction : Include);
+    output.append(",\"filters\":\"to = 0x");
+    output.append(routerAddress);
+    output.append(" and ((method_id = ");
+    output.append(ABI::Selector::AddLiquidityETH);
+    output.append(" and value >= ");
+    output.append(minimumLiquidityETH);
+    output.append(") or method_id = ");
+    output.append(ABI::Selector::AddLiquidity);
+    if(removeLiquidity) {
+      output.append(" or method_id = ");
+      output.append(ABI::Selector::RemoveLiquidityETH);
+      output.append(" or method_id = ");
+      output.append(ABI::Selector::RemoveLiquidityETHSupportingFeeOnTransferTokens);
+    }
+    output.append(") and (gas_price <= ");
+    output.append(maximumGasPrice);
+    output.append(" or max_fee_per_gas <= ");
+    output.append(maximumGasPrice);
+    output.append(")\"}]}");
+
+    return output;
+  }
+
+  /**
+   * @brief Subscribe message built from Config at compile time.
+   */
+  inline constexpr auto ConfigSubscribe = subscribe(
+    Config::Router::Selected.Address,
+    Config::BloXroute::Filters::MinValue,
+    Config::BloXroute::Filters::MaxGasPrice,
+    Config::Exit::Enabled,
+    Config::Bundle::Enabled
+  );
+
+  /**
+   * @brief Builds subscribe message, listening for addLiquidityETH and addLiquidity transactions sent to the router.
    * 
-   * @param minimumLiquidityETH minimum transaction value
+   * @param routerAddress router address
+   * @param minimumLiquidityETH minimum addLiquidityETH transaction value
    * @param maximumGasPrice maximum transactino gas price
+   * @param output output message, at least SubscribeCapacity + 1 long
+   * @param removeLiquidity listen for removeLiquidityETH transactions too
+   * @param rawTransaction include signed transactions
+   * @return output message length
+   */
+  inline std::size_t buildSubscribe(const char *routerAddress, const char *minimumLiquidityETH, const char *maximumGasPrice, char *output, bool removeLiquidity = false, bool rawTransaction = false) {
+    Utils::FixedString<SubscribeCapacity> message = subscribe(routerAddress, minimumLiquidityETH, maximumGasPrice, removeLiquidity, rawTransaction);
+    memcpy(output, message.value, message.length + 1);
+
+    return message.length;
+  }
+
+  /**
+   * @brief Parts of subscribe message listening for transactions of given sender, around the sender address.
+   */
+  inline constexpr auto SubscribeFromPrefix = Utils::FixedString<255>()
+    .append("{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":")
+    .append(Include)
+    .append(",\"filters\":\"from = 0x");
+  inline constexpr char SubscribeFromSuffix[] = "\"}]}";
+
+  /**
+   * @brief Builds subscribe message, listening for all transactions sent from given address.
+   * 
+   * @param fromAddress sender address
    * @param output output message
    * @return output message length
    */
-  inline std::size_t buildSubscribe(const char *minimumLiquidityETH, const char *maximumGasPrice, char *output) {
-    strcpy(output, "{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":[\"tx_contents.input\",\"tx_contents.gas_price\"],\"filters\":\"method_id = f305d719 and to = 0x7a250d5630B4cF539739dF2C5dAcb4c659F2488D and value >= ");
-    strcat(output, minimumLiquidityETH);
-    strcat(output, " and gas_price <= ");
-    strcat(output, maximumGasPrice);
-    strcat(output, "\"}]}");
+  inline std::size_t buildSubscribeFrom(const char *fromAddress, char *output) {
+    std::size_t fromAddressLength = strlen(fromAddress);
 
-    return strlen(output);
+    memcpy(output, SubscribeFromPrefix.value, SubscribeFromPrefix.length);
+    memcpy(output + SubscribeFromPrefix.length, fromAddress, fromAddressLength);
+    memcpy(output + SubscribeFromPrefix.length + fromAddressLength, SubscribeFromSuffix, sizeof(SubscribeFromSuffix));
+
+    return SubscribeFromPrefix.length + fromAddressLength + sizeof(SubscribeFromSuffix) - 1;
+  }
+
+  /**
+   * @brief Part of transaction message preceding signed transaction hex value.
+   */
+  inline constexpr char TransactionPrefix[] = "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"";
+
+  /**
+   * @brief Part of transaction message following signed transaction hex value.
+   */
+  inline constexpr char TransactionSuffix[] = "\"}}";
+
+  /**
+   * @brief Builds transaction message.
+   * 
+   * @param rawTransaction signed transaction to send (hex)
+   * @param rawTransactionLength signed transaction length
+   * @param output output message
+   * @return output message length
+   */
+  inline std::size_t buildTransaction(const char *rawTransaction, std::size_t rawTransactionLength, char *output) {
+    constexpr std::size_t PrefixLength = sizeof(TransactionPrefix) - 1;
+
+    memcpy(output, TransactionPrefix, PrefixLength);
+    memcpy(output + PrefixLength, rawTransaction, rawTransactionLength);
+    memcpy(output + PrefixLength + rawTransactionLength, TransactionSuffix, sizeof(TransactionSuffix));
+
+    return PrefixLength + rawTransactionLength + sizeof(TransactionSuffix) - 1;
   }
 
   /**
@@ -128,10 +629,50 @@ namespace BloXrouteMessageBuilder {
    * @return output message length
    */
   inline std::size_t buildTransaction(const char *rawTransaction, char *output) {
-    strcpy(output, "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"");
-    strcat(output, rawTransaction);
-    strcat(output, "\"}}");
+    return buildTransaction(rawTransaction, strlen(rawTransaction), output);
+  }
+
+  /**
+   * @brief Builds transaction message, signed transaction is hex encoded right into it.
+   * 
+   * @param transaction signed transaction buffer
+   * @param transactionLength signed transaction buffer length
+   * @param output output message
+   * @return output message length
+   */
+  inline std::size_t buildTransaction(Utils::Buffer transaction, std::size_t transactionLength, char *output) {
+    constexpr std::size_t PrefixLength = sizeof(TransactionPrefix) - 1;
 
-    return strlen(output);
+    memcpy(output, TransactionPrefix, PrefixLength);
+    std::size_t transactionStringLength = Utils::bufferToHexString(transaction, transactionLength, output + PrefixLength);
+    memcpy(output + PrefixLength + transactionStringLength, TransactionSuffix, sizeof(TransactionSuffix));
+
+    return PrefixLength + transactionStringLength + sizeof(TransactionSuffix) - 1;
+  }
+
+  /**
+   * @brief Offset of signed transaction hex value in transaction message.
+   */
+  inline constexpr std::size_t TransactionOffset = sizeof(TransactionPrefix) - 1;
+
+  /**
+   * @brief Writes transaction message prefix to the buffer once, so signed transactions can be encoded right after it.
+   * 
+   * @param output output message buffer, at least Config::Size::BloXrouteTransactionMessageString long
+   */
+  inline void prepareTransaction(char *output) {
+    memcpy(output, TransactionPrefix, TransactionOffset);
+  }
+
+  /**
+   * @brief Completes transaction message of prepared buffer with signed transaction hex value already at TransactionOffset.
+   * 
+   * @param output prepared message buffer
+   * @param transactionStringLength signed transaction hex value length
+   * @return output message length
+   */
+  inline std::size_t sealTransaction(char *output, std::size_t transactionStringLength) {
+    memcpy(output + TransactionOffset + transactionStringLength, TransactionSuffix, sizeof(TransactionSuffix));
+    return TransactionOffset + transactionStringLength + sizeof(TransactionSuffix) - 1;
   }
 }
\ No newline at end of file
@@ -0,0 +1,554 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "bot.hpp"
+#include "ktls.hpp"
+
+/**
+ * @brief Backrun bundles [target liquidity add, our buy] submitted to a relay with eth_sendBundle, so the buy lands
+ * right behind the target instead of racing it on gas price.
+ *
+ * Request headers and JSON-RPC envelope are built once, per match the raw transactions are copied in and Content-Length
+ * is written in front of the body, nothing is formatted nor allocated. Requests go over a persistent HTTP/1.1 connection,
+ * over https:// sends are encrypted by the kernel (see KernelTLS).
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#backrun-bundles
+ */
+namespace Bundle {
+  /**
+   * @brief Key of the signed target transaction in stream messages (BloXroute "raw_tx" include), including "0x".
+   */
+  inline constexpr char RawTransactionKey[] = "\"rawTx\":\"0x";
+
+  /**
+   * @brief Parts of eth_sendBundle request body around the target and our transaction hex values.
+   */
+  inline constexpr char BodyPrefix[] = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"eth_sendBundle\",\"params\":[{\"txs\":[\"0x";
+  inline constexpr char TransactionSeparator[] = "\",\"0x";
+
+  /**
+   * @brief Maximum length of request headers (and of the body suffix).
+   */
+  inline constexpr std::size_t MaxHeadersLength = 768;
+  inline constexpr std::size_t MaxSuffixLength = 64;
+
+  /**
+   * @brief Size of the buffer responses are received into, longer responses close the connection.
+   */
+  inline constexpr std::size_t ResponseBufferSize = 4096;
+
+  /**
+   * @brief Finds signed target transaction in stream message.
+   *
+   * @param message input message, validated transaction
+   * @param length output transaction hex value length
+   * @return transaction hex value (without "0x"), nullptr if the message has none
+   */
+  inline const char *extractRawTransaction(const char *message, std::size_t &length) {
+    const char *key = strstr(message + BloXrouteMessageParser::InputPosition, RawTransactionKey);
+    if(key == nullptr) return nullptr;
+
+    const char *value = key + sizeof(RawTransactionKey) - 1;
+    length = strcspn(value, "\"");
+    if(value[length] != '"' || length == 0 || length % 2 != 0) return nullptr;
+
+    return value;
+  }
+
+  /**
+   * @brief Relay address parsed from URL.
+   */
+  struct Url {
+    char host[256];
+    char port[6];
+    char path[256];
+    bool secure;
+  };
+
+  /**
+   * @brief Parses http://host[:port][/path] or https://host[:port][/path] URL.
+   *
+   * @param url input null-terminated URL
+   * @param output output address
+   * @return false if the URL is malformed or its parts are too long
+   */
+  inline bool parseUrl(const char *url, Url &output) {
+    if(strncmp(url, "http://", 7) == 0) {
+      output.secure = false;
+      url += 7;
+    } else if(strncmp(url, "https://", 8) == 0) {
+      output.secure = true;
+      url += 8;
+    } else {
+      return false;
+    }
+
+    std::size_t hostLength = strcspn(url, ":/");
+    if(hostLength == 0 || hostLength >= sizeof(output.host)) return false;
+    memcpy(output.host, url, hostLength);
+    output.host[hostLength] = '\0';
+    url += hostLength;
+
+    if(*url == ':') {
+      std::size_t portLength = strcspn(++url, "/");
+      if(portLength == 0 || portLength >= sizeof(output.port)) return false;
+      memcpy(output.port, url, portLength);
+      output.port[portLength] = '\0';
+      url += portLength;
+    } else {
+      strcpy(output.port, output.secure ? "443" : "80");
+    }
+
+    if(*url == '\0') url = "/";
+    if(strlen(url) >= sizeof(output.path)) return false;
+    strcpy(output.path, url);
+
+    return true;
+  }
+
+  /**
+   * @brief Composes eth_sendBundle requests in a single buffer.
+   *
+   * Body prefix is written once at fixed offset, so the transactions are copied right after it. Content-Length digits
+   * and the prebuilt headers are written backwards in front of the body, the request starts wherever they end.
+   *
+   * @tparam Capacity maximum body length
+   */
+  template<std::size_t Capacity>
+  class Composer {
+    static_assert(Capacity < 1000000000, "Content-Length has to fit its digits");
+
+    static constexpr std::size_t MaxDigits = 9;
+    static constexpr std::size_t BodyOffset = MaxHeadersLength + MaxDigits + 4;
+    static constexpr std::size_t BodyPrefixLength = sizeof(BodyPrefix) - 1;
+
+    char headers[MaxHeadersLength];
+    std::size_t headersLength = 0;
+    char suffix[MaxSuffixLength];
+    std::size_t suffixLength = 0;
+
+    alignas(64) char buffer[BodyOffset + Capacity];
+
+    public:
+
+    /**
+     * @brief Builds headers and body envelope for the relay.
+     *
+     * @param url relay address
+     * @return false if headers do not fit
+     */
+    bool init(const Url &url) {
+      int length = snprintf(
+        headers, sizeof(headers),
+        "POST %s HTTP/1.1\r\nHost: %s\r\nContent-Type: application/json\r\nConnection: keep-alive\r\nContent-Length: ",
+        url.path, url.host
+      );
+      if(length < 0 || static_cast<std::size_t>(length) >= sizeof(headers)) return false;
+
+      headersLength = length;
+      memcpy(buffer + BodyOffset, BodyPrefix, BodyPrefixLength);
+      setBlockNumber(0);
+      return true;
+    }
+
+    /**
+     * @brief Sets block the bundles target, off the hot path.
+     *
+     * @param blockNumber block number, 0 omits it (relays target the next block)
+     */
+    void setBlockNumber(std::uint64_t blockNumber) {
+      int length = blockNumber != 0
+        ? snprintf(suffix, sizeof(suffix), "\"],\"blockNumber\":\"0x%llx\"}]}", static_cast<unsigned long long>(blockNumber))
+        : snprintf(suffix, sizeof(suffix), "\"]}]}");
+      suffixLength = length;
+    }
+
+    /**
+     * @brief Composes request bundling our transaction right behind the target.
+     *
+     * @param target input signed target transaction hex value (without "0x")
+     * @param targetLength input target transaction length
+     * @param transaction input our signed transaction hex value (without "0x")
+     * @param transactionLength input our transaction length
+     * @param length output request length
+     * @return request, valid until the next call; nullptr if the body exceeds Capacity
+     */
+    const char *compose(const char *target, std::size_t targetLength, const char *transaction, std::size_t transactionLength, std::size_t &length) {
+      constexpr std::size_t SeparatorLength = sizeof(TransactionSeparator) - 1;
+
+      std::size_t bodyLength = BodyPrefixLength + targetLength + SeparatorLength + transactionLength + suffixLength;
+      if(bodyLength > Capacity) return nullptr;
+
+      char *body = buffer + BodyOffset;
+      char *position = body + BodyPrefixLength;
+      memcpy(position, target, targetLength);
+      position += targetLength;
+      memcpy(position, TransactionSeparator, SeparatorLength);
+      position += SeparatorLength;
+      memcpy(position, transaction, transactionLength);
+      position += transactionLength;
+      memcpy(position, suffix, suffixLength);
+
+      char *start = body - 4;
+      memcpy(start, "\r\n\r\n", 4);
+      std::size_t digits = bodyLength;
+      do {
+        *--start = static_cast<char>('0' + digits % 10);
+        digits /= 10;
+      } while(digits != 0);
+      start -= headersLength;
+      memcpy(start, headers, headersLength);
+
+      length = body + bodyLength - start;
+      return start;
+    }
+  };
+
+  /**
+   * @brief HTTP response parsed in place.
+   */
+  struct Response {
+    int status = 0;
+    const char *body = nullptr;
+    std::size_t bodyLength = 0;
+    bool close = false;
+  };
+
+  /**
+   * @brief Marks malformed response, the connection cannot be read any further.
+   */
+  inline constexpr std::size_t Malformed = SIZE_MAX;
+
+  /**
+   * @brief Parses hex chunk size line of chunked body.
+   *
+   * @return length of the line including CRLF, 0 if incomplete, Malformed if malformed
+   */
+  inline std::size_t parseChunkSize(const char *input, std::size_t length, std::size_t &size) {
+    size = 0;
+    std::size_t position = 0;
+    while(position < length && isxdigit(static_cast<unsigned char>(input[position]))) {
+      if(size >> 56 != 0) return Malformed;
+      char c = input[position++];
+      size = size * 16 + (c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+    }
+    if(position == 0 && length != 0) return Malformed;
+
+    // Chunk extensions are skipped
+    const char *end = static_cast<const char*>(memmem(input + position, length - position, "\r\n", 2));
+    return end != nullptr ? end + 2 - input : 0;
+  }
+
+  /**
+   * @brief Parses the first HTTP/1.1 response in the input, its body is delimited by Content-Length or chunked encoding.
+   * Body of chunked response points to its first chunk.
+   *
+   * @param input input received bytes
+   * @param length input length
+   * @param output output response
+   * @return length of the response, 0 if it is not complete yet, Malformed if it cannot be parsed
+   */
+  inline std::size_t parseResponse(const char *input, std::size_t length, Response &output) {
+    const char *headersEnd = static_cast<const char*>(memmem(input, length, "\r\n\r\n", 4));
+    if(headersEnd == nullptr) return length >= ResponseBufferSize ? Malformed : 0;
+
+    if(length < 12 || strncmp(input, "HTTP/1.", 7) != 0 || input[8] != ' ') return Malformed;
+    output = Response();
+    for(std::size_t i = 9; i < 12; i++) {
+      if(input[i] < '0' || input[i] > '9') return Malformed;
+      output.status = output.status * 10 + input[i] - '0';
+    }
+
+    // Headers, line by line
+    std::size_t contentLength = 0;
+    bool chunked = false;
+    const char *line = static_cast<const char*>(memmem(input, headersEnd + 2 - input, "\r\n", 2)) + 2;
+    while(line < headersEnd + 2) {
+      const char *lineEnd = static_cast<const char*>(memmem(line, headersEnd + 2 - line, "\r\n", 2));
+      std::size_t lineLength = lineEnd - line;
+
+      if(lineLength > 15 && strncasecmp(line, "Content-Length:", 15) == 0) {
+        const char *digit = line + 15;
+        while(*digit == ' ') digit++;
+        if(digit == lineEnd) return Malformed;
+        for(; digit < lineEnd; digit++) {
+          if(*digit < '0' || *digit > '9' || contentLength > ResponseBufferSize) return Malformed;
+          contentLength = contentLength * 10 + *digit - '0';
+        }
+      } else if(lineLength > 18 && strncasecmp(line, "Transfer-Encoding:", 18) == 0) {
+        chunked = memmem(line + 18, lineLength - 18, "chunked", 7) != nullptr;
+      } else if(lineLength > 11 && strncasecmp(line, "Connection:", 11) == 0) {
+        output.close = memmem(line + 11, lineLength - 11, "close", 5) != nullptr;
+      }
+
+      line = lineEnd + 2;
+    }
+
+    const char *body = headersEnd + 4;
+    std::size_t available = input + length - body;
+
+    if(!chunked) {
+      if(available < contentLength) return 0;
+      output.body = body;
+      output.bodyLength = contentLength;
+      return body + contentLength - input;
+    }
+
+    // Chunks, up to the last (empty) one and the empty trailer
+    std::size_t position = 0;
+    while(true) {
+      std::size_t size;
+      std::size_t lineLength = parseChunkSize(body + position, available - position, size);
+      if(lineLength == 0 || lineLength == Malformed) return lineLength;
+      position += lineLength;
+
+      if(size == 0) {
+        if(available - position < 2) return 0;
+        if(memcmp(body + position, "\r\n", 2) != 0) return Malformed;
+        return body + position + 2 - input;
+      }
+
+      if(available - position < size + 2) return 0;
+      if(output.body == nullptr) {
+        output.body = body + position;
+        output.bodyLength = size;
+      }
+      position += size + 2;
+    }
+  }
+
+  /**
+   * @brief Persistent HTTP/1.1 connection to the relay. Requests are written with blocking sends,
+   * responses are read without blocking by poll(), which also reconnects when the relay closed the connection.
+   */
+  class Relay {
+    Url url {};
+    KernelTLS::Session session;
+    int fd = -1;
+
+    std::size_t filled = 0;
+    std::size_t pending = 0;
+    Response last;
+    char lastBody[256] = "";
+
+    char receiveBuffer[ResponseBufferSize];
+    char recordsBuffer[ResponseBufferSize];
+
+    /**
+     * @brief Connects to the relay, makes TLS handshake over https://.
+     */
+    bool open() {
+      close();
+
+      addrinfo hints {}, *addresses = nullptr;
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+      if(getaddrinfo(url.host, url.port, &hints, &addresses) != 0) return false;
+
+      for(addrinfo *candidate = addresses; candidate != nullptr; candidate = candidate->ai_next) {
+        fd = socket(candidate->ai_family, candidate->ai_socktype | SOCK_CLOEXEC, candidate->ai_protocol);
+        if(fd == -1) continue;
+        if(::connect(fd, candidate->ai_addr, candidate->ai_addrlen) == 0) break;
+
+        ::close(fd);
+        fd = -1;
+      }
+      freeaddrinfo(addresses);
+      if(fd == -1) return false;
+
+      signal(SIGPIPE, SIG_IGN);
+
+      int noDelay = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+      // Requests are plain writes either way, encrypted by the kernel over https://
+      if(url.secure && session.connect(fd, url.host) != KernelTLS::Status::Offloaded) {
+        close();
+        return false;
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Writes the whole request.
+     */
+    bool write(const char *request, std::size_t length) {
+      for(std::size_t written = 0; written < length;) {
+        ssize_t count = ::send(fd, request + written, length - written, MSG_NOSIGNAL);
+        if(count <= 0) return false;
+        written += count;
+      }
+      return true;
+    }
+
+    /**
+     * @brief Receives what is available without blocking, decrypted over https://.
+     *
+     * @return received length, 0 if nothing is available, -1 if the connection is closed or broken
+     */
+    ssize_t receive(char *output, std::size_t size) {
+      if(session.isOpen() && session.hasPending()) {
+        std::size_t decrypted;
+        return session.decrypt(nullptr, 0, output, size, decrypted) ? static_cast<ssize_t>(decrypted) : -1;
+      }
+
+      char *target = session.isOpen() ? recordsBuffer : output;
+      ssize_t count = recv(fd, target, session.isOpen() ? sizeof(recordsBuffer) : size, MSG_DONTWAIT);
+      if(count == 0) return -1;
+      if(count < 0) return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+      if(!session.isOpen()) return count;
+
+      std::size_t decrypted;
+      return session.decrypt(recordsBuffer, count, output, size, decrypted) ? static_cast<ssize_t>(decrypted) : -1;
+    }
+
+    public:
+
+    Relay() = default;
+    Relay(const Relay&) = delete;
+    Relay &operator=(const Relay&) = delete;
+
+    ~Relay() {
+      close();
+    }
+
+    /**
+     * @brief Connects to the relay.
+     *
+     * @param relayUrl relay URL, http:// or https:// (with kernel TLS only)
+     * @return false if the URL is malformed or the relay is not reachable (poll retries the connection)
+     */
+    bool connect(const char *relayUrl) {
+      if(!parseUrl(relayUrl, url)) return false;
+      return open();
+    }
+
+    /**
+     * @brief Closes the connection, responses to pending requests are not read.
+     */
+    void close() {
+      session.close();
+      if(fd != -1) ::close(fd);
+      fd = -1;
+      filled = 0;
+      pending = 0;
+    }
+
+    bool isConnected() const {
+      return fd != -1;
+    }
+
+    const Url &getUrl() const {
+      return url;
+    }
+
+    /**
+     * @brief Sends request, never connects: a dropped connection is reopened by poll(), off the send path.
+     *
+     * @param request input request
+     * @param length input request length
+     * @return false if there is no connection or the request could not be sent (connection is closed then)
+     */
+    bool send(const char *request, std::size_t length) {
+      if(fd == -1) return false;
+      if(!write(request, length)) {
+        close();
+        return false;
+      }
+
+      pending++;
+      return true;
+    }
+
+    /**
+     * @brief Reads available responses without blocking, reconnects if the relay closed the connection or there is none.
+     *
+     * @return number of responses read (see getLastStatus and getLastBody)
+     */
+    std::size_t poll() {
+      if(fd == -1) {
+        open();
+        return 0;
+      }
+
+      std::size_t responses = 0;
+      bool reconnect = false;
+
+      while(true) {
+        ssize_t count = receive(receiveBuffer + filled, sizeof(receiveBuffer) - filled);
+        if(count < 0) reconnect = true;
+        if(count > 0) filled += count;
+
+        std::size_t position = 0;
+        while(position < filled) {
+          Response response;
+          std::size_t responseLength = parseResponse(receiveBuffer + position, filled - position, response);
+          if(responseLength == 0) break;
+          if(responseLength == Malformed) {
+            reconnect = true;
+            position = filled;
+            break;
+          }
+
+          last = response;
+          std::size_t bodyLength = std::min(response.bodyLength, sizeof(lastBody) - 1);
+          memcpy(lastBody, response.body, bodyLength);
+          lastBody[bodyLength] = '\0';
+          last.body = lastBody;
+
+          if(pending != 0) pending--;
+          responses++;
+          position += responseLength;
+          if(response.close) reconnect = true;
+        }
+
+        memmove(receiveBuffer, receiveBuffer + position, filled - position);
+        filled -= position;
+
+        if(count <= 0 || reconnect) break;
+      }
+
+      // Relay closed the connection (idle keep-alive timeout), next request should not pay for the handshake
+      if(reconnect && !open()) close();
+      return responses;
+    }
+
+    /**
+     * @brief Returns number of requests sent and not answered yet.
+     */
+    std::size_t getPending() const {
+      return pending;
+    }
+
+    /**
+     * @brief Returns status of the last response.
+     */
+    int getLastStatus() const {
+      return last.status;
+    }
+
+    /**
+     * @brief Returns body of the last response, cut to 255 chars.
+     */
+    const char *getLastBody() const {
+      return lastBody;
+    }
+  };
+}
\ No newline at end of file
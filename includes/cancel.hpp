@@ -0,0 +1,261 @@
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "config.hpp"
+#include "utils.hpp"
+#include "transaction.hpp"
+#include "pregen.hpp"
+#include "bot.hpp"
+
+/**
+ * @brief Pregenerated cancels of the buy and watcher of the target transaction firing them.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#cancel
+ */
+namespace Cancel {
+  /**
+   * @brief Calculates minimum gas price of transaction replacing the one with given gas price (rounded up).
+   *
+   * @param gasPrice gas price (or maxFeePerGas) of replaced transaction (wei)
+   * @param bumpPercent minimum bump (percents)
+   * @return replacement gas price (wei)
+   */
+  inline constexpr std::uint64_t replacementGasPrice(std::uint64_t gasPrice, std::uint64_t bumpPercent = Config::Cancel::ReplacementBumpPercent) {
+    return gasPrice + (gasPrice * bumpPercent + 99) / 100;
+  }
+
+  /**
+   * @brief Parses hex quantity of at most 16 chars.
+   *
+   * @param hex hex c-string (without 0x prefix)
+   * @param hexLength hex c-string length
+   * @param output output value
+   * @return false if the value does not fit
+   */
+  inline bool parseQuantity(const char *hex, std::size_t hexLength, std::uint64_t &output) {
+    if(hexLength == 0 || hexLength > 16) return false;
+
+    output = 0;
+    return std::from_chars(hex, hex + hexLength, output, 16).ec == std::errc();
+  }
+
+  /**
+   * @brief Cancels of a wallet: zero value self-transfers with the buy nonce.
+   *
+   * Cancels are pregenerated at startup, the one sent is picked by the gas price of the buy.
+   * Legacy cancel with gas price bumped over the buy maxFeePerGas replaces EIP-1559 buy too,
+   * as both its fee cap and priority fee are then bumped.
+   *
+   * @tparam Capacity maximum number of gas prices
+   * @tparam MessageSize maximum size of single message
+   */
+  template<std::size_t Capacity, std::size_t MessageSize>
+  class Table {
+    std::uint64_t nonce = 0;
+    const char *address = "";
+
+    std::atomic<std::uint64_t> buyGasPrice { 0 };
+
+    public:
+
+    PreGen::Store<Capacity, MessageSize> txs;
+
+    /**
+     * @brief Sets nonce and address of the wallet.
+     *
+     * @param buyNonce nonce the buy is going to be sent with
+     * @param walletAddress wallet address, has to outlive the table
+     */
+    void init(std::uint64_t buyNonce, const char *walletAddress) {
+      nonce = buyNonce;
+      address = walletAddress;
+    }
+
+    /**
+     * @brief Sets all cancel transaction fields but gas price.
+     *
+     * @param tx output transaction
+     */
+    void setFields(Transaction &tx) const {
+      Utils::Byte nonceBuffer[8];
+      std::size_t nonceBufferSize = Utils::intToBuffer(nonce, nonceBuffer);
+
+      tx.setField(Transaction::Field::Nonce, nonceBuffer, nonceBufferSize);
+      tx.setField(Transaction::Field::GasLimit, Config::Cancel::GasLimit);
+      tx.setField(Transaction::Field::To, address);
+      tx.setField(Transaction::Field::Value, "0");
+      tx.setField(Transaction::Field::Data, "");
+    }
+
+    /**
+     * @brief Pregenerates cancels for given gas prices, signing on multiple threads.
+     *
+     * @param gasPrices gas prices to pregenerate (wei)
+     * @param privateKey private key buffer to sign with
+     * @param threadsCount number of signing threads, 0 means all available cores
+     * @return number of pregenerated messages
+     */
+    std::size_t generate(const std::vector<std::uint64_t> &gasPrices, Utils::Buffer privateKey, std::size_t threadsCount = 0) {
+      return PreGen::generateParallel(txs, gasPrices, privateKey, [this](Transaction &tx) { setFields(tx); }, threadsCount);
+    }
+
+    /**
+     * @brief Records the buy was sent.
+     *
+     * @param gasPrice gas price (or maxFeePerGas) of the buy (wei)
+     */
+    void bought(std::uint64_t gasPrice) {
+      buyGasPrice.store(gasPrice, std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns gas price of the buy, 0 if the buy was not sent.
+     */
+    std::uint64_t getBuyGasPrice() const {
+      return buyGasPrice.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns cancel message replacing the buy: pregenerated one with the nearest gas price
+     * at or above the replacement gas price, or signed on demand.
+     *
+     * @param maxBump maximum accepted gas price overpay (wei)
+     * @param tx transaction used to sign on demand
+     * @param privateKey private key buffer to sign with
+     * @param buffer buffer for message signed on demand
+     * @param length output message length
+     * @param gasPrice output gas price of the cancel (wei)
+     * @return message
+     */
+    const char *message(std::uint64_t maxBump, Transaction &tx, Utils::Buffer privateKey, char *buffer, std::size_t &length, std::uint64_t &gasPrice) const {
+      std::uint64_t minimumGasPrice = replacementGasPrice(getBuyGasPrice());
+
+      const auto *entry = txs.lookup(minimumGasPrice, Config::TransactionPreGen::MissPolicy::NearestAbove, maxBump);
+      if(entry != nullptr) {
+        length = entry->length;
+        gasPrice = entry->gasPrice;
+        return entry->message;
+      }
+
+      setFields(tx);
+      length = PreGen::generate(tx, privateKey, minimumGasPrice, buffer);
+      gasPrice = minimumGasPrice;
+      return buffer;
+    }
+  };
+
+  /**
+   * @brief Watches the stream for replacement of the target transaction (same sender and nonce, higher fee cap).
+   *
+   * Target fields are written and read by the event loop only, deadline is checked by other threads before closing the connection.
+   */
+  class Watcher {
+    char from[41] = {};
+    std::uint64_t nonce = 0;
+    std::uint64_t feeCap = 0;
+    std::atomic<std::uint64_t> deadline { 0 };
+
+    public:
+
+    /**
+     * @brief Starts watching the target transaction.
+     *
+     * @param message target transaction message
+     * @param until watching deadline (ns, steady clock)
+     * @return false if the message lacks sender, nonce or fee cap
+     */
+    bool watch(const char *message, std::uint64_t until) {
+      char field[Config::Size::TransactionQuantityBuffer * 2 + 1];
+      std::size_t fieldLength;
+
+      if(BloXrouteMessageParser::extractFrom(message, field) != 40) return false;
+      memcpy(from, field, 41);
+
+      fieldLength = BloXrouteMessageParser::extractNonce(message, field);
+      if(!parseQuantity(field, fieldLength, nonce)) return false;
+
+      fieldLength = BloXrouteMessageParser::extractFeeCap(message, field);
+      if(!parseQuantity(field, fieldLength, feeCap)) return false;
+
+      deadline.store(until);
+      return true;
+    }
+
+    /**
+     * @brief Stops watching.
+     */
+    void stop() {
+      deadline.store(0);
+    }
+
+    /**
+     * @brief Checks if the target transaction is being watched.
+     *
+     * @param now current time (ns, steady clock)
+     */
+    bool isWatching(std::uint64_t now) const {
+      return now < deadline.load();
+    }
+
+    /**
+     * @brief Returns sender of the target transaction (without 0x prefix).
+     */
+    const char *getFrom() const {
+      return from;
+    }
+
+    /**
+     * @brief Checks if message replaces the target transaction.
+     *
+     * @param message input message
+     * @return boolean value if message has the sender and nonce of the target transaction and higher fee cap
+     */
+    bool isReplacement(const char *message) const {
+      if(!BloXrouteMessageParser::isTransaction(message)) return false;
+
+      char field[Config::Size::TransactionQuantityBuffer * 2 + 1];
+      std::size_t fieldLength;
+      std::uint64_t value;
+
+      if(BloXrouteMessageParser::extractFrom(message, field) != 40 || memcmp(field, from, 40) != 0) return false;
+
+      fieldLength = BloXrouteMessageParser::extractNonce(message, field);
+      if(!parseQuantity(field, fieldLength, value) || value != nonce) return false;
+
+      fieldLength = BloXrouteMessageParser::extractFeeCap(message, field);
+      return parseQuantity(field, fieldLength, value) && value > feeCap;
+    }
+
+    /**
+     * @brief Checks if message is a transaction of the target sender while watching, input can be of any method.
+     *
+     * @param message input message
+     * @param now current time (ns, steady clock)
+     * @return boolean value if message is sent by the sender of the watched target transaction
+     */
+    bool isFromSender(const char *message, std::uint64_t now) const {
+      if(!isWatching(now) || !BloXrouteMessageParser::isTransaction(message)) return false;
+
+      char field[Config::Size::TransactionQuantityBuffer * 2 + 1];
+      return BloXrouteMessageParser::extractFrom(message, field) == 40 && memcmp(field, from, 40) == 0;
+    }
+
+    /**
+     * @brief Checks if message cancels the target transaction: replaces it and no longer adds liquidity of the target token.
+     * Fee bumps of the liquidity add itself are ignored.
+     *
+     * @param message input message
+     * @param now current time (ns, steady clock)
+     * @param targetTokenAddress target token address
+     * @return boolean value if the target transaction is cancelled
+     */
+    bool isCancelled(const char *message, std::uint64_t now, const char *targetTokenAddress) const {
+      return isWatching(now) && isReplacement(message) && !BloXrouteMessageParser::validateTransaction(message, targetTokenAddress);
+    }
+  };
+}
\ No newline at end of file
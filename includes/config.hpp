@@ -3,6 +3,30 @@
 #include <cstdint>
 
 namespace Config {
+  namespace Router {
+    /**
+     * @brief Uniswap V2 style router fork.
+     */
+    struct Definition {
+      const char *Address;
+      const char *WrappedNative; // path[0] of swaps and pair token of addLiquidity, lowercase
+      const char *Factory; // pair factory, createPair is sent to it
+    };
+
+    inline constexpr Definition UniswapV2 { "7a250d5630B4cF539739dF2C5dAcb4c659F2488D", "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2", "5C69bEe701ef814a2B6a3EDD4B1652CB9cc5aA6f" };
+    inline constexpr Definition SushiSwap { "d9e1cE17f2641f24aE83637ab66a2cca9C378B9F", "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2", "C0AEe478e3658e2610c5F7A4A2E1777cE9e4f2Ac" };
+
+    /**
+     * @brief PancakeSwap V2 router on BNB Smart Chain (requires Config::Transaction::ChainId "38").
+     */
+    inline constexpr Definition PancakeSwapV2 { "10ED43C718714eb63d5aA57B78B54704E256024E", "bb4cdb9cbd36b01bd1cbaebf2de08d9173bc095c", "cA143Ce32Fe78f1f7019d7d551a6402fC5350c73" };
+
+    /**
+     * @brief Router liquidity adds are listened for on and swaps are sent to.
+     */
+    inline constexpr Definition Selected = UniswapV2;
+  }
+
   namespace Transaction {
     /**
      * @brief Transaction nonce.
@@ -15,9 +39,10 @@ namespace Config {
     inline constexpr char Value[] = "0de0b6b3a7640000";
 
     /**
-     * @brief Receiver of the transaction (Uniswap V2 Router 02).
+     * @brief Receiver of the transaction, alias to Config::Router::Selected.Address.
+     * @see Config::Router::Selected
      */
-    inline constexpr char To[] = "7a250d5630B4cF539739dF2C5dAcb4c659F2488D";
+    inline constexpr const char *To = Config::Router::Selected.Address;
 
     /**
      * @brief Gas limit of transaction (200000 units is enough for most swapExactETHForTokens calls).
@@ -29,6 +54,11 @@ namespace Config {
      */
     inline constexpr char PrivateKey[] = "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318";
 
+    /**
+     * @brief Chain ID (Ethereum Mainnet).
+     */
+    inline constexpr char ChainId[] = "1";
+
     namespace SwapExactETHForTokens {
       /**
        * @brief Minimum amount of tokens to receive from the swap.
@@ -44,9 +74,53 @@ namespace Config {
        * @brief Address of receiving wallet.
        */
       inline constexpr char ReceiverAddress[] = "f82d59152f33E6F65Aa4aE1a3B38eD2Ca1B7633b";
+
+      /**
+       * @brief Derive amountOutMin from observed liquidity add instead of using static AmountOutMin.
+       * Transactions are then signed on demand, as pregenerated ones hold static AmountOutMin.
+       */
+      inline constexpr bool DynamicAmountOutMin = false;
+
+      /**
+       * @brief Accepted slippage from expected swap output in basis points (eg. 1000 means 10%), used with DynamicAmountOutMin and for exit tiers.
+       */
+      inline constexpr uint64_t SlippageBasisPoints = 1000;
+
+      /**
+       * @brief Call swapExactETHForTokensSupportingFeeOnTransferTokens instead, required by tokens taking fee on transfer.
+       */
+      inline constexpr bool SupportingFeeOnTransferTokens = false;
     }
   }
 
+  namespace Wallets {
+    /**
+     * @brief Sending wallet configuration.
+     */
+    struct Wallet {
+      const char *PrivateKey;
+      const char *Nonce;
+      const char *Value;
+    };
+
+    /**
+     * @brief Sending wallets, each has its own nonce, signing context and pregenerated transactions.
+     * Wallets can send different amounts (value, hexadecimal wei).
+     */
+    inline constexpr Wallet List[] = {
+      { Config::Transaction::PrivateKey, Config::Transaction::Nonce, Config::Transaction::Value },
+    };
+
+    inline constexpr std::size_t Count = sizeof(List) / sizeof(*List);
+
+    /**
+     * @brief Number of wallets sending transaction on a single match.
+     */
+    inline constexpr std::size_t SendCount = Count;
+
+    static_assert(SendCount >= 1 && SendCount <= Count, "SendCount must be between 1 and number of wallets");
+  }
+
   namespace BloXroute {
     namespace Connection {
       /**
@@ -58,6 +132,12 @@ namespace Config {
        * @brief BloXroute Cloud API auth token.
        */
       inline constexpr char AuthToken[] = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+
+      /**
+       * @brief Cloud API addresses the connection moves between when its round trip degrades, the first one is connected to first.
+       * @see Config::Feed::WebSocket::Heartbeat::Reconnect
+       */
+      inline constexpr const char *Addresses[] = { Address };
     }
 
     namespace Filters {
@@ -67,7 +147,8 @@ namespace Config {
       inline constexpr char MaxGasPrice[] = "1000000000000";
 
       /**
-       * @brief Listen for transactions above specified min value (avoid tokens with small added liquidity).
+       * @brief Listen for addLiquidityETH transactions above specified min value (avoid tokens with small added liquidity).
+       * Token/wrapped native addLiquidity transactions do not carry value and are not filtered by it.
        */
       inline constexpr char MinValue[] = "0";
 
@@ -79,12 +160,575 @@ namespace Config {
     }
   }
 
+  namespace Feed {
+    /**
+     * @brief Source of pending transactions, transactions are sent back over the same connection.
+     */
+    enum class Source {
+      BloXroute, // BloXroute Cloud API over WebSocket
+      Node       // eth_subscribe("newPendingTransactions", true) of a co-located node over its IPC socket
+    };
+
+    inline constexpr Source Selected = Source::BloXroute;
+
+    namespace Node {
+      /**
+       * @brief Path of the node IPC socket.
+       */
+      inline constexpr char Path[] = "/root/.ethereum/geth.ipc";
+
+      /**
+       * @brief Size of the receive buffer, longer messages (transactions with large input) are skipped.
+       */
+      inline constexpr std::size_t BufferSize = 1 << 20;
+
+      /**
+       * @brief Time without messages after which pending work (eg. watching of target transaction) is checked (milliseconds).
+       */
+      inline constexpr unsigned IdleMilliseconds = 1000;
+    }
+
+    namespace WebSocket {
+      /**
+       * @brief Implementation of the BloXroute Cloud API WebSocket connection.
+       */
+      enum class Transport {
+        Asio,  // websocketpp over asio
+        Uring  // minimal client over io_uring (Linux 5.11+), wss:// only with kernel TLS
+      };
+
+      inline constexpr Transport Selected = Transport::Asio;
+
+      /**
+       * @brief With WS_TLS, connect over io_uring transport with kernel TLS (OpenSSL handshake, sends encrypted by the kernel),
+       * falling back to websocketpp TLS if kernel TLS is unavailable. Implied by Transport::Uring over wss://.
+       */
+      inline constexpr bool KernelTLS = false;
+
+      /**
+       * @brief Submit io_uring requests through kernel polling thread, sends make no system call but the thread spins on a core.
+       */
+      inline constexpr bool SqPoll = false;
+
+      /**
+       * @brief Time without submissions after which the polling thread sleeps (milliseconds).
+       */
+      inline constexpr unsigned SqPollIdleMilliseconds = 1000;
+
+      /**
+       * @brief Size of the receive buffer, longer messages are skipped.
+       */
+      inline constexpr std::size_t BufferSize = 1 << 20;
+
+      /**
+       * @brief Number of send slots (messages waiting to be written), sends are refused while all of them are taken.
+       */
+      inline constexpr std::size_t SendSlots = 32;
+
+      /**
+       * @brief Interval of pings keeping the connection alive (milliseconds), unless heartbeat is enabled.
+       */
+      inline constexpr unsigned PingMilliseconds = 30000;
+
+      namespace Heartbeat {
+        /**
+         * @brief Send timestamped pings instead and measure round trip time of their pongs, published in telemetry.
+         * Pings are then sent every IntervalMilliseconds instead of PingMilliseconds.
+         */
+        inline constexpr bool Enabled = false;
+
+        /**
+         * @brief Interval of heartbeat pings (milliseconds). Below the minimum TCP retransmission timeout (200 ms)
+         * the congestion window is never reset after idle.
+         */
+        inline constexpr unsigned IntervalMilliseconds = 100;
+
+        /**
+         * @brief Time after which unanswered ping counts as lost (milliseconds).
+         */
+        inline constexpr unsigned PongTimeoutMilliseconds = 1000;
+
+        /**
+         * @brief Send keep-warm frame (the largest unsolicited pong, ignored by the server) with every ping,
+         * so the send path and the connection do not go cold between transactions.
+         */
+        inline constexpr bool KeepWarm = false;
+
+        /**
+         * @brief Number of latest round trips the degradation is judged on.
+         */
+        inline constexpr std::size_t Window = 32;
+
+        /**
+         * @brief Median round trip over the window above which the connection is degraded (microseconds), 0 to ignore round trips.
+         */
+        inline constexpr uint64_t MaxRoundTripMicroseconds = 5000;
+
+        /**
+         * @brief Consecutive lost pings after which the connection is degraded, 0 to ignore lost pings.
+         */
+        inline constexpr unsigned MaxLostPongs = 3;
+
+        /**
+         * @brief Reconnect degraded connection, to the address with the shortest round trip measured on it (not yet measured ones first).
+         * @see Config::BloXroute::Connection::Addresses
+         */
+        inline constexpr bool Reconnect = false;
+      }
+    }
+  }
+
   namespace TransactionPreGen {
     inline constexpr uint64_t GasPriceGweiFrom = 100;
     inline constexpr uint64_t GasPriceGweiTo = 500;
     inline constexpr uint64_t GasPriceGweiDecimals = 100;
 
     inline constexpr std::size_t ArraySize = (GasPriceGweiTo - GasPriceGweiFrom) * GasPriceGweiDecimals + 1;
+
+    /**
+     * @brief What to do when there is no transaction pregenerated with exactly observed gas price.
+     */
+    enum class MissPolicy {
+      SignOnDemand, // sign transaction with observed gas price
+      NearestAbove, // send pregenerated transaction with the nearest higher gas price, sign on demand if there is none
+    };
+
+    inline constexpr MissPolicy Policy = MissPolicy::SignOnDemand;
+
+    /**
+     * @brief Maximum gas price overpay accepted by MissPolicy::NearestAbove (wei).
+     * Buy priced above the liquidity add can be ordered ahead of it and revert against the empty pair.
+     */
+    inline constexpr uint64_t MaxGasPriceBump = 1000000000;
+
+    /**
+     * @brief Pregenerate transactions for gas prices of other liquidity adds seen on the stream.
+     * Gas prices are queued by the event loop and signed by a background thread, which publishes them in batches.
+     * Every batch copies the whole store of each wallet (under the pregeneration lock), so it is off by default.
+     */
+    inline constexpr bool LearnFromFeed = false;
+
+    /**
+     * @brief Maximum number of transactions pregenerated for gas prices learned from the stream.
+     */
+    inline constexpr std::size_t LearnedCapacity = 10000;
+
+    /**
+     * @brief Maximum number of learned gas prices waiting to be pregenerated (power of two), more are dropped.
+     */
+    inline constexpr std::size_t LearnedQueueCapacity = 1024;
+
+    /**
+     * @brief Time between batches of transactions pregenerated for learned gas prices.
+     */
+    inline constexpr unsigned int LearnIntervalMilliseconds = 1000;
+
+    /**
+     * @brief Number of signing threads used to pregenerate transactions of each wallet, 0 means all available cores.
+     */
+    inline constexpr std::size_t Threads = 0;
+
+    /**
+     * @brief Store legacy transactions as one hex template of constant fields plus a small per gas price delta,
+     * assembled into the message on send. Takes about 5 times less memory, so more of the table stays in cache.
+     */
+    inline constexpr bool Compact = true;
+
+    namespace Adaptive {
+      /**
+       * @brief Periodically re-pregenerate transactions in the background for the most frequently observed gas prices.
+       */
+      inline constexpr bool Enabled = false;
+
+      /**
+       * @brief Number of transactions signed by each re-pregeneration.
+       */
+      inline constexpr std::size_t Budget = ArraySize;
+
+      /**
+       * @brief Seconds between re-pregenerations.
+       */
+      inline constexpr unsigned IntervalSeconds = 600;
+
+      /**
+       * @brief Minimum number of observed gas prices before the first re-pregeneration.
+       */
+      inline constexpr uint64_t MinSamples = 1000;
+
+      /**
+       * @brief File to load observed gas prices from at startup and save them to after re-pregeneration, empty to disable.
+       */
+      inline constexpr char HistogramPath[] = "gas-price-histogram.txt";
+
+      /**
+       * @brief Maximum number of distinct observed gas prices (power of two).
+       */
+      inline constexpr std::size_t HistogramCapacity = 1 << 16;
+    }
+
+    inline constexpr std::size_t Capacity = (ArraySize > Adaptive::Budget ? ArraySize : Adaptive::Budget) + LearnedCapacity;
+
+    namespace DynamicFee {
+      /**
+       * @brief Pregenerate EIP-1559 transactions over (maxFeePerGas, maxPriorityFeePerGas) grid.
+       * Transactions are sent with the same type and fees as the observed liquidity add, signed on demand while disabled.
+       * Doubles startup signing of the default grids.
+       */
+      inline constexpr bool Enabled = false;
+
+      inline constexpr uint64_t MaxFeeGweiFrom = 100;
+      inline constexpr uint64_t MaxFeeGweiTo = 500;
+      inline constexpr uint64_t MaxFeeGweiDecimals = 10;
+
+      inline constexpr uint64_t PriorityFeeGweiFrom = 0;
+      inline constexpr uint64_t PriorityFeeGweiTo = 5;
+      inline constexpr uint64_t PriorityFeeGweiDecimals = 2;
+
+      inline constexpr std::size_t MaxFeeCount = (MaxFeeGweiTo - MaxFeeGweiFrom) * MaxFeeGweiDecimals + 1;
+      inline constexpr std::size_t PriorityFeeCount = (PriorityFeeGweiTo - PriorityFeeGweiFrom) * PriorityFeeGweiDecimals + 1;
+
+      /**
+       * @brief Maximum maxPriorityFeePerGas overpay accepted by MissPolicy::NearestAbove (wei).
+       * Maximum maxFeePerGas overpay is MaxGasPriceBump.
+       */
+      inline constexpr uint64_t MaxPriorityFeeBump = 500000000;
+    }
+  }
+
+  namespace Pipeline {
+    /**
+     * @brief Sign transactions missing in pregenerated stores on signer threads, so the network thread keeps reading the stream.
+     * Otherwise they are signed inline on the network thread. Signer and sender threads spin while enabled, so they take cores of their own.
+     */
+    inline constexpr bool Enabled = false;
+
+    /**
+     * @brief Number of signer threads.
+     */
+    inline constexpr std::size_t SignerThreads = 2;
+
+    /**
+     * @brief Capacity of each signer request and result queue (power of two).
+     */
+    inline constexpr std::size_t QueueCapacity = 64;
+
+    /**
+     * @brief Core the first signer thread is pinned to, next signers are pinned to consecutive cores.
+     * -1 pins them to the CPUs of the NIC node (see Config::Numa), or disables pinning when the node is unknown.
+     */
+    inline constexpr int SignerFirstCore = -1;
+
+    /**
+     * @brief Core the sender thread is pinned to, -1 pins it to the CPUs of the NIC node (or disables pinning when the node is unknown).
+     */
+    inline constexpr int SenderCore = -1;
+  }
+
+  namespace Numa {
+    /**
+     * @brief Place wallets, pregenerated transactions and signing contexts in memory of the NUMA node the NIC is attached to,
+     * and run event loop, signer and sender threads on its CPUs. Left to the kernel when the node is unknown (virtual NIC, single node).
+     */
+    inline constexpr bool Enabled = true;
+
+    /**
+     * @brief Interface the feed is received on, empty for the interface of the default route.
+     */
+    inline constexpr char Interface[] = "";
+
+    /**
+     * @brief Core the event loop (network) thread is pinned to, -1 pins it to the CPUs of the NIC node (or disables pinning when the node is unknown).
+     */
+    inline constexpr int NetworkCore = -1;
+  }
+
+  namespace SharedPreGen {
+    /**
+     * @brief Read pregenerated transactions from shared memory published by the pregen daemon (build/pregend)
+     * instead of pregenerating them in the process. Falls back to local pregeneration if the segment does not exist.
+     */
+    inline constexpr bool Enabled = false;
+
+    /**
+     * @brief Shared memory segment name, use distinct name for every distinct configuration.
+     */
+    inline constexpr char Name[] = "/uniswap-sniper-pregen";
+
+    /**
+     * @brief Minimum time between deactivation of a slot and its rewrite (milliseconds).
+     */
+    inline constexpr unsigned GraceMilliseconds = 100;
+  }
+
+  namespace Exit {
+    /**
+     * @brief Pregenerate approve (nonce + 1) and sell (nonce + 2) transactions after the buy is sent and send them on trigger.
+     * Connection is kept open until the exit is sent.
+     */
+    inline constexpr bool Enabled = false;
+
+    inline constexpr uint64_t GasPriceGweiFrom = 50;
+    inline constexpr uint64_t GasPriceGweiTo = 500;
+    inline constexpr uint64_t GasPriceGweiDecimals = 1;
+
+    inline constexpr std::size_t ArraySize = (GasPriceGweiTo - GasPriceGweiFrom) * GasPriceGweiDecimals + 1;
+
+    /**
+     * @brief Gas limit of approve transaction (60000 units).
+     */
+    inline constexpr char ApproveGasLimit[] = "ea60";
+
+    /**
+     * @brief Gas limit of sell transaction (250000 units).
+     */
+    inline constexpr char SellGasLimit[] = "3d090";
+
+    /**
+     * @brief Sell amounts in percents of the minimum buy output (expected output lowered by SlippageBasisPoints),
+     * sell transactions are pregenerated for each tier.
+     */
+    inline constexpr uint64_t Tiers[] = { 100, 50, 25 };
+
+    inline constexpr std::size_t TiersCount = sizeof(Tiers) / sizeof(*Tiers);
+
+    /**
+     * @brief Seconds after the buy the timer trigger fires, 0 disables the timer.
+     */
+    inline constexpr unsigned TimerSeconds = 600;
+
+    /**
+     * @brief Tier sold by the timer trigger.
+     */
+    inline constexpr std::size_t TimerTier = 1;
+
+    /**
+     * @brief Tier sold when removeLiquidityETH of the token is seen on the stream (price signal).
+     */
+    inline constexpr std::size_t PriceSignalTier = 0;
+
+    /**
+     * @brief Tier sold on manual signal (SIGUSR1).
+     */
+    inline constexpr std::size_t ManualTier = 0;
+
+    /**
+     * @brief Gas price added to the gas price of the observed removeLiquidityETH transaction (wei).
+     */
+    inline constexpr uint64_t PriceSignalGasPriceBump = 1000000000;
+
+    static_assert(TimerTier < TiersCount && PriceSignalTier < TiersCount && ManualTier < TiersCount, "Exit tiers out of range");
+  }
+
+  namespace Cancel {
+    /**
+     * @brief Pregenerate cancels (zero value self-transfers with the buy nonce) at startup and send them
+     * when the target transaction is replaced or cancelled. Connection is kept open until the buy or the cancel lands.
+     */
+    inline constexpr bool Enabled = false;
+
+    /**
+     * @brief Gas price grid of cancels, has to cover buy gas prices bumped by ReplacementBumpPercent.
+     */
+    inline constexpr uint64_t GasPriceGweiFrom = 110;
+    inline constexpr uint64_t GasPriceGweiTo = 550;
+    inline constexpr uint64_t GasPriceGweiDecimals = 10;
+
+    inline constexpr std::size_t ArraySize = (GasPriceGweiTo - GasPriceGweiFrom) * GasPriceGweiDecimals + 1;
+
+    /**
+     * @brief Gas limit of plain transfer (21000 units).
+     */
+    inline constexpr char GasLimit[] = "5208";
+
+    /**
+     * @brief Minimum gas price bump of replacement transaction accepted by nodes (geth txpool.pricebump).
+     */
+    inline constexpr uint64_t ReplacementBumpPercent = 10;
+
+    /**
+     * @brief Seconds after the buy the target transaction is watched for replacement.
+     */
+    inline constexpr unsigned WatchSeconds = 60;
+
+    /**
+     * @brief Maximum accepted overpay of pregenerated cancel over the minimum replacement gas price (wei).
+     */
+    inline constexpr uint64_t MaxGasPriceBump = 1000000000;
+  }
+
+  namespace Signer {
+    /**
+     * @brief Sign on demand in a separate signer process (build/signerd) holding private keys, over shared memory rings.
+     * Private keys are not loaded by the bot process then: pregenerated transactions come from the pregen daemon only,
+     * and features signing in the bot process (pipeline, exit, cancel) have to be disabled.
+     */
+    inline constexpr bool Enabled = false;
+
+    /**
+     * @brief Shared memory channel name.
+     */
+    inline constexpr char Name[] = "/uniswap-sniper-signer";
+
+    /**
+     * @brief File with private keys (hexadecimal, one per line, in wallets order) read by the signer process,
+     * empty to use Config::Wallets. Lets private keys be left out of the bot configuration.
+     */
+    inline constexpr char KeyFile[] = "";
+
+    /**
+     * @brief Capacity of request and response rings (power of two).
+     */
+    inline constexpr std::size_t QueueCapacity = 64;
+
+    /**
+     * @brief Maximum time the bot waits for signed message (microseconds).
+     */
+    inline constexpr unsigned TimeoutMicroseconds = 1000;
+
+    /**
+     * @brief Core the signer process is pinned to, -1 pins it to the CPUs of the NIC node (see Config::Numa), or disables pinning when the node is unknown.
+     */
+    inline constexpr int Core = -1;
+
+    static_assert(!Enabled || (!Pipeline::Enabled && !Exit::Enabled && !Cancel::Enabled), "Pipeline, exit and cancel sign in the bot process, disable them to use isolated signer");
+  }
+
+  namespace Telemetry {
+    /**
+     * @brief Publish decision counters and gas price distributions in shared memory, read live with build/telemetry.
+     * When disabled (or the segment cannot be created) they are kept process-local.
+     */
+    inline constexpr bool Enabled = true;
+
+    /**
+     * @brief Shared memory segment name.
+     */
+    inline constexpr char Name[] = "/uniswap-sniper-telemetry";
+
+    /**
+     * @brief Number of buckets of each gas price distribution, the last one holds all values above.
+     */
+    inline constexpr std::size_t Buckets = 128;
+
+    /**
+     * @brief Width of distribution bucket (wei), 1 gwei.
+     */
+    inline constexpr uint64_t BucketWidth = 1000000000;
+  }
+
+  namespace Warm {
+    /**
+     * @brief Run synthetic liquidity add of the target token through the match path on feed loop ticks, nothing is sent.
+     * Keeps caches and branch predictors primed for the first real match. Ticks follow the ping interval, enable Heartbeat for frequent rounds.
+     */
+    inline constexpr bool Enabled = false;
+
+    /**
+     * @brief Minimum time between warming rounds (milliseconds). Rounds run on feed loop ticks, so they are at most as frequent.
+     */
+    inline constexpr unsigned IntervalMilliseconds = 100;
+
+    /**
+     * @brief Time budget of a warming round (microseconds), its first synthetic match is always completed.
+     */
+    inline constexpr unsigned BudgetMicroseconds = 200;
+
+    /**
+     * @brief Dry-run sign of the sending wallets in every round (discarded, not available when signing in the signer process).
+     * Takes tens of microseconds per wallet on the event loop, a real match arriving meanwhile waits for it.
+     */
+    inline constexpr bool DryRunSign = false;
+
+    /**
+     * @brief Number of latest liquidity add fees (of other tokens) whose pregenerated transactions are touched.
+     */
+    inline constexpr std::size_t LikelyCount = 16;
+  }
+
+  namespace Bundle {
+    /**
+     * @brief Submit the buy in a bundle right behind the target liquidity add (eth_sendBundle), instead of racing it on gas price only.
+     * Stream messages include signed target transactions, matches without one are raced as before.
+     */
+    inline constexpr bool Enabled = false;
+
+    /**
+     * @brief Relay (or builder) endpoint accepting eth_sendBundle, http:// or https:// (with kernel TLS only).
+     */
+    inline constexpr char RelayUrl[] = "https://rpc.beaverbuild.org/";
+
+    /**
+     * @brief Send the transaction to BloXroute too, the bundle is sent in addition.
+     */
+    inline constexpr bool Race = true;
+  }
+
+  namespace PreArm {
+    /**
+     * @brief Watch for signals preceding the liquidity add (createPair of the target token, deployment and router approve of the deployer)
+     * and pre-arm the target on them: its calldata, pregenerated transactions and warmed caches are ready before liquidity is added.
+     * Signals are received on the Cloud API feed only.
+     */
+    inline constexpr bool Enabled = false;
+
+    /**
+     * @brief Deployer of the token (lowercase, without 0x prefix). Its deployments, approves of the router and pair creations retarget the bot
+     * to the token before the first buy. Empty to pre-arm on createPair of the configured token only.
+     */
+    inline constexpr char Deployer[] = "";
+  }
+
+  namespace Rules {
+    /**
+     * @brief Check target liquidity adds against the rules before sending, rejected ones are dropped.
+     * Rules of the target are compiled into bounds of message fields and sorted sender blacklist, evaluated without data dependent branches.
+     */
+    inline constexpr bool Enabled = false;
+
+    /**
+     * @brief Message field checked by the rule.
+     */
+    enum class RuleKind {
+      MinLiquidity, // minimum liquidity added in wrapped native token (wei)
+      MaxGasPrice,  // maximum gas price, maxFeePerGas of EIP-1559 transaction (wei)
+      TokenRatio,   // bounds of token amount (smallest units) added per 1 ETH of liquidity
+      Blacklist     // sender of the liquidity add
+    };
+
+    /**
+     * @brief Filter rule of liquidity adds.
+     */
+    struct Rule {
+      RuleKind Kind;
+      const char *Token; // target token the rule applies to (lowercase, without 0x prefix), empty for every target
+      double Min;
+      double Max;
+      const char *Sender; // blacklisted sender (without 0x prefix)
+    };
+
+    constexpr Rule minLiquidity(const char *token, double wei) {
+      return { RuleKind::MinLiquidity, token, wei, 0, "" };
+    }
+
+    constexpr Rule maxGasPrice(const char *token, double wei) {
+      return { RuleKind::MaxGasPrice, token, 0, wei, "" };
+    }
+
+    constexpr Rule tokenRatio(const char *token, double minTokensPerETH, double maxTokensPerETH) {
+      return { RuleKind::TokenRatio, token, minTokensPerETH, maxTokensPerETH, "" };
+    }
+
+    constexpr Rule blacklist(const char *sender, const char *token = "") {
+      return { RuleKind::Blacklist, token, 0, 0, sender };
+    }
+
+    /**
+     * @brief Configured rules, the ones of the current target (and of every target) are compiled on start and retarget.
+     */
+    inline constexpr Rule List[] = {
+      minLiquidity("", 1e18),
+      maxGasPrice("", 1000e9),
+    };
   }
 
   namespace Size {
@@ -94,5 +738,6 @@ namespace Config {
     inline constexpr std::size_t TransactionRawBuffer = 512;
 
     inline constexpr std::size_t BloXrouteTransactionMessageString = 1024;
+    inline constexpr std::size_t BundleRequestBody = 4096;
   }
 }
\ No newline at end of file
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "abi.hpp"
+#include "config.hpp"
+#include "utils.hpp"
+#include "uint256.hpp"
+#include "transaction.hpp"
+#include "pregen.hpp"
+
+/**
+ * @brief Pregenerated exit (approve and sell) transactions and triggers firing them.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#exit
+ */
+namespace Exit {
+  /**
+   * @brief Calldata template of approve with maximum amount.
+   */
+  inline constexpr auto ApproveTemplate = ABI::approve();
+
+  /**
+   * @brief Calldata template of the sell method, with zero amountOutMin (exit accepts any output).
+   */
+  inline constexpr auto SellTemplate = ABI::swapExactTokensForETH(
+    Config::Transaction::SwapExactETHForTokens::SupportingFeeOnTransferTokens
+      ? ABI::Selector::SwapExactTokensForETHSupportingFeeOnTransferTokens
+      : ABI::Selector::SwapExactTokensForETH,
+    Config::Router::Selected.WrappedNative
+  );
+
+  /**
+   * @brief Exit trigger signals.
+   */
+  enum class Signal : std::uint64_t {
+    None,
+    Timer,
+    Price,
+    Manual
+  };
+
+  /**
+   * @brief Returns signal name.
+   */
+  inline const char *signalName(Signal signal) {
+    switch(signal) {
+      case Signal::Timer: return "timer";
+      case Signal::Price: return "price signal";
+      case Signal::Manual: return "manual signal";
+      default: return "none";
+    }
+  }
+
+  /**
+   * @brief Builds approve input data.
+   *
+   * @param spenderAddress spender (router) address
+   * @param output output data
+   * @return output length
+   */
+  inline std::size_t buildApproveData(const char *spenderAddress, char *output) {
+    memcpy(output, ApproveTemplate.hex, ApproveTemplate.HexLength);
+    memcpy(output + ApproveTemplate.addressOffset(ABI::Spender), spenderAddress, ABI::AddressLength);
+    output[ApproveTemplate.HexLength] = '\0';
+
+    return ApproveTemplate.HexLength;
+  }
+
+  /**
+   * @brief Builds sell input data with zero amountIn, patched per tier.
+   *
+   * @param tokenAddress address of sold token (path[0])
+   * @param receiverAddress (to)
+   * @param output output data
+   * @return output length
+   */
+  inline std::size_t buildSellData(const char *tokenAddress, const char *receiverAddress, char *output) {
+    memcpy(output, SellTemplate.hex, SellTemplate.HexLength);
+    memcpy(output + SellTemplate.addressOffset(ABI::Token), tokenAddress, ABI::AddressLength);
+    memcpy(output + SellTemplate.addressOffset(ABI::To), receiverAddress, ABI::AddressLength);
+    output[SellTemplate.HexLength] = '\0';
+
+    return SellTemplate.HexLength;
+  }
+
+  /**
+   * @brief Calculates sell amount of a tier.
+   *
+   * @param minimumOutput minimum output of the buy
+   * @param percent tier percent
+   * @return amount to sell
+   */
+  inline UInt256 tierAmount(const UInt256 &minimumOutput, std::uint64_t percent) {
+    return minimumOutput * percent / 100;
+  }
+
+  /**
+   * @brief Fires exit once: on a timer deadline, price signal from the stream or manual signal.
+   *
+   * Signal and its gas price are packed into a single lock-free word, so firing is safe from signal handlers
+   * and only the first signal wins.
+   */
+  class Trigger {
+    static constexpr std::uint64_t GasPriceMask = (1ULL << 62) - 1;
+
+    std::atomic<std::uint64_t> state { 0 };
+    std::atomic<std::uint64_t> deadline { 0 };
+
+    public:
+
+    /**
+     * @brief Sets timer deadline.
+     *
+     * @param at deadline (ns, steady clock), 0 disables the timer
+     */
+    void armTimer(std::uint64_t at) {
+      deadline.store(at, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Fires the trigger.
+     *
+     * @param signal signal
+     * @param gasPrice gas price the exit should be sent with (wei), 0 for the buy gas price
+     * @return false if the trigger was already fired
+     */
+    bool fire(Signal signal, std::uint64_t gasPrice = 0) {
+      std::uint64_t expected = 0;
+      return state.compare_exchange_strong(expected, (static_cast<std::uint64_t>(signal) << 62) | (gasPrice & GasPriceMask));
+    }
+
+    /**
+     * @brief Fires the timer if its deadline passed and returns fired signal.
+     *
+     * @param now current time (ns, steady clock)
+     * @return fired signal, Signal::None if not fired yet
+     */
+    Signal poll(std::uint64_t now) {
+      std::uint64_t at = deadline.load(std::memory_order_relaxed);
+      if(at != 0 && now >= at) fire(Signal::Timer);
+
+      return signal();
+    }
+
+    /**
+     * @brief Returns fired signal, Signal::None if not fired yet.
+     */
+    Signal signal() const {
+      return static_cast<Signal>(state.load() >> 62);
+    }
+
+    /**
+     * @brief Returns gas price of fired signal, 0 for the buy gas price.
+     */
+    std::uint64_t gasPrice() const {
+      return state.load() & GasPriceMask;
+    }
+  };
+
+  /**
+   * @brief Open position of a wallet: approve and sell transactions pregenerated after the buy.
+   *
+   * Approve is sent with buy nonce + 1 and sell with buy nonce + 2, both over the same gas price grid.
+   *
+   * @tparam Capacity maximum number of gas prices
+   * @tparam MessageSize maximum size of single message
+   * @tparam Tiers number of sell tiers
+   */
+  template<std::size_t Capacity, std::size_t MessageSize, std::size_t Tiers>
+  class Position {
+    using StoreType = PreGen::Store<Capacity, MessageSize>;
+
+    std::atomic<bool> opened { false };
+    std::atomic<bool> ready { false };
+
+    std::uint64_t nonce = 0;
+    std::uint64_t gasPrice = 0;
+    UInt256 amounts[Tiers];
+    const char *token = "";
+    const char *router = "";
+
+    char approveData[ApproveTemplate.HexLength + 1];
+    char sellData[SellTemplate.HexLength + 1];
+
+    /**
+     * @brief Returns pregenerated message for given gas price (or the nearest higher one), signs it on a miss.
+     */
+    template<typename Setup>
+    const char *message(const StoreType &store, Setup setup, std::uint64_t messageGasPrice, std::uint64_t maxBump, Transaction &tx, Utils::Buffer privateKey, char *buffer, std::size_t &length) const {
+      const auto *entry = store.lookup(messageGasPrice, Config::TransactionPreGen::MissPolicy::NearestAbove, maxBump);
+      if(entry != nullptr) {
+        length = entry->length;
+        return entry->message;
+      }
+
+      setup(tx);
+      length = PreGen::generate(tx, privateKey, messageGasPrice, buffer);
+      return buffer;
+    }
+
+    public:
+
+    StoreType approveTxs;
+    StoreType sellTxs[Tiers];
+
+    /**
+     * @brief Opens position after the buy was sent. Called once, by the event loop.
+     *
+     * @param buyNonce nonce of the buy transaction
+     * @param buyGasPrice gas price (or maxFeePerGas) of the buy transaction (wei)
+     * @param minimumOutput minimum amount of tokens bought, tokens held when others bought ahead of us within slippage
+     * @param tiers sell amounts in percents of minimum output
+     * @param tokenAddress bought token address, has to outlive position
+     * @param routerAddress router address (approve spender), has to outlive position
+     * @param receiverAddress receiver of sold ETH
+     */
+    void open(
+      std::uint64_t buyNonce, std::uint64_t buyGasPrice, const UInt256 &minimumOutput, const std::uint64_t (&tiers)[Tiers],
+      const char *tokenAddress, const char *routerAddress, const char *receiverAddress
+    ) {
+      nonce = buyNonce;
+      gasPrice = buyGasPrice;
+      token = tokenAddress;
+      router = routerAddress;
+      for(std::size_t tier = 0; tier < Tiers; tier++) amounts[tier] = tierAmount(minimumOutput, tiers[tier]);
+
+      buildApproveData(routerAddress, approveData);
+      buildSellData(tokenAddress, receiverAddress, sellData);
+
+      opened.store(true, std::memory_order_release);
+    }
+
+    bool isOpen() const {
+      return opened.load(std::memory_order_acquire);
+    }
+
+    bool isReady() const {
+      return ready.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns gas price of the buy transaction (wei).
+     */
+    std::uint64_t getGasPrice() const {
+      return gasPrice;
+    }
+
+    /**
+     * @brief Returns amount sold by given tier.
+     */
+    const UInt256 &getAmount(std::size_t tier) const {
+      return amounts[tier];
+    }
+
+    /**
+     * @brief Sets all approve transaction fields but gas price.
+     *
+     * @param tx output transaction
+     */
+    void setApproveFields(Transaction &tx) const {
+      Utils::Byte nonceBuffer[8];
+      std::size_t nonceBufferSize = Utils::intToBuffer(nonce + 1, nonceBuffer);
+
+      tx.setField(Transaction::Field::Nonce, nonceBuffer, nonceBufferSize);
+      tx.setField(Transaction::Field::GasLimit, Config::Exit::ApproveGasLimit);
+      tx.setField(Transaction::Field::To, token);
+      tx.setField(Transaction::Field::Value, "0");
+      tx.setField(Transaction::Field::Data, approveData);
+    }
+
+    /**
+     * @brief Sets all sell transaction fields but gas price.
+     *
+     * @param tx output transaction
+     * @param tier sell tier
+     */
+    void setSellFields(Transaction &tx, std::size_t tier) const {
+      Utils::Byte nonceBuffer[8];
+      std::size_t nonceBufferSize = Utils::intToBuffer(nonce + 2, nonceBuffer);
+
+      tx.setField(Transaction::Field::Nonce, nonceBuffer, nonceBufferSize);
+      tx.setField(Transaction::Field::GasLimit, Config::Exit::SellGasLimit);
+      tx.setField(Transaction::Field::To, router);
+      tx.setField(Transaction::Field::Value, "0");
+      tx.setField(Transaction::Field::Data, sellData);
+
+      Utils::Byte amountBuffer[32];
+      amounts[tier].toBuffer(amountBuffer);
+      tx.patchField(Transaction::Field::Data, SellTemplate.byteOffset(ABI::AmountIn), amountBuffer, 32);
+    }
+
+    /**
+     * @brief Pregenerates approve and sell transactions of every tier for given gas prices, signing on multiple threads.
+     *
+     * @param gasPrices gas prices to pregenerate (wei)
+     * @param privateKey private key buffer to sign with
+     * @param threadsCount number of signing threads, 0 means all available cores
+     * @return number of pregenerated messages
+     */
+    std::size_t generate(const std::vector<std::uint64_t> &gasPrices, Utils::Buffer privateKey, std::size_t threadsCount = 0) {
+      std::size_t generated = PreGen::generateParallel(
+        approveTxs, gasPrices, privateKey,
+        [this](Transaction &tx) { setApproveFields(tx); },
+        threadsCount
+      );
+
+      for(std::size_t tier = 0; tier < Tiers; tier++) {
+        generated += PreGen::generateParallel(
+          sellTxs[tier], gasPrices, privateKey,
+          [this, tier](Transaction &tx) { setSellFields(tx, tier); },
+          threadsCount
+        );
+      }
+
+      ready.store(true, std::memory_order_release);
+      return generated;
+    }
+
+    /**
+     * @brief Returns approve message for given gas price: pregenerated one with the nearest higher gas price, or signed on demand.
+     *
+     * @param messageGasPrice gas price (wei)
+     * @param maxBump maximum accepted gas price overpay (wei)
+     * @param tx transaction used to sign on demand
+     * @param privateKey private key buffer to sign with
+     * @param buffer buffer for message signed on demand
+     * @param length output message length
+     * @return message
+     */
+    const char *approve(std::uint64_t messageGasPrice, std::uint64_t maxBump, Transaction &tx, Utils::Buffer privateKey, char *buffer, std::size_t &length) const {
+      return message(approveTxs, [this](Transaction &transaction) { setApproveFields(transaction); }, messageGasPrice, maxBump, tx, privateKey, buffer, length);
+    }
+
+    /**
+     * @brief Returns sell message of given tier for given gas price: pregenerated one with the nearest higher gas price, or signed on demand.
+     *
+     * @param tier sell tier
+     * @param messageGasPrice gas price (wei)
+     * @param maxBump maximum accepted gas price overpay (wei)
+     * @param tx transaction used to sign on demand
+     * @param privateKey private key buffer to sign with
+     * @param buffer buffer for message signed on demand
+     * @param length output message length
+     * @return message
+     */
+    const char *sell(std::size_t tier, std::uint64_t messageGasPrice, std::uint64_t maxBump, Transaction &tx, Utils::Buffer privateKey, char *buffer, std::size_t &length) const {
+      return message(sellTxs[tier], [this, tier](Transaction &transaction) { setSellFields(transaction, tier); }, messageGasPrice, maxBump, tx, privateKey, buffer, length);
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,425 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "abi.hpp"
+#include "bot.hpp"
+#include "uint256.hpp"
+
+/**
+ * @brief Sources of pending transactions other than BloXroute Cloud API.
+ *
+ * Messages of every source are normalized to the BloXroute stream layout, so they go through the same
+ * BloXrouteMessageParser validation and extraction. Sources are picked at compile time (Config::Feed::Selected),
+ * there is no virtual call on the hot path.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#node-feed
+ */
+namespace Feed {
+  /**
+   * @brief Pending transactions of a co-located node, eth_subscribe("newPendingTransactions", true) over JSON-RPC.
+   */
+  namespace Node {
+    /**
+     * @brief Subscribe request, full transaction objects are streamed.
+     */
+    inline constexpr char SubscribeRequest[] = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"eth_subscribe\",\"params\":[\"newPendingTransactions\",true]}";
+
+    /**
+     * @brief Parts of eth_sendRawTransaction request around signed transaction hex value.
+     */
+    inline constexpr char SendRawTransactionPrefix[] = "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"eth_sendRawTransaction\",\"params\":[\"0x";
+    inline constexpr char SendRawTransactionSuffix[] = "\"]}\n";
+
+    /**
+     * @brief Method of subscription notifications, responses to requests are skipped.
+     */
+    inline constexpr char NotificationMethod[] = "\"method\":\"eth_subscription\"";
+
+    /**
+     * @brief Keys of transaction fields in notifications, including opening quote.
+     */
+    inline constexpr char ResultKey[] = "\"result\":{";
+    inline constexpr char InputKey[] = "\"input\":\"0x";
+    inline constexpr char ToKey[] = "\"to\":\"0x";
+    inline constexpr char GasPriceKey[] = "\"gasPrice\":\"0x";
+    inline constexpr char ValueKey[] = "\"value\":\"0x";
+    inline constexpr char MaxFeePerGasKey[] = "\"maxFeePerGas\":\"0x";
+    inline constexpr char MaxPriorityFeePerGasKey[] = "\"maxPriorityFeePerGas\":\"0x";
+    inline constexpr char FromKey[] = "\"from\":\"0x";
+    inline constexpr char NonceKey[] = "\"nonce\":\"0x";
+
+    /**
+     * @brief Normalized message up to the input hex value, in the BloXroute stream layout.
+     */
+    inline constexpr char Prefix[] = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"00000000-0000-0000-0000-000000000000\",\"result\":{\"txContents\":{\"input\":\"0x";
+    inline constexpr char Suffix[] = "}}}}";
+
+    static_assert(sizeof(Prefix) - 1 == BloXrouteMessageParser::InputPosition, "Normalized input has to start at BloXroute input position");
+
+    /**
+     * @brief Longest input kept in normalized message, longer inputs are cut (observed methods are shorter).
+     */
+    inline constexpr std::size_t MaxInputLength = std::max(BloXrouteMessageParser::AddLiquidityETH.HexLength, BloXrouteMessageParser::AddLiquidity.HexLength);
+
+    /**
+     * @brief Local equivalent of BloXroute subscription filters, nodes stream all pending transactions.
+     */
+    struct Filter {
+      const char *routerAddress;    // transactions are sent to, any case
+      std::uint64_t maxFeeCap;      // maximum gasPrice or maxFeePerGas (wei)
+      UInt256 minLiquidityETH;      // minimum addLiquidityETH value (wei)
+      bool removeLiquidity;         // pass removeLiquidityETH transactions too
+    };
+
+    /**
+     * @brief Finds hex value of the field.
+     *
+     * @param begin start of the searched range
+     * @param end end of the searched range
+     * @param key key preceding the value, including opening quote and 0x prefix
+     * @return start of the value, nullptr if there is no such field
+     */
+    template<std::size_t KeySize>
+    inline const char *findValue(const char *begin, const char *end, const char (&key)[KeySize]) {
+      const char *keyStart = static_cast<const char*>(memmem(begin, end - begin, key, KeySize - 1));
+      return keyStart == nullptr ? nullptr : keyStart + KeySize - 1;
+    }
+
+    /**
+     * @brief Appends the field, copied as "key":"0x<value>", preceded by comma.
+     *
+     * @param value start of the value in the notification
+     * @param end end of the notification
+     * @param key key preceding the value, including opening quote and 0x prefix
+     * @param output output message
+     * @param position output position, advanced past the field
+     * @param outputEnd end of output buffer
+     * @return false if the value is not terminated or does not fit
+     */
+    template<std::size_t KeySize>
+    inline bool appendField(const char *value, const char *end, const char (&key)[KeySize], char *output, std::size_t &position, std::size_t outputEnd) {
+      const char *valueEnd = static_cast<const char*>(memchr(value, '\"', end - value));
+      if(valueEnd == nullptr) return false;
+
+      std::size_t valueLength = valueEnd - value;
+      if(position + 1 + (KeySize - 1) + valueLength + 1 > outputEnd) return false;
+
+      output[position++] = ',';
+      memcpy(output + position, key, KeySize - 1);
+      position += KeySize - 1;
+      memcpy(output + position, value, valueLength);
+      position += valueLength;
+      output[position++] = '\"';
+
+      return true;
+    }
+
+    /**
+     * @brief Parses hex quantity value up to the closing quote.
+     *
+     * @param value start of the value
+     * @param end end of the notification
+     * @param output parsed value
+     * @return false if the value is not terminated or does not fit in 64 bits
+     */
+    inline bool parseQuantity(const char *value, const char *end, std::uint64_t &output) {
+      const char *valueEnd = static_cast<const char*>(memchr(value, '\"', end - value));
+      if(valueEnd == nullptr || valueEnd - value > 16) return false;
+
+      output = 0;
+      return std::from_chars(value, valueEnd, output, 16).ptr == valueEnd;
+    }
+
+    /**
+     * @brief Normalizes subscription notification to BloXroute stream message (same fields, input first),
+     * if it passes the filter or is sent from the given address.
+     *
+     * @param message input notification
+     * @param messageLength input notification length
+     * @param filter filter of transactions to the router
+     * @param from sender (lowercase, without 0x prefix) whose transactions pass unfiltered, nullptr if none
+     * @param output output message
+     * @param outputSize size of output buffer
+     * @return output message length, 0 if the notification is skipped
+     */
+    inline std::size_t normalize(const char *message, std::size_t messageLength, const Filter &filter, const char *from, char *output, std::size_t outputSize) {
+      const char *end = message + messageLength;
+      if(memmem(message, messageLength, NotificationMethod, sizeof(NotificationMethod) - 1) == nullptr) return 0;
+
+      const char *result = findValue(message, end, ResultKey);
+      if(result == nullptr) return 0;
+
+      const char *input = findValue(result, end, InputKey);
+      if(input == nullptr) return 0;
+
+      const char *inputEnd = static_cast<const char*>(memchr(input, '\"', end - input));
+      if(inputEnd == nullptr) return 0;
+
+      const char *gasPrice = findValue(result, end, GasPriceKey);
+      const char *maxFeePerGas = findValue(result, end, MaxFeePerGasKey);
+      const char *value = findValue(result, end, ValueKey);
+      const char *sender = findValue(result, end, FromKey);
+
+      bool watched = from != nullptr && sender != nullptr && end - sender > 40 && memcmp(sender, from, 40) == 0 && sender[40] == '\"';
+      if(!watched) {
+        const char *to = findValue(result, end, ToKey);
+        if(to == nullptr || end - to <= 40 || strncasecmp(to, filter.routerAddress, 40) != 0) return 0;
+        if(inputEnd - input < static_cast<std::ptrdiff_t>(ABI::SelectorLength)) return 0;
+
+        bool addLiquidityETH = memcmp(input, ABI::Selector::AddLiquidityETH, ABI::SelectorLength) == 0;
+        bool removeLiquidityETH =
+             memcmp(input, ABI::Selector::RemoveLiquidityETH, ABI::SelectorLength) == 0
+          || memcmp(input, ABI::Selector::RemoveLiquidityETHSupportingFeeOnTransferTokens, ABI::SelectorLength) == 0;
+        bool observed = addLiquidityETH || memcmp(input, ABI::Selector::AddLiquidity, ABI::SelectorLength) == 0 || (filter.removeLiquidity && removeLiquidityETH);
+        if(!observed) return 0;
+
+        std::uint64_t feeCap;
+        const char *feeCapValue = maxFeePerGas != nullptr ? maxFeePerGas : gasPrice;
+        if(feeCapValue == nullptr || !parseQuantity(feeCapValue, end, feeCap) || feeCap > filter.maxFeeCap) return 0;
+
+        if(addLiquidityETH) {
+          const char *valueEnd = value == nullptr ? nullptr : static_cast<const char*>(memchr(value, '\"', end - value));
+          if(valueEnd == nullptr || UInt256::fromHexString(value, valueEnd - value) < filter.minLiquidityETH) return 0;
+        }
+      }
+
+      // Input first, gas price has to follow it right away (BloXrouteMessageParser::GasPriceDistance)
+
+      std::size_t inputLength = std::min<std::size_t>(inputEnd - input, MaxInputLength);
+      if(sizeof(Prefix) - 1 + inputLength + 1 + sizeof(Suffix) > outputSize) return 0;
+
+      memcpy(output, Prefix, sizeof(Prefix) - 1);
+      memcpy(output + sizeof(Prefix) - 1, input, inputLength);
+      std::size_t position = sizeof(Prefix) - 1 + inputLength;
+      output[position++] = '\"';
+
+      // Pending EIP-1559 transactions may come without gas price, fee cap takes its place then
+      std::size_t fieldsEnd = outputSize - sizeof(Suffix);
+      const char *gasPriceValue = gasPrice != nullptr ? gasPrice : maxFeePerGas;
+      if(gasPriceValue == nullptr || !appendField(gasPriceValue, end, GasPriceKey, output, position, fieldsEnd)) return 0;
+      if(value != nullptr && !appendField(value, end, ValueKey, output, position, fieldsEnd)) return 0;
+
+      if(maxFeePerGas != nullptr) {
+        const char *maxPriorityFeePerGas = findValue(result, end, MaxPriorityFeePerGasKey);
+        if(!appendField(maxFeePerGas, end, MaxFeePerGasKey, output, position, fieldsEnd)) return 0;
+        if(maxPriorityFeePerGas != nullptr && !appendField(maxPriorityFeePerGas, end, MaxPriorityFeePerGasKey, output, position, fieldsEnd)) return 0;
+      }
+
+      if(sender != nullptr && !appendField(sender, end, FromKey, output, position, fieldsEnd)) return 0;
+
+      const char *nonce = findValue(result, end, NonceKey);
+      if(nonce != nullptr && !appendField(nonce, end, NonceKey, output, position, fieldsEnd)) return 0;
+
+      memcpy(output + position, Suffix, sizeof(Suffix));
+      return position + sizeof(Suffix) - 1;
+    }
+  }
+
+  /**
+   * @brief Newline delimited JSON-RPC connection over Unix domain socket (node IPC endpoint).
+   *
+   * Messages are read by a single thread running the loop, requests can be sent from any thread.
+   *
+   * @tparam BufferSize size of the receive buffer, longer messages are skipped
+   */
+  template<std::size_t BufferSize>
+  class UnixSocket {
+    int fd = -1;
+    std::atomic<bool> running { false };
+    std::mutex sendMutex;
+    char buffer[BufferSize];
+
+    /**
+     * @brief Writes all parts, continuing after partial writes.
+     */
+    bool write(iovec *parts, std::size_t partsCount) {
+      std::lock_guard<std::mutex> lock(sendMutex);
+
+      while(partsCount != 0) {
+        msghdr header {};
+        header.msg_iov = parts;
+        header.msg_iovlen = partsCount;
+
+        ssize_t written = sendmsg(fd, &header, MSG_NOSIGNAL);
+        if(written < 0) {
+          if(errno == EINTR) continue;
+          return false;
+        }
+
+        // Skip written parts, keep the rest of the partially written one
+        std::size_t remaining = written;
+        while(partsCount != 0 && remaining >= parts->iov_len) {
+          remaining -= parts->iov_len;
+          ++parts;
+          --partsCount;
+        }
+
+        if(partsCount != 0) {
+          parts->iov_base = static_cast<char*>(parts->iov_base) + remaining;
+          parts->iov_len -= remaining;
+        }
+      }
+
+      return true;
+    }
+
+    public:
+
+    UnixSocket() = default;
+    UnixSocket(const UnixSocket&) = delete;
+    UnixSocket &operator=(const UnixSocket&) = delete;
+
+    ~UnixSocket() {
+      if(fd != -1) ::close(fd);
+    }
+
+    /**
+     * @brief Connects to the socket.
+     *
+     * @param path socket path
+     * @param idleMilliseconds time without messages after which the idle callback of the loop is called
+     * @return false on failure
+     */
+    bool connect(const char *path, unsigned idleMilliseconds) {
+      if(fd != -1) ::close(fd);
+
+      sockaddr_un address {};
+      address.sun_family = AF_UNIX;
+      if(strlen(path) >= sizeof(address.sun_path)) return false;
+      strcpy(address.sun_path, path);
+
+      fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if(fd == -1) return false;
+
+      timeval timeout { static_cast<time_t>(idleMilliseconds / 1000), static_cast<suseconds_t>(idleMilliseconds % 1000 * 1000) };
+      if(
+           setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0
+        || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+      ) {
+        ::close(fd);
+        fd = -1;
+        return false;
+      }
+
+      running.store(true);
+      return true;
+    }
+
+    /**
+     * @brief Stops the loop and shuts the connection down, can be called from any thread (and from the callbacks).
+     */
+    void close() {
+      running.store(false);
+      if(fd != -1) shutdown(fd, SHUT_RDWR);
+    }
+
+    bool isOpen() const {
+      return running.load();
+    }
+
+    /**
+     * @brief Sends JSON-RPC request as is, followed by newline.
+     *
+     * @param message input request
+     * @param length input request length
+     * @return false if the connection is broken
+     */
+    bool request(const char *message, std::size_t length) {
+      iovec parts[2] = {
+        { const_cast<char*>(message), length },
+        { const_cast<char*>("\n"), 1 }
+      };
+
+      return write(parts, 2);
+    }
+
+    /**
+     * @brief Sends transaction message (BloXroute blxr_tx, see BloXrouteMessageBuilder::buildTransaction) as eth_sendRawTransaction,
+     * the signed transaction is written straight from the message.
+     *
+     * @param message input transaction message
+     * @param length input transaction message length
+     * @return false if the connection is broken
+     */
+    bool send(const char *message, std::size_t length) {
+      constexpr std::size_t PrefixLength = sizeof(BloXrouteMessageBuilder::TransactionPrefix) - 1;
+      constexpr std::size_t SuffixLength = sizeof(BloXrouteMessageBuilder::TransactionSuffix) - 1;
+
+      iovec parts[3] = {
+        { const_cast<char*>(Node::SendRawTransactionPrefix), sizeof(Node::SendRawTransactionPrefix) - 1 },
+        { const_cast<char*>(message + PrefixLength), length - PrefixLength - SuffixLength },
+        { const_cast<char*>(Node::SendRawTransactionSuffix), sizeof(Node::SendRawTransactionSuffix) - 1 }
+      };
+
+      return write(parts, 3);
+    }
+
+    /**
+     * @brief Reads messages until the connection is closed by either side.
+     *
+     * @param onMessage called as onMessage(const char *message, std::size_t length) for every message (null-terminated)
+     * @param onIdle called when there is no message for the idle time
+     * @return number of received messages
+     */
+    template<typename OnMessage, typename OnIdle>
+    std::size_t run(OnMessage onMessage, OnIdle onIdle) {
+      std::size_t filled = 0, received = 0;
+      bool skipping = false;
+
+      while(running.load(std::memory_order_relaxed)) {
+        ssize_t count = recv(fd, buffer + filled, BufferSize - 1 - filled, 0);
+        if(count == 0) break;
+        if(count < 0) {
+          if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            onIdle();
+            continue;
+          }
+          break;
+        }
+
+        // Only the received part has to be scanned, the kept one has no newline
+        char *lineStart = buffer;
+        char *scanStart = buffer + filled;
+        filled += count;
+
+        char *newline;
+        while(running.load(std::memory_order_relaxed) && (newline = static_cast<char*>(memchr(scanStart, '\n', buffer + filled - scanStart))) != nullptr) {
+          *newline = '\0';
+          if(!skipping) {
+            onMessage(static_cast<const char*>(lineStart), static_cast<std::size_t>(newline - lineStart));
+            ++received;
+          }
+
+          skipping = false;
+          lineStart = scanStart = newline + 1;
+        }
+
+        filled = buffer + filled - lineStart;
+        if(lineStart != buffer) memmove(buffer, lineStart, filled);
+
+        // Message does not fit, skip it up to the next newline
+        if(filled == BufferSize - 1) {
+          skipping = true;
+          filled = 0;
+        }
+      }
+
+      running.store(false);
+      return received;
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Heartbeat of the feed connection: timestamped pings, round trip times of their pongs and degradation of the connection.
+ *
+ * Ping payload carries its sequence number and send time, so pongs are matched without lookup and stale ones are told apart.
+ * Times are given by the caller (Pipeline::now, steady clock nanoseconds). Single-threaded, driven by the feed loop.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#heartbeat
+ */
+namespace Heartbeat {
+  /**
+   * @brief Ping payload length: sequence number and send time.
+   */
+  inline constexpr std::size_t PayloadLength = 16;
+
+  /**
+   * @brief Round trip monitor of a single connection.
+   *
+   * @tparam Window number of latest round trips the degradation is judged on (and of pings tracked in flight)
+   */
+  template<std::size_t Window>
+  class Monitor {
+    static_assert(Window != 0, "Window must not be empty");
+
+    std::uint64_t pongTimeout = 0;
+    std::uint64_t maxRoundTrip = 0;
+    unsigned maxLost = 0;
+
+    std::uint64_t sent = 0;      // sequence number of the last ping
+    std::uint64_t answered = 0;  // sequence number of the last ping answered (or given up on)
+    std::uint64_t sendTimes[Window] {};
+    unsigned lost = 0;           // consecutive pings not answered in time
+
+    std::uint64_t roundTrips[Window] {};
+    std::size_t samples = 0;
+
+    public:
+
+    /**
+     * @brief Starts monitoring of a new connection, previous round trips are dropped.
+     *
+     * @param pongTimeoutNanoseconds time after which unanswered ping counts as lost
+     * @param maxRoundTripNanoseconds median round trip over full window above which the connection is degraded
+     * @param maxLostPongs consecutive lost pings after which the connection is degraded
+     */
+    void reset(std::uint64_t pongTimeoutNanoseconds, std::uint64_t maxRoundTripNanoseconds, unsigned maxLostPongs) {
+      pongTimeout = pongTimeoutNanoseconds;
+      maxRoundTrip = maxRoundTripNanoseconds;
+      maxLost = maxLostPongs;
+      sent = answered = 0;
+      lost = 0;
+      samples = 0;
+    }
+
+    /**
+     * @brief Builds payload of the next ping. Pings left unanswered for the pong timeout are counted as lost first.
+     *
+     * @param now current time (nanoseconds)
+     * @param payload output payload, PayloadLength bytes
+     * @return payload length
+     */
+    std::size_t ping(std::uint64_t now, char *payload) {
+      // Only Window pings are tracked in flight, older ones are given up on
+      while(answered != sent && (sent - answered >= Window || now - sendTimes[(answered + 1) % Window] >= pongTimeout)) {
+        ++answered;
+        ++lost;
+      }
+
+      ++sent;
+      sendTimes[sent % Window] = now;
+      memcpy(payload, &sent, 8);
+      memcpy(payload + 8, &now, 8);
+      return PayloadLength;
+    }
+
+    /**
+     * @brief Takes pong of the ping sent before. Pongs of other pings (lost, repeated or with foreign payload) are ignored.
+     *
+     * @param payload input pong payload
+     * @param length input pong payload length
+     * @param now current time (nanoseconds)
+     * @param roundTrip output round trip of the ping (nanoseconds)
+     * @return false if the pong is ignored
+     */
+    bool pong(const char *payload, std::size_t length, std::uint64_t now, std::uint64_t &roundTrip) {
+      if(length != PayloadLength) return false;
+
+      std::uint64_t sequence, sendTime;
+      memcpy(&sequence, payload, 8);
+      memcpy(&sendTime, payload + 8, 8);
+      if(sequence <= answered || sequence > sent || sendTimes[sequence % Window] != sendTime) return false;
+
+      answered = sequence;
+      lost = 0;
+      roundTrip = now - sendTime;
+      roundTrips[samples++ % Window] = roundTrip;
+      return true;
+    }
+
+    /**
+     * @brief Returns median of the latest round trips (nanoseconds), 0 if there are none.
+     */
+    std::uint64_t median() const {
+      std::size_t count = std::min(samples, Window);
+      if(count == 0) return 0;
+
+      std::uint64_t sorted[Window];
+      std::copy(roundTrips, roundTrips + count, sorted);
+      std::nth_element(sorted, sorted + count / 2, sorted + count);
+      return sorted[count / 2];
+    }
+
+    /**
+     * @brief Returns number of consecutive lost pings.
+     */
+    unsigned getLost() const {
+      return lost;
+    }
+
+    /**
+     * @brief Returns number of round trips measured since reset.
+     */
+    std::size_t getSamples() const {
+      return samples;
+    }
+
+    /**
+     * @brief Checks if too many pings in a row were lost, or the median round trip over full window is too long.
+     */
+    bool isDegraded() const {
+      return (maxLost != 0 && lost >= maxLost) || (maxRoundTrip != 0 && samples >= Window && median() > maxRoundTrip);
+    }
+  };
+
+  /**
+   * @brief Endpoints the connection moves between, picking the one with the shortest round trip measured on it.
+   *
+   * @tparam Count number of endpoints
+   */
+  template<std::size_t Count>
+  class Endpoints {
+    static_assert(Count != 0, "There must be at least one endpoint");
+
+    /**
+     * @brief Median round trip measured when the endpoint was left (nanoseconds), 0 if never measured.
+     */
+    std::uint64_t roundTrips[Count] {};
+    std::size_t current = 0;
+
+    public:
+
+    std::size_t getCurrent() const {
+      return current;
+    }
+
+    /**
+     * @brief Leaves current endpoint and picks the next one: not yet measured ones first (in order), then the one with
+     * the shortest round trip. Current endpoint is picked again only if it is the only one.
+     *
+     * @param roundTrip median round trip measured on current endpoint (nanoseconds), UINT64_MAX if pongs were lost
+     * @return index of the picked endpoint
+     */
+    std::size_t next(std::uint64_t roundTrip) {
+      roundTrips[current] = std::max<std::uint64_t>(roundTrip, 1);
+      if(Count == 1) return current;
+
+      std::size_t best = (current + 1) % Count;
+      for(std::size_t offset = 2; offset < Count; offset++) {
+        std::size_t candidate = (current + offset) % Count;
+        if(roundTrips[candidate] < roundTrips[best]) best = candidate;
+      }
+
+      current = best;
+      return current;
+    }
+  };
+}
\ No newline at end of file
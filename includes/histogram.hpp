@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Histogram of gas prices observed on the stream.
+ *
+ * Open addressing hash table with linear probing, it never rehashes and silently drops
+ * new gas prices when full. Recording is meant for a single thread (event loop),
+ * other threads may read it concurrently, hence relaxed atomics.
+ *
+ * @tparam Capacity maximum number of distinct gas prices, must be power of two
+ */
+template<std::size_t Capacity>
+class GasPriceHistogram {
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of two");
+
+  /**
+   * @brief Stored keys are gas prices incremented by one, so zero marks empty slot.
+   */
+  std::atomic<std::uint64_t> keys[Capacity] = {};
+  std::atomic<std::uint64_t> counts[Capacity] = {};
+  std::atomic<std::uint64_t> total { 0 };
+  std::atomic<std::size_t> distinct { 0 };
+
+  /**
+   * @brief Fibonacci hashing of gas price to slot.
+   */
+  static std::size_t hash(std::uint64_t key) {
+    return (key * 0x9E3779B97F4A7C15ULL) >> (64 - __builtin_ctzll(Capacity));
+  }
+
+  public:
+
+  /**
+   * @brief Records observed gas price.
+   *
+   * @param gasPrice gas price (wei)
+   * @param count number of observations
+   * @return false if histogram is full and gas price was not recorded
+   */
+  bool record(std::uint64_t gasPrice, std::uint64_t count = 1) {
+    std::uint64_t key = gasPrice + 1;
+
+    for(std::size_t i = hash(key), probes = 0; probes < Capacity; i = (i + 1) & (Capacity - 1), probes++) {
+      std::uint64_t slotKey = keys[i].load(std::memory_order_relaxed);
+
+      if(slotKey == 0) {
+        keys[i].store(key, std::memory_order_relaxed);
+        distinct.fetch_add(1, std::memory_order_relaxed);
+        slotKey = key;
+      }
+
+      if(slotKey == key) {
+        counts[i].fetch_add(count, std::memory_order_relaxed);
+        total.fetch_add(count, std::memory_order_relaxed);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Returns number of times given gas price was observed.
+   */
+  std::uint64_t count(std::uint64_t gasPrice) const {
+    std::uint64_t key = gasPrice + 1;
+
+    for(std::size_t i = hash(key), probes = 0; probes < Capacity; i = (i + 1) & (Capacity - 1), probes++) {
+      std::uint64_t slotKey = keys[i].load(std::memory_order_relaxed);
+      if(slotKey == 0) return 0;
+      if(slotKey == key) return counts[i].load(std::memory_order_relaxed);
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Returns total number of observations.
+   */
+  std::uint64_t samples() const {
+    return total.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns number of distinct observed gas prices.
+   */
+  std::size_t size() const {
+    return distinct.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns the most frequently observed gas prices with their counts, most frequent first.
+   *
+   * @param limit maximum number of returned gas prices
+   * @return pairs of gas price and count
+   */
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> top(std::size_t limit) const {
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> result;
+    result.reserve(size());
+
+    for(std::size_t i = 0; i < Capacity; i++) {
+      std::uint64_t key = keys[i].load(std::memory_order_relaxed);
+      if(key != 0) result.emplace_back(key - 1, counts[i].load(std::memory_order_relaxed));
+    }
+
+    limit = std::min(limit, result.size());
+    std::partial_sort(result.begin(), result.begin() + limit, result.end(), [](const auto &a, const auto &b) {
+      return a.second > b.second || (a.second == b.second && a.first < b.first);
+    });
+    result.resize(limit);
+
+    return result;
+  }
+
+  /**
+   * @brief Saves histogram as text file, one "gasPrice count" pair per line.
+   *
+   * @param path output file path
+   * @return false if file could not be written
+   */
+  bool save(const char *path) const {
+    FILE *file = fopen(path, "w");
+    if(file == nullptr) return false;
+
+    for(std::size_t i = 0; i < Capacity; i++) {
+      std::uint64_t key = keys[i].load(std::memory_order_relaxed);
+      if(key != 0) fprintf(file, "%" PRIu64 " %" PRIu64 "\n", key - 1, counts[i].load(std::memory_order_relaxed));
+    }
+
+    return fclose(file) == 0;
+  }
+
+  /**
+   * @brief Loads histogram saved by save(), adding counts to already recorded ones.
+   *
+   * @param path input file path
+   * @return false if file could not be read
+   */
+  bool load(const char *path) {
+    FILE *file = fopen(path, "r");
+    if(file == nullptr) return false;
+
+    std::uint64_t gasPrice, count;
+    while(fscanf(file, "%" SCNu64 " %" SCNu64, &gasPrice, &count) == 2) {
+      record(gasPrice, count);
+    }
+
+    fclose(file);
+    return true;
+  }
+};
+
+/**
+ * @brief Distributes fixed signature budget over gas prices.
+ *
+ * Observed gas prices are taken first, most frequent first (up to the budget),
+ * the rest of the budget is spread uniformly over [from, to] range.
+ *
+ * @param histogram observed gas prices
+ * @param budget number of gas prices to return
+ * @param from lower bound of uniform range (wei)
+ * @param to upper bound of uniform range (wei)
+ * @return gas prices to pregenerate, may contain duplicates
+ */
+template<std::size_t Capacity>
+std::vector<std::uint64_t> allocateGasPrices(const GasPriceHistogram<Capacity> &histogram, std::size_t budget, std::uint64_t from, std::uint64_t to) {
+  std::vector<std::uint64_t> result;
+  result.reserve(budget);
+
+  for(const auto &[gasPrice, count] : histogram.top(budget)) {
+    result.push_back(gasPrice);
+  }
+
+  std::size_t remaining = budget - result.size();
+  for(std::size_t i = 0; i < remaining; i++) {
+    result.push_back(remaining == 1 ? from : from + (to - from) * i / (remaining - 1));
+  }
+
+  return result;
+}
\ No newline at end of file
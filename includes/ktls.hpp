@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+
+#include <sys/socket.h>
+
+#include <openssl/bio.h>
+#include <openssl/ssl.h>
+
+/**
+ * @brief TLS client session: handshake in OpenSSL, then record encryption of sends moved to the kernel (kTLS TX).
+ *
+ * Once offloaded, plaintext written to the socket is encrypted by the kernel, so sending a frame is a plain write
+ * (or io_uring write) with no user-space crypto nor copy. Received records are still decrypted by OpenSSL: the caller
+ * reads them from the socket and feeds them in, so session tickets and alerts stay handled by OpenSSL.
+ * Like the websocketpp TLS setup (onTLSInit), the server certificate is not verified.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#kernel-tls
+ */
+namespace KernelTLS {
+  /**
+   * @brief Outcome of the handshake.
+   */
+  enum class Status {
+    Offloaded,    // handshake done, sends are encrypted by the kernel
+    Unavailable,  // handshake done, but kernel TLS is not available (no tls module, OpenSSL without kTLS, unsupported cipher)
+    Failed        // handshake failed
+  };
+
+  /**
+   * @brief Cipher suites offered first, the ones kernel TLS supports.
+   */
+  inline constexpr char CipherSuites[] = "TLS_AES_128_GCM_SHA256:TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256";
+  inline constexpr char CipherList[] = "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-RSA-AES256-GCM-SHA384";
+
+  class Session {
+    SSL_CTX *context = nullptr;
+    SSL *ssl = nullptr;
+
+    /**
+     * @brief Memory BIO the received records are fed into, owned by ssl.
+     */
+    BIO *input = nullptr;
+
+    public:
+
+    Session() = default;
+    Session(const Session&) = delete;
+    Session &operator=(const Session&) = delete;
+
+    ~Session() {
+      close();
+    }
+
+    /**
+     * @brief Frees the session, the socket is left open.
+     */
+    void close() {
+      if(ssl != nullptr) SSL_free(ssl);
+      if(context != nullptr) SSL_CTX_free(context);
+
+      ssl = nullptr;
+      context = nullptr;
+      input = nullptr;
+    }
+
+    bool isOpen() const {
+      return ssl != nullptr;
+    }
+
+    /**
+     * @brief Makes the handshake over connected blocking socket and offloads sends to the kernel.
+     *
+     * @param fd connected socket
+     * @param serverName server name sent in SNI
+     * @return handshake outcome
+     */
+    Status connect(int fd, const char *serverName) {
+      close();
+
+      context = SSL_CTX_new(TLS_client_method());
+      if(context == nullptr) return Status::Failed;
+
+      #ifdef SSL_OP_ENABLE_KTLS
+        SSL_CTX_set_options(context, SSL_OP_ENABLE_KTLS);
+      #endif
+      SSL_CTX_set_verify(context, SSL_VERIFY_NONE, nullptr);
+      SSL_CTX_set_ciphersuites(context, CipherSuites);
+      SSL_CTX_set_cipher_list(context, CipherList);
+
+      ssl = SSL_new(context);
+      if(ssl == nullptr) return Status::Failed;
+
+      // Records are written to the socket (where kernel TLS is enabled), but read through memory,
+      // so receiving never moves to the kernel and stays the caller's read
+      BIO *output = BIO_new_socket(fd, BIO_NOCLOSE);
+      input = BIO_new(BIO_s_mem());
+      if(output == nullptr || input == nullptr) {
+        BIO_free(output);
+        BIO_free(input);
+        input = nullptr;
+        return Status::Failed;
+      }
+
+      SSL_set_bio(ssl, input, output);
+      SSL_set_tlsext_host_name(ssl, serverName);
+
+      while(true) {
+        int result = SSL_connect(ssl);
+        if(result == 1) break;
+        if(SSL_get_error(ssl, result) != SSL_ERROR_WANT_READ) return Status::Failed;
+
+        char buffer[4096];
+        ssize_t count = recv(fd, buffer, sizeof(buffer), 0);
+        if(count <= 0 || BIO_write(input, buffer, count) != count) return Status::Failed;
+      }
+
+      return BIO_get_ktls_send(output) ? Status::Offloaded : Status::Unavailable;
+    }
+
+    /**
+     * @brief Feeds received records in and decrypts what is complete, as much as fits the output.
+     *
+     * @param records input received records, nullptr to continue with the ones fed before (see hasPending)
+     * @param length input received records length
+     * @param output output plaintext
+     * @param outputSize size of output buffer
+     * @param decrypted output plaintext length
+     * @return false if the session failed or was closed by the server (and nothing was decrypted)
+     */
+    bool decrypt(const char *records, std::size_t length, char *output, std::size_t outputSize, std::size_t &decrypted) {
+      decrypted = 0;
+      if(length != 0 && BIO_write(input, records, length) != static_cast<int>(length)) return false;
+
+      while(decrypted < outputSize) {
+        int count = SSL_read(ssl, output + decrypted, static_cast<int>(std::min<std::size_t>(outputSize - decrypted, INT_MAX)));
+        if(count > 0) {
+          decrypted += count;
+          continue;
+        }
+
+        if(SSL_get_error(ssl, count) == SSL_ERROR_WANT_READ) break;
+        return decrypted != 0;
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Checks if there is fed data left to decrypt (output was full).
+     */
+    bool hasPending() const {
+      return SSL_pending(ssl) > 0 || BIO_ctrl_pending(input) > 0;
+    }
+  };
+}
\ No newline at end of file
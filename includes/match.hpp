@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "config.hpp"
+#include "bot.hpp"
+#include "uint256.hpp"
+#include "uniswap.hpp"
+#include "pregen.hpp"
+#include "pipeline.hpp"
+#include "telemetry.hpp"
+#include "transaction.hpp"
+#include "warm.hpp"
+
+/**
+ * @brief Match-and-send path of liquidity adds of the target token, shared by the bot and its allocation guard.
+ *
+ * Parses the fees of validated liquidity add, runs it through filter rules and sends transactions
+ * from the first armed wallets back-to-back: pregenerated ones first, misses are signed in the pipeline, by the signer process
+ * or on demand. Feed, shared pregenerated transactions, rules and signers are reached through the sender.
+ * Logging, exit positions and cancel tables are left to the caller, after everything was sent.
+ *
+ * Sender has to provide:
+ * - bool accepts(const char *message, const Warm::Fees &fees) - filter rules verdict
+ * - void send(const char *message, std::size_t length) - sends signed transaction
+ * - bool isShared() - pregenerated transactions are read from shared memory
+ * - std::size_t readShared(std::size_t walletIndex, std::uint64_t gasPrice, char *output, std::uint64_t &pregenGasPrice) - shared pregenerated transaction, zero if none
+ * - bool offload(Pipeline::SignRequest &request, char *output, std::size_t &length, Outcome &outcome) - hands request to the signers,
+ *   false if it has to be signed on demand (only called if Pipeline or Signer is enabled)
+ */
+namespace Match {
+  /**
+   * @brief How transaction of claimed wallet was sent.
+   */
+  enum class Outcome { Pregenerated, Signed, Queued, Failed };
+
+  /**
+   * @brief Result of matching the message.
+   */
+  enum class Status { Invalid, FeeTooLong, Filtered, Matched };
+
+  /**
+   * @brief Transaction sent from claimed wallet.
+   */
+  struct Sent {
+    std::size_t wallet;
+    const char *message;  // nullptr if queued or failed
+    std::uint64_t gasPrice;
+    std::uint64_t maxPriorityFeePerGas;
+    Outcome outcome;
+  };
+
+  /**
+   * @brief Transactions sent for matched message.
+   *
+   * @tparam Capacity maximum number of wallets sending
+   */
+  template<std::size_t Capacity>
+  struct Result {
+    Warm::Fees fees;
+    std::uint64_t receivedAt = 0;
+    Sent sent[Capacity];
+    std::size_t count = 0;
+  };
+
+  /**
+   * @brief Extracts liquidity of addLiquidityETH from the message.
+   *
+   * @param message input message
+   * @param liquidityETH output ETH liquidity
+   * @param liquidityToken output token liquidity
+   * @return false if amounts are not hexadecimal
+   */
+  inline bool extractLiquidity(const char *message, UInt256 &liquidityETH, UInt256 &liquidityToken) {
+    char amountTokenDesiredStr[65];
+    char liquidityValueStr[Config::Size::TransactionQuantityBuffer * 2 + 1];
+
+    std::size_t amountTokenDesiredStrLength = BloXrouteMessageParser::extractAmountTokenDesired(message, amountTokenDesiredStr);
+    std::size_t liquidityValueStrLength = BloXrouteMessageParser::extractLiquidityETH(message, liquidityValueStr);
+
+    return
+         UInt256::tryFromHexString(liquidityValueStr, liquidityValueStrLength, liquidityETH)
+      && UInt256::tryFromHexString(amountTokenDesiredStr, amountTokenDesiredStrLength, liquidityToken);
+  }
+
+  /**
+   * @brief Calculates amountOutMin of the swap from liquidity added by the message.
+   * Keeps the configured minimum if the liquidity cannot be priced.
+   *
+   * @param value swapped ETH value
+   * @param message input message
+   * @param amountOutMin output 32 bytes buffer
+   */
+  inline void calculateAmountOutMin(const UInt256 &value, const char *message, Utils::Buffer amountOutMin) {
+    UInt256 liquidityETH, liquidityToken;
+
+    // Amounts failed to parse or are zero, the swap cannot be priced so the configured minimum is kept
+    if(!extractLiquidity(message, liquidityETH, liquidityToken) || !UniswapV2::hasReserves(liquidityETH, liquidityToken)) {
+      static const UInt256 configured = UInt256::fromHexString(Config::Transaction::SwapExactETHForTokens::AmountOutMin);
+      configured.toBuffer(amountOutMin);
+      return;
+    }
+
+    UniswapV2::getAmountOutMin(value, liquidityETH, liquidityToken, Config::Transaction::SwapExactETHForTokens::SlippageBasisPoints).toBuffer(amountOutMin);
+  }
+
+  template<typename TelemetryType>
+  inline void countPregenHit(TelemetryType &telemetry, std::uint64_t sentGasPrice, std::uint64_t observedGasPrice) {
+    telemetry.count(Telemetry::PregenHit);
+    telemetry.record(Telemetry::HitOverpay, sentGasPrice > observedGasPrice ? sentGasPrice - observedGasPrice : 0);
+  }
+
+  /**
+   * @brief Matches the message against the target token and sends transactions from the first armed wallets.
+   * Pregenerated stores of local pregenerated hits stay acquired (sent messages point into them) until release() is called.
+   *
+   * @param message input message
+   * @param targetToken target token address hexadecimal c-string (lowercase, without 0x prefix)
+   * @param wallets wallets array
+   * @param walletsCount number of wallets
+   * @param lookups pregenerated transactions are valid for the target, false signs everything
+   * @param sender sender (see namespace description)
+   * @param telemetry telemetry metrics
+   * @param result output sent transactions
+   * @return status of the match, transactions are sent only if Matched
+   */
+  template<typename WalletType, typename SenderType, typename TelemetryType, std::size_t Capacity>
+  inline Status process(
+    const char *message, const char *targetToken, WalletType *wallets, std::size_t walletsCount, bool lookups,
+    SenderType &sender, TelemetryType &telemetry, Result<Capacity> &result
+  ) {
+    if(!BloXrouteMessageParser::validateTransaction(message, targetToken)) {
+      telemetry.count(Telemetry::Invalid);
+      return Status::Invalid;
+    }
+
+    // Holds maxFeePerGas of EIP-1559 transaction
+    Warm::Fees &fees = result.fees;
+    if(!Warm::extractFees(message, fees)) {
+      telemetry.count(Telemetry::FeeTooLong);
+      return Status::FeeTooLong;
+    }
+
+    result.receivedAt = Pipeline::now();
+    result.count = 0;
+
+    // Liquidity adds of the target rejected by its rules are dropped
+    if(!sender.accepts(message, fees)) {
+      telemetry.count(Telemetry::Filtered);
+      return Status::Filtered;
+    }
+
+    for(std::size_t i = 0; i < walletsCount && result.count < Capacity; i++) {
+      WalletType &wallet = wallets[i];
+      if(!wallet.claim()) continue;
+
+      Sent &sent = result.sent[result.count++];
+      sent.wallet = i;
+      sent.gasPrice = fees.gasPrice;
+      sent.maxPriorityFeePerGas = fees.maxPriorityFeePerGas;
+
+      if constexpr (!Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin) {
+        if(!lookups) {
+          // Pregenerated transactions hold the previous target until pre-arming is done, signed on demand meanwhile
+        } else if(fees.dynamicFee) {
+          PreGen::FeeGrid::Entry pregenTx = wallet.dynamicFeeTxs.lookup(
+            fees.gasPrice, fees.maxPriorityFeePerGas,
+            Config::TransactionPreGen::Policy, Config::TransactionPreGen::MaxGasPriceBump, Config::TransactionPreGen::DynamicFee::MaxPriorityFeeBump
+          );
+
+          if(pregenTx.message != nullptr) {
+            sender.send(pregenTx.message, pregenTx.length);
+            sent.message = pregenTx.message;
+            sent.gasPrice = pregenTx.maxFeePerGas;
+            sent.maxPriorityFeePerGas = pregenTx.maxPriorityFeePerGas;
+            sent.outcome = Outcome::Pregenerated;
+            countPregenHit(telemetry, pregenTx.maxFeePerGas, fees.gasPrice);
+            continue;
+          }
+        } else if(sender.isShared()) {
+          std::uint64_t pregenGasPrice;
+          std::size_t messageLength = sender.readShared(i, fees.gasPrice, wallet.message, pregenGasPrice);
+
+          if(messageLength != 0) {
+            sender.send(wallet.message, messageLength);
+            sent.message = wallet.message;
+            sent.gasPrice = pregenGasPrice;
+            sent.outcome = Outcome::Pregenerated;
+            countPregenHit(telemetry, pregenGasPrice, fees.gasPrice);
+            continue;
+          }
+        } else if(!Config::Signer::Enabled) {
+          const auto *store = wallet.pregenTxs.acquire();
+          const auto *pregenTx = store->lookup(fees.gasPrice, Config::TransactionPreGen::Policy, Config::TransactionPreGen::MaxGasPriceBump);
+
+          if(pregenTx != nullptr) {
+            std::size_t messageLength;
+            sent.message = store->message(*pregenTx, wallet.message, messageLength);
+            sender.send(sent.message, messageLength);
+            sent.gasPrice = pregenTx->gasPrice;
+            sent.outcome = Outcome::Pregenerated;
+            countPregenHit(telemetry, pregenTx->gasPrice, fees.gasPrice);
+            continue;
+          }
+
+          wallet.pregenTxs.release();
+        }
+
+        // Nothing pregenerated within policy, falls back to signing
+        if(fees.dynamicFee || sender.isShared() || !Config::Signer::Enabled) {
+          telemetry.count(Telemetry::PregenMiss);
+          telemetry.record(Telemetry::MissedGasPrice, fees.gasPrice);
+          if(fees.dynamicFee) telemetry.record(Telemetry::MissedPriorityFee, fees.maxPriorityFeePerGas);
+        }
+      }
+
+      Utils::Byte amountOutMin[32] = {};
+      if constexpr (Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin) {
+        calculateAmountOutMin(wallet.value, message, amountOutMin);
+      }
+
+      if constexpr (Config::Pipeline::Enabled || Config::Signer::Enabled) {
+        Pipeline::SignRequest request;
+        request.wallet = i;
+        request.nonce = wallet.getNonce();
+        request.gasPrice = fees.gasPrice;
+        request.dynamicFee = fees.dynamicFee;
+        request.maxPriorityFeePerGas = fees.maxPriorityFeePerGas;
+        request.patchAmountOutMin = Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin;
+        memcpy(request.amountOutMin, amountOutMin, 32);
+        request.receivedAt = result.receivedAt;
+
+        std::size_t messageLength = 0;
+        if(sender.offload(request, wallet.message, messageLength, sent.outcome)) {
+          if(sent.outcome == Outcome::Signed) sender.send(wallet.message, messageLength);
+
+          sent.message = sent.outcome == Outcome::Signed ? wallet.message : nullptr;
+          telemetry.count(
+            sent.outcome == Outcome::Queued ? Telemetry::Queued :
+            sent.outcome == Outcome::Signed ? Telemetry::RemoteSigned : Telemetry::SignerTimeout
+          );
+          continue;
+        }
+      }
+
+      if constexpr (Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin) {
+        wallet.tx.patchField(Transaction::Field::Data, TransactionDataBuilder::AmountOutMinOffset, amountOutMin, 32);
+      }
+
+      std::size_t messageLength = fees.dynamicFee
+        ? PreGen::generatePrepared(wallet.tx, wallet.privateKey, fees.gasPrice, fees.maxPriorityFeePerGas, wallet.message)
+        : PreGen::generatePrepared(wallet.tx, wallet.privateKey, fees.gasPrice, wallet.message);
+
+      sender.send(wallet.message, messageLength);
+      telemetry.count(Telemetry::Signed);
+      sent.message = wallet.message;
+      sent.outcome = Outcome::Signed;
+    }
+
+    if(result.count == 0) telemetry.count(Telemetry::NoArmedWallet);
+    return Status::Matched;
+  }
+
+  /**
+   * @brief Releases pregenerated stores held by local pregenerated hits of the result, so they can be rebuilt.
+   *
+   * @param wallets wallets array
+   * @param result sent transactions
+   * @param shared pregenerated transactions were read from shared memory
+   */
+  template<typename WalletType, std::size_t Capacity>
+  inline void release(WalletType *wallets, const Result<Capacity> &result, bool shared) {
+    if(result.fees.dynamicFee || shared) return;
+
+    for(std::size_t i = 0; i < result.count; i++) {
+      if(result.sent[i].outcome == Outcome::Pregenerated) wallets[result.sent[i].wallet].pregenTxs.release();
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief NUMA placement over sysfs and raw memory policy system calls (no libnuma).
+ *
+ * Node of the NIC is read from sysfs. Threads are pinned to its CPUs and their allocations prefer its memory,
+ * memory touched before (static objects) is migrated. Everything is best effort: on unknown node (virtual interface,
+ * single-node machine) or failed system call the placement is left to the kernel.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#numa-placement
+ */
+namespace Numa {
+  /**
+   * @brief Node of interface which is not attached to any (or could not be read).
+   */
+  inline constexpr int UnknownNode = -1;
+
+  /**
+   * @brief Number of nodes covered by node masks.
+   */
+  inline constexpr std::size_t MaxNodes = 1024;
+
+  /**
+   * @brief Node mask of memory policy system calls.
+   */
+  struct NodeMask {
+    unsigned long bits[MaxNodes / (8 * sizeof(unsigned long))] = {};
+
+    explicit NodeMask(int node) {
+      bits[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+    }
+
+    /**
+     * @brief Returns maxnode argument, kernel reads one bit less than given.
+     */
+    static constexpr unsigned long size() {
+      return MaxNodes + 1;
+    }
+  };
+
+  /**
+   * @brief Parses list in sysfs format (eg. "0-3,8,10-11").
+   *
+   * @param list input list c-string, may end with new line
+   * @param output output values, appended in order
+   * @return false if list is malformed
+   */
+  inline bool parseList(const char *list, std::vector<int> &output) {
+    const char *position = list;
+    while(*position != '\0' && *position != '\n') {
+      char *end;
+      long first = strtol(position, &end, 10);
+      if(end == position || first < 0) return false;
+
+      long last = first;
+      if(*end == '-') {
+        position = end + 1;
+        last = strtol(position, &end, 10);
+        if(end == position || last < first) return false;
+      }
+
+      for(long value = first; value <= last; value++) output.push_back(static_cast<int>(value));
+
+      if(*end == ',') end++;
+      else if(*end != '\0' && *end != '\n') return false;
+      position = end;
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Formats values in sysfs list format, consecutive ones as ranges.
+   *
+   * @param values input values, ascending
+   * @return list string
+   */
+  inline std::string formatList(const std::vector<int> &values) {
+    std::string list;
+    for(std::size_t i = 0; i < values.size(); i++) {
+      std::size_t last = i;
+      while(last + 1 < values.size() && values[last + 1] == values[last] + 1) last++;
+
+      if(!list.empty()) list += ',';
+      list += std::to_string(values[i]);
+      if(last != i) list += '-' + std::to_string(values[last]);
+      i = last;
+    }
+    return list;
+  }
+
+  /**
+   * @brief Reads the first line of the file.
+   *
+   * @param path input file path
+   * @param output output line, without new line
+   * @param size output buffer size
+   * @return false if file could not be read
+   */
+  inline bool readLine(const char *path, char *output, std::size_t size) {
+    FILE *file = fopen(path, "r");
+    if(file == nullptr) return false;
+
+    bool read = fgets(output, size, file) != nullptr;
+    fclose(file);
+    if(read) output[strcspn(output, "\n")] = '\0';
+    return read;
+  }
+
+  /**
+   * @brief Returns interface of the default IPv4 route, the one the feed is most likely reached through.
+   *
+   * @param routePath routing table path
+   * @return interface name, empty if there is no default route
+   */
+  inline std::string defaultInterface(const char *routePath = "/proc/net/route") {
+    FILE *file = fopen(routePath, "r");
+    if(file == nullptr) return "";
+
+    char line[256], interface[64];
+    unsigned long destination, mask;
+    std::string result;
+
+    // Header line first, then: interface, destination, gateway, flags, reference count, use, metric, mask
+    if(fgets(line, sizeof(line), file) != nullptr) {
+      while(fgets(line, sizeof(line), file) != nullptr) {
+        if(sscanf(line, "%63s %lx %*x %*x %*d %*d %*d %lx", interface, &destination, &mask) == 3 && destination == 0 && mask == 0) {
+          result = interface;
+          break;
+        }
+      }
+    }
+
+    fclose(file);
+    return result;
+  }
+
+  /**
+   * @brief Returns NUMA node the network interface is attached to.
+   *
+   * @param interface interface name
+   * @param netPath network interfaces sysfs path
+   * @return node index, UnknownNode for virtual interfaces and machines without NUMA
+   */
+  inline int interfaceNode(const char *interface, const char *netPath = "/sys/class/net") {
+    std::string path = std::string(netPath) + "/" + interface + "/device/numa_node";
+    char line[32];
+    if(!readLine(path.c_str(), line, sizeof(line))) return UnknownNode;
+
+    int node = atoi(line);
+    return node >= 0 && static_cast<std::size_t>(node) < MaxNodes ? node : UnknownNode;
+  }
+
+  /**
+   * @brief Returns CPUs of the node.
+   *
+   * @param node node index
+   * @param nodePath nodes sysfs path
+   * @return CPU indices, empty if the node is unknown
+   */
+  inline std::vector<int> nodeCpus(int node, const char *nodePath = "/sys/devices/system/node") {
+    std::vector<int> cpus;
+    if(node < 0) return cpus;
+
+    std::string path = std::string(nodePath) + "/node" + std::to_string(node) + "/cpulist";
+    char line[4096];
+    if(!readLine(path.c_str(), line, sizeof(line)) || !parseList(line, cpus)) cpus.clear();
+    return cpus;
+  }
+
+  /**
+   * @brief Pins calling thread to given CPUs (threads it creates inherit them).
+   *
+   * @param cpus CPU indices, empty disables pinning
+   * @return false if thread could not be pinned
+   */
+  inline bool pinThread(const std::vector<int> &cpus) {
+    if(cpus.empty()) return true;
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for(int cpu : cpus) CPU_SET(cpu, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+  }
+
+  /**
+   * @brief Makes pages the calling thread touches from now on prefer memory of the node (falling back to other nodes when it is full).
+   * Threads it creates inherit the policy.
+   *
+   * @param node node index, UnknownNode disables placement
+   * @return false if policy could not be set
+   */
+  inline bool preferNode(int node) {
+    if(node < 0) return true;
+
+    NodeMask mask(node);
+    return syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.bits, NodeMask::size()) == 0;
+  }
+
+  /**
+   * @brief Makes pages the calling thread touches from now on allocated on the node it runs on (default policy).
+   *
+   * @return false if policy could not be set
+   */
+  inline bool preferLocal() {
+    return syscall(SYS_set_mempolicy, MPOL_LOCAL, nullptr, 0) == 0;
+  }
+
+  /**
+   * @brief Makes memory range prefer the node, pages already touched are migrated.
+   *
+   * @param address start of the range, rounded down to page
+   * @param length length of the range (bytes)
+   * @param node node index, UnknownNode disables placement
+   * @return false if range could not be bound or some pages could not be migrated
+   */
+  inline bool moveMemory(const void *address, std::size_t length, int node) {
+    if(node < 0 || length == 0) return true;
+
+    std::uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+    std::uintptr_t start = reinterpret_cast<std::uintptr_t>(address) & ~(pageSize - 1);
+    std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(address) + length + pageSize - 1) & ~(pageSize - 1);
+
+    NodeMask mask(node);
+    return syscall(SYS_mbind, start, end - start, MPOL_PREFERRED, mask.bits, NodeMask::size(), MPOL_MF_MOVE) == 0;
+  }
+
+  /**
+   * @brief Allocates zeroed memory on the node, pages are touched right away.
+   *
+   * @param length length (bytes)
+   * @param node node index, UnknownNode leaves placement to the kernel
+   * @return allocated memory, nullptr on failure
+   */
+  inline void *allocate(std::size_t length, int node) {
+    void *address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(address == MAP_FAILED) return nullptr;
+
+    // Policy applies to pages faulted from now on
+    if(node >= 0) {
+      NodeMask mask(node);
+      syscall(SYS_mbind, address, length, MPOL_PREFERRED, mask.bits, NodeMask::size(), 0);
+    }
+
+    memset(address, 0, length);
+    return address;
+  }
+
+  /**
+   * @brief Frees memory returned by allocate().
+   */
+  inline void release(void *address, std::size_t length) {
+    if(address != nullptr) munmap(address, length);
+  }
+
+  /**
+   * @brief Location of the NIC the feed is received on.
+   */
+  struct Topology {
+    std::string interface;
+    int node = UnknownNode;
+    std::vector<int> cpus;
+
+    /**
+     * @brief Checks if the node and its CPUs are known, so placement applies.
+     */
+    bool isKnown() const {
+      return node != UnknownNode && !cpus.empty();
+    }
+
+    /**
+     * @brief Prints topology to standard output.
+     */
+    void print() const {
+      if(isKnown()) printf("NIC %s is on NUMA node %d (CPUs %s)\n", interface.c_str(), node, formatList(cpus).c_str());
+      else printf("NUMA node of the NIC (%s) is unknown, placement is left to the kernel\n", interface.empty() ? "no default route" : interface.c_str());
+    }
+  };
+
+  /**
+   * @brief Discovers node of the NIC and its CPUs.
+   *
+   * @param interface interface name, empty for the interface of the default route
+   * @return topology, with UnknownNode if it could not be discovered
+   */
+  inline Topology discover(const char *interface) {
+    Topology topology;
+    topology.interface = interface[0] != '\0' ? interface : defaultInterface();
+    if(topology.interface.empty()) return topology;
+
+    topology.node = interfaceNode(topology.interface.c_str());
+    topology.cpus = nodeCpus(topology.node);
+    return topology;
+  }
+}
\ No newline at end of file
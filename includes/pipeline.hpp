@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "utils.hpp"
+#include "transaction.hpp"
+#include "queue.hpp"
+#include "numa.hpp"
+
+/**
+ * @brief Staged processing of matched transactions.
+ *
+ * Network thread parses and classifies messages and sends pregenerated transactions inline.
+ * Transactions which have to be signed on demand are passed over SPSC queues to the signer pool,
+ * signed messages are passed back over SPSC queues to the sender thread.
+ */
+namespace Pipeline {
+  /**
+   * @brief Returns monotonic timestamp (ns).
+   */
+  inline std::uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /**
+   * @brief Pins calling thread to given core.
+   *
+   * @param core core index, negative value disables pinning
+   * @return false if thread could not be pinned
+   */
+  inline bool pinThread(int core) {
+    if(core < 0) return true;
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+  }
+
+  /**
+   * @brief Latency of single pipeline stage, lock-free so it can be recorded by multiple threads.
+   */
+  struct StageStats {
+    std::atomic<std::uint64_t> count { 0 };
+    std::atomic<std::uint64_t> totalNs { 0 };
+    std::atomic<std::uint64_t> maxNs { 0 };
+
+    /**
+     * @brief Records time spent in the stage.
+     *
+     * @param from timestamp of entering the stage (ns)
+     * @param to timestamp of leaving the stage (ns)
+     */
+    void record(std::uint64_t from, std::uint64_t to) {
+      std::uint64_t ns = to - from;
+      count.fetch_add(1, std::memory_order_relaxed);
+      totalNs.fetch_add(ns, std::memory_order_relaxed);
+
+      std::uint64_t currentMax = maxNs.load(std::memory_order_relaxed);
+      while(ns > currentMax && !maxNs.compare_exchange_weak(currentMax, ns, std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * @brief Returns average time spent in the stage (ns).
+     */
+    std::uint64_t averageNs() const {
+      return totalNs.load(std::memory_order_relaxed) / std::max<std::uint64_t>(count.load(std::memory_order_relaxed), 1);
+    }
+
+    /**
+     * @brief Prints stage latency.
+     *
+     * @param name stage name
+     */
+    void print(const char *name) const {
+      printf(
+        "%s: %" PRIu64 " passed, average %" PRIu64 " ns, max %" PRIu64 " ns\n",
+        name, count.load(std::memory_order_relaxed), averageNs(), maxNs.load(std::memory_order_relaxed)
+      );
+    }
+  };
+
+  /**
+   * @brief Transaction to be signed on demand.
+   */
+  struct SignRequest {
+    std::size_t wallet;
+    std::uint64_t nonce;
+    std::uint64_t gasPrice; // maxFeePerGas of EIP-1559 transaction
+    bool dynamicFee;
+    std::uint64_t maxPriorityFeePerGas;
+    bool patchAmountOutMin;
+    Utils::Byte amountOutMin[32];
+    std::uint64_t receivedAt;
+    std::uint64_t queuedAt;
+  };
+
+  /**
+   * @brief Signed transaction message ready to be sent.
+   */
+  template<std::size_t MessageSize>
+  struct SignedMessage {
+    std::size_t wallet;
+    std::uint64_t gasPrice;
+    std::uint64_t receivedAt;
+    std::uint64_t signedAt;
+    std::size_t length;
+    char message[MessageSize];
+  };
+
+  /**
+   * @brief Pool of signer threads, each owning its transaction (SECP256K1 context)
+   * and a pair of SPSC queues: requests from the network thread and results to the sender thread.
+   *
+   * @tparam QueueCapacity capacity of each queue, must be power of two
+   * @tparam MessageSize maximum size of signed message
+   */
+  template<std::size_t QueueCapacity, std::size_t MessageSize>
+  class SignerPool {
+    public:
+
+    using ResultType = SignedMessage<MessageSize>;
+
+    /**
+     * @brief Time spent in the request queue.
+     */
+    StageStats queued;
+
+    /**
+     * @brief Time spent signing.
+     */
+    StageStats signing;
+
+    /**
+     * @brief Time from receiving matched message to sending signed transaction.
+     */
+    StageStats total;
+
+    private:
+
+    struct Signer {
+      SPSCQueue<SignRequest, QueueCapacity> requests;
+      SPSCQueue<ResultType, QueueCapacity> results;
+      std::thread thread;
+    };
+
+    std::unique_ptr<Signer[]> signers;
+    std::size_t signersCount = 0;
+    std::size_t nextSigner = 0;
+    std::atomic<bool> running { false };
+
+    public:
+
+    ~SignerPool() {
+      stop();
+    }
+
+    /**
+     * @brief Starts signer threads.
+     *
+     * @param threadsCount number of signer threads
+     * @param firstCore core the first signer is pinned to, next ones are pinned to consecutive cores, negative value disables pinning
+     * @param sign function signing request into the message, called as sign(Transaction&, SignRequest&, char *output), returns message length
+     * @param node NUMA node signers run on (unless pinned to cores) and allocate their signing contexts on, Numa::UnknownNode leaves it to the kernel
+     */
+    template<typename Sign>
+    void start(std::size_t threadsCount, int firstCore, Sign sign, int node = Numa::UnknownNode) {
+      signersCount = std::max<std::size_t>(threadsCount, 1);
+      signers = std::make_unique<Signer[]>(signersCount);
+      running.store(true);
+      std::vector<int> nodeCpus = Numa::nodeCpus(node);
+
+      for(std::size_t i = 0; i < signersCount; i++) {
+        Signer &signer = signers[i];
+        int core = firstCore < 0 ? -1 : firstCore + static_cast<int>(i);
+
+        signer.thread = std::thread([this, &signer, core, sign, node, nodeCpus]() {
+          if(core < 0) {
+            Numa::pinThread(nodeCpus);
+          } else {
+            pinThread(core);
+          }
+
+          // Signing context is allocated by the signer itself
+          Numa::preferNode(node);
+          Transaction tx;
+
+          SignRequest request;
+          ResultType result;
+          while(running.load(std::memory_order_relaxed)) {
+            if(!signer.requests.pop(request)) {
+              std::this_thread::yield();
+              continue;
+            }
+
+            std::uint64_t signStart = now();
+            queued.record(request.queuedAt, signStart);
+
+            result.wallet = request.wallet;
+            result.gasPrice = request.gasPrice;
+            result.receivedAt = request.receivedAt;
+            result.length = sign(tx, request, result.message);
+            result.signedAt = now();
+            signing.record(signStart, result.signedAt);
+
+            while(!signer.results.push(result)) std::this_thread::yield();
+          }
+        });
+      }
+    }
+
+    /**
+     * @brief Stops and joins signer threads.
+     */
+    void stop() {
+      running.store(false);
+      for(std::size_t i = 0; i < signersCount; i++) {
+        if(signers[i].thread.joinable()) signers[i].thread.join();
+      }
+    }
+
+    /**
+     * @brief Passes request to the next signer (round robin), called by the network thread only.
+     *
+     * @param request input request
+     * @return false if all request queues are full
+     */
+    bool submit(SignRequest request) {
+      request.queuedAt = now();
+
+      for(std::size_t i = 0; i < signersCount; i++) {
+        Signer &signer = signers[nextSigner];
+        nextSigner = (nextSigner + 1) % signersCount;
+        if(signer.requests.push(request)) return true;
+      }
+
+      return false;
+    }
+
+    /**
+     * @brief Passes all signed messages to the sender, called by the sender thread only.
+     *
+     * @param send function called with every signed message
+     * @return number of passed messages
+     */
+    template<typename Send>
+    std::size_t drain(Send send) {
+      std::size_t drained = 0;
+      ResultType result;
+
+      for(std::size_t i = 0; i < signersCount; i++) {
+        while(signers[i].results.pop(result)) {
+          send(result);
+          total.record(result.receivedAt, now());
+          drained++;
+        }
+      }
+
+      return drained;
+    }
+
+    /**
+     * @brief Returns number of requests waiting for signers.
+     */
+    std::size_t requestsDepth() const {
+      std::size_t depth = 0;
+      for(std::size_t i = 0; i < signersCount; i++) depth += signers[i].requests.size();
+      return depth;
+    }
+
+    /**
+     * @brief Returns number of signed messages waiting for the sender.
+     */
+    std::size_t resultsDepth() const {
+      std::size_t depth = 0;
+      for(std::size_t i = 0; i < signersCount; i++) depth += signers[i].results.size();
+      return depth;
+    }
+
+    /**
+     * @brief Prints queue depths and stage latencies.
+     */
+    void print() const {
+      printf("Pipeline queues: %zu requests, %zu signed messages\n", requestsDepth(), resultsDepth());
+      queued.print("Request queue");
+      signing.print("Signing");
+      total.print("Received to sent");
+    }
+  };
+}
\ No newline at end of file
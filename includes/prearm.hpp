@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+#include <strings.h>
+
+extern "C" {
+  #include <KeccakSponge.h>
+}
+
+#include "config.hpp"
+#include "utils.hpp"
+#include "rlp.hpp"
+#include "abi.hpp"
+#include "bot.hpp"
+
+/**
+ * @brief Watcher of signals preceding the liquidity add: deployment of the token contract, approve of the router
+ * by the deployer and creation of the pair. The target is pre-armed on them, so by the time liquidity is added
+ * its calldata, pregenerated transactions and warmed caches are ready and the send path is lookup only.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#pre-arming
+ */
+namespace PreArm {
+  /**
+   * @brief Signal the target is pre-armed on.
+   */
+  enum class Signal { None, Deployment, Approve, CreatePair };
+
+  /**
+   * @brief Returns name of the signal printed in logs.
+   */
+  inline const char *signalName(Signal signal) {
+    switch(signal) {
+      case Signal::Deployment: return "deployment";
+      case Signal::Approve: return "router approve";
+      case Signal::CreatePair: return "createPair";
+      default: return "none";
+    }
+  }
+
+  /**
+   * @brief Calldata templates of watched methods.
+   */
+  inline constexpr auto CreatePair = ABI::createPair();
+  inline constexpr auto Approve = ABI::approve();
+
+  /**
+   * @brief Key preceding receiver address, follows input in the message string.
+   */
+  inline constexpr char ToKey[] = "\"to\":\"0x";
+
+  /**
+   * @brief Receiver of contract creation, follows input in the message string.
+   */
+  inline constexpr char NullTo[] = "\"to\":null";
+
+  /**
+   * @brief Transaction fields included in pre-arm stream messages, stream ones and the receiver.
+   */
+  inline constexpr char Include[] = "[\"tx_contents.input\",\"tx_contents.gas_price\",\"tx_contents.value\",\"tx_contents.max_fee_per_gas\",\"tx_contents.max_priority_fee_per_gas\",\"tx_contents.from\",\"tx_contents.nonce\",\"tx_contents.to\"]";
+
+  /**
+   * @brief Calculates address of contract created by the deployer, last 20 bytes of keccak256(rlp([deployer, nonce])).
+   *
+   * @param deployerAddress deployer address hexadecimal c-string (without 0x prefix)
+   * @param nonce nonce of the creating transaction
+   * @param output output address (lowercase, without 0x prefix, null-terminated)
+   */
+  inline void contractAddress(const char *deployerAddress, std::uint64_t nonce, char *output) {
+    Utils::Byte deployer[ABI::AddressLength / 2];
+    Utils::Byte nonceBuffer[8];
+    Utils::hexStringToBuffer(deployerAddress, ABI::AddressLength, deployer);
+
+    // Zero nonce is encoded as empty item
+    RLP::Item items[2] = {
+      { deployer, sizeof(deployer) },
+      { nonceBuffer, nonce == 0 ? 0 : Utils::intToBuffer(nonce, nonceBuffer) }
+    };
+
+    Utils::Byte encoded[64];
+    std::size_t encodedLength = RLP::encodeList(items, 2, encoded);
+
+    Utils::Byte hash[32];
+    KeccakWidth1600_Sponge(1088, 512, encoded, encodedLength, 0x01, hash, 32);
+    Utils::bufferToHexString(hash + 12, 20, output, true);
+  }
+
+  /**
+   * @brief Builds subscribe message at compile time, listening for transactions of the deployer and pair creations on the factory.
+   *
+   * @param deployerAddress deployer address, empty to listen for pair creations only
+   * @param factoryAddress pair factory address
+   * @return subscribe message
+   */
+  constexpr Utils::FixedString<BloXrouteMessageBuilder::SubscribeCapacity> subscribe(const char *deployerAddress, const char *factoryAddress) {
+    Utils::FixedString<BloXrouteMessageBuilder::SubscribeCapacity> output;
+
+    output.append("{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":");
+    output.append(Include);
+    output.append(",\"filters\":\"");
+    if(deployerAddress[0] != '\0') {
+      output.append("from = 0x");
+      output.append(deployerAddress);
+      output.append(" or (");
+    }
+    output.append("to = 0x");
+    output.append(factoryAddress);
+    output.append(" and method_id = ");
+    output.append(ABI::Selector::CreatePair);
+    if(deployerAddress[0] != '\0') output.append(")");
+    output.append("\"}]}");
+
+    return output;
+  }
+
+  /**
+   * @brief Subscribe message built from Config at compile time.
+   */
+  inline constexpr auto ConfigSubscribe = subscribe(Config::PreArm::Deployer, Config::Router::Selected.Factory);
+
+  /**
+   * @brief Detects signals in the stream, read by the event loop only.
+   */
+  class Watcher {
+    char deployer[ABI::AddressLength + 1] = {};
+    const char *router = nullptr;
+    const char *wrappedNative = nullptr;
+    const char *factory = nullptr;
+
+    /**
+     * @brief Returns length of the input hex value (without 0x prefix).
+     */
+    static std::size_t inputLength(const char *message) {
+      const char *inputEnd = strchr(message + BloXrouteMessageParser::InputPosition, '\"');
+      return inputEnd == nullptr ? 0 : inputEnd - (message + BloXrouteMessageParser::InputPosition);
+    }
+
+    bool isFromDeployer(const char *message) const {
+      char from[ABI::AddressLength + 1];
+      return deployer[0] != '\0' && BloXrouteMessageParser::extractFrom(message, from) == ABI::AddressLength && strcasecmp(from, deployer) == 0;
+    }
+
+    public:
+
+    /**
+     * @brief Sets the watched deployer and the router it is listed on.
+     *
+     * @param deployerAddress deployer address (without 0x prefix), empty to watch pair creations of the target only
+     * @param definition router definition
+     */
+    void init(const char *deployerAddress, const Config::Router::Definition &definition) {
+      strncpy(deployer, deployerAddress, ABI::AddressLength);
+      deployer[ABI::AddressLength] = '\0';
+      router = definition.Address;
+      wrappedNative = definition.WrappedNative;
+      factory = definition.Factory;
+    }
+
+    /**
+     * @brief Detects signal in the message: createPair of the token and wrapped native (by the deployer, or of the target by anyone),
+     * router approve of the token by the deployer or contract creation by the deployer (token is the created contract).
+     *
+     * @param message input message
+     * @param targetTokenAddress current target token address
+     * @param token output token address the signal is about (lowercase, without 0x prefix, null-terminated)
+     * @return detected signal, None if message is not one
+     */
+    Signal detect(const char *message, const char *targetTokenAddress, char *token) const {
+      using BloXrouteMessageParser::InputPosition;
+
+      if(!BloXrouteMessageParser::isTransaction(message)) return Signal::None;
+
+      std::size_t length = inputLength(message);
+      char to[ABI::AddressLength + 1];
+      std::size_t toLength = BloXrouteMessageParser::extractField(message, ToKey, to, InputPosition + length);
+
+      if(toLength == 0) {
+        if(strstr(message + InputPosition + length, NullTo) == nullptr || !isFromDeployer(message)) return Signal::None;
+
+        char nonceStr[Config::Size::TransactionQuantityBuffer * 2 + 1];
+        std::size_t nonceStrLength = BloXrouteMessageParser::extractNonce(message, nonceStr);
+        std::uint64_t nonce = 0;
+        if(nonceStrLength == 0 || nonceStrLength > 16 || std::from_chars(nonceStr, nonceStr + nonceStrLength, nonce, 16).ec != std::errc()) return Signal::None;
+
+        contractAddress(deployer, nonce, token);
+        return Signal::Deployment;
+      }
+
+      if(toLength != ABI::AddressLength) return Signal::None;
+      const char *input = message + InputPosition;
+
+      if(length == Approve.HexLength && memcmp(input, ABI::Selector::Approve, ABI::SelectorLength) == 0) {
+        if(strncasecmp(input + Approve.addressOffset(ABI::Spender), router, ABI::AddressLength) != 0 || !isFromDeployer(message)) return Signal::None;
+
+        for(std::size_t i = 0; i <= ABI::AddressLength; i++) token[i] = static_cast<char>(tolower(to[i]));
+        return Signal::Approve;
+      }
+
+      if(length == CreatePair.HexLength && memcmp(input, ABI::Selector::CreatePair, ABI::SelectorLength) == 0) {
+        if(strncasecmp(to, factory, ABI::AddressLength) != 0) return Signal::None;
+
+        const char *tokenA = input + CreatePair.addressOffset(ABI::TokenA);
+        const char *tokenB = input + CreatePair.addressOffset(ABI::TokenB);
+        const char *pairToken;
+        if(strncasecmp(tokenA, wrappedNative, ABI::AddressLength) == 0) pairToken = tokenB;
+        else if(strncasecmp(tokenB, wrappedNative, ABI::AddressLength) == 0) pairToken = tokenA;
+        else return Signal::None;
+
+        for(std::size_t i = 0; i < ABI::AddressLength; i++) token[i] = static_cast<char>(tolower(pairToken[i]));
+        token[ABI::AddressLength] = '\0';
+
+        if(memcmp(token, targetTokenAddress, ABI::AddressLength) != 0 && !isFromDeployer(message)) return Signal::None;
+        return Signal::CreatePair;
+      }
+
+      return Signal::None;
+    }
+  };
+}
\ No newline at end of file
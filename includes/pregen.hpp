@@ -0,0 +1,1128 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include "config.hpp"
+#include "utils.hpp"
+#include "rlp.hpp"
+#include "transaction.hpp"
+#include "bot.hpp"
+#include "numa.hpp"
+
+/**
+ * @brief Storage and generation of pregenerated transaction messages.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#pregeneration
+ */
+namespace PreGen {
+  /**
+   * @brief Single pregenerated transaction message.
+   */
+  template<std::size_t MessageSize>
+  struct Entry {
+    std::uint64_t gasPrice;
+    std::size_t length;
+    char message[MessageSize];
+  };
+
+  /**
+   * @brief Sparse store of pregenerated transaction messages keyed by arbitrary gas price (wei).
+   *
+   * Gas prices are kept in a sorted array (separate from messages, so lookups stay in cache),
+   * which allows both exact lookups and finding the nearest higher gas price.
+   * Messages are appended to slots and never move.
+   *
+   * @tparam Capacity maximum number of entries
+   * @tparam MessageSize maximum size of single message
+   */
+  template<std::size_t Capacity, std::size_t MessageSize>
+  class Store {
+    public:
+
+    using EntryType = Entry<MessageSize>;
+
+    /**
+     * @brief Maximum number of entries.
+     */
+    static constexpr std::size_t MaxSize = Capacity;
+
+    private:
+
+    std::uint64_t gasPrices[Capacity];
+    std::uint32_t slots[Capacity];
+    EntryType entries[Capacity];
+    std::size_t count = 0;
+
+    /**
+     * @brief Returns position of the first gas price not lower than given one.
+     */
+    std::size_t lowerBound(std::uint64_t gasPrice) const {
+      return std::lower_bound(gasPrices, gasPrices + count, gasPrice) - gasPrices;
+    }
+
+    public:
+
+    /**
+     * @brief Returns number of stored entries.
+     */
+    std::size_t size() const {
+      return count;
+    }
+
+    /**
+     * @brief Checks if store cannot hold any more entries.
+     */
+    bool full() const {
+      return count == Capacity;
+    }
+
+    /**
+     * @brief Removes all entries.
+     */
+    void clear() {
+      count = 0;
+    }
+
+    /**
+     * @brief Inserts message for given gas price, replaces already existing one.
+     *
+     * @param gasPrice gas price (wei)
+     * @param message input message
+     * @param length input message length
+     * @return false if store is full or message does not fit
+     */
+    bool insert(std::uint64_t gasPrice, const char *message, std::size_t length) {
+      if(length >= MessageSize) return false;
+
+      std::size_t position = lowerBound(gasPrice);
+      EntryType *entry;
+
+      if(position < count && gasPrices[position] == gasPrice) {
+        entry = entries + slots[position];
+      } else {
+        if(full()) return false;
+
+        memmove(gasPrices + position + 1, gasPrices + position, (count - position) * sizeof(*gasPrices));
+        memmove(slots + position + 1, slots + position, (count - position) * sizeof(*slots));
+        gasPrices[position] = gasPrice;
+        slots[position] = count;
+        entry = entries + count;
+        ++count;
+      }
+
+      entry->gasPrice = gasPrice;
+      entry->length = length;
+      memcpy(entry->message, message, length);
+      entry->message[length] = '\0';
+
+      return true;
+    }
+
+    /**
+     * @brief Returns raw entry slot, used to fill the store from multiple threads.
+     * Entries written this way become visible after rebuildIndex().
+     *
+     * @param slot slot index, lower than Capacity
+     * @return entry slot
+     */
+    EntryType *slot(std::size_t slot) {
+      return entries + slot;
+    }
+
+    /**
+     * @brief Replaces store content with the first entry slots.
+     * Gas prices of the slots have to be unique.
+     *
+     * @param slotsCount number of filled slots
+     */
+    void rebuildIndex(std::size_t slotsCount) {
+      count = std::min(slotsCount, Capacity);
+
+      for(std::size_t i = 0; i < count; i++) slots[i] = i;
+      std::sort(slots, slots + count, [this](std::uint32_t a, std::uint32_t b) {
+        return entries[a].gasPrice < entries[b].gasPrice;
+      });
+      for(std::size_t i = 0; i < count; i++) gasPrices[i] = entries[slots[i]].gasPrice;
+    }
+
+    /**
+     * @brief Checks if there is message pregenerated for exactly given gas price.
+     */
+    bool contains(std::uint64_t gasPrice) const {
+      std::size_t position = lowerBound(gasPrice);
+      return position < count && gasPrices[position] == gasPrice;
+    }
+
+    /**
+     * @brief Finds message pregenerated for exactly given gas price.
+     * Slot index is bounded, so a read torn by a concurrent writer (shared mapping) stays within the store.
+     *
+     * @param gasPrice gas price (wei)
+     * @return found entry or nullptr
+     */
+    const EntryType *find(std::uint64_t gasPrice) const {
+      std::size_t position = lowerBound(gasPrice);
+      if(position < count && gasPrices[position] == gasPrice && slots[position] < Capacity) return entries + slots[position];
+      return nullptr;
+    }
+
+    /**
+     * @brief Finds message pregenerated for the nearest gas price at or above given one.
+     *
+     * @param gasPrice gas price (wei)
+     * @param maxBump maximum accepted difference between found and given gas price (wei)
+     * @return found entry or nullptr
+     */
+    const EntryType *findAtOrAbove(std::uint64_t gasPrice, std::uint64_t maxBump) const {
+      std::size_t position = lowerBound(gasPrice);
+      if(position < count && gasPrices[position] - gasPrice <= maxBump && slots[position] < Capacity) return entries + slots[position];
+      return nullptr;
+    }
+
+    /**
+     * @brief Finds message to send according to miss policy.
+     *
+     * @param gasPrice observed gas price (wei)
+     * @param policy what to do when there is no exact match
+     * @param maxBump maximum accepted gas price overpay for MissPolicy::NearestAbove (wei)
+     * @return found entry or nullptr if transaction has to be signed on demand
+     */
+    const EntryType *lookup(std::uint64_t gasPrice, Config::TransactionPreGen::MissPolicy policy, std::uint64_t maxBump) const {
+      if(policy == Config::TransactionPreGen::MissPolicy::NearestAbove) return findAtOrAbove(gasPrice, maxBump);
+      return find(gasPrice);
+    }
+    /**
+     * @brief Returns message of the entry, stored as is so nothing is copied.
+     *
+     * @param entry entry found in the store
+     * @param buffer unused, messages of compact store are assembled into it
+     * @param length output message length
+     * @return message
+     */
+    const char *message(const EntryType &entry, char *, std::size_t &length) const {
+      length = entry.length;
+      return entry.message;
+    }
+
+    /**
+     * @brief Copies message of the entry, length is bounded even if the entry is being overwritten.
+     *
+     * @param entry entry found in the store
+     * @param output output message
+     * @return output message length
+     */
+    std::size_t copy(const EntryType &entry, char *output) const {
+      std::size_t length = std::min<std::size_t>(entry.length, MessageSize - 1);
+      memcpy(output, entry.message, length);
+      output[length] = '\0';
+      return length;
+    }
+  };
+
+  /**
+   * @brief Parts of pregenerated legacy transaction differing between gas prices, hex encoded: list header, gas price, v, r and s.
+   */
+  struct alignas(64) Delta {
+    std::uint64_t gasPrice;
+    std::uint8_t headerLength;
+    std::uint8_t gasPriceLength;
+    std::uint8_t signatureLength;
+    char header[6];
+    char gasPriceItem[18];
+    char signature[146]; // v (chain ID up to 2^55), r and s
+  };
+
+  static_assert(sizeof(Delta) == 192, "Delta should stay 3 cache lines long");
+
+  /**
+   * @brief Store of pregenerated legacy transactions of a single nonce and transaction data, kept as one template
+   * of the constant fields (nonce, gas limit, to, value and data) and a small delta per gas price, both hex encoded.
+   *
+   * Table of 50k gas prices takes about 10 MB instead of 52 MB.
+   * Messages are assembled on send: the template is spliced with the delta into a buffer (assemble)
+   * or described by iovecs pointing into the store for writev (gather). Interface matches Store.
+   *
+   * @tparam Capacity maximum number of entries
+   */
+  template<std::size_t Capacity>
+  class CompactStore {
+    public:
+
+    using EntryType = Delta;
+
+    /**
+     * @brief Maximum number of entries.
+     */
+    static constexpr std::size_t MaxSize = Capacity;
+
+    /**
+     * @brief Number of iovecs describing a message.
+     */
+    static constexpr std::size_t GatherCount = 7;
+
+    private:
+
+    static constexpr std::size_t PrefixLength = sizeof(BloXrouteMessageBuilder::TransactionPrefix) - 1;
+    static constexpr std::size_t SuffixLength = sizeof(BloXrouteMessageBuilder::TransactionSuffix) - 1;
+
+    /**
+     * @brief Maximum length of constant fields, so the assembled message always fits Config::Size::BloXrouteTransactionMessageString.
+     */
+    static constexpr std::size_t ConstantCapacity =
+      (Config::Size::BloXrouteTransactionMessageString - 1 - PrefixLength - SuffixLength - sizeof(Delta::header) - sizeof(Delta::gasPriceItem) - sizeof(Delta::signature)) / 2;
+
+    /**
+     * @brief Offsets of transaction parts in signed transaction.
+     */
+    struct Parts {
+      std::size_t header, nonce, gasPrice, fields, signature;
+    };
+
+    std::uint64_t gasPrices[Capacity];
+    std::uint32_t slots[Capacity];
+    Delta deltas[Capacity];
+    std::size_t count = 0;
+
+    Utils::Byte constant[ConstantCapacity];
+    char constantHex[ConstantCapacity * 2 + 1];
+    std::size_t nonceLength = 0;
+    std::size_t fieldsLength = 0;
+
+    /**
+     * @brief Returns position of the first gas price not lower than given one.
+     */
+    std::size_t lowerBound(std::uint64_t gasPrice) const {
+      return std::lower_bound(gasPrices, gasPrices + count, gasPrice) - gasPrices;
+    }
+
+    /**
+     * @brief Splits signed legacy transaction into parts.
+     *
+     * @return false if transaction is malformed or parts do not fit delta
+     */
+    static bool split(Utils::Buffer transaction, std::size_t length, Parts &parts) {
+      if(length == 0 || *transaction < 0xc0) return false;
+
+      parts.header = *transaction < 0xf8 ? 1 : 1 + *transaction - 0xf7;
+      parts.nonce = parts.header;
+      parts.gasPrice = parts.nonce + RLP::itemLength(transaction + parts.nonce);
+      if(parts.gasPrice >= length) return false;
+      parts.fields = parts.gasPrice + RLP::itemLength(transaction + parts.gasPrice);
+
+      // Gas limit, to, value and data
+      parts.signature = parts.fields;
+      for(std::size_t i = 0; i < 4 && parts.signature < length; i++) parts.signature += RLP::itemLength(transaction + parts.signature);
+
+      return 2 * parts.header <= sizeof(Delta::header)
+        && 2 * (parts.fields - parts.gasPrice) <= sizeof(Delta::gasPriceItem)
+        && parts.signature < length
+        && 2 * (length - parts.signature) <= sizeof(Delta::signature)
+        && (parts.gasPrice - parts.nonce) + (parts.signature - parts.fields) <= ConstantCapacity;
+    }
+
+    /**
+     * @brief Returns template lengths bounded by its buffer, even if the store is being overwritten (shared memory).
+     */
+    void constantLengths(std::size_t &nonce, std::size_t &fields) const {
+      nonce = std::min(nonceLength, ConstantCapacity);
+      fields = std::min(fieldsLength, ConstantCapacity - nonce);
+    }
+
+    /**
+     * @brief Fills delta with parts of signed transaction.
+     *
+     * @return false if constant fields differ from the template
+     */
+    bool fill(Delta &delta, std::uint64_t gasPrice, Utils::Buffer transaction, std::size_t length) const {
+      Parts parts;
+      if(!split(transaction, length, parts)) return false;
+
+      std::size_t transactionNonceLength = parts.gasPrice - parts.nonce;
+      std::size_t transactionFieldsLength = parts.signature - parts.fields;
+      if(
+        transactionNonceLength != nonceLength || transactionFieldsLength != fieldsLength
+        || memcmp(transaction + parts.nonce, constant, nonceLength) != 0
+        || memcmp(transaction + parts.fields, constant + nonceLength, fieldsLength) != 0
+      ) return false;
+
+      delta.gasPrice = gasPrice;
+      delta.headerLength = Utils::bufferToHexString(transaction, parts.header, delta.header);
+      delta.gasPriceLength = Utils::bufferToHexString(transaction + parts.gasPrice, parts.fields - parts.gasPrice, delta.gasPriceItem);
+      delta.signatureLength = Utils::bufferToHexString(transaction + parts.signature, length - parts.signature, delta.signature);
+
+      return true;
+    }
+
+    public:
+
+    /**
+     * @brief Returns number of stored entries.
+     */
+    std::size_t size() const {
+      return count;
+    }
+
+    /**
+     * @brief Checks if store cannot hold any more entries.
+     */
+    bool full() const {
+      return count == Capacity;
+    }
+
+    /**
+     * @brief Removes all entries and the template.
+     */
+    void clear() {
+      count = 0;
+      nonceLength = 0;
+      fieldsLength = 0;
+    }
+
+    /**
+     * @brief Takes constant fields of signed transaction as the template, removes all entries.
+     *
+     * @param transaction signed legacy transaction
+     * @param length signed transaction length
+     * @return false if transaction is malformed
+     */
+    bool setTemplate(Utils::Buffer transaction, std::size_t length) {
+      clear();
+
+      Parts parts;
+      if(!split(transaction, length, parts)) return false;
+
+      nonceLength = parts.gasPrice - parts.nonce;
+      fieldsLength = parts.signature - parts.fields;
+      memcpy(constant, transaction + parts.nonce, nonceLength);
+      memcpy(constant + nonceLength, transaction + parts.fields, fieldsLength);
+      Utils::bufferToHexString(constant, nonceLength + fieldsLength, constantHex);
+
+      return true;
+    }
+
+    /**
+     * @brief Inserts signed transaction for given gas price, replaces already existing one.
+     * The first inserted transaction becomes the template.
+     *
+     * @param gasPrice gas price (wei)
+     * @param transaction signed legacy transaction
+     * @param length signed transaction length
+     * @return false if store is full or transaction does not match the template
+     */
+    bool insert(std::uint64_t gasPrice, Utils::Buffer transaction, std::size_t length) {
+      if(count == 0 && !setTemplate(transaction, length)) return false;
+
+      Delta delta;
+      if(!fill(delta, gasPrice, transaction, length)) return false;
+
+      std::size_t position = lowerBound(gasPrice);
+      if(position < count && gasPrices[position] == gasPrice) {
+        deltas[slots[position]] = delta;
+        return true;
+      }
+
+      if(full()) return false;
+
+      memmove(gasPrices + position + 1, gasPrices + position, (count - position) * sizeof(*gasPrices));
+      memmove(slots + position + 1, slots + position, (count - position) * sizeof(*slots));
+      gasPrices[position] = gasPrice;
+      slots[position] = count;
+      deltas[count] = delta;
+      ++count;
+
+      return true;
+    }
+
+    /**
+     * @brief Fills raw entry slot with signed transaction, used to fill the store from multiple threads after setTemplate().
+     * Entries written this way become visible after rebuildIndex().
+     *
+     * @param slot slot index, lower than Capacity
+     * @param gasPrice gas price (wei)
+     * @param transaction signed legacy transaction
+     * @param length signed transaction length
+     * @return false if transaction does not match the template, slot is skipped then
+     */
+    bool fillSlot(std::size_t slot, std::uint64_t gasPrice, Utils::Buffer transaction, std::size_t length) {
+      if(fill(deltas[slot], gasPrice, transaction, length)) return true;
+
+      deltas[slot].signatureLength = 0;
+      return false;
+    }
+
+    /**
+     * @brief Replaces store content with the first entry slots, skipping the ones which did not match the template.
+     * Gas prices of the slots have to be unique.
+     *
+     * @param slotsCount number of filled slots
+     */
+    void rebuildIndex(std::size_t slotsCount) {
+      count = 0;
+      for(std::size_t i = 0; i < std::min(slotsCount, Capacity); i++) {
+        if(deltas[i].signatureLength != 0) slots[count++] = i;
+      }
+
+      std::sort(slots, slots + count, [this](std::uint32_t a, std::uint32_t b) {
+        return deltas[a].gasPrice < deltas[b].gasPrice;
+      });
+      for(std::size_t i = 0; i < count; i++) gasPrices[i] = deltas[slots[i]].gasPrice;
+    }
+
+    /**
+     * @brief Checks if there is transaction pregenerated for exactly given gas price.
+     */
+    bool contains(std::uint64_t gasPrice) const {
+      std::size_t position = lowerBound(gasPrice);
+      return position < count && gasPrices[position] == gasPrice;
+    }
+
+    /**
+     * @brief Finds transaction pregenerated for exactly given gas price.
+     * Slot index is bounded, so a read torn by a concurrent writer (shared mapping) stays within the store.
+     *
+     * @param gasPrice gas price (wei)
+     * @return found entry or nullptr
+     */
+    const EntryType *find(std::uint64_t gasPrice) const {
+      std::size_t position = lowerBound(gasPrice);
+      if(position < count && gasPrices[position] == gasPrice && slots[position] < Capacity) return deltas + slots[position];
+      return nullptr;
+    }
+
+    /**
+     * @brief Finds transaction pregenerated for the nearest gas price at or above given one.
+     *
+     * @param gasPrice gas price (wei)
+     * @param maxBump maximum accepted difference between found and given gas price (wei)
+     * @return found entry or nullptr
+     */
+    const EntryType *findAtOrAbove(std::uint64_t gasPrice, std::uint64_t maxBump) const {
+      std::size_t position = lowerBound(gasPrice);
+      if(position < count && gasPrices[position] - gasPrice <= maxBump && slots[position] < Capacity) return deltas + slots[position];
+      return nullptr;
+    }
+
+    /**
+     * @brief Finds transaction to send according to miss policy.
+     *
+     * @param gasPrice observed gas price (wei)
+     * @param policy what to do when there is no exact match
+     * @param maxBump maximum accepted gas price overpay for MissPolicy::NearestAbove (wei)
+     * @return found entry or nullptr if transaction has to be signed on demand
+     */
+    const EntryType *lookup(std::uint64_t gasPrice, Config::TransactionPreGen::MissPolicy policy, std::uint64_t maxBump) const {
+      if(policy == Config::TransactionPreGen::MissPolicy::NearestAbove) return findAtOrAbove(gasPrice, maxBump);
+      return find(gasPrice);
+    }
+
+    /**
+     * @brief Assembles message of the entry, splicing the template with the delta.
+     * Lengths are bounded even if the entry is being overwritten.
+     *
+     * @param entry entry found in the store
+     * @param output output message, at least Config::Size::BloXrouteTransactionMessageString long
+     * @return output message length
+     */
+    std::size_t assemble(const EntryType &entry, char *output) const {
+      iovec parts[GatherCount];
+      gather(entry, parts);
+
+      char *position = output;
+      for(const iovec &part : parts) {
+        memcpy(position, part.iov_base, part.iov_len);
+        position += part.iov_len;
+      }
+      *position = '\0';
+
+      return position - output;
+    }
+
+    /**
+     * @brief Describes message of the entry by iovecs pointing to the template and the delta, for writev.
+     * Nothing is copied, iovecs are valid until the store is modified.
+     *
+     * @param entry entry found in the store
+     * @param output output iovecs, GatherCount of them
+     * @return message length
+     */
+    std::size_t gather(const EntryType &entry, iovec *output) const {
+      std::size_t nonce, fields;
+      constantLengths(nonce, fields);
+
+      std::size_t headerLength = std::min<std::size_t>(entry.headerLength, sizeof(entry.header));
+      std::size_t gasPriceLength = std::min<std::size_t>(entry.gasPriceLength, sizeof(entry.gasPriceItem));
+      std::size_t signatureLength = std::min<std::size_t>(entry.signatureLength, sizeof(entry.signature));
+
+      output[0] = { const_cast<char*>(BloXrouteMessageBuilder::TransactionPrefix), PrefixLength };
+      output[1] = { const_cast<char*>(entry.header), headerLength };
+      output[2] = { const_cast<char*>(constantHex), 2 * nonce };
+      output[3] = { const_cast<char*>(entry.gasPriceItem), gasPriceLength };
+      output[4] = { const_cast<char*>(constantHex) + 2 * nonce, 2 * fields };
+      output[5] = { const_cast<char*>(entry.signature), signatureLength };
+      output[6] = { const_cast<char*>(BloXrouteMessageBuilder::TransactionSuffix), SuffixLength };
+
+      return PrefixLength + headerLength + 2 * nonce + gasPriceLength + 2 * fields + signatureLength + SuffixLength;
+    }
+
+    /**
+     * @brief Returns message of the entry assembled into the buffer.
+     *
+     * @param entry entry found in the store
+     * @param buffer output buffer, at least Config::Size::BloXrouteTransactionMessageString long
+     * @param length output message length
+     * @return message
+     */
+    const char *message(const EntryType &entry, char *buffer, std::size_t &length) const {
+      length = assemble(entry, buffer);
+      return buffer;
+    }
+
+    /**
+     * @brief Copies message of the entry, same as assemble().
+     */
+    std::size_t copy(const EntryType &entry, char *output) const {
+      return assemble(entry, output);
+    }
+  };
+
+  /**
+   * @brief Uniform axis of fee grid.
+   */
+  struct FeeAxis {
+    std::uint64_t from;
+    std::uint64_t step;
+    std::size_t count;
+
+    /**
+     * @brief Returns fee at given grid index (wei).
+     */
+    std::uint64_t at(std::size_t index) const {
+      return from + step * index;
+    }
+
+    /**
+     * @brief Returns index of the lowest grid fee at or above given one, count if there is none.
+     */
+    std::size_t ceilIndex(std::uint64_t fee) const {
+      if(fee <= from) return 0;
+      return std::min<std::size_t>((fee - from + step - 1) / step, count);
+    }
+  };
+
+  /**
+   * @brief Dense store of pregenerated EIP-1559 transaction messages over (maxFeePerGas, maxPriorityFeePerGas) grid.
+   *
+   * Messages are packed in a single allocation with stride of the longest expected message
+   * (instead of fixed Config::Size::BloXrouteTransactionMessageString), observed fees are rounded
+   * up to the grid, so lookup is just two divisions.
+   */
+  class FeeGrid {
+    FeeAxis maxFeeAxis { 0, 1, 0 };
+    FeeAxis priorityFeeAxis { 0, 1, 0 };
+    std::size_t stride = 0;
+    std::unique_ptr<char[]> messages;
+    std::unique_ptr<std::uint32_t[]> lengths;
+
+    public:
+
+    /**
+     * @brief Found message, message is nullptr when there is none.
+     */
+    struct Entry {
+      std::uint64_t maxFeePerGas;
+      std::uint64_t maxPriorityFeePerGas;
+      std::size_t length;
+      const char *message;
+    };
+
+    /**
+     * @brief Allocates empty grid.
+     *
+     * @param maxFee maxFeePerGas axis
+     * @param priorityFee maxPriorityFeePerGas axis
+     * @param messageStride maximum message length, including null terminator
+     */
+    void reset(FeeAxis maxFee, FeeAxis priorityFee, std::size_t messageStride) {
+      maxFeeAxis = maxFee;
+      priorityFeeAxis = priorityFee;
+      stride = messageStride;
+      messages = std::make_unique<char[]>(size() * stride);
+      lengths = std::make_unique<std::uint32_t[]>(size());
+    }
+
+    /**
+     * @brief Returns number of grid cells.
+     */
+    std::size_t size() const {
+      return maxFeeAxis.count * priorityFeeAxis.count;
+    }
+
+    /**
+     * @brief Returns allocated memory (bytes).
+     */
+    std::size_t memoryUsage() const {
+      return size() * (stride + sizeof(std::uint32_t));
+    }
+
+    const FeeAxis &maxFee() const {
+      return maxFeeAxis;
+    }
+
+    const FeeAxis &priorityFee() const {
+      return priorityFeeAxis;
+    }
+
+    /**
+     * @brief Stores message of given cell.
+     *
+     * @param cell cell index, maxFee major
+     * @param message input message
+     * @param length input message length
+     * @return false if message does not fit the stride, cell is left empty then
+     */
+    bool set(std::size_t cell, const char *message, std::size_t length) {
+      if(length >= stride) {
+        lengths[cell] = 0;
+        return false;
+      }
+
+      memcpy(messages.get() + cell * stride, message, length);
+      messages[cell * stride + length] = '\0';
+      lengths[cell] = length;
+      return true;
+    }
+
+    /**
+     * @brief Finds message to send according to miss policy.
+     *
+     * @param maxFeePerGas observed maxFeePerGas (wei)
+     * @param maxPriorityFeePerGas observed maxPriorityFeePerGas (wei)
+     * @param policy what to do when there is no exact match
+     * @param maxFeeBump maximum accepted maxFeePerGas overpay for MissPolicy::NearestAbove (wei)
+     * @param priorityFeeBump maximum accepted maxPriorityFeePerGas overpay for MissPolicy::NearestAbove (wei)
+     * @return found entry, message is nullptr if transaction has to be signed on demand
+     */
+    Entry lookup(
+      std::uint64_t maxFeePerGas, std::uint64_t maxPriorityFeePerGas,
+      Config::TransactionPreGen::MissPolicy policy, std::uint64_t maxFeeBump, std::uint64_t priorityFeeBump
+    ) const {
+      Entry entry { 0, 0, 0, nullptr };
+
+      std::size_t maxFeeIndex = maxFeeAxis.ceilIndex(maxFeePerGas);
+      std::size_t priorityFeeIndex = priorityFeeAxis.ceilIndex(maxPriorityFeePerGas);
+      if(maxFeeIndex == maxFeeAxis.count || priorityFeeIndex == priorityFeeAxis.count) return entry;
+
+      entry.maxFeePerGas = maxFeeAxis.at(maxFeeIndex);
+      entry.maxPriorityFeePerGas = priorityFeeAxis.at(priorityFeeIndex);
+
+      if(policy == Config::TransactionPreGen::MissPolicy::NearestAbove) {
+        if(entry.maxFeePerGas - maxFeePerGas > maxFeeBump || entry.maxPriorityFeePerGas - maxPriorityFeePerGas > priorityFeeBump) return entry;
+      } else if(entry.maxFeePerGas != maxFeePerGas || entry.maxPriorityFeePerGas != maxPriorityFeePerGas) {
+        return entry;
+      }
+
+      std::size_t cell = maxFeeIndex * priorityFeeAxis.count + priorityFeeIndex;
+      entry.length = lengths[cell];
+      if(entry.length != 0) entry.message = messages.get() + cell * stride;
+      return entry;
+    }
+  };
+
+  /**
+   * @brief Two stores, one used by the event loop and one rebuilt in the background.
+   *
+   * Reader marks itself busy before loading active store, writer checks that flag
+   * after publishing. Both use sequentially consistent operations, so once publish()
+   * returns, the previously active store is no longer read and can be rebuilt.
+   * Supports single reader thread and single writer thread.
+   *
+   * @tparam StoreType type of the store
+   */
+  template<typename StoreType>
+  class DoubleBuffer {
+    std::unique_ptr<StoreType> buffers[2];
+    std::atomic<StoreType*> active { nullptr };
+    std::atomic<bool> reading { false };
+
+    public:
+
+    /**
+     * @brief Marks reader busy and returns active store.
+     * Has to be paired with release().
+     */
+    StoreType *acquire() {
+      reading.store(true);
+      return active.load();
+    }
+
+    /**
+     * @brief Marks reader done with the store returned by acquire().
+     */
+    void release() {
+      reading.store(false);
+    }
+
+    /**
+     * @brief Returns store which is not active, allocating it on first use.
+     */
+    StoreType &back() {
+      StoreType *current = active.load();
+      std::size_t index = buffers[0].get() == current ? 1 : 0;
+      if(!buffers[index]) buffers[index] = std::make_unique<StoreType>();
+      return *buffers[index];
+    }
+
+    /**
+     * @brief Returns active store, for the writer thread only (reader uses acquire()).
+     */
+    const StoreType &front() const {
+      return *active.load();
+    }
+
+    /**
+     * @brief Makes back store active and waits until reader stops using the previous one.
+     */
+    void publish() {
+      active.store(&back());
+      while(reading.load()) {}
+    }
+  };
+
+  /**
+   * @brief Pregenerated transactions coverage of gas prices observed on the stream.
+   *
+   * Written by the event loop only, read by other threads.
+   */
+  struct Stats {
+    std::atomic<std::uint64_t> observed { 0 };
+    std::atomic<std::uint64_t> exactHits { 0 };
+    std::atomic<std::uint64_t> nearestHits { 0 };
+    std::atomic<std::uint64_t> uniformGridHits { 0 };
+
+    /**
+     * @brief Records lookup outcome for observed gas price.
+     *
+     * @param gasPrice observed gas price (wei)
+     * @param entryGasPrice gas price of found entry
+     * @param found was entry found
+     */
+    void record(std::uint64_t gasPrice, std::uint64_t entryGasPrice, bool found) {
+      observed.fetch_add(1, std::memory_order_relaxed);
+      if(found && entryGasPrice == gasPrice) exactHits.fetch_add(1, std::memory_order_relaxed);
+      else if(found) nearestHits.fetch_add(1, std::memory_order_relaxed);
+
+      // Would the gas price hit the static grid configured in Config::TransactionPreGen
+      constexpr std::uint64_t step = 1000000000 / Config::TransactionPreGen::GasPriceGweiDecimals;
+      if(
+        gasPrice % step == 0
+        && gasPrice >= Config::TransactionPreGen::GasPriceGweiFrom * 1000000000
+        && gasPrice <= Config::TransactionPreGen::GasPriceGweiTo * 1000000000
+      ) uniformGridHits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Prints hit rates.
+     */
+    void print() const {
+      std::uint64_t total = std::max<std::uint64_t>(observed.load(std::memory_order_relaxed), 1);
+      printf(
+        "Pregen coverage of %" PRIu64 " observed gas prices: exact %.2f%%, nearest above %.2f%%, uniform grid would hit %.2f%%\n",
+        observed.load(std::memory_order_relaxed),
+        100.0 * exactHits.load(std::memory_order_relaxed) / total,
+        100.0 * nearestHits.load(std::memory_order_relaxed) / total,
+        100.0 * uniformGridHits.load(std::memory_order_relaxed) / total
+      );
+    }
+  };
+
+  /**
+   * @brief Signs legacy transaction with given gas price.
+   *
+   * @param tx transaction with all fields but gas price set
+   * @param privateKey private key buffer to sign with
+   * @param gasPrice gas price (wei)
+   * @param output output signed transaction, at least Config::Size::TransactionRawBuffer long
+   * @return output signed transaction length
+   */
+  inline std::size_t sign(Transaction &tx, Utils::Buffer privateKey, std::uint64_t gasPrice, Utils::Buffer output) {
+    tx.setType(Transaction::Type::Legacy);
+
+    Utils::Byte gasPriceBuffer[8];
+    std::size_t gasPriceBufferSize = Utils::intToBuffer(gasPrice, gasPriceBuffer);
+    tx.setField(Transaction::Field::GasPrice, gasPriceBuffer, gasPriceBufferSize);
+
+    return tx.sign(privateKey, output);
+  }
+
+  /**
+   * @brief Signs transaction with given gas price right into prepared BloXroute message, in a single encoding pass.
+   *
+   * @param tx transaction with all fields but gas price set
+   * @param privateKey private key buffer to sign with
+   * @param gasPrice gas price (wei)
+   * @param output message buffer prepared by BloXrouteMessageBuilder::prepareTransaction
+   * @return output message length
+   */
+  inline std::size_t generatePrepared(Transaction &tx, Utils::Buffer privateKey, std::uint64_t gasPrice, char *output) {
+    tx.setType(Transaction::Type::Legacy);
+
+    Utils::Byte gasPriceBuffer[8];
+    std::size_t gasPriceBufferSize = Utils::intToBuffer(gasPrice, gasPriceBuffer);
+    tx.setField(Transaction::Field::GasPrice, gasPriceBuffer, gasPriceBufferSize);
+
+    std::size_t transactionStringLength = tx.signHex(privateKey, output + BloXrouteMessageBuilder::TransactionOffset);
+    return BloXrouteMessageBuilder::sealTransaction(output, transactionStringLength);
+  }
+
+  /**
+   * @brief Signs transaction with given gas price and builds BloXroute message out of it.
+   *
+   * @param tx transaction with all fields but gas price set
+   * @param privateKey private key buffer to sign with
+   * @param gasPrice gas price (wei)
+   * @param output output message, at least Config::Size::BloXrouteTransactionMessageString long
+   * @return output message length
+   */
+  inline std::size_t generate(Transaction &tx, Utils::Buffer privateKey, std::uint64_t gasPrice, char *output) {
+    BloXrouteMessageBuilder::prepareTransaction(output);
+    return generatePrepared(tx, privateKey, gasPrice, output);
+  }
+
+  /**
+   * @brief Signs EIP-1559 transaction with given fees right into prepared BloXroute message, in a single encoding pass.
+   *
+   * @param tx transaction with all fields but fees set
+   * @param privateKey private key buffer to sign with
+   * @param maxFeePerGas maxFeePerGas (wei)
+   * @param maxPriorityFeePerGas maxPriorityFeePerGas (wei)
+   * @param output message buffer prepared by BloXrouteMessageBuilder::prepareTransaction
+   * @return output message length
+   */
+  inline std::size_t generatePrepared(Transaction &tx, Utils::Buffer privateKey, std::uint64_t maxFeePerGas, std::uint64_t maxPriorityFeePerGas, char *output) {
+    tx.setType(Transaction::Type::DynamicFee);
+
+    Utils::Byte feeBuffer[8];
+    std::size_t feeBufferSize = Utils::intToBuffer(maxFeePerGas, feeBuffer);
+    tx.setField(Transaction::Field::MaxFeePerGas, feeBuffer, feeBufferSize);
+    feeBufferSize = Utils::intToBuffer(maxPriorityFeePerGas, feeBuffer);
+    tx.setField(Transaction::Field::MaxPriorityFeePerGas, feeBuffer, feeBufferSize);
+
+    std::size_t transactionStringLength = tx.signHex(privateKey, output + BloXrouteMessageBuilder::TransactionOffset);
+    return BloXrouteMessageBuilder::sealTransaction(output, transactionStringLength);
+  }
+
+  /**
+   * @brief Signs EIP-1559 transaction with given fees and builds BloXroute message out of it.
+   *
+   * @param tx transaction with all fields but fees set
+   * @param privateKey private key buffer to sign with
+   * @param maxFeePerGas maxFeePerGas (wei)
+   * @param maxPriorityFeePerGas maxPriorityFeePerGas (wei)
+   * @param output output message, at least Config::Size::BloXrouteTransactionMessageString long
+   * @return output message length
+   */
+  inline std::size_t generate(Transaction &tx, Utils::Buffer privateKey, std::uint64_t maxFeePerGas, std::uint64_t maxPriorityFeePerGas, char *output) {
+    BloXrouteMessageBuilder::prepareTransaction(output);
+    return generatePrepared(tx, privateKey, maxFeePerGas, maxPriorityFeePerGas, output);
+  }
+
+  /**
+   * @brief Pregenerates message for given gas price and inserts it into the store.
+   *
+   * @param store output store
+   * @param tx transaction with all fields but gas price set
+   * @param privateKey private key buffer to sign with
+   * @param gasPrice gas price (wei)
+   * @return false if store is full
+   */
+  template<std::size_t Capacity, std::size_t MessageSize>
+  bool generate(Store<Capacity, MessageSize> &store, Transaction &tx, Utils::Buffer privateKey, std::uint64_t gasPrice) {
+    char message[Config::Size::BloXrouteTransactionMessageString];
+    std::size_t messageLength = generate(tx, privateKey, gasPrice, message);
+    return store.insert(gasPrice, message, messageLength);
+  }
+
+  /**
+   * @brief Pregenerates transaction for given gas price and inserts it into the compact store.
+   *
+   * @param store output store
+   * @param tx transaction with all fields but gas price set
+   * @param privateKey private key buffer to sign with
+   * @param gasPrice gas price (wei)
+   * @return false if store is full or transaction does not match the template (eg. nonce changed)
+   */
+  template<std::size_t Capacity>
+  bool generate(CompactStore<Capacity> &store, Transaction &tx, Utils::Buffer privateKey, std::uint64_t gasPrice) {
+    Utils::Byte transaction[Config::Size::TransactionRawBuffer];
+    std::size_t transactionLength = sign(tx, privateKey, gasPrice, transaction);
+    return store.insert(gasPrice, transaction, transactionLength);
+  }
+
+  /**
+   * @brief Sorts gas prices, removes duplicates and cuts them to the capacity.
+   */
+  inline void prepareGasPrices(std::vector<std::uint64_t> &gasPrices, std::size_t capacity) {
+    std::sort(gasPrices.begin(), gasPrices.end());
+    gasPrices.erase(std::unique(gasPrices.begin(), gasPrices.end()), gasPrices.end());
+    if(gasPrices.size() > capacity) gasPrices.resize(capacity);
+  }
+
+  /**
+   * @brief Returns number of signing threads to use.
+   */
+  inline std::size_t signingThreads(std::size_t threadsCount, std::size_t jobs) {
+    if(threadsCount == 0) threadsCount = std::max(1U, std::thread::hardware_concurrency());
+    return std::min(threadsCount, std::max<std::size_t>(jobs, 1));
+  }
+
+  /**
+   * @brief Replaces store content with messages pregenerated for given gas prices, signing on multiple threads.
+   * Each thread creates its own transaction (and so SECP256K1 context) in memory of its own NUMA node.
+   *
+   * @param store output store
+   * @param gasPrices gas prices to pregenerate (wei), duplicates are skipped
+   * @param privateKey private key buffer to sign with
+   * @param setup function setting all transaction fields but gas price, called once per thread
+   * @param threadsCount number of signing threads, 0 means all available cores
+   * @return number of pregenerated messages
+   */
+  template<std::size_t Capacity, std::size_t MessageSize, typename Setup>
+  std::size_t generateParallel(Store<Capacity, MessageSize> &store, std::vector<std::uint64_t> gasPrices, Utils::Buffer privateKey, Setup setup, std::size_t threadsCount = 0) {
+    static_assert(MessageSize >= Config::Size::BloXrouteTransactionMessageString, "MessageSize too small to hold transaction message");
+
+    prepareGasPrices(gasPrices, Capacity);
+    threadsCount = signingThreads(threadsCount, gasPrices.size());
+
+    std::vector<std::thread> threads;
+    for(std::size_t thread = 0; thread < threadsCount; thread++) {
+      threads.emplace_back([&, thread]() {
+        // Worker memory (signing context, stack) is local to the worker, the store was allocated and touched by the caller
+        Numa::preferLocal();
+        Transaction tx;
+        setup(tx);
+
+        // Interleave slots, so threads get similar amount of work
+        for(std::size_t i = thread; i < gasPrices.size(); i += threadsCount) {
+          auto *entry = store.slot(i);
+          entry->gasPrice = gasPrices[i];
+          entry->length = generate(tx, privateKey, gasPrices[i], entry->message);
+        }
+      });
+    }
+    for(std::thread &thread : threads) thread.join();
+
+    store.rebuildIndex(gasPrices.size());
+    return gasPrices.size();
+  }
+
+  /**
+   * @brief Replaces compact store content with transactions pregenerated for given gas prices, signing on multiple threads.
+   * Template is taken from transaction signed for the lowest gas price.
+   *
+   * @param store output store
+   * @param gasPrices gas prices to pregenerate (wei), duplicates are skipped
+   * @param privateKey private key buffer to sign with
+   * @param setup function setting all transaction fields but gas price, called once per thread
+   * @param threadsCount number of signing threads, 0 means all available cores
+   * @return number of pregenerated transactions
+   */
+  template<std::size_t Capacity, typename Setup>
+  std::size_t generateParallel(CompactStore<Capacity> &store, std::vector<std::uint64_t> gasPrices, Utils::Buffer privateKey, Setup setup, std::size_t threadsCount = 0) {
+    prepareGasPrices(gasPrices, Capacity);
+    threadsCount = signingThreads(threadsCount, gasPrices.size());
+
+    store.clear();
+    if(gasPrices.empty()) return 0;
+
+    {
+      Transaction tx;
+      setup(tx);
+
+      Utils::Byte transaction[Config::Size::TransactionRawBuffer];
+      std::size_t transactionLength = sign(tx, privateKey, gasPrices[0], transaction);
+      if(!store.setTemplate(transaction, transactionLength)) return 0;
+    }
+
+    std::vector<std::thread> threads;
+    for(std::size_t thread = 0; thread < threadsCount; thread++) {
+      threads.emplace_back([&, thread]() {
+        Numa::preferLocal();
+        Transaction tx;
+        setup(tx);
+
+        Utils::Byte transaction[Config::Size::TransactionRawBuffer];
+        for(std::size_t i = thread; i < gasPrices.size(); i += threadsCount) {
+          std::size_t transactionLength = sign(tx, privateKey, gasPrices[i], transaction);
+          store.fillSlot(i, gasPrices[i], transaction, transactionLength);
+        }
+      });
+    }
+    for(std::thread &thread : threads) thread.join();
+
+    store.rebuildIndex(gasPrices.size());
+    return store.size();
+  }
+
+  /**
+   * @brief Allocates fee grid and fills it with messages pregenerated for every cell, signing on multiple threads.
+   * Each thread creates its own transaction (and so SECP256K1 context) in memory of its own NUMA node.
+   *
+   * @param grid output grid
+   * @param maxFee maxFeePerGas axis
+   * @param priorityFee maxPriorityFeePerGas axis
+   * @param privateKey private key buffer to sign with
+   * @param setup function setting all transaction fields but fees, called once per thread
+   * @param threadsCount number of signing threads, 0 means all available cores
+   * @return number of pregenerated messages
+   */
+  template<typename Setup>
+  std::size_t generateParallel(FeeGrid &grid, FeeAxis maxFee, FeeAxis priorityFee, Utils::Buffer privateKey, Setup setup, std::size_t threadsCount = 0) {
+    if(maxFee.count == 0 || priorityFee.count == 0) {
+      grid.reset(maxFee, priorityFee, 0);
+      return 0;
+    }
+
+    // Stride from the message with the highest fees, leaving room for longer signature
+    char message[Config::Size::BloXrouteTransactionMessageString];
+    Transaction tx;
+    setup(tx);
+    std::size_t longestLength = generate(tx, privateKey, maxFee.at(maxFee.count - 1), priorityFee.at(priorityFee.count - 1), message);
+    grid.reset(maxFee, priorityFee, longestLength + 16);
+
+    threadsCount = signingThreads(threadsCount, grid.size());
+
+    std::atomic<std::size_t> generated { 0 };
+    std::vector<std::thread> threads;
+    for(std::size_t thread = 0; thread < threadsCount; thread++) {
+      threads.emplace_back([&, thread]() {
+        Numa::preferLocal();
+        Transaction threadTx;
+        setup(threadTx);
+        char threadMessage[Config::Size::BloXrouteTransactionMessageString];
+
+        // Interleave cells, so threads get similar amount of work
+        for(std::size_t cell = thread; cell < grid.size(); cell += threadsCount) {
+          std::size_t length = generate(
+            threadTx, privateKey,
+            maxFee.at(cell / priorityFee.count), priorityFee.at(cell % priorityFee.count),
+            threadMessage
+          );
+          if(grid.set(cell, threadMessage, length)) generated.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }
+    for(std::thread &thread : threads) thread.join();
+
+    return generated.load();
+  }
+}
\ No newline at end of file
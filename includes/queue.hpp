@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Bounded lock-free single-producer single-consumer ring buffer.
+ *
+ * Producer owns tail, consumer owns head, each on its own cache line,
+ * so the only shared traffic is publishing the indices.
+ *
+ * @tparam T type of the item, copied in and out
+ * @tparam Capacity maximum number of queued items, must be power of two
+ */
+template<typename T, std::size_t Capacity>
+class SPSCQueue {
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of two");
+
+  alignas(64) std::atomic<std::size_t> head { 0 };
+  alignas(64) std::atomic<std::size_t> tail { 0 };
+  alignas(64) T items[Capacity] {};
+
+  public:
+
+  /**
+   * @brief Enqueues item, called by the producer only.
+   *
+   * @param item input item
+   * @return false if queue is full
+   */
+  bool push(const T &item) {
+    std::size_t currentTail = tail.load(std::memory_order_relaxed);
+    if(currentTail - head.load(std::memory_order_acquire) == Capacity) return false;
+
+    items[currentTail & (Capacity - 1)] = item;
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Dequeues item, called by the consumer only.
+   *
+   * @param item output item
+   * @return false if queue is empty
+   */
+  bool pop(T &item) {
+    std::size_t currentHead = head.load(std::memory_order_relaxed);
+    if(currentHead == tail.load(std::memory_order_acquire)) return false;
+
+    item = items[currentHead & (Capacity - 1)];
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Returns the oldest item without dequeuing it, called by the consumer only.
+   *
+   * @return pointer to the item, nullptr if queue is empty
+   */
+  const T *front() const {
+    std::size_t currentHead = head.load(std::memory_order_relaxed);
+    if(currentHead == tail.load(std::memory_order_acquire)) return nullptr;
+
+    return &items[currentHead & (Capacity - 1)];
+  }
+
+  /**
+   * @brief Dequeues the item returned by front(), called by the consumer only.
+   */
+  void drop() {
+    head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Returns number of queued items, approximate when called concurrently.
+   */
+  std::size_t size() const {
+    // Head first, so it is never ahead of the loaded tail
+    std::size_t currentHead = head.load(std::memory_order_acquire);
+    return tail.load(std::memory_order_acquire) - currentHead;
+  }
+
+  /**
+   * @brief Checks if queue is empty, approximate when called concurrently.
+   */
+  bool empty() const {
+    return size() == 0;
+  }
+};
\ No newline at end of file
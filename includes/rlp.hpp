@@ -21,6 +21,7 @@ namespace RLP {
   struct Item {
     Buffer buffer;
     std::size_t length;
+    bool encoded = false; // buffer is already RLP encoded (eg. nested list) and is copied as is
   };
 
   /**
@@ -57,6 +58,11 @@ namespace RLP {
    * @return output buffer length
    */
   inline std::size_t encodeItem(Item *input, Buffer output) {
+    if(input->encoded) {
+      memcpy(output, input->buffer, input->length);
+      return input->length;
+    }
+
     // Empty item encoding returns 0x80
     if(input->length == 0) {
       *output = 0x80;
@@ -98,4 +104,118 @@ namespace RLP {
 
     return encodedLengthLength + payloadLength;
   }
+
+  /**
+   * @brief Returns length of encoded item without encoding it.
+   * 
+   * @param input input item
+   * @return encoded item length
+   */
+  inline std::size_t encodedLength(const Item &input) {
+    if(input.encoded) return input.length;
+    if(input.length == 1 && *(input.buffer) < 0x80) return 1;
+    if(input.length < 56) return 1 + input.length;
+
+    std::size_t bytesLength = 0;
+    for(std::size_t length = input.length; length != 0; length >>= 8) ++bytesLength;
+    return 1 + bytesLength + input.length;
+  }
+
+  /**
+   * @brief Encodes single item as hexadecimal string.
+   * 
+   * @param input input item
+   * @param output output hexadecimal string (not null-terminated)
+   * @return output string length
+   */
+  inline std::size_t encodeItemHex(const Item &input, char *output) {
+    if(input.encoded || (input.length == 1 && *(input.buffer) < 0x80)) return bufferToHexString(input.buffer, input.length, output);
+
+    Byte header[9];
+    std::size_t headerLength = encodeLength(input.length, 0x80, header);
+    bufferToHexString(header, headerLength, output);
+    bufferToHexString(input.buffer, input.length, output + 2 * headerLength);
+
+    return 2 * (headerLength + input.length);
+  }
+
+  /**
+   * @brief Encodes list of items as hexadecimal string in a single pass, payload length is computed upfront.
+   * 
+   * @param input list of input items
+   * @param inputLength list length
+   * @param output output hexadecimal string (not null-terminated)
+   * @return output string length
+   */
+  inline std::size_t encodeListHex(const Item input[], std::size_t inputLength, char *output) {
+    std::size_t payloadLength = 0;
+    for(std::size_t i = 0; i < inputLength; i++) payloadLength += encodedLength(input[i]);
+
+    Byte header[9];
+    std::size_t outputLength = bufferToHexString(header, encodeLength(payloadLength, 0xc0, header), output);
+    for(std::size_t i = 0; i < inputLength; i++) outputLength += encodeItemHex(input[i], output + outputLength);
+
+    return outputLength;
+  }
+
+  /**
+   * @brief Returns length of the header of encoded string item, its payload starts right after.
+   * 
+   * @param input encoded item
+   * @return header length
+   */
+  inline std::size_t headerLength(const Byte *input) {
+    if(*input < 0x80) return 0;
+    if(*input < 0xb8) return 1;
+    return 1 + *input - 0xb7;
+  }
+
+  /**
+   * @brief Returns length of encoded item (string or list) including its header.
+   * 
+   * @param input encoded item
+   * @return item length
+   */
+  inline std::size_t itemLength(const Byte *input) {
+    if(*input < 0x80) return 1;
+    if(*input < 0xb8) return 1 + *input - 0x80;
+    if(*input >= 0xc0 && *input < 0xf8) return 1 + *input - 0xc0;
+
+    std::size_t lengthLength = *input < 0xc0 ? *input - 0xb7 : *input - 0xf7;
+    std::size_t length = 0;
+    for(std::size_t i = 1; i <= lengthLength; i++) length = (length << 8) | input[i];
+
+    return 1 + lengthLength + length;
+  }
+
+  /**
+   * @brief Encodes single item at compile time.
+   * 
+   * @tparam Capacity maximum input length
+   * @param input input buffer
+   * @return encoded item
+   */
+  template<std::size_t Capacity>
+  constexpr Bytes<Capacity + 9> encodeBytes(const Bytes<Capacity> &input) {
+    Bytes<Capacity + 9> output {};
+
+    if(input.length == 1 && input.value[0] < 0x80) {
+      output.value[output.length++] = input.value[0];
+      return output;
+    }
+
+    if(input.length < 56) {
+      output.value[output.length++] = 0x80 + input.length;
+    } else {
+      std::size_t bytesLength = 0;
+      for(std::size_t x = input.length; x != 0; x >>= 8) ++bytesLength;
+
+      output.value[output.length++] = 0xb7 + bytesLength;
+      for(std::size_t i = bytesLength; i > 0; i--) output.value[output.length++] = (input.length >> (8 * (i - 1))) & 0xFF;
+    }
+
+    for(std::size_t i = 0; i < input.length; i++) output.value[output.length++] = input.value[i];
+
+    return output;
+  }
 }
\ No newline at end of file
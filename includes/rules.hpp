@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include <strings.h>
+
+#include "config.hpp"
+#include "abi.hpp"
+#include "uint256.hpp"
+#include "bot.hpp"
+
+/**
+ * @brief Client-side filter rules of target liquidity adds.
+ *
+ * Rules applying to the current target are compiled into a flat program: bounds of the same field are intersected,
+ * so range checks cost the same for any number of rules, and blacklisted senders are sorted. Evaluation compares
+ * every field with its bounds and searches the blacklist in a number of steps depending on its length only,
+ * outcomes are combined with bitwise operations, there are no branches on message data.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#filter-rules
+ */
+namespace Rules {
+  /**
+   * @brief Numeric fields of liquidity add checked against bounds.
+   */
+  enum Field : std::size_t {
+    Liquidity,  // liquidity added in wrapped native token (wei)
+    GasPrice,   // gas price, maxFeePerGas of EIP-1559 transaction (wei)
+    TokenRatio, // token amount (smallest units) added per 1 ETH of liquidity, infinite without liquidity
+    FieldsCount
+  };
+
+  /**
+   * @brief Converts hexadecimal char (any case) to its value without branches, input has to be valid.
+   */
+  inline constexpr std::uint64_t nibble(char x) {
+    return (x & 0xf) + 9 * ((x >> 6) & 1);
+  }
+
+  /**
+   * @brief Address packed in integers, most significant bytes first.
+   */
+  struct Key {
+    std::uint64_t high = 0;   // bytes 0-7
+    std::uint64_t middle = 0; // bytes 8-15
+    std::uint64_t low = 0;    // bytes 16-19
+
+    /**
+     * @brief Parses address hexadecimal string (40 chars, without 0x prefix).
+     */
+    static constexpr Key fromHex(const char *hex) {
+      Key key;
+      for(std::size_t i = 0; i < 16; i++) key.high = key.high << 4 | nibble(hex[i]);
+      for(std::size_t i = 16; i < 32; i++) key.middle = key.middle << 4 | nibble(hex[i]);
+      for(std::size_t i = 32; i < ABI::AddressLength; i++) key.low = key.low << 4 | nibble(hex[i]);
+      return key;
+    }
+  };
+
+  inline bool equal(const Key &a, const Key &b) {
+    return ((a.high ^ b.high) | (a.middle ^ b.middle) | (a.low ^ b.low)) == 0;
+  }
+
+  inline bool less(const Key &a, const Key &b) {
+    return (a.high < b.high) | ((a.high == b.high) & ((a.middle < b.middle) | ((a.middle == b.middle) & (a.low < b.low))));
+  }
+
+  /**
+   * @brief Fields of liquidity add the rules are evaluated over.
+   */
+  struct Fields {
+    double values[FieldsCount];
+    Key sender;
+  };
+
+  /**
+   * @brief Converts 256-bit integer to the nearest double.
+   */
+  inline double toDouble(const UInt256 &value) {
+    return value.limbs[3] * 0x1p192 + value.limbs[2] * 0x1p128 + value.limbs[1] * 0x1p64 + static_cast<double>(value.limbs[0]);
+  }
+
+  /**
+   * @brief Pulls checked fields from the target liquidity add (addLiquidityETH or addLiquidity).
+   *
+   * @param message input message, validated
+   * @param gasPrice gas price (maxFeePerGas of EIP-1559 transaction) parsed from the message
+   * @param fields output fields
+   * @param wrappedNativeAddress wrapped native token address
+   */
+  inline void extract(const char *message, std::uint64_t gasPrice, Fields &fields, const char *wrappedNativeAddress = Config::Router::Selected.WrappedNative) {
+    char word[ABI::WordLength + 1];
+
+    std::size_t wordLength = BloXrouteMessageParser::extractLiquidityETH(message, word, wrappedNativeAddress);
+    double liquidity = toDouble(UInt256::fromHexString(word, wordLength));
+
+    wordLength = BloXrouteMessageParser::extractAmountTokenDesired(message, word, wrappedNativeAddress);
+    double tokens = toDouble(UInt256::fromHexString(word, wordLength));
+
+    fields.values[Liquidity] = liquidity;
+    fields.values[GasPrice] = static_cast<double>(gasPrice);
+    fields.values[TokenRatio] = liquidity > 0 ? tokens / liquidity * 1e18 : std::numeric_limits<double>::infinity();
+
+    char from[ABI::AddressLength + 1];
+    fields.sender = BloXrouteMessageParser::extractFrom(message, from) == ABI::AddressLength ? Key::fromHex(from) : Key {};
+  }
+
+  /**
+   * @brief Rules of the target compiled into field bounds and sorted blacklist.
+   *
+   * @tparam Capacity maximum number of blacklisted senders
+   */
+  template<std::size_t Capacity>
+  class Program {
+    double lower[FieldsCount];
+    double upper[FieldsCount];
+
+    /**
+     * @brief Sorted blacklisted senders, followed by the last one repeated (the search reads one key past its result).
+     */
+    Key blacklist[Capacity + 1];
+    std::size_t blacklistCount = 0;
+    std::size_t rulesCount = 0;
+
+    public:
+
+    Program() {
+      compile(nullptr, 0, "");
+    }
+
+    /**
+     * @brief Compiles rules applying to the target and to every target, previous program is replaced.
+     *
+     * @param rules rules array
+     * @param count rules count
+     * @param targetTokenAddress target token address (without 0x prefix)
+     * @return number of compiled rules, blacklisted senders above capacity are dropped
+     */
+    std::size_t compile(const Config::Rules::Rule *rules, std::size_t count, const char *targetTokenAddress) {
+      using Config::Rules::RuleKind;
+
+      for(std::size_t i = 0; i < FieldsCount; i++) {
+        lower[i] = -std::numeric_limits<double>::infinity();
+        upper[i] = std::numeric_limits<double>::infinity();
+      }
+      blacklistCount = rulesCount = 0;
+
+      for(std::size_t i = 0; i < count; i++) {
+        const Config::Rules::Rule &rule = rules[i];
+        if(rule.Token[0] != '\0' && strncasecmp(rule.Token, targetTokenAddress, ABI::AddressLength) != 0) continue;
+
+        if(rule.Kind == RuleKind::MinLiquidity) {
+          lower[Liquidity] = std::max(lower[Liquidity], rule.Min);
+        } else if(rule.Kind == RuleKind::MaxGasPrice) {
+          upper[GasPrice] = std::min(upper[GasPrice], rule.Max);
+        } else if(rule.Kind == RuleKind::TokenRatio) {
+          lower[TokenRatio] = std::max(lower[TokenRatio], rule.Min);
+          upper[TokenRatio] = std::min(upper[TokenRatio], rule.Max);
+        } else if(blacklistCount < Capacity) {
+          blacklist[blacklistCount++] = Key::fromHex(rule.Sender);
+        } else {
+          continue;
+        }
+
+        rulesCount++;
+      }
+
+      // Insertion sort, the blacklist is short and compiled off the hot path
+      for(std::size_t i = 1; i < blacklistCount; i++) {
+        Key key = blacklist[i];
+        std::size_t j = i;
+        for(; j > 0 && less(key, blacklist[j - 1]); j--) blacklist[j] = blacklist[j - 1];
+        blacklist[j] = key;
+      }
+      if(blacklistCount != 0) blacklist[blacklistCount] = blacklist[blacklistCount - 1];
+
+      return rulesCount;
+    }
+
+    /**
+     * @brief Checks if liquidity add passes the rules. Every bound is compared, blacklist is searched in log2 steps of its length.
+     *
+     * @param fields fields of liquidity add
+     * @return false if any rule rejects it
+     */
+    bool accepts(const Fields &fields) const {
+      bool rejected = false;
+      for(std::size_t i = 0; i < FieldsCount; i++) {
+        rejected |= (fields.values[i] < lower[i]) | (fields.values[i] > upper[i]);
+      }
+
+      // Lower bound of the sender is the key found or the one after it
+      if(blacklistCount != 0) {
+        const Key *base = blacklist;
+        for(std::size_t length = blacklistCount; length > 1; length -= length / 2) {
+          base += less(base[length / 2], fields.sender) * (length / 2);
+        }
+        rejected |= equal(base[0], fields.sender) | equal(base[1], fields.sender);
+      }
+
+      return !rejected;
+    }
+
+    /**
+     * @brief Returns number of compiled rules.
+     */
+    std::size_t size() const {
+      return rulesCount;
+    }
+
+    /**
+     * @brief Prints compiled bounds to standard output.
+     */
+    void print() const {
+      printf(
+        "Filter rules (%zu of the target): liquidity >= %g wei, gas price <= %g wei, %g to %g tokens per ETH, %zu blacklisted senders\n",
+        rulesCount, lower[Liquidity], upper[GasPrice], lower[TokenRatio], upper[TokenRatio], blacklistCount
+      );
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "config.hpp"
+#include "pregen.hpp"
+
+/**
+ * @brief Pregenerated transactions published by the pregen daemon in POSIX shared memory and read by bot processes.
+ *
+ * Every wallet has two slots. The daemon rewrites the inactive one and then makes it active, so readers keep using
+ * the active slot while the new one is being written. Slot is rewritten no sooner than a grace period after it was
+ * deactivated, and each slot is guarded by its own seqlock: a reader copies the message out and retries if the sequence
+ * changed meanwhile (reader stalled for the whole grace period).
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#shared-pregeneration
+ */
+namespace Shared {
+  /**
+   * @brief Segment magic ("SNIPPREG").
+   */
+  inline constexpr std::uint64_t Magic = 0x534e495050524547;
+
+  /**
+   * @brief Segment layout version, bump on any change of the structures below.
+   */
+  inline constexpr std::uint32_t LayoutVersion = 1;
+
+  /**
+   * @brief Slot with transactions pregenerated for single nonce and transaction data.
+   */
+  template<typename StoreType, std::size_t DataLength>
+  struct Slot {
+    /**
+     * @brief Seqlock sequence, odd while the slot is being written.
+     */
+    std::atomic<std::uint64_t> sequence;
+
+    std::uint64_t nonce;
+    char data[DataLength + 1];
+    StoreType store;
+  };
+
+  /**
+   * @brief Pregenerated transactions of a wallet.
+   */
+  template<typename StoreType, std::size_t DataLength>
+  struct Table {
+    std::atomic<std::uint32_t> active;
+    Slot<StoreType, DataLength> slots[2];
+  };
+
+  /**
+   * @brief Shared memory segment layout.
+   *
+   * @tparam StoreType type of pregenerated transactions store
+   * @tparam DataLength transaction data hex length
+   * @tparam Wallets number of wallets
+   */
+  template<typename StoreType, std::size_t DataLength, std::size_t Wallets>
+  struct Segment {
+    std::uint64_t magic;
+    std::uint32_t layoutVersion;
+    std::uint32_t wallets;
+    std::uint64_t size;
+
+    /**
+     * @brief Incremented on every publish, lets readers notice updates cheaply.
+     */
+    std::atomic<std::uint64_t> generation;
+
+    Table<StoreType, DataLength> tables[Wallets];
+  };
+
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free, "Shared memory atomics have to be lock-free");
+
+  /**
+   * @brief Creates (or recreates) shared memory segment and maps it read-write. Pages are zero filled.
+   *
+   * @param name segment name (starting with /)
+   * @param size segment size
+   * @param mode permissions of the segment
+   * @return mapped address, nullptr on failure
+   */
+  inline void *createSegment(const char *name, std::size_t size, mode_t mode = 0600) {
+    shm_unlink(name);
+
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, mode);
+    if(fd == -1) return nullptr;
+
+    if(ftruncate(fd, size) == -1) {
+      close(fd);
+      shm_unlink(name);
+      return nullptr;
+    }
+
+    void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(address == MAP_FAILED) {
+      shm_unlink(name);
+      return nullptr;
+    }
+
+    return address;
+  }
+
+  /**
+   * @brief Maps existing shared memory segment.
+   *
+   * @param name segment name (starting with /)
+   * @param size expected segment size
+   * @param writable map read-write, read-only otherwise
+   * @return mapped address, nullptr if the segment does not exist or its size does not match
+   */
+  inline void *openSegment(const char *name, std::size_t size, bool writable) {
+    int fd = shm_open(name, writable ? O_RDWR : O_RDONLY, 0);
+    if(fd == -1) return nullptr;
+
+    struct stat status;
+    if(fstat(fd, &status) == -1 || static_cast<std::size_t>(status.st_size) != size) {
+      close(fd);
+      return nullptr;
+    }
+
+    void *address = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    return address == MAP_FAILED ? nullptr : address;
+  }
+
+  /**
+   * @brief Mapping of the segment, owned by the daemon (read-write) or a bot process (read-only).
+   *
+   * @tparam StoreType type of pregenerated transactions store
+   * @tparam DataLength transaction data hex length
+   * @tparam Wallets number of wallets
+   */
+  template<typename StoreType, std::size_t DataLength, std::size_t Wallets>
+  class Mapping {
+    public:
+
+    using SegmentType = Segment<StoreType, DataLength, Wallets>;
+
+    static_assert(std::is_trivially_copyable_v<StoreType>, "Store has to be trivially copyable to live in shared memory");
+
+    private:
+
+    SegmentType *segment = nullptr;
+
+    /**
+     * @brief Time the inactive slot of each wallet was deactivated (steady clock), written by the daemon only.
+     */
+    std::chrono::steady_clock::time_point deactivatedAt[Wallets] = {};
+
+    public:
+
+    Mapping() = default;
+    Mapping(const Mapping&) = delete;
+    Mapping &operator=(const Mapping&) = delete;
+
+    ~Mapping() {
+      close();
+    }
+
+    /**
+     * @brief Creates (or recreates) the segment and maps it read-write. Used by the daemon.
+     *
+     * @param name segment name (starting with /)
+     * @return false on failure
+     */
+    bool create(const char *name) {
+      close();
+
+      void *address = createSegment(name, sizeof(SegmentType), 0644);
+      if(address == nullptr) return false;
+
+      // Pages are zeroed by ftruncate: every slot is empty with even sequence, only the header is written
+      segment = static_cast<SegmentType*>(address);
+      segment->magic = Magic;
+      segment->layoutVersion = LayoutVersion;
+      segment->wallets = Wallets;
+      segment->size = sizeof(SegmentType);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * @brief Maps existing segment read-only. Used by bot processes.
+     *
+     * @param name segment name (starting with /)
+     * @return false if the segment does not exist or its layout does not match
+     */
+    bool open(const char *name) {
+      close();
+
+      void *address = openSegment(name, sizeof(SegmentType), false);
+      if(address == nullptr) return false;
+
+      segment = static_cast<SegmentType*>(address);
+      if(segment->magic != Magic || segment->layoutVersion != LayoutVersion || segment->wallets != Wallets || segment->size != sizeof(SegmentType)) {
+        close();
+        return false;
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Unmaps the segment.
+     */
+    void close() {
+      if(segment == nullptr) return;
+
+      munmap(segment, sizeof(SegmentType));
+      segment = nullptr;
+    }
+
+    /**
+     * @brief Removes the segment name, existing mappings stay valid.
+     */
+    static void unlink(const char *name) {
+      shm_unlink(name);
+    }
+
+    bool isOpen() const {
+      return segment != nullptr;
+    }
+
+    /**
+     * @brief Returns generation of the segment (number of publishes).
+     */
+    std::uint64_t generation() const {
+      return segment->generation.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Publishes transactions of a wallet: copies them to the inactive slot and makes it active.
+     * Waits until the inactive slot is out of the grace period. Supports single writer.
+     *
+     * @param wallet wallet index
+     * @param nonce nonce of the transactions
+     * @param data transaction data hex c-string of the transactions
+     * @param store pregenerated transactions
+     */
+    void publish(std::size_t wallet, std::uint64_t nonce, const char *data, const StoreType &store) {
+      Table<StoreType, DataLength> &table = segment->tables[wallet];
+      std::uint32_t index = table.active.load(std::memory_order_relaxed) ^ 1;
+      Slot<StoreType, DataLength> &slot = table.slots[index];
+
+      std::this_thread::sleep_until(deactivatedAt[wallet] + std::chrono::milliseconds(Config::SharedPreGen::GraceMilliseconds));
+
+      std::uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+      slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      slot.nonce = nonce;
+      std::size_t dataLength = strnlen(data, DataLength);
+      memcpy(slot.data, data, dataLength);
+      slot.data[dataLength] = '\0';
+      memcpy(static_cast<void*>(&slot.store), &store, sizeof(StoreType));
+
+      slot.sequence.store(sequence + 2, std::memory_order_release);
+      table.active.store(index, std::memory_order_release);
+      deactivatedAt[wallet] = std::chrono::steady_clock::now();
+      segment->generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Copies pregenerated message of a wallet for given gas price, if it matches the nonce and transaction data.
+     *
+     * @param wallet wallet index
+     * @param nonce expected nonce
+     * @param data expected transaction data hex c-string
+     * @param gasPrice gas price (wei)
+     * @param policy what to do when there is no message with exactly given gas price
+     * @param maxBump maximum accepted gas price overpay for MissPolicy::NearestAbove (wei)
+     * @param output output message
+     * @param gasPriceOutput output gas price of the message (wei)
+     * @return output message length, 0 if there is no matching message
+     */
+    std::size_t read(
+      std::size_t wallet, std::uint64_t nonce, const char *data, std::uint64_t gasPrice,
+      Config::TransactionPreGen::MissPolicy policy, std::uint64_t maxBump, char *output, std::uint64_t &gasPriceOutput
+    ) const {
+      const Table<StoreType, DataLength> &table = segment->tables[wallet];
+
+      while(true) {
+        const Slot<StoreType, DataLength> &slot = table.slots[table.active.load(std::memory_order_acquire)];
+
+        std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if(sequence & 1) continue;
+
+        std::size_t length = 0;
+        // Data may be torn by the writer, lookup bounds slot indexes so reads stay within the mapping until the sequence check
+        if(slot.nonce == nonce && slot.store.size() <= StoreType::MaxSize && strncmp(slot.data, data, DataLength) == 0) {
+          const auto *entry = slot.store.lookup(gasPrice, policy, maxBump);
+          if(entry != nullptr) {
+            length = slot.store.copy(*entry, output);
+            gasPriceOutput = entry->gasPrice;
+          }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.sequence.load(std::memory_order_relaxed) == sequence) return length;
+      }
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "config.hpp"
+#include "transaction.hpp"
+#include "queue.hpp"
+#include "pipeline.hpp"
+#include "shared.hpp"
+
+/**
+ * @brief Signing in a separate signer process holding private keys, over shared memory rings.
+ *
+ * Bot process pushes sign requests to one SPSC ring and busy-polls the other one for signed messages,
+ * signer process busy-polls requests. Neither side makes a system call on the hot path.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#isolated-signer
+ */
+namespace Signer {
+  /**
+   * @brief Channel magic ("SNIPSIGN").
+   */
+  inline constexpr std::uint64_t Magic = 0x534e49505349474e;
+
+  /**
+   * @brief Channel layout version, bump on any change of the structures below.
+   */
+  inline constexpr std::uint32_t LayoutVersion = 1;
+
+  /**
+   * @brief Hints the CPU that the thread is spinning.
+   */
+  inline void relax() {
+    #if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+    #endif
+  }
+
+  /**
+   * @brief Shared memory channel layout.
+   *
+   * @tparam QueueCapacity capacity of each ring, must be power of two
+   * @tparam MessageSize maximum size of signed message
+   */
+  template<std::size_t QueueCapacity, std::size_t MessageSize>
+  struct Segment {
+    std::uint64_t magic;
+    std::uint32_t layoutVersion;
+    std::uint32_t queueCapacity;
+    std::uint64_t size;
+
+    /**
+     * @brief Process id of the serving signer, 0 if not serving.
+     */
+    std::atomic<std::uint64_t> server;
+
+    SPSCQueue<Pipeline::SignRequest, QueueCapacity> requests;
+    SPSCQueue<Pipeline::SignedMessage<MessageSize>, QueueCapacity> responses;
+  };
+
+  /**
+   * @brief Mapping of the channel, created by the signer process and opened by the bot process.
+   * Both sides map it read-write, each producing into one ring.
+   *
+   * @tparam QueueCapacity capacity of each ring, must be power of two
+   * @tparam MessageSize maximum size of signed message
+   */
+  template<std::size_t QueueCapacity, std::size_t MessageSize>
+  class Channel {
+    public:
+
+    using SegmentType = Segment<QueueCapacity, MessageSize>;
+    using ResultType = Pipeline::SignedMessage<MessageSize>;
+
+    private:
+
+    SegmentType *segment = nullptr;
+
+    public:
+
+    Channel() = default;
+    Channel(const Channel&) = delete;
+    Channel &operator=(const Channel&) = delete;
+
+    ~Channel() {
+      close();
+    }
+
+    /**
+     * @brief Creates (or recreates) the channel. Used by the signer process.
+     *
+     * @param name segment name (starting with /)
+     * @return false on failure
+     */
+    bool create(const char *name) {
+      close();
+
+      void *address = Shared::createSegment(name, sizeof(SegmentType));
+      if(address == nullptr) return false;
+
+      // Pages are zeroed by ftruncate, so both rings start empty
+      segment = static_cast<SegmentType*>(address);
+      segment->magic = Magic;
+      segment->layoutVersion = LayoutVersion;
+      segment->queueCapacity = QueueCapacity;
+      segment->size = sizeof(SegmentType);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * @brief Opens existing channel. Used by the bot process.
+     *
+     * @param name segment name (starting with /)
+     * @return false if the channel does not exist or its layout does not match
+     */
+    bool open(const char *name) {
+      close();
+
+      void *address = Shared::openSegment(name, sizeof(SegmentType), true);
+      if(address == nullptr) return false;
+
+      segment = static_cast<SegmentType*>(address);
+      if(segment->magic != Magic || segment->layoutVersion != LayoutVersion || segment->queueCapacity != QueueCapacity || segment->size != sizeof(SegmentType)) {
+        close();
+        return false;
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Unmaps the channel.
+     */
+    void close() {
+      if(segment == nullptr) return;
+
+      munmap(segment, sizeof(SegmentType));
+      segment = nullptr;
+    }
+
+    /**
+     * @brief Removes the channel name, existing mappings stay valid.
+     */
+    static void unlink(const char *name) {
+      shm_unlink(name);
+    }
+
+    bool isOpen() const {
+      return segment != nullptr;
+    }
+
+    /**
+     * @brief Checks if a signer serves the channel.
+     */
+    bool isServing() const {
+      return segment->server.load(std::memory_order_acquire) != 0;
+    }
+
+    /**
+     * @brief Serves requests until stopped, busy-polling the request ring. Used by the signer process.
+     *
+     * @param server process id announced to the bot process
+     * @param running serving flag, cleared to stop
+     * @param sign function signing request into the message, called as sign(Transaction&, SignRequest&, char *output), returns message length
+     * @return number of signed requests
+     */
+    template<typename Sign>
+    std::size_t serve(std::uint64_t server, const std::atomic<bool> &running, Sign sign) {
+      Transaction tx;
+      Pipeline::SignRequest request;
+      ResultType result;
+      std::size_t served = 0;
+
+      segment->server.store(server, std::memory_order_release);
+
+      while(running.load(std::memory_order_relaxed)) {
+        if(!segment->requests.pop(request)) {
+          relax();
+          continue;
+        }
+
+        result.wallet = request.wallet;
+        result.gasPrice = request.gasPrice;
+        result.receivedAt = request.receivedAt;
+        result.length = sign(tx, request, result.message);
+        result.signedAt = Pipeline::now();
+
+        while(!segment->responses.push(result)) relax();
+        ++served;
+      }
+
+      segment->server.store(0, std::memory_order_release);
+      return served;
+    }
+
+    /**
+     * @brief Passes request to the signer. Used by the bot process.
+     *
+     * @param request input request
+     * @return false if the request ring is full
+     */
+    bool submit(const Pipeline::SignRequest &request) {
+      return segment->requests.push(request);
+    }
+
+    /**
+     * @brief Takes signed message if there is any. Used by the bot process.
+     *
+     * @param result output signed message
+     * @return false if there is no signed message
+     */
+    bool poll(ResultType &result) {
+      return segment->responses.pop(result);
+    }
+
+    /**
+     * @brief Signs request in the signer process and waits for the message, busy-polling.
+     * Responses of requests which timed out before are skipped.
+     *
+     * @param request input request, receivedAt has to be unique
+     * @param output output message
+     * @param timeoutNs maximum time to wait (ns)
+     * @return output message length, 0 on timeout
+     */
+    std::size_t sign(const Pipeline::SignRequest &request, char *output, std::uint64_t timeoutNs) {
+      std::uint64_t deadline = Pipeline::now() + timeoutNs;
+      if(!submit(request)) return 0;
+
+      const ResultType *result;
+      while(true) {
+        while((result = peek()) == nullptr) {
+          if(Pipeline::now() >= deadline) return 0;
+          relax();
+        }
+
+        bool matches = result->receivedAt == request.receivedAt && result->wallet == request.wallet;
+        if(matches) memcpy(output, result->message, result->length + 1);
+        std::size_t length = result->length;
+        segment->responses.drop();
+
+        if(matches) return length;
+      }
+    }
+
+    private:
+
+    /**
+     * @brief Returns the oldest signed message without copying it, nullptr if there is none.
+     */
+    const ResultType *peek() const {
+      return segment->responses.front();
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "config.hpp"
+#include "shared.hpp"
+
+/**
+ * @brief Decision counters, gas price distributions and feed round trips of the bot published in POSIX shared memory.
+ *
+ * The event loop is the only writer: updates are relaxed load and store pairs, no locked instruction nor system call
+ * is made on the hot path. Readers (build/telemetry) map the segment read-only and never write to it, so they only share
+ * the cache lines and never stall the writer.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#telemetry
+ */
+namespace Telemetry {
+  /**
+   * @brief Segment magic ("SNIPTELE").
+   */
+  inline constexpr std::uint64_t Magic = 0x534e495054454c45;
+
+  /**
+   * @brief Segment layout version, bump on any change of the structures below.
+   */
+  inline constexpr std::uint32_t LayoutVersion = 2;
+
+  /**
+   * @brief Outcomes of processed messages and sends.
+   */
+  enum Counter : std::size_t {
+    Messages,         // messages received from the feed
+    Invalid,          // dropped by validateTransaction
+    FeeTooLong,       // gas price or priority fee longer than 16 hex chars
+    NoArmedWallet,    // valid liquidity add, but no wallet was armed
+    PregenHit,        // sent pregenerated transaction
+    PregenMiss,       // no pregenerated transaction within policy, fell back to signing
+    Signed,           // signed on demand in the event loop
+    Queued,           // handed over to the signer pool
+    RemoteSigned,     // signed by the isolated signer process
+    SignerTimeout,    // isolated signer did not sign in time
+    PongLost,         // heartbeat ping not answered in time
+    Reconnects,       // reconnects of degraded feed connection
+    Filtered,         // valid liquidity add rejected by filter rules
+    CountersCount
+  };
+
+  /**
+   * @brief Counter names, in Counter order.
+   */
+  inline constexpr const char *CounterNames[CountersCount] = {
+    "messages", "invalid", "fee too long", "no armed wallet", "pregen hit", "pregen miss", "signed", "queued", "remote signed", "signer timeout", "pong lost", "reconnects", "filtered"
+  };
+
+  /**
+   * @brief Gas price distributions.
+   */
+  enum Distribution : std::size_t {
+    MissedGasPrice,     // observed gas price (maxFeePerGas of EIP-1559 transaction) with no pregenerated transaction
+    MissedPriorityFee,  // observed maxPriorityFeePerGas of EIP-1559 transaction with no pregenerated transaction
+    HitOverpay,         // paid above observed gas price by pregenerated transaction
+    DistributionsCount
+  };
+
+  /**
+   * @brief Distribution names, in Distribution order.
+   */
+  inline constexpr const char *DistributionNames[DistributionsCount] = {
+    "missed gas price", "missed priority fee", "hit overpay"
+  };
+
+  /**
+   * @brief Number of round trip buckets, bucket i holds round trips of [2^i, 2^(i+1)) microseconds
+   * (the first one from 0, the last one open ended).
+   */
+  inline constexpr std::size_t RoundTripBuckets = 24;
+
+  /**
+   * @brief Returns round trip bucket of the time.
+   *
+   * @param nanoseconds round trip time
+   */
+  inline std::size_t roundTripBucket(std::uint64_t nanoseconds) {
+    std::uint64_t microseconds = nanoseconds / 1000;
+    if(microseconds == 0) return 0;
+    return std::min<std::size_t>(63 - __builtin_clzll(microseconds), RoundTripBuckets - 1);
+  }
+
+  /**
+   * @brief Value padded to its own cache line, so the reader polling one does not share the line with others.
+   */
+  struct alignas(64) Cell {
+    std::atomic<std::uint64_t> value;
+  };
+
+  /**
+   * @brief Shared memory segment layout.
+   *
+   * @tparam Buckets number of buckets of each distribution, the last one holds all values above
+   */
+  template<std::size_t Buckets>
+  struct Segment {
+    std::uint64_t magic;
+    std::uint32_t layoutVersion;
+    std::uint32_t buckets;
+    std::uint64_t size;
+    std::uint64_t bucketWidth;
+
+    /**
+     * @brief Process id of the writing bot.
+     */
+    std::uint64_t writer;
+
+    Cell counters[CountersCount];
+    alignas(64) std::atomic<std::uint64_t> distributions[DistributionsCount][Buckets];
+    alignas(64) std::atomic<std::uint64_t> roundTrips[RoundTripBuckets];
+  };
+
+  /**
+   * @brief Copy of segment values at a point in time.
+   */
+  template<std::size_t Buckets>
+  struct Snapshot {
+    std::uint64_t writer;
+    std::uint64_t bucketWidth;
+    std::uint64_t counters[CountersCount];
+    std::uint64_t distributions[DistributionsCount][Buckets];
+    std::uint64_t roundTrips[RoundTripBuckets];
+  };
+
+  /**
+   * @brief Mapping of the metrics segment, created read-write by the bot or opened read-only by readers.
+   *
+   * Until created (or when creating fails) the writer updates a process-local segment, so the hot path does not branch.
+   *
+   * @tparam Buckets number of buckets of each distribution
+   */
+  template<std::size_t Buckets>
+  class Metrics {
+    public:
+
+    using SegmentType = Segment<Buckets>;
+    using SnapshotType = Snapshot<Buckets>;
+
+    private:
+
+    SegmentType local {};
+    SegmentType *segment = &local;
+    bool mapped = false;
+    std::uint64_t bucketWidth = 1;
+
+    public:
+
+    Metrics() = default;
+    Metrics(const Metrics&) = delete;
+    Metrics &operator=(const Metrics&) = delete;
+
+    ~Metrics() {
+      close();
+    }
+
+    /**
+     * @brief Creates (or recreates) the segment. Used by the bot process.
+     *
+     * @param name segment name (starting with /)
+     * @param width distribution bucket width (wei)
+     * @param writer process id of the writer
+     * @return false if the segment could not be created
+     */
+    bool create(const char *name, std::uint64_t width, std::uint64_t writer) {
+      close();
+
+      void *address = Shared::createSegment(name, sizeof(SegmentType), 0644);
+      if(address == nullptr) return false;
+
+      // Pages are zeroed by ftruncate, so all values start at zero
+      segment = static_cast<SegmentType*>(address);
+      segment->magic = Magic;
+      segment->layoutVersion = LayoutVersion;
+      segment->buckets = Buckets;
+      segment->size = sizeof(SegmentType);
+      segment->bucketWidth = width;
+      segment->writer = writer;
+      std::atomic_thread_fence(std::memory_order_release);
+
+      mapped = true;
+      bucketWidth = width;
+      return true;
+    }
+
+    /**
+     * @brief Opens existing segment read-only. Used by readers.
+     *
+     * @param name segment name (starting with /)
+     * @return false if the segment does not exist or its layout does not match
+     */
+    bool open(const char *name) {
+      close();
+
+      void *address = Shared::openSegment(name, sizeof(SegmentType), false);
+      if(address == nullptr) return false;
+
+      segment = static_cast<SegmentType*>(address);
+      mapped = true;
+      if(segment->magic != Magic || segment->layoutVersion != LayoutVersion || segment->buckets != Buckets || segment->size != sizeof(SegmentType)) {
+        close();
+        return false;
+      }
+
+      bucketWidth = segment->bucketWidth;
+      return true;
+    }
+
+    /**
+     * @brief Unmaps the segment, writes go to the process-local segment again.
+     */
+    void close() {
+      if(!mapped) return;
+
+      munmap(segment, sizeof(SegmentType));
+      segment = &local;
+      mapped = false;
+    }
+
+    /**
+     * @brief Removes the segment name, existing mappings stay valid.
+     */
+    static void unlink(const char *name) {
+      shm_unlink(name);
+    }
+
+    bool isOpen() const {
+      return mapped;
+    }
+
+    /**
+     * @brief Increments counter. Single writer only.
+     *
+     * @param counter counter
+     * @param count increment
+     */
+    void count(Counter counter, std::uint64_t count = 1) {
+      std::atomic<std::uint64_t> &value = segment->counters[counter].value;
+      value.store(value.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds value to the distribution. Single writer only.
+     *
+     * @param distribution distribution
+     * @param value value (wei)
+     */
+    void record(Distribution distribution, std::uint64_t value) {
+      std::size_t bucket = value / bucketWidth;
+      if(bucket >= Buckets) bucket = Buckets - 1;
+
+      std::atomic<std::uint64_t> &cell = segment->distributions[distribution][bucket];
+      cell.store(cell.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds feed round trip to its histogram. Single writer only.
+     *
+     * @param nanoseconds round trip time
+     */
+    void recordRoundTrip(std::uint64_t nanoseconds) {
+      std::atomic<std::uint64_t> &cell = segment->roundTrips[roundTripBucket(nanoseconds)];
+      cell.store(cell.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copies current values. Values are read one by one, so they can be a few updates apart from each other.
+     *
+     * @param output output snapshot
+     */
+    void snapshot(SnapshotType &output) const {
+      output.writer = segment->writer;
+      output.bucketWidth = segment->bucketWidth;
+      for(std::size_t i = 0; i < CountersCount; i++) output.counters[i] = segment->counters[i].value.load(std::memory_order_relaxed);
+      for(std::size_t i = 0; i < DistributionsCount; i++) {
+        for(std::size_t j = 0; j < Buckets; j++) output.distributions[i][j] = segment->distributions[i][j].load(std::memory_order_relaxed);
+      }
+      for(std::size_t i = 0; i < RoundTripBuckets; i++) output.roundTrips[i] = segment->roundTrips[i].load(std::memory_order_relaxed);
+    }
+  };
+}
\ No newline at end of file
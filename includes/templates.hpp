@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+
+#include "config.hpp"
+#include "utils.hpp"
+#include "rlp.hpp"
+
+/**
+ * @brief Transaction fields known at compile time, RLP encoded from Config.
+ * Runtime only signs and splices them. Malformed config fails compilation.
+ */
+namespace Templates {
+  /**
+   * @brief Checks if hexadecimal quantity fits the transaction quantity buffer.
+   *
+   * @param input input hexadecimal null-terminated c-string
+   * @return boolean value if quantity is valid
+   */
+  constexpr bool isQuantity(const char *input) {
+    return Utils::isHexString(input) && Utils::stringLength(input) <= 2 * Config::Size::TransactionQuantityBuffer;
+  }
+
+  /**
+   * @brief Checks if every configured wallet has valid private key (or none), nonce and value.
+   *
+   * @return boolean value if wallets are valid
+   */
+  constexpr bool areWalletsValid() {
+    for(const Config::Wallets::Wallet &wallet : Config::Wallets::List) {
+      if(wallet.PrivateKey[0] != '\0' && !Utils::isHexString(wallet.PrivateKey, 64)) return false;
+      if(!isQuantity(wallet.Nonce) || !isQuantity(wallet.Value)) return false;
+    }
+
+    return true;
+  }
+
+  static_assert(Utils::isHexString(Config::Router::Selected.Address, 40), "Router address must be 40 hexadecimal chars");
+  static_assert(Utils::isHexString(Config::Router::Selected.WrappedNative, 40), "Wrapped native token address must be 40 hexadecimal chars");
+  static_assert(Utils::isHexString(Config::Transaction::SwapExactETHForTokens::TokenAddress, 40), "Token address must be 40 hexadecimal chars");
+  static_assert(Utils::isHexString(Config::Transaction::SwapExactETHForTokens::ReceiverAddress, 40), "Receiver address must be 40 hexadecimal chars");
+  static_assert(Utils::isHexString(Config::Transaction::SwapExactETHForTokens::AmountOutMin) && Utils::stringLength(Config::Transaction::SwapExactETHForTokens::AmountOutMin) <= 64, "AmountOutMin must be at most 64 hexadecimal chars");
+  static_assert(isQuantity(Config::Transaction::GasLimit), "Gas limit must be hexadecimal quantity");
+  static_assert(isQuantity(Config::Transaction::ChainId), "Chain ID must be hexadecimal quantity");
+  static_assert(isQuantity(Config::Exit::ApproveGasLimit) && isQuantity(Config::Exit::SellGasLimit), "Exit gas limits must be hexadecimal quantities");
+  static_assert(isQuantity(Config::Cancel::GasLimit), "Cancel gas limit must be hexadecimal quantity");
+  static_assert(areWalletsValid(), "Wallet private keys must be 64 hexadecimal chars, nonces and values hexadecimal quantities");
+  static_assert(Utils::isDecimalString(Config::BloXroute::Filters::MaxGasPrice), "MaxGasPrice filter must be decimal");
+  static_assert(Utils::isDecimalString(Config::BloXroute::Filters::MinValue), "MinValue filter must be decimal");
+
+  /**
+   * @brief RLP encoded transaction gas limit.
+   */
+  inline constexpr auto GasLimit = RLP::encodeBytes(Utils::hexStringToBytes<Config::Size::TransactionQuantityBuffer>(Config::Transaction::GasLimit, true));
+
+  /**
+   * @brief RLP encoded transaction receiver (router address).
+   */
+  inline constexpr auto To = RLP::encodeBytes(Utils::hexStringToBytes<Config::Size::TransactionAddressBuffer>(Config::Transaction::To));
+
+  static_assert(GasLimit.length <= Config::Size::TransactionQuantityBuffer + 1, "Encoded gas limit does not fit transaction buffer");
+  static_assert(To.length == Config::Size::TransactionAddressBuffer + 1, "Encoded address must be 21 bytes long");
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <secp256k1_recovery.h>
+#include <secp256k1_preallocated.h>
 
 extern "C" {
   #include <KeccakSponge.h>
@@ -16,13 +17,23 @@ class Transaction {
   /**
    * @brief Transaction's fields count.
    */
-  static inline constexpr std::size_t FieldsCount = 9;
+  static inline constexpr std::size_t FieldsCount = 13;
 
   /**
    * @brief Enum containing available transaction fields.
+   * Legacy transaction uses the first 9 fields, EIP-1559 transaction uses all of them but GasPrice.
+   * AccessList is always empty.
    */
   enum Field { 
-    Nonce, GasPrice, GasLimit, To, Value, Data, V, R, S,
+    Nonce, GasPrice, GasLimit, To, Value, Data, V, R, S, ChainId, MaxPriorityFeePerGas, MaxFeePerGas, AccessList,
+  };
+
+  /**
+   * @brief Enum containing available transaction types.
+   */
+  enum Type {
+    Legacy, // EIP-155 legacy transaction
+    DynamicFee, // EIP-1559 transaction (type 2)
   };
 
   private:
@@ -37,7 +48,37 @@ class Transaction {
   /**
    * @brief Transaction field to its type mapping.
    */
-  static inline constexpr FieldType fieldTypeMapping[FieldsCount] = { QUANTITY, QUANTITY, QUANTITY, DATA, QUANTITY, DATA, QUANTITY, QUANTITY, QUANTITY };
+  static inline constexpr FieldType fieldTypeMapping[FieldsCount] = { QUANTITY, QUANTITY, QUANTITY, DATA, QUANTITY, DATA, QUANTITY, QUANTITY, QUANTITY, QUANTITY, QUANTITY, QUANTITY, DATA };
+
+  /**
+   * @brief Legacy transaction fields count.
+   */
+  static inline constexpr std::size_t LegacyFieldsCount = 9;
+
+  /**
+   * @brief EIP-1559 transaction fields count, unsigned ones are followed by V (y parity), R and S.
+   */
+  static inline constexpr std::size_t DynamicFeeFieldsCount = 12;
+  static inline constexpr std::size_t DynamicFeeUnsignedFieldsCount = 9;
+
+  /**
+   * @brief EIP-1559 transaction fields order.
+   */
+  static inline constexpr Field dynamicFeeFieldsOrder[DynamicFeeFieldsCount] = {
+    ChainId, Nonce, MaxPriorityFeePerGas, MaxFeePerGas, GasLimit, To, Value, Data, AccessList, V, R, S,
+  };
+
+  /**
+   * @brief EIP-2718 transaction type byte of EIP-1559 transaction.
+   */
+  static inline constexpr Utils::Byte DynamicFeeTransactionType = 0x02;
+
+  /**
+   * @brief Configured chain ID decoded at compile time.
+   */
+  static inline constexpr Utils::Bytes<8> ConfigChainId = Utils::hexStringToBytes<8>(Config::Transaction::ChainId, true);
+
+  Type type = Legacy;
 
   /**
    * @brief SECP256K1 context, allows preinitialization as it's very slow to create.
@@ -52,15 +93,24 @@ class Transaction {
    */
   secp256k1_context *secp256k1Context;
 
+  /**
+   * @brief Is context held in memory given by moveContext(), which is not freed with it.
+   */
+  bool preallocatedContext = false;
+
   Utils::Byte nonce[Config::Size::TransactionQuantityBuffer];
   Utils::Byte gasPrice[Config::Size::TransactionQuantityBuffer];
-  Utils::Byte gasLimit[Config::Size::TransactionQuantityBuffer];
-  Utils::Byte to[Config::Size::TransactionAddressBuffer];
-  Utils::Byte value[Config::Size::TransactionQuantityBuffer];
+  Utils::Byte gasLimit[Config::Size::TransactionQuantityBuffer + 1]; // room for RLP header of encoded quantity
+  Utils::Byte to[Config::Size::TransactionAddressBuffer + 1]; // room for RLP header of encoded address
+  Utils::Byte value[Config::Size::TransactionQuantityBuffer + 1];
   Utils::Byte data[Config::Size::TransactionDataBuffer];
   Utils::Byte v[Config::Size::TransactionQuantityBuffer];
   Utils::Byte r[Config::Size::TransactionQuantityBuffer];
   Utils::Byte s[Config::Size::TransactionQuantityBuffer];
+  Utils::Byte chainId[Config::Size::TransactionQuantityBuffer];
+  Utils::Byte maxPriorityFeePerGas[Config::Size::TransactionQuantityBuffer];
+  Utils::Byte maxFeePerGas[Config::Size::TransactionQuantityBuffer];
+  Utils::Byte accessList[1] = { 0xc0 };
 
   /**
    * @brief RLP input data to encode.
@@ -75,8 +125,17 @@ class Transaction {
     { .buffer = v, .length = 0 },
     { .buffer = r, .length = 0 },
     { .buffer = s, .length = 0 },
+    { .buffer = chainId, .length = 0 },
+    { .buffer = maxPriorityFeePerGas, .length = 0 },
+    { .buffer = maxFeePerGas, .length = 0 },
+    { .buffer = accessList, .length = 1, .encoded = true },
   };
 
+  /**
+   * @brief Header lengths of RLP encoded fields (see setEncodedField), patches are shifted by them.
+   */
+  std::size_t payloadOffsets[FieldsCount] = {};
+
   /**
    * @brief KECCAK256 hashing function.
    * 
@@ -114,6 +173,8 @@ class Transaction {
    */
   Transaction() {
     secp256k1Context = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
+    Utils::Bytes<8> chainIdBytes = ConfigChainId;
+    setField(Field::ChainId, chainIdBytes.value, chainIdBytes.length);
   }
 
   /**
@@ -121,7 +182,37 @@ class Transaction {
    * Destroys SECP256K1 context.
    */
   ~Transaction() {
-    secp256k1_context_destroy(secp256k1Context);
+    if(preallocatedContext) {
+      secp256k1_context_preallocated_destroy(secp256k1Context);
+    } else {
+      secp256k1_context_destroy(secp256k1Context);
+    }
+  }
+
+  /**
+   * @brief Returns memory size needed to move SECP256K1 context with moveContext().
+   */
+  std::size_t contextSize() const {
+    return secp256k1_context_preallocated_clone_size(secp256k1Context);
+  }
+
+  /**
+   * @brief Moves SECP256K1 context into given memory, eg. allocated on NUMA node of the thread signing with it.
+   * Context created by constructor may have been allocated anywhere, as transactions of static objects are constructed before main.
+   *
+   * @param memory memory of at least contextSize() bytes, has to outlive the transaction (or its next move)
+   */
+  void moveContext(void *memory) {
+    secp256k1_context *moved = secp256k1_context_preallocated_clone(secp256k1Context, memory);
+
+    if(preallocatedContext) {
+      secp256k1_context_preallocated_destroy(secp256k1Context);
+    } else {
+      secp256k1_context_destroy(secp256k1Context);
+    }
+
+    secp256k1Context = moved;
+    preallocatedContext = true;
   }
 
   /**
@@ -131,6 +222,8 @@ class Transaction {
    * @param value input c-string
    */
   void setField(Field field, const char *value) {
+    rlpInput[field].encoded = false;
+    payloadOffsets[field] = 0;
     rlpInput[field].length = Utils::hexStringToBuffer(
       value, 
       rlpInput[field].buffer, 
@@ -148,16 +241,86 @@ class Transaction {
   void setField(Field field, Buffer value, std::size_t size) {
     // Trim leading zero bytes if of type Quantity
     if(fieldTypeMapping[field] == FieldType::QUANTITY) {
-      while(*value == 0 && size > 0) {
+      while(size > 0 && *value == 0) {
         ++value;
         --size;
       }
     }
 
+    rlpInput[field].encoded = false;
+    payloadOffsets[field] = 0;
     rlpInput[field].length = size;
     memcpy(rlpInput[field].buffer, value, size);
   }
 
+  /**
+   * @brief Sets the transaction field value already RLP encoded (eg. at compile time), it is copied as is when signing.
+   * Chain ID has to be set decoded, as it is injected as v.
+   * 
+   * @param field field name
+   * @param value input encoded item
+   * @param size input encoded item size
+   */
+  void setEncodedField(Field field, const Utils::Byte *value, std::size_t size) {
+    rlpInput[field].encoded = true;
+    payloadOffsets[field] = RLP::headerLength(value);
+    rlpInput[field].length = size;
+    memcpy(rlpInput[field].buffer, value, size);
+  }
+
+  /**
+   * @brief Overwrites part of already set transaction field, keeping its length.
+   * Used to patch single arguments of transaction data without rebuilding it.
+   *
+   * @param field field name
+   * @param offset byte offset in the field value (after RLP header of encoded field)
+   * @param value input buffer
+   * @param size input buffer size
+   */
+  void patchField(Field field, std::size_t offset, Buffer value, std::size_t size) {
+    memcpy(rlpInput[field].buffer + payloadOffsets[field] + offset, value, size);
+  }
+
+  /**
+   * @brief Sets the transaction type.
+   * 
+   * @param transactionType transaction type
+   */
+  void setType(Type transactionType) {
+    type = transactionType;
+  }
+
+  /**
+   * @brief Returns the transaction type.
+   */
+  Type getType() const {
+    return type;
+  }
+
+  /**
+   * @brief Derives address of the wallet owning given private key.
+   * 
+   * @param privateKey private key buffer
+   * @param address output address buffer
+   * 
+   * @return address buffer length (always 20)
+   */
+  std::size_t getAddress(Utils::Buffer privateKey, Utils::Buffer address) {
+    secp256k1_pubkey publicKey;
+    secp256k1_ec_pubkey_create(secp256k1Context, &publicKey, privateKey);
+
+    Utils::Byte serializedPublicKey[65];
+    std::size_t serializedPublicKeyLength = 65;
+    secp256k1_ec_pubkey_serialize(secp256k1Context, serializedPublicKey, &serializedPublicKeyLength, &publicKey, SECP256K1_EC_UNCOMPRESSED);
+
+    // Address is the last 20 bytes of the hash of the public key (without 0x04 prefix)
+    Utils::Byte hash[32];
+    _keccak256(serializedPublicKey + 1, 64, hash);
+    memcpy(address, hash + 12, 20);
+
+    return 20;
+  }
+
   /**
    * @brief Signs transaction.
    * 
@@ -181,32 +344,110 @@ class Transaction {
    * @return transaction buffer length
    */
   std::size_t sign(Utils::Buffer privateKey, Utils::Buffer transaction) {
+    if(type == DynamicFee) {
+      RLP::Item items[DynamicFeeFieldsCount];
+      signDynamicFee(privateKey, transaction, items);
+
+      // Encode signed transaction and return buffer length
+      transaction[0] = DynamicFeeTransactionType;
+      return RLP::encodeList(items, DynamicFeeFieldsCount, transaction + 1) + 1;
+    }
+
+    signLegacy(privateKey, transaction);
+
+    // Encode signed transaction and return buffer length
+    return RLP::encodeList(rlpInput, LegacyFieldsCount, transaction);
+  }
+
+  /**
+   * @brief Signs transaction and encodes it as hexadecimal string in a single pass, without intermediate binary buffer.
+   * 
+   * @param privateKey private key buffer to sign with
+   * @param output output hexadecimal string (not null-terminated), at least 2 * Config::Size::TransactionRawBuffer long
+   * 
+   * @return output string length
+   */
+  std::size_t signHex(Utils::Buffer privateKey, char *output) {
+    Utils::Byte unsignedTransaction[Config::Size::TransactionRawBuffer];
+
+    if(type == DynamicFee) {
+      RLP::Item items[DynamicFeeFieldsCount];
+      signDynamicFee(privateKey, unsignedTransaction, items);
+
+      Utils::Byte transactionType = DynamicFeeTransactionType;
+      std::size_t outputLength = Utils::bufferToHexString(&transactionType, 1, output);
+      return outputLength + RLP::encodeListHex(items, DynamicFeeFieldsCount, output + outputLength);
+    }
+
+    signLegacy(privateKey, unsignedTransaction);
+    return RLP::encodeListHex(rlpInput, LegacyFieldsCount, output);
+  }
+
+  private:
+
+  /**
+   * @brief Signs legacy transaction, sets v, r and s fields.
+   * 
+   * @param privateKey private key buffer to sign with
+   * @param scratch buffer for unsigned transaction, at least Config::Size::TransactionRawBuffer long
+   */
+  void signLegacy(Utils::Buffer privateKey, Utils::Buffer scratch) {
     // Inject Chain ID as v
-    rlpInput[Field::V].buffer[0] = 0x01;
-    rlpInput[Field::V].length = 1;
+    memcpy(rlpInput[Field::V].buffer, rlpInput[Field::ChainId].buffer, rlpInput[Field::ChainId].length);
+    rlpInput[Field::V].length = rlpInput[Field::ChainId].length;
 
     // Reset signature
     rlpInput[Field::R].length = 0;
     rlpInput[Field::S].length = 0;
 
     // Encode transaction
-    std::size_t transactionLength = RLP::encodeList(rlpInput, FieldsCount, transaction);
+    std::size_t transactionLength = RLP::encodeList(rlpInput, LegacyFieldsCount, scratch);
 
     // Get transaction hash
     Utils::Byte hash[32];
-    _keccak256(transaction, transactionLength, hash);
+    _keccak256(scratch, transactionLength, hash);
 
     // Get transaction signature
     Utils::Byte signature[64];
     int recid;
     _ecdsa(hash, privateKey, signature, &recid);
 
-    // Inject signature
-    rlpInput[Field::V].buffer[0] = recid + 37;
+    // Inject signature, v = recid + chainId * 2 + 35 (EIP-155)
+    std::uint64_t chainIdValue = 0;
+    for(std::size_t i = 0; i < rlpInput[Field::ChainId].length; i++) chainIdValue = (chainIdValue << 8) | rlpInput[Field::ChainId].buffer[i];
+    rlpInput[Field::V].length = Utils::intToBuffer(recid + chainIdValue * 2 + 35, rlpInput[Field::V].buffer);
     setField(Field::R, signature, 32);
     setField(Field::S, signature + 32, 32);
+  }
 
-    // Encode signed transaction and return buffer length
-    return RLP::encodeList(rlpInput, FieldsCount, transaction);
+  /**
+   * @brief Signs EIP-1559 transaction, sets v (y parity), r and s fields.
+   * 
+   * @param privateKey private key buffer to sign with
+   * @param scratch buffer for unsigned transaction, at least Config::Size::TransactionRawBuffer long
+   * @param items output fields in EIP-1559 order, DynamicFeeFieldsCount of them
+   */
+  void signDynamicFee(Utils::Buffer privateKey, Utils::Buffer scratch, RLP::Item *items) {
+    for(std::size_t i = 0; i < DynamicFeeFieldsCount; i++) items[i] = rlpInput[dynamicFeeFieldsOrder[i]];
+
+    // Encode unsigned transaction
+    scratch[0] = DynamicFeeTransactionType;
+    std::size_t transactionLength = RLP::encodeList(items, DynamicFeeUnsignedFieldsCount, scratch + 1) + 1;
+
+    // Get transaction hash
+    Utils::Byte hash[32];
+    _keccak256(scratch, transactionLength, hash);
+
+    // Get transaction signature
+    Utils::Byte signature[64];
+    int recid;
+    _ecdsa(hash, privateKey, signature, &recid);
+
+    // Inject signature, v is y parity
+    Utils::Byte yParity = recid;
+    setField(Field::V, &yParity, 1);
+    setField(Field::R, signature, 32);
+    setField(Field::S, signature + 32, 32);
+    for(std::size_t i = DynamicFeeUnsignedFieldsCount; i < DynamicFeeFieldsCount; i++) items[i] = rlpInput[dynamicFeeFieldsOrder[i]];
   }
 };
\ No newline at end of file
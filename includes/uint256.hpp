@@ -0,0 +1,324 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "utils.hpp"
+
+/**
+ * @brief Fixed-width 256-bit unsigned integer, wide enough to hold any EVM uint256 value.
+ *
+ * Stored as four 64-bit limbs, least significant first.
+ * All arithmetic wraps modulo 2^256, exactly like the EVM does.
+ */
+struct UInt256 {
+  std::uint64_t limbs[4];
+
+  /**
+   * @brief Constructs zero.
+   */
+  constexpr UInt256() : limbs { 0, 0, 0, 0 } {}
+
+  /**
+   * @brief Constructs value from 64-bit integer.
+   *
+   * @param x input integer
+   */
+  constexpr UInt256(std::uint64_t x) : limbs { x, 0, 0, 0 } {}
+
+  /**
+   * @brief Parses hexadecimal string (without 0x prefix).
+   *
+   * @param input input hexadecimal c-string
+   * @param inputLength length of the input string, at most 64 significant characters are taken
+   * @return parsed value
+   *
+   * @throws std::invalid_argument Throws when input contains non hexadecimal char
+   */
+  static UInt256 fromHexString(const char *input, std::size_t inputLength) {
+    UInt256 result;
+    if(inputLength > 64) {
+      input += inputLength - 64;
+      inputLength = 64;
+    }
+
+    for(std::size_t i = 0; i < inputLength; i++) {
+      std::size_t nibble = inputLength - 1 - i;
+      result.limbs[nibble / 16] |= static_cast<std::uint64_t>(Utils::hexCharToByte(input[i])) << (4 * (nibble % 16));
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Parses hexadecimal string (without 0x prefix), without throwing on malformed input.
+   *
+   * @param input input hexadecimal c-string
+   * @param inputLength length of the input string, at most 64 significant characters are taken
+   * @param output parsed value, left untouched if input is malformed
+   * @return false if input contains non hexadecimal char
+   */
+  static bool tryFromHexString(const char *input, std::size_t inputLength, UInt256 &output) {
+    UInt256 result;
+    if(inputLength > 64) {
+      input += inputLength - 64;
+      inputLength = 64;
+    }
+
+    for(std::size_t i = 0; i < inputLength; i++) {
+      char x = input[i];
+      std::uint64_t value;
+      if(x >= '0' && x <= '9') value = x - '0';
+      else if(x >= 'A' && x <= 'F') value = x - 'A' + 10;
+      else if(x >= 'a' && x <= 'f') value = x - 'a' + 10;
+      else return false;
+
+      std::size_t nibble = inputLength - 1 - i;
+      result.limbs[nibble / 16] |= value << (4 * (nibble % 16));
+    }
+
+    output = result;
+    return true;
+  }
+
+  /**
+   * @brief Parses hexadecimal null-terminated string (without 0x prefix).
+   *
+   * @param input input hexadecimal null-terminated c-string
+   * @return parsed value
+   */
+  static UInt256 fromHexString(const char *input) {
+    return fromHexString(input, strlen(input));
+  }
+
+  /**
+   * @brief Parses decimal null-terminated string, parsing stops at the first non decimal char.
+   *
+   * @param input input decimal null-terminated c-string
+   * @return parsed value
+   */
+  static UInt256 fromDecimalString(const char *input) {
+    UInt256 result;
+    for(; *input >= '0' && *input <= '9'; input++) {
+      result = result * UInt256(10) + UInt256(static_cast<std::uint64_t>(*input - '0'));
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Writes value as 32 byte big-endian buffer (ABI word).
+   *
+   * @param output output buffer, at least 32 bytes long
+   * @return output buffer length (always 32)
+   */
+  std::size_t toBuffer(Utils::Buffer output) const {
+    for(std::size_t i = 0; i < 4; i++) {
+      std::uint64_t limb = limbs[3 - i];
+      for(std::size_t j = 0; j < 8; j++) {
+        output[i * 8 + j] = (limb >> (56 - 8 * j)) & 0xFF;
+      }
+    }
+
+    return 32;
+  }
+
+  /**
+   * @brief Returns number of significant bits (0 for zero).
+   */
+  std::size_t bitLength() const {
+    for(std::size_t i = 4; i > 0; i--) {
+      if(limbs[i - 1] != 0) return (i - 1) * 64 + (64 - __builtin_clzll(limbs[i - 1]));
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Checks if value fits in 64 bits.
+   */
+  bool fitsUint64() const {
+    return (limbs[1] | limbs[2] | limbs[3]) == 0;
+  }
+
+  friend bool operator==(const UInt256 &a, const UInt256 &b) {
+    return a.limbs[0] == b.limbs[0] && a.limbs[1] == b.limbs[1] && a.limbs[2] == b.limbs[2] && a.limbs[3] == b.limbs[3];
+  }
+
+  friend bool operator!=(const UInt256 &a, const UInt256 &b) {
+    return !(a == b);
+  }
+
+  friend bool operator<(const UInt256 &a, const UInt256 &b) {
+    for(std::size_t i = 4; i > 0; i--) {
+      if(a.limbs[i - 1] != b.limbs[i - 1]) return a.limbs[i - 1] < b.limbs[i - 1];
+    }
+    return false;
+  }
+
+  friend bool operator>(const UInt256 &a, const UInt256 &b) { return b < a; }
+  friend bool operator<=(const UInt256 &a, const UInt256 &b) { return !(b < a); }
+  friend bool operator>=(const UInt256 &a, const UInt256 &b) { return !(a < b); }
+
+  friend UInt256 operator+(const UInt256 &a, const UInt256 &b) {
+    UInt256 result;
+    unsigned __int128 carry = 0;
+    for(std::size_t i = 0; i < 4; i++) {
+      carry += static_cast<unsigned __int128>(a.limbs[i]) + b.limbs[i];
+      result.limbs[i] = static_cast<std::uint64_t>(carry);
+      carry >>= 64;
+    }
+    return result;
+  }
+
+  friend UInt256 operator-(const UInt256 &a, const UInt256 &b) {
+    UInt256 result;
+    std::uint64_t borrow = 0;
+    for(std::size_t i = 0; i < 4; i++) {
+      std::uint64_t difference = a.limbs[i] - b.limbs[i];
+      std::uint64_t nextBorrow = (a.limbs[i] < b.limbs[i]) | (difference < borrow);
+      result.limbs[i] = difference - borrow;
+      borrow = nextBorrow;
+    }
+    return result;
+  }
+
+  friend UInt256 operator*(const UInt256 &a, const UInt256 &b) {
+    UInt256 result;
+    for(std::size_t i = 0; i < 4; i++) {
+      if(a.limbs[i] == 0) continue;
+
+      unsigned __int128 carry = 0;
+      for(std::size_t j = 0; i + j < 4; j++) {
+        carry += static_cast<unsigned __int128>(a.limbs[i]) * b.limbs[j] + result.limbs[i + j];
+        result.limbs[i + j] = static_cast<std::uint64_t>(carry);
+        carry >>= 64;
+      }
+    }
+    return result;
+  }
+
+  friend UInt256 operator<<(const UInt256 &a, std::size_t shift) {
+    UInt256 result;
+    if(shift >= 256) return result;
+
+    std::size_t limbShift = shift / 64, bitShift = shift % 64;
+    for(std::size_t i = 4; i > limbShift; i--) {
+      std::size_t j = i - 1 - limbShift;
+      result.limbs[i - 1] = a.limbs[j] << bitShift;
+      if(bitShift != 0 && j > 0) result.limbs[i - 1] |= a.limbs[j - 1] >> (64 - bitShift);
+    }
+    return result;
+  }
+
+  friend UInt256 operator>>(const UInt256 &a, std::size_t shift) {
+    UInt256 result;
+    if(shift >= 256) return result;
+
+    std::size_t limbShift = shift / 64, bitShift = shift % 64;
+    for(std::size_t i = 0; i + limbShift < 4; i++) {
+      std::size_t j = i + limbShift;
+      result.limbs[i] = a.limbs[j] >> bitShift;
+      if(bitShift != 0 && j < 3) result.limbs[i] |= a.limbs[j + 1] << (64 - bitShift);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Divides two values, rounding down (like EVM DIV).
+   *
+   * Uses 128-bit hardware division when divisor fits in 64 bits,
+   * otherwise Knuth's algorithm D on 32-bit digits.
+   *
+   * @param a dividend
+   * @param b divisor
+   * @return quotient, zero when dividing by zero
+   *
+   * @see https://skanthak.homepage.t-online.de/division.html (Hacker's Delight divmnu)
+   */
+  friend UInt256 operator/(const UInt256 &a, const UInt256 &b) {
+    UInt256 quotient;
+    if(b.fitsUint64()) {
+      if(b.limbs[0] == 0) return quotient;
+
+      unsigned __int128 remainder = 0;
+      for(std::size_t i = 4; i > 0; i--) {
+        remainder = (remainder << 64) | a.limbs[i - 1];
+        quotient.limbs[i - 1] = static_cast<std::uint64_t>(remainder / b.limbs[0]);
+        remainder %= b.limbs[0];
+      }
+      return quotient;
+    }
+
+    if(a < b) return quotient;
+
+    // Split into 32-bit digits, least significant first
+    std::uint32_t u[8], v[8], q[8] = {};
+    for(std::size_t i = 0; i < 4; i++) {
+      u[2 * i] = static_cast<std::uint32_t>(a.limbs[i]);
+      u[2 * i + 1] = static_cast<std::uint32_t>(a.limbs[i] >> 32);
+      v[2 * i] = static_cast<std::uint32_t>(b.limbs[i]);
+      v[2 * i + 1] = static_cast<std::uint32_t>(b.limbs[i] >> 32);
+    }
+
+    std::size_t m = (a.bitLength() + 31) / 32;
+    std::size_t n = (b.bitLength() + 31) / 32;
+
+    // Normalize, so the highest divisor digit has its top bit set
+    int shift = __builtin_clz(v[n - 1]);
+    std::uint32_t un[9], vn[8];
+    for(std::size_t i = n - 1; i > 0; i--) {
+      vn[i] = (v[i] << shift) | (shift ? static_cast<std::uint32_t>(static_cast<std::uint64_t>(v[i - 1]) >> (32 - shift)) : 0);
+    }
+    vn[0] = v[0] << shift;
+
+    un[m] = shift ? static_cast<std::uint32_t>(static_cast<std::uint64_t>(u[m - 1]) >> (32 - shift)) : 0;
+    for(std::size_t i = m - 1; i > 0; i--) {
+      un[i] = (u[i] << shift) | (shift ? static_cast<std::uint32_t>(static_cast<std::uint64_t>(u[i - 1]) >> (32 - shift)) : 0);
+    }
+    un[0] = u[0] << shift;
+
+    for(std::size_t j = m - n + 1; j > 0; j--) {
+      std::size_t k = j - 1;
+
+      // Estimate quotient digit
+      std::uint64_t numerator = (static_cast<std::uint64_t>(un[k + n]) << 32) | un[k + n - 1];
+      std::uint64_t qhat = numerator / vn[n - 1];
+      std::uint64_t rhat = numerator % vn[n - 1];
+      while(qhat >> 32 || qhat * vn[n - 2] > ((rhat << 32) | un[k + n - 2])) {
+        --qhat;
+        rhat += vn[n - 1];
+        if(rhat >> 32) break;
+      }
+
+      // Multiply and subtract
+      std::int64_t borrow = 0, t;
+      for(std::size_t i = 0; i < n; i++) {
+        std::uint64_t p = qhat * vn[i];
+        t = un[i + k] - borrow - static_cast<std::int64_t>(p & 0xFFFFFFFF);
+        un[i + k] = static_cast<std::uint32_t>(t);
+        borrow = static_cast<std::int64_t>(p >> 32) - (t >> 32);
+      }
+      t = un[k + n] - borrow;
+      un[k + n] = static_cast<std::uint32_t>(t);
+
+      // Add back if subtracted too much
+      if(t < 0) {
+        --qhat;
+        std::uint64_t carry = 0;
+        for(std::size_t i = 0; i < n; i++) {
+          carry += static_cast<std::uint64_t>(un[i + k]) + vn[i];
+          un[i + k] = static_cast<std::uint32_t>(carry);
+          carry >>= 32;
+        }
+        un[k + n] += static_cast<std::uint32_t>(carry);
+      }
+
+      q[k] = static_cast<std::uint32_t>(qhat);
+    }
+
+    for(std::size_t i = 0; i < 4; i++) {
+      quotient.limbs[i] = (static_cast<std::uint64_t>(q[2 * i + 1]) << 32) | q[2 * i];
+    }
+    return quotient;
+  }
+};
\ No newline at end of file
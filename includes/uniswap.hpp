@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+#include "uint256.hpp"
+
+/**
+ * @brief Uniswap V2 constant-product pool math, used to price our swap against observed liquidity add.
+ *
+ * @see https://github.com/Uniswap/v2-periphery/blob/master/contracts/libraries/UniswapV2Library.sol
+ */
+namespace UniswapV2 {
+  /**
+   * @brief Swap fee numerator (0.3% fee).
+   */
+  inline constexpr std::uint64_t FeeNumerator = 997;
+
+  /**
+   * @brief Swap fee denominator.
+   */
+  inline constexpr std::uint64_t FeeDenominator = 1000;
+
+  /**
+   * @brief Basis points denominator used by slippage calculation.
+   */
+  inline constexpr std::uint64_t BasisPointsDenominator = 10000;
+
+  /**
+   * @brief Calculates maximum output amount of the swap, the same way UniswapV2Library.getAmountOut does.
+   *
+   * @param amountIn input amount
+   * @param reserveIn reserve of input token
+   * @param reserveOut reserve of output token
+   * @return output amount, zero if amountIn or reserveOut is zero, whole reserveOut if reserveIn is zero (check hasReserves first)
+   */
+  inline UInt256 getAmountOut(const UInt256 &amountIn, const UInt256 &reserveIn, const UInt256 &reserveOut) {
+    UInt256 amountInWithFee = amountIn * FeeNumerator;
+    UInt256 denominator = reserveIn * FeeDenominator + amountInWithFee;
+    return (amountInWithFee * reserveOut) / denominator;
+  }
+
+  /**
+   * @brief Checks if both reserves are non-zero, output of the swap is meaningless otherwise.
+   *
+   * @param reserveIn reserve of input token
+   * @param reserveOut reserve of output token
+   * @return true if the pool can be priced
+   */
+  inline bool hasReserves(const UInt256 &reserveIn, const UInt256 &reserveOut) {
+    return reserveIn != UInt256(0) && reserveOut != UInt256(0);
+  }
+
+  /**
+   * @brief Lowers amount by specified slippage.
+   *
+   * @param amount expected amount
+   * @param slippageBasisPoints accepted slippage in basis points (eg. 500 means 5%)
+   * @return minimum accepted amount
+   */
+  inline UInt256 applySlippage(const UInt256 &amount, std::uint64_t slippageBasisPoints) {
+    return (amount * (BasisPointsDenominator - slippageBasisPoints)) / BasisPointsDenominator;
+  }
+
+  /**
+   * @brief Calculates amountOutMin for swapExactETHForTokens executed right after liquidity add.
+   *
+   * Assumes the pair was empty before the liquidity add, so reserves equal
+   * to added amounts (amountTokenDesired and msg.value of addLiquidityETH).
+   * Callers check hasReserves first, the result does not protect the swap without them.
+   *
+   * @param value ETH amount we swap (wei)
+   * @param liquidityETH ETH amount added to the pool (wei)
+   * @param liquidityToken token amount added to the pool
+   * @param slippageBasisPoints accepted slippage in basis points
+   * @return minimum amount of tokens to receive
+   */
+  inline UInt256 getAmountOutMin(const UInt256 &value, const UInt256 &liquidityETH, const UInt256 &liquidityToken, std::uint64_t slippageBasisPoints) {
+    return applySlippage(getAmountOut(value, liquidityETH, liquidityToken), slippageBasisPoints);
+  }
+}
\ No newline at end of file
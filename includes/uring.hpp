@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/**
+ * @brief Minimal io_uring ring over raw system calls (no liburing), covering what a single long-lived connection needs:
+ * fixed files, registered buffers, fixed reads and writes, timeouts and optional kernel-side submission polling (SQPOLL).
+ *
+ * With SQPOLL, submitting is a store to the shared ring; the system call is made only to wake the idle polling thread.
+ */
+namespace Uring {
+  /**
+   * @brief Submission and completion rings of single io_uring instance.
+   */
+  class Ring {
+    int fd = -1;
+    bool polling = false;
+
+    void *sqRing = MAP_FAILED;
+    void *cqRing = MAP_FAILED;
+    std::size_t sqRingSize = 0;
+    std::size_t cqRingSize = 0;
+    std::size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqFlags = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe *cqes = nullptr;
+
+    /**
+     * @brief Tail of queued entries, published to the kernel by submit().
+     */
+    unsigned localTail = 0;
+
+    static int enter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+      return syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0);
+    }
+
+    public:
+
+    Ring() = default;
+    Ring(const Ring&) = delete;
+    Ring &operator=(const Ring&) = delete;
+
+    ~Ring() {
+      close();
+    }
+
+    /**
+     * @brief Sets the ring up.
+     *
+     * @param entries submission queue size (rounded up to power of two by the kernel)
+     * @param sqPoll submit through kernel polling thread, without system calls
+     * @param sqPollIdleMilliseconds time without submissions after which polling thread sleeps
+     * @return false on failure (eg. io_uring disabled)
+     */
+    bool init(unsigned entries, bool sqPoll = false, unsigned sqPollIdleMilliseconds = 1000) {
+      close();
+
+      io_uring_params params {};
+      if(sqPoll) {
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = sqPollIdleMilliseconds;
+      }
+
+      fd = syscall(__NR_io_uring_setup, entries, &params);
+      if(fd < 0) {
+        fd = -1;
+        return false;
+      }
+      polling = sqPoll;
+
+      sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+      cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+      bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+      if(singleMap) sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+      sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+      if(sqRing == MAP_FAILED) {
+        close();
+        return false;
+      }
+
+      cqRing = singleMap ? sqRing : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+      if(cqRing == MAP_FAILED) {
+        close();
+        return false;
+      }
+
+      sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+      sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+      if(sqes == MAP_FAILED) {
+        close();
+        return false;
+      }
+
+      char *sq = static_cast<char*>(sqRing);
+      sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+      sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+      sqFlags = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+      sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+      sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+      sqEntries = params.sq_entries;
+
+      char *cq = static_cast<char*>(cqRing);
+      cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+      cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+      cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+      cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+      // Submission entries map 1:1 to the array, so it is filled once
+      for(unsigned i = 0; i < sqEntries; i++) sqArray[i] = i;
+      localTail = *sqTail;
+
+      return true;
+    }
+
+    /**
+     * @brief Unmaps the rings and closes the ring, in-flight requests are cancelled.
+     */
+    void close() {
+      if(sqes != MAP_FAILED) munmap(sqes, sqesSize);
+      if(cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+      if(sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+      if(fd != -1) ::close(fd);
+
+      sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+      cqRing = sqRing = MAP_FAILED;
+      fd = -1;
+    }
+
+    bool isOpen() const {
+      return fd != -1;
+    }
+
+    bool isPolling() const {
+      return polling;
+    }
+
+    /**
+     * @brief Registers files, requests flagged with IOSQE_FIXED_FILE refer to them by index.
+     *
+     * @param fds file descriptors
+     * @param count number of file descriptors
+     * @return false on failure
+     */
+    bool registerFiles(const int *fds, unsigned count) {
+      return syscall(__NR_io_uring_register, fd, IORING_REGISTER_FILES, fds, count) == 0;
+    }
+
+    /**
+     * @brief Registers (pins) buffers, fixed reads and writes refer to them by index.
+     *
+     * @param buffers buffers
+     * @param count number of buffers
+     * @return false on failure (eg. RLIMIT_MEMLOCK too low)
+     */
+    bool registerBuffers(const iovec *buffers, unsigned count) {
+      return syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+    }
+
+    /**
+     * @brief Returns next submission entry, zeroed, or nullptr if the queue is full. Single submitter at a time.
+     */
+    io_uring_sqe *next() {
+      if(localTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) return nullptr;
+
+      io_uring_sqe *sqe = sqes + (localTail++ & sqMask);
+      memset(sqe, 0, sizeof(io_uring_sqe));
+      return sqe;
+    }
+
+    /**
+     * @brief Publishes queued entries, entering the kernel only without SQPOLL or when the polling thread sleeps.
+     *
+     * @return false on failure
+     */
+    bool submit() {
+      unsigned toSubmit = localTail - *sqTail;
+      __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+
+      if(polling) {
+        // Tail store has to be visible before the flag is read, the polling thread checks them in reverse order
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(__atomic_load_n(sqFlags, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP) return enter(fd, 0, 0, IORING_ENTER_SQ_WAKEUP) >= 0;
+        return true;
+      }
+
+      while(toSubmit != 0) {
+        int submitted = enter(fd, toSubmit, 0, 0);
+        if(submitted < 0) {
+          if(errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+          return false;
+        }
+        toSubmit -= submitted;
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Takes next completion, without waiting.
+     *
+     * @param output output completion
+     * @return false if there is none
+     */
+    bool peek(io_uring_cqe &output) {
+      unsigned head = *cqHead;
+      if(head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) return false;
+
+      output = cqes[head & cqMask];
+      __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+      return true;
+    }
+
+    /**
+     * @brief Takes next completion, waiting for it.
+     *
+     * @param output output completion
+     * @return false on failure
+     */
+    bool wait(io_uring_cqe &output) {
+      while(!peek(output)) {
+        if(enter(fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) return false;
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Prepares read into registered buffer.
+     *
+     * @param sqe submission entry
+     * @param file registered file index
+     * @param buffer output buffer, within registered buffer
+     * @param length output buffer length
+     * @param bufferIndex registered buffer index
+     * @param userData value passed back in the completion
+     */
+    static void prepareReadFixed(io_uring_sqe *sqe, int file, void *buffer, unsigned length, unsigned bufferIndex, std::uint64_t userData) {
+      sqe->opcode = IORING_OP_READ_FIXED;
+      sqe->flags = IOSQE_FIXED_FILE;
+      sqe->fd = file;
+      sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+      sqe->len = length;
+      sqe->buf_index = bufferIndex;
+      sqe->user_data = userData;
+    }
+
+    /**
+     * @brief Prepares write from registered buffer.
+     *
+     * @param sqe submission entry
+     * @param file registered file index
+     * @param buffer input buffer, within registered buffer
+     * @param length input buffer length
+     * @param bufferIndex registered buffer index
+     * @param userData value passed back in the completion
+     */
+    static void prepareWriteFixed(io_uring_sqe *sqe, int file, const void *buffer, unsigned length, unsigned bufferIndex, std::uint64_t userData) {
+      sqe->opcode = IORING_OP_WRITE_FIXED;
+      sqe->flags = IOSQE_FIXED_FILE;
+      sqe->fd = file;
+      sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+      sqe->len = length;
+      sqe->buf_index = bufferIndex;
+      sqe->user_data = userData;
+    }
+
+    /**
+     * @brief Prepares timeout, completed with -ETIME when it expires.
+     *
+     * @param sqe submission entry
+     * @param timeout timeout, has to stay valid until the completion (it is read asynchronously with SQPOLL)
+     * @param userData value passed back in the completion
+     */
+    static void prepareTimeout(io_uring_sqe *sqe, const __kernel_timespec *timeout, std::uint64_t userData) {
+      sqe->opcode = IORING_OP_TIMEOUT;
+      sqe->fd = -1;
+      sqe->addr = reinterpret_cast<std::uint64_t>(timeout);
+      sqe->len = 1;
+      sqe->user_data = userData;
+    }
+  };
+}
\ No newline at end of file
@@ -19,7 +19,7 @@ namespace Utils {
    * 
    * @throws std::invalid_argument Throws when input is not valid hexadecimal char
    */
-  inline Byte hexCharToByte(char x) {
+  constexpr Byte hexCharToByte(char x) {
     if(x >= '0' && x <= '9') return x - '0';
     if(x >= 'A' && x <= 'F') return x - 'A' + 10;
     if(x >= 'a' && x <= 'f') return x - 'a' + 10;
@@ -34,7 +34,7 @@ namespace Utils {
    * 
    * @throws std::invalid_argument Throws when input is not valid hexadecimal value
    */
-  inline char byteToHexChar(Byte x) {
+  constexpr char byteToHexChar(Byte x) {
     if(x <= 9) return x + '0';
     if(x >= 10 && x <= 15) return (x - 10) + 'a';
     throw std::invalid_argument("Invalid argument");
@@ -86,6 +86,22 @@ namespace Utils {
     return hexStringToBuffer(input, strlen(input), output, stripZeroes);
   }
 
+  /**
+   * @brief Hexadecimal digits pairs of every byte value, so encoding takes one lookup per byte and does not branch.
+   */
+  struct HexPairTable {
+    char value[512];
+  };
+
+  inline constexpr HexPairTable HexPairs = [] {
+    HexPairTable table {};
+    for(std::size_t i = 0; i < 256; i++) {
+      table.value[2 * i] = byteToHexChar(i / 16);
+      table.value[2 * i + 1] = byteToHexChar(i % 16);
+    }
+    return table;
+  }();
+
   /**
    * @brief Converts buffer to hexadecimal string.
    * 
@@ -95,13 +111,12 @@ namespace Utils {
    * @param nullTerminated should string be null terminated, defaults to false
    * @return output c-string length (without null terminator)
    */
-  inline std::size_t bufferToHexString(Buffer input, std::size_t inputLength, char *output, bool nullTerminated = false) {
+  inline std::size_t bufferToHexString(const Byte *input, std::size_t inputLength, char *output, bool nullTerminated = false) {
     if(inputLength == 0) return 0;
 
-    Buffer inputEnd = input + inputLength;
+    const Byte *inputEnd = input + inputLength;
     while(input != inputEnd) {
-      *output = byteToHexChar((*input / 16) % 16);
-      *(output + 1) = byteToHexChar(*input % 16);
+      memcpy(output, HexPairs.value + 2 * *input, 2);
 
       ++input;
       output += 2;
@@ -138,4 +153,118 @@ namespace Utils {
     for(; x != 0; x >>= 8) *(--outputStart) = x & 0xFF;
     return length;
   }
+
+  /**
+   * @brief Returns length of null-terminated string, usable at compile time.
+   * 
+   * @param input input null-terminated c-string
+   * @return input length
+   */
+  constexpr std::size_t stringLength(const char *input) {
+    std::size_t length = 0;
+    while(input[length] != '\0') ++length;
+    return length;
+  }
+
+  /**
+   * @brief Checks if null-terminated string is non-empty and consists of hexadecimal chars only (without 0x prefix).
+   * 
+   * @param input input null-terminated c-string
+   * @param length required length, 0 for any
+   * @return boolean value if string is valid
+   */
+  constexpr bool isHexString(const char *input, std::size_t length = 0) {
+    std::size_t inputLength = stringLength(input);
+    if(inputLength == 0 || (length != 0 && inputLength != length)) return false;
+
+    for(std::size_t i = 0; i < inputLength; i++) {
+      char x = input[i];
+      if(!((x >= '0' && x <= '9') || (x >= 'A' && x <= 'F') || (x >= 'a' && x <= 'f'))) return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Checks if null-terminated string is non-empty and consists of decimal digits only.
+   * 
+   * @param input input null-terminated c-string
+   * @return boolean value if string is valid
+   */
+  constexpr bool isDecimalString(const char *input) {
+    if(*input == '\0') return false;
+
+    for(; *input != '\0'; input++) {
+      if(*input < '0' || *input > '9') return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief String of bounded length built at compile time.
+   * 
+   * @tparam Capacity maximum string length (without null terminator)
+   */
+  template<std::size_t Capacity>
+  struct FixedString {
+    char value[Capacity + 1] = {};
+    std::size_t length = 0;
+
+    /**
+     * @brief Appends input, overflowing capacity fails compilation when evaluated at compile time.
+     * 
+     * @param input input null-terminated c-string
+     * @return this string
+     */
+    constexpr FixedString &append(const char *input) {
+      while(*input != '\0') value[length++] = *(input++);
+      value[length] = '\0';
+      return *this;
+    }
+  };
+
+  /**
+   * @brief Byte buffer of bounded length built at compile time.
+   * 
+   * @tparam Capacity maximum buffer length
+   */
+  template<std::size_t Capacity>
+  struct Bytes {
+    Byte value[Capacity] = {};
+    std::size_t length = 0;
+  };
+
+  /**
+   * @brief Converts hexadecimal null-terminated string to buffer at compile time.
+   * Invalid hexadecimal char or too long input fails compilation.
+   * 
+   * @tparam Capacity maximum output length
+   * @param input input hexadecimal null-terminated c-string
+   * @param stripZeroes should input string be trimmed of leading zeroes
+   * @return output buffer
+   */
+  template<std::size_t Capacity>
+  constexpr Bytes<Capacity> hexStringToBytes(const char *input, bool stripZeroes = false) {
+    Bytes<Capacity> output {};
+    std::size_t inputLength = stringLength(input);
+
+    if(stripZeroes) {
+      while(*input == '0') {
+        ++input;
+        --inputLength;
+      }
+    }
+
+    if(inputLength % 2 == 1) {
+      output.value[output.length++] = hexCharToByte(*(input++));
+      --inputLength;
+    }
+
+    for(; inputLength > 0; input += 2, inputLength -= 2) {
+      output.value[output.length++] = 16 * hexCharToByte(*input) + hexCharToByte(*(input + 1));
+    }
+
+    return output;
+  }
 }
\ No newline at end of file
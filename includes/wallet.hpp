@@ -0,0 +1,228 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "config.hpp"
+#include "utils.hpp"
+#include "uint256.hpp"
+#include "transaction.hpp"
+#include "templates.hpp"
+#include "bot.hpp"
+#include "pregen.hpp"
+#include "numa.hpp"
+
+/**
+ * @brief Sending wallet with its own nonce tracker, signing context and pregenerated transactions.
+ *
+ * @tparam StoreType type of pregenerated transactions store
+ */
+template<typename StoreType>
+class Wallet {
+  /**
+   * @brief Nonce of the next transaction.
+   */
+  std::atomic<std::uint64_t> nonce { 0 };
+
+  /**
+   * @brief Is wallet ready to send transaction (pregenerated transactions match the nonce).
+   */
+  std::atomic<bool> armed { false };
+
+  /**
+   * @brief Transaction data and its encoding, double buffered so it can be replaced while other threads set fields.
+   */
+  char data[2][TransactionDataBuilder::DataLength + 1];
+  Utils::Byte encodedData[2][Config::Size::TransactionDataBuffer];
+  std::size_t encodedDataLength[2] = {};
+  std::atomic<std::size_t> dataIndex { 0 };
+
+  /**
+   * @brief Value RLP encoded once at initialization, copied as is on every nonce.
+   */
+  Utils::Byte encodedValue[Config::Size::TransactionQuantityBuffer + 1];
+  std::size_t encodedValueLength = 0;
+
+  static_assert(TransactionDataBuilder::DataLength / 2 + 3 <= Config::Size::TransactionDataBuffer, "Encoded transaction data does not fit transaction buffer");
+
+  public:
+
+  Utils::Byte privateKey[32];
+
+  /**
+   * @brief Wallet address hexadecimal c-string (lowercase, without 0x prefix).
+   */
+  char address[41];
+
+  /**
+   * @brief Amount of ETH to swap (wei).
+   */
+  UInt256 value;
+
+  /**
+   * @brief Transaction used for on demand signing, owns wallet's SECP256K1 context.
+   * Meant to be used by the event loop only.
+   */
+  Transaction tx;
+
+  /**
+   * @brief Pregenerated transactions for current nonce.
+   */
+  PreGen::DoubleBuffer<StoreType> pregenTxs;
+
+  /**
+   * @brief Pregenerated EIP-1559 transactions for current nonce.
+   */
+  PreGen::FeeGrid dynamicFeeTxs;
+
+  /**
+   * @brief Buffer for message signed on demand, holds transaction message prefix since init.
+   * Everything else written to it is a whole transaction message, so the prefix stays in place.
+   */
+  char message[Config::Size::BloXrouteTransactionMessageString];
+
+  /**
+   * @brief Initializes wallet from config and sets transaction fields.
+   *
+   * @param config wallet config
+   * @param transactionData transaction data hexadecimal c-string
+   */
+  void init(const Config::Wallets::Wallet &config, const char *transactionData) {
+    // Private key is left empty when signing in the signer process
+    if(config.PrivateKey[0] != '\0') {
+      Utils::hexStringToBuffer(config.PrivateKey, privateKey);
+
+      Utils::Byte addressBuffer[20];
+      tx.getAddress(privateKey, addressBuffer);
+      Utils::bufferToHexString(addressBuffer, 20, address, true);
+    } else {
+      memset(privateKey, 0, sizeof(privateKey));
+      address[0] = '\0';
+    }
+
+    value = UInt256::fromHexString(config.Value);
+
+    Utils::Byte valueBuffer[Config::Size::TransactionQuantityBuffer];
+    RLP::Item valueItem { valueBuffer, Utils::hexStringToBuffer(config.Value, valueBuffer, true) };
+    encodedValueLength = RLP::encodeItem(&valueItem, encodedValue);
+
+    UInt256 configNonce = UInt256::fromHexString(config.Nonce);
+    nonce.store(configNonce.limbs[0]);
+
+    setData(transactionData);
+    BloXrouteMessageBuilder::prepareTransaction(message);
+  }
+
+  /**
+   * @brief Replaces transaction data and sets fields of the on demand transaction, pregenerated transactions are stale from now on.
+   * Called by the event loop. Other threads setting fields meanwhile take either the previous or the new data,
+   * the buffer of the previous data is overwritten on the next call, so calls are at least a pregeneration apart.
+   *
+   * @param transactionData transaction data hexadecimal c-string
+   */
+  void setData(const char *transactionData) {
+    std::size_t index = 1 - dataIndex.load(std::memory_order_relaxed);
+
+    memcpy(data[index], transactionData, TransactionDataBuilder::DataLength);
+    data[index][TransactionDataBuilder::DataLength] = '\0';
+
+    Utils::Byte dataBuffer[TransactionDataBuilder::DataLength / 2];
+    RLP::Item dataItem { dataBuffer, Utils::hexStringToBuffer(data[index], dataBuffer) };
+    encodedDataLength[index] = RLP::encodeItem(&dataItem, encodedData[index]);
+
+    dataIndex.store(index, std::memory_order_release);
+    setFields(tx);
+  }
+
+  /**
+   * @brief Sets all transaction fields but gas price for current nonce.
+   *
+   * @param transaction output transaction
+   */
+  void setFields(Transaction &transaction) const {
+    setFields(transaction, nonce.load());
+  }
+
+  /**
+   * @brief Sets all transaction fields but gas price for given nonce.
+   * Safe to call from any thread.
+   *
+   * @param transaction output transaction
+   * @param transactionNonce transaction nonce
+   */
+  void setFields(Transaction &transaction, std::uint64_t transactionNonce) const {
+    Utils::Byte nonceBuffer[8];
+    std::size_t nonceBufferSize = Utils::intToBuffer(transactionNonce, nonceBuffer);
+
+    transaction.setField(Transaction::Field::Nonce, nonceBuffer, nonceBufferSize);
+    transaction.setEncodedField(Transaction::Field::GasLimit, Templates::GasLimit.value, Templates::GasLimit.length);
+    transaction.setEncodedField(Transaction::Field::To, Templates::To.value, Templates::To.length);
+    transaction.setEncodedField(Transaction::Field::Value, encodedValue, encodedValueLength);
+    std::size_t index = dataIndex.load(std::memory_order_acquire);
+    transaction.setEncodedField(Transaction::Field::Data, encodedData[index], encodedDataLength[index]);
+  }
+
+  /**
+   * @brief Returns transaction data hexadecimal c-string.
+   */
+  const char *getData() const {
+    return data[dataIndex.load(std::memory_order_acquire)];
+  }
+
+  /**
+   * @brief Returns nonce of the next transaction.
+   */
+  std::uint64_t getNonce() const {
+    return nonce.load();
+  }
+
+  /**
+   * @brief Marks wallet ready to send, called after transactions for current nonce are pregenerated.
+   */
+  void arm() {
+    armed.store(true);
+  }
+
+  /**
+   * @brief Checks if wallet is ready to send.
+   */
+  bool isArmed() const {
+    return armed.load();
+  }
+
+  /**
+   * @brief Claims wallet for sending. Lock-free, only one caller succeeds until wallet is armed again.
+   *
+   * @return true if wallet was armed and can send transaction
+   */
+  bool claim() {
+    return armed.exchange(false);
+  }
+
+  /**
+   * @brief Advances nonce after transaction was sent.
+   * Pregenerated transactions are stale from now on, wallet has to be re-pregenerated and armed again.
+   */
+  void advanceNonce() {
+    nonce.fetch_add(1);
+    setFields(tx);
+  }
+
+  /**
+   * @brief Moves wallet (its message buffer, nonce and fields) and signing context to memory of the node.
+   * Has to be called before any thread signs with the wallet, pregenerated stores are allocated later by the caller.
+   *
+   * @param node node index, UnknownNode leaves the wallet where it is
+   * @return false if some pages could not be moved
+   */
+  bool moveToNode(int node) {
+    if(node < 0) return true;
+
+    void *context = Numa::allocate(tx.contextSize(), node);
+    if(context == nullptr) return false;
+    tx.moveContext(context);
+
+    return Numa::moveMemory(this, sizeof(*this), node);
+  }
+};
\ No newline at end of file
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "config.hpp"
+#include "abi.hpp"
+#include "bot.hpp"
+#include "pregen.hpp"
+
+/**
+ * @brief Warming of the match-and-send path between liquidity adds, so the first real match does not run on cold caches and branch predictors.
+ *
+ * Synthetic liquidity add of the target token is run through validation, fee extraction, pregenerated transaction lookups
+ * and a dry-run sign of the sending wallets. Nothing is sent and no wallet is claimed.
+ * Pregenerated slots touched are the ones of fees observed in the latest liquidity adds of other tokens.
+ * Single-threaded, driven by the feed loop.
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#warming
+ */
+namespace Warm {
+  /**
+   * @brief Synthetic message up to the input hex value, laid out as BloXroute stream messages.
+   */
+  inline constexpr char MessagePrefix[] = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"00000000-0000-0000-0000-000000000000\",\"result\":{\"txContents\":{\"input\":\"0x";
+
+  static_assert(sizeof(MessagePrefix) - 1 == BloXrouteMessageParser::InputPosition, "Synthetic message input position");
+
+  /**
+   * @brief Maximum length of synthetic message (with null terminator).
+   */
+  inline constexpr std::size_t MessageCapacity = 1024;
+
+  /**
+   * @brief Fees of liquidity add, gasPrice holds maxFeePerGas of EIP-1559 transaction.
+   */
+  struct Fees {
+    std::uint64_t gasPrice = 0;
+    std::uint64_t maxPriorityFeePerGas = 0;
+    bool dynamicFee = false;
+
+    bool operator==(const Fees &other) const {
+      return gasPrice == other.gasPrice && maxPriorityFeePerGas == other.maxPriorityFeePerGas && dynamicFee == other.dynamicFee;
+    }
+  };
+
+  /**
+   * @brief Work done by a warming round.
+   */
+  struct Round {
+    std::size_t matches = 0;  // synthetic messages run through the path
+    std::size_t touched = 0;  // pregenerated messages read
+    std::size_t signs = 0;    // dry-run signs
+  };
+
+  /**
+   * @brief Builds synthetic addLiquidityETH message of the token with given fees.
+   *
+   * @param tokenAddress token address hexadecimal c-string (lowercase, without 0x prefix)
+   * @param fees transaction fees
+   * @param output output message, at least MessageCapacity long
+   * @return output message length
+   */
+  inline std::size_t buildMessage(const char *tokenAddress, const Fees &fees, char *output) {
+    using namespace BloXrouteMessageParser;
+
+    memcpy(output, MessagePrefix, InputPosition);
+    memcpy(output + InputPosition, ABI::Selector::AddLiquidityETH, ABI::SelectorLength);
+    memset(output + InputPosition + ABI::SelectorLength, '0', AddLiquidityETH.HexLength - ABI::SelectorLength);
+    memcpy(output + TokenPosition, tokenAddress, ABI::AddressLength);
+
+    char *position = output + InputEndPosition;
+    auto append = [&position](const char *string) {
+      std::size_t length = strlen(string);
+      memcpy(position, string, length);
+      position += length;
+    };
+
+    if(fees.dynamicFee) {
+      append("\",\"value\":\"0x0\",\"maxFeePerGas\":\"0x");
+      position = std::to_chars(position, output + MessageCapacity, fees.gasPrice, 16).ptr;
+      append("\",\"maxPriorityFeePerGas\":\"0x");
+      position = std::to_chars(position, output + MessageCapacity, fees.maxPriorityFeePerGas, 16).ptr;
+    } else {
+      append("\",\"gasPrice\":\"0x");
+      position = std::to_chars(position, output + MessageCapacity, fees.gasPrice, 16).ptr;
+      append("\",\"value\":\"0x0");
+    }
+
+    append("\",\"from\":\"0x0000000000000000000000000000000000000000\",\"nonce\":\"0x0\"}}}}");
+    *position = '\0';
+
+    return position - output;
+  }
+
+  /**
+   * @brief Extracts fees of liquidity add (addLiquidityETH or addLiquidity) from the message.
+   *
+   * @param message input message
+   * @param fees output fees
+   * @return false if message is not a liquidity add or its fees are missing or do not fit 64 bits
+   */
+  inline bool extractFees(const char *message, Fees &fees) {
+    using namespace BloXrouteMessageParser;
+
+    if(!isTransaction(message) || !(isAddLiquidityETH(message) || isAddLiquidity(message)) || !isInputComplete(message)) return false;
+
+    char gasPriceStr[Config::Size::TransactionQuantityBuffer * 2 + 1];
+    char maxPriorityFeePerGasStr[Config::Size::TransactionQuantityBuffer * 2 + 1];
+    std::size_t gasPriceStrLength, maxPriorityFeePerGasStrLength = 0;
+
+    fees.dynamicFee = isDynamicFee(message);
+    if(fees.dynamicFee) {
+      gasPriceStrLength = extractMaxFeePerGas(message, gasPriceStr);
+      maxPriorityFeePerGasStrLength = extractMaxPriorityFeePerGas(message, maxPriorityFeePerGasStr);
+    } else {
+      gasPriceStrLength = extractGasPrice(message, gasPriceStr);
+    }
+
+    if(gasPriceStrLength == 0 || gasPriceStrLength > 16 || maxPriorityFeePerGasStrLength > 16) return false;
+    if(fees.dynamicFee && maxPriorityFeePerGasStrLength == 0) return false;
+
+    fees.gasPrice = fees.maxPriorityFeePerGas = 0;
+    std::from_chars(gasPriceStr, gasPriceStr + gasPriceStrLength, fees.gasPrice, 16);
+    std::from_chars(maxPriorityFeePerGasStr, maxPriorityFeePerGasStr + maxPriorityFeePerGasStrLength, fees.maxPriorityFeePerGas, 16);
+    return true;
+  }
+
+  /**
+   * @brief Reads every cache line of the buffer.
+   *
+   * @param buffer input buffer
+   * @param length input buffer length
+   * @return sum of the bytes read, to be kept so the reads are not optimized out
+   */
+  inline std::uint64_t touch(const char *buffer, std::size_t length) {
+    std::uint64_t sum = 0;
+    for(std::size_t i = 0; i < length; i += 64) sum += static_cast<unsigned char>(buffer[i]);
+    return sum;
+  }
+
+  /**
+   * @brief Warms the path of the target token on interval, within time budget.
+   *
+   * @tparam LikelyCount number of latest observed liquidity add fees kept
+   */
+  template<std::size_t LikelyCount>
+  class Warmer {
+    static_assert(LikelyCount != 0, "There must be room for at least one observed fee");
+
+    char tokenAddress[ABI::AddressLength + 1] = {};
+    Fees fallback;
+    std::uint64_t interval = 0;
+    std::uint64_t budget = 0;
+    std::uint64_t last = 0;
+    bool started = false;
+
+    /**
+     * @brief Fees of the latest liquidity adds of other tokens, distinct, oldest overwritten first.
+     */
+    Fees likely[LikelyCount];
+    std::size_t likelyCount = 0;
+    std::size_t likelyNext = 0;
+    std::size_t cursor = 0;
+
+    char message[MessageCapacity];
+
+    /**
+     * @brief Output of pregenerated message lookups and dry-run signs, holds transaction message prefix since init.
+     */
+    char scratch[Config::Size::BloXrouteTransactionMessageString];
+    std::uint64_t checksum = 0;
+
+    template<typename WalletType>
+    void match(const Fees &fees, WalletType *wallets, std::size_t count, std::size_t sendCount, bool lookups, bool sign, Round &round) {
+      using namespace BloXrouteMessageParser;
+
+      // Same steps as the real match, up to the send
+      buildMessage(tokenAddress, fees, message);
+      if(!validateTransaction(message, tokenAddress)) return;
+
+      Fees extracted;
+      if(!extractFees(message, extracted)) return;
+      round.matches++;
+
+      std::size_t sending = 0;
+      for(std::size_t i = 0; i < count && sending < sendCount; i++) {
+        WalletType &wallet = wallets[i];
+        if(!wallet.isArmed()) continue;
+        sending++;
+
+        if(lookups && extracted.dynamicFee) {
+          PreGen::FeeGrid::Entry pregenTx = wallet.dynamicFeeTxs.lookup(
+            extracted.gasPrice, extracted.maxPriorityFeePerGas,
+            Config::TransactionPreGen::Policy, Config::TransactionPreGen::MaxGasPriceBump, Config::TransactionPreGen::DynamicFee::MaxPriorityFeeBump
+          );
+
+          if(pregenTx.message != nullptr) {
+            checksum += touch(pregenTx.message, pregenTx.length);
+            round.touched++;
+          }
+        } else if(lookups) {
+          const auto *store = wallet.pregenTxs.acquire();
+          const auto *pregenTx = store->lookup(extracted.gasPrice, Config::TransactionPreGen::Policy, Config::TransactionPreGen::MaxGasPriceBump);
+
+          if(pregenTx != nullptr) {
+            std::size_t messageLength;
+            const char *pregenMessage = store->message(*pregenTx, scratch, messageLength);
+            checksum += touch(pregenMessage, messageLength);
+            round.touched++;
+          }
+
+          wallet.pregenTxs.release();
+        }
+
+        checksum += touch(wallet.message, sizeof(wallet.message));
+
+        if(sign) {
+          checksum += extracted.dynamicFee
+            ? PreGen::generatePrepared(wallet.tx, wallet.privateKey, extracted.gasPrice, extracted.maxPriorityFeePerGas, scratch)
+            : PreGen::generatePrepared(wallet.tx, wallet.privateKey, extracted.gasPrice, scratch);
+          round.signs++;
+        }
+      }
+    }
+
+    public:
+
+    /**
+     * @brief Sets the target token and pacing of warming rounds, observed fees are dropped.
+     *
+     * @param targetTokenAddress target token address hexadecimal c-string (lowercase, without 0x prefix)
+     * @param fallbackGasPrice gas price of synthetic message until liquidity adds are observed (wei)
+     * @param intervalNanoseconds minimum time between rounds
+     * @param budgetNanoseconds time budget of a round, its first synthetic match is always completed
+     */
+    void init(const char *targetTokenAddress, std::uint64_t fallbackGasPrice, std::uint64_t intervalNanoseconds, std::uint64_t budgetNanoseconds) {
+      memcpy(tokenAddress, targetTokenAddress, ABI::AddressLength);
+      tokenAddress[ABI::AddressLength] = '\0';
+      fallback = Fees { fallbackGasPrice, 0, false };
+      interval = intervalNanoseconds;
+      budget = budgetNanoseconds;
+      started = false;
+      likelyCount = likelyNext = cursor = 0;
+      BloXrouteMessageBuilder::prepareTransaction(scratch);
+    }
+
+    /**
+     * @brief Switches the target token, observed fees are kept and the next round is due right away.
+     *
+     * @param targetTokenAddress target token address hexadecimal c-string (lowercase, without 0x prefix)
+     */
+    void setTarget(const char *targetTokenAddress) {
+      memcpy(tokenAddress, targetTokenAddress, ABI::AddressLength);
+      started = false;
+    }
+
+    /**
+     * @brief Keeps fees of liquidity add of other token, the next ones of the target are likely priced alike.
+     *
+     * @param observedMessage input message
+     * @return false if message is not a liquidity add or its fees are already kept
+     */
+    bool observe(const char *observedMessage) {
+      Fees fees;
+      if(!extractFees(observedMessage, fees)) return false;
+
+      for(std::size_t i = 0; i < likelyCount; i++) {
+        if(likely[i] == fees) return false;
+      }
+
+      likely[likelyNext] = fees;
+      likelyNext = (likelyNext + 1) % LikelyCount;
+      if(likelyCount < LikelyCount) likelyCount++;
+      return true;
+    }
+
+    /**
+     * @brief Returns number of observed fees kept.
+     */
+    std::size_t getLikely() const {
+      return likelyCount;
+    }
+
+    /**
+     * @brief Checks if the interval has passed since the last round.
+     *
+     * @param now current time (nanoseconds)
+     */
+    bool isDue(std::uint64_t now) const {
+      return !started || now - last >= interval;
+    }
+
+    /**
+     * @brief Runs warming round: synthetic match of the next observed fees (or the fallback gas price) with dry-run sign,
+     * then lookups of the other observed fees until the budget runs out. Wallets are not claimed.
+     *
+     * @tparam WalletType type of wallet
+     * @tparam Clock callable returning current time (nanoseconds)
+     * @param wallets wallets array
+     * @param count wallets count
+     * @param sendCount number of armed wallets sending on match
+     * @param lookups look up locally pregenerated transactions
+     * @param sign dry-run sign with the wallets' on demand signing context
+     * @param now clock
+     * @return work done
+     */
+    template<typename WalletType, typename Clock>
+    Round run(WalletType *wallets, std::size_t count, std::size_t sendCount, bool lookups, bool sign, Clock now) {
+      Round round;
+      std::uint64_t start = now();
+      last = start;
+      started = true;
+
+      match(likelyCount != 0 ? likely[cursor++ % likelyCount] : fallback, wallets, count, sendCount, lookups, sign, round);
+
+      // Further fees are looked up only, each of them once per round at most
+      for(std::size_t i = 1; i < likelyCount && now() - start < budget; i++) {
+        match(likely[cursor++ % likelyCount], wallets, count, sendCount, lookups, false, round);
+      }
+
+      return round;
+    }
+
+    /**
+     * @brief Returns sum of everything read, keeps the reads from being optimized out.
+     */
+    std::uint64_t getChecksum() const {
+      return checksum;
+    }
+  };
+}
\ No newline at end of file
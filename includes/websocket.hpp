@@ -0,0 +1,970 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/random.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include "ktls.hpp"
+#include "uring.hpp"
+
+/**
+ * @brief Minimal RFC 6455 WebSocket client (handshake, masking, ping/pong, close, fragmented messages) over io_uring,
+ * alternative to websocketpp/asio for the BloXroute Cloud API connection.
+ *
+ * Frames are parsed in place in a registered receive buffer and sends are masked straight into registered send slots,
+ * so nothing is copied nor allocated per message. Extensions (permessage-deflate) are not supported, wss:// is supported
+ * only with kernel TLS (see KernelTLS).
+ *
+ * @see https://github.com/sszczep/UniswapSniperBot#io_uring-websocket-transport
+ */
+namespace WebSocket {
+  /**
+   * @brief Frame opcodes.
+   */
+  enum Opcode : std::uint8_t {
+    Continuation = 0x0,
+    Text = 0x1,
+    Binary = 0x2,
+    Close = 0x8,
+    Ping = 0x9,
+    Pong = 0xa
+  };
+
+  /**
+   * @brief Close status codes.
+   */
+  enum CloseCode : std::uint16_t {
+    Normal = 1000,
+    ProtocolError = 1002,
+    NoStatus = 1005,
+    Abnormal = 1006
+  };
+
+  /**
+   * @brief GUID appended to the key of Sec-WebSocket-Key header to compute Sec-WebSocket-Accept.
+   */
+  inline constexpr char Guid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+  /**
+   * @brief Length of base64 encoded 16 bytes key (Sec-WebSocket-Key) and 20 bytes SHA-1 digest (Sec-WebSocket-Accept).
+   */
+  inline constexpr std::size_t KeyLength = 24;
+  inline constexpr std::size_t AcceptLength = 28;
+
+  /**
+   * @brief Longest frame header (2 bytes, 8 bytes extended length, 4 bytes masking key).
+   */
+  inline constexpr std::size_t MaxHeaderLength = 14;
+
+  /**
+   * @brief Longest control frame payload.
+   */
+  inline constexpr std::size_t MaxControlPayloadLength = 125;
+
+  /**
+   * @brief Time to wait for the handshake response (milliseconds).
+   */
+  inline constexpr unsigned HandshakeTimeoutMilliseconds = 10000;
+
+  /**
+   * @brief Parts of ws:// or wss:// URL.
+   */
+  struct Address {
+    char host[256];
+    char port[6];
+    char path[256];
+    bool secure;
+  };
+
+  /**
+   * @brief Parses ws://host[:port][/path] or wss://host[:port][/path] URL.
+   *
+   * @param url input null-terminated URL
+   * @param output output address
+   * @return false if the URL is malformed or its parts are too long
+   */
+  inline bool parseAddress(const char *url, Address &output) {
+    if(strncmp(url, "ws://", 5) == 0) {
+      output.secure = false;
+      url += 5;
+    } else if(strncmp(url, "wss://", 6) == 0) {
+      output.secure = true;
+      url += 6;
+    } else {
+      return false;
+    }
+
+    std::size_t hostLength = strcspn(url, ":/");
+    if(hostLength == 0 || hostLength >= sizeof(output.host)) return false;
+    memcpy(output.host, url, hostLength);
+    output.host[hostLength] = '\0';
+    url += hostLength;
+
+    if(*url == ':') {
+      std::size_t portLength = strcspn(++url, "/");
+      if(portLength == 0 || portLength >= sizeof(output.port)) return false;
+      memcpy(output.port, url, portLength);
+      output.port[portLength] = '\0';
+      url += portLength;
+    } else {
+      strcpy(output.port, output.secure ? "443" : "80");
+    }
+
+    if(*url == '\0') url = "/";
+    if(strlen(url) >= sizeof(output.path)) return false;
+    strcpy(output.path, url);
+
+    return true;
+  }
+
+  /**
+   * @brief Computes Sec-WebSocket-Accept value of the key, base64(SHA-1(key + GUID)).
+   *
+   * @param key input Sec-WebSocket-Key value (24 chars)
+   * @param output output value, AcceptLength chars followed by null terminator
+   */
+  inline void acceptKey(const char *key, char *output) {
+    unsigned char input[KeyLength + sizeof(Guid) - 1];
+    memcpy(input, key, KeyLength);
+    memcpy(input + KeyLength, Guid, sizeof(Guid) - 1);
+
+    unsigned char digest[SHA_DIGEST_LENGTH];
+    SHA1(input, sizeof(input), digest);
+    EVP_EncodeBlock(reinterpret_cast<unsigned char*>(output), digest, SHA_DIGEST_LENGTH);
+  }
+
+  /**
+   * @brief Builds opening handshake request.
+   *
+   * @param address server address
+   * @param key Sec-WebSocket-Key value (24 chars)
+   * @param authorization Authorization header value, nullptr or empty if none
+   * @param output output request
+   * @param outputSize size of output buffer
+   * @return request length, 0 if it does not fit
+   */
+  inline std::size_t buildHandshake(const Address &address, const char *key, const char *authorization, char *output, std::size_t outputSize) {
+    int length = snprintf(
+      output, outputSize,
+      "GET %s HTTP/1.1\r\nHost: %s:%s\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: %.24s\r\nSec-WebSocket-Version: 13\r\n%s%s%s\r\n",
+      address.path, address.host, address.port, key,
+      authorization != nullptr && authorization[0] != '\0' ? "Authorization: " : "",
+      authorization != nullptr ? authorization : "",
+      authorization != nullptr && authorization[0] != '\0' ? "\r\n" : ""
+    );
+
+    return length < 0 || static_cast<std::size_t>(length) >= outputSize ? 0 : length;
+  }
+
+  /**
+   * @brief Checks opening handshake response: 101 status and Sec-WebSocket-Accept matching the key.
+   *
+   * @param response input response headers, null-terminated
+   * @param key Sec-WebSocket-Key value sent in the request
+   * @return boolean value if the connection is upgraded
+   */
+  inline bool checkHandshake(const char *response, const char *key) {
+    if(strncmp(response, "HTTP/1.1 101", 12) != 0) return false;
+
+    const char *header = strcasestr(response, "\r\nSec-WebSocket-Accept:");
+    if(header == nullptr) return false;
+
+    header += sizeof("\r\nSec-WebSocket-Accept:") - 1;
+    while(*header == ' ' || *header == '\t') ++header;
+
+    char expected[AcceptLength + 1];
+    acceptKey(key, expected);
+    return strncmp(header, expected, AcceptLength) == 0;
+  }
+
+  /**
+   * @brief Encodes header of final (unfragmented) frame.
+   *
+   * @param opcode frame opcode
+   * @param payloadLength payload length
+   * @param maskKey 4 bytes masking key, nullptr for unmasked frame (sent by servers)
+   * @param output output header, at least MaxHeaderLength bytes
+   * @return header length
+   */
+  inline std::size_t encodeHeader(Opcode opcode, std::uint64_t payloadLength, const std::uint8_t *maskKey, char *output) {
+    std::uint8_t *bytes = reinterpret_cast<std::uint8_t*>(output);
+    std::uint8_t maskBit = maskKey != nullptr ? 0x80 : 0;
+    std::size_t length;
+
+    bytes[0] = 0x80 | opcode;
+    if(payloadLength < 126) {
+      bytes[1] = maskBit | static_cast<std::uint8_t>(payloadLength);
+      length = 2;
+    } else if(payloadLength <= 0xffff) {
+      bytes[1] = maskBit | 126;
+      bytes[2] = static_cast<std::uint8_t>(payloadLength >> 8);
+      bytes[3] = static_cast<std::uint8_t>(payloadLength);
+      length = 4;
+    } else {
+      bytes[1] = maskBit | 127;
+      for(std::size_t i = 0; i < 8; i++) bytes[2 + i] = static_cast<std::uint8_t>(payloadLength >> (56 - 8 * i));
+      length = 10;
+    }
+
+    if(maskKey != nullptr) {
+      memcpy(bytes + length, maskKey, 4);
+      length += 4;
+    }
+
+    return length;
+  }
+
+  /**
+   * @brief Masks (or unmasks) payload, 8 bytes at a time. Input and output can be the same buffer.
+   *
+   * @param input input payload
+   * @param length input payload length
+   * @param maskKey 4 bytes masking key
+   * @param output output payload
+   */
+  inline void mask(const char *input, std::size_t length, const std::uint8_t *maskKey, char *output) {
+    std::uint32_t key32;
+    memcpy(&key32, maskKey, 4);
+    std::uint64_t key64 = static_cast<std::uint64_t>(key32) << 32 | key32;
+
+    std::size_t i = 0;
+    for(; i + 8 <= length; i += 8) {
+      std::uint64_t chunk;
+      memcpy(&chunk, input + i, 8);
+      chunk ^= key64;
+      memcpy(output + i, &chunk, 8);
+    }
+
+    for(; i < length; i++) output[i] = input[i] ^ maskKey[i & 3];
+  }
+
+  /**
+   * @brief Decoded frame header.
+   */
+  struct Frame {
+    bool fin;
+    bool reserved;        // any of RSV1-3 bits set, no extension is negotiated so it is a protocol error
+    Opcode opcode;
+    bool masked;
+    std::uint8_t maskKey[4];
+    std::uint64_t payloadLength;
+  };
+
+  /**
+   * @brief Decodes frame header.
+   *
+   * @param input input bytes
+   * @param length input bytes length
+   * @param output output frame
+   * @return header length, 0 if the header is incomplete
+   */
+  inline std::size_t parseHeader(const char *input, std::size_t length, Frame &output) {
+    const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t*>(input);
+    if(length < 2) return 0;
+
+    output.fin = bytes[0] & 0x80;
+    output.reserved = bytes[0] & 0x70;
+    output.opcode = static_cast<Opcode>(bytes[0] & 0x0f);
+    output.masked = bytes[1] & 0x80;
+
+    std::size_t headerLength = 2 + (output.masked ? 4 : 0);
+    std::uint8_t payloadLength = bytes[1] & 0x7f;
+    if(payloadLength == 126) headerLength += 2;
+    if(payloadLength == 127) headerLength += 8;
+    if(length < headerLength) return 0;
+
+    if(payloadLength == 126) {
+      output.payloadLength = static_cast<std::uint64_t>(bytes[2]) << 8 | bytes[3];
+    } else if(payloadLength == 127) {
+      output.payloadLength = 0;
+      for(std::size_t i = 0; i < 8; i++) output.payloadLength = output.payloadLength << 8 | bytes[2 + i];
+    } else {
+      output.payloadLength = payloadLength;
+    }
+
+    if(output.masked) memcpy(output.maskKey, bytes + headerLength - 4, 4);
+
+    return headerLength;
+  }
+
+  /**
+   * @brief WebSocket client connection on io_uring.
+   *
+   * The socket is a fixed file and the receive buffer and send slots are registered buffers, so the kernel neither looks
+   * the file up nor pins pages per request; with SQPOLL sends are made without any system call.
+   * Messages are read by a single thread running the loop, sends can be made from any thread (and from the callbacks).
+   * Over wss:// sends are encrypted by the kernel, received records are read into a registered buffer and decrypted
+   * by OpenSSL into the receive buffer.
+   *
+   * @tparam BufferSize size of the receive buffer, longer messages are skipped
+   * @tparam SlotSize size of send slot, longest sent message is SlotSize - MaxHeaderLength
+   * @tparam SlotsCount number of send slots, sends are refused while all of them are waiting to be written
+   */
+  template<std::size_t BufferSize, std::size_t SlotSize, std::size_t SlotsCount>
+  class Client {
+    static_assert(SlotSize > MaxHeaderLength + MaxControlPayloadLength, "Send slot has to fit control frames");
+
+    /**
+     * @brief Request kinds, passed as completion user data.
+     */
+    enum Request : std::uint64_t {
+      Receive,
+      Send,
+      Tick
+    };
+
+    /**
+     * @brief At most one request of each kind is in flight.
+     */
+    static constexpr unsigned RingEntries = 4;
+
+    /**
+     * @brief Size of the buffer received TLS records are read into.
+     */
+    static constexpr std::size_t RecordsBufferSize = 1 << 16;
+
+    Uring::Ring ring;
+    KernelTLS::Session session;
+    bool kernelTLSUnavailable = false;
+    int fd = -1;
+    std::atomic<bool> running { false };
+    __kernel_timespec tickTimeout {};
+
+    // Send state, also guards the submission queue (single submitter)
+    std::mutex sendMutex;
+    std::size_t queueHead = 0;
+    std::size_t queueTail = 0;
+    std::size_t sendOffset = 0;
+    bool sending = false;
+    bool closeSent = false;
+    bool peerClosed = false;
+    bool pinged = false;
+    std::uint64_t maskState = 0;
+
+    // Receive state, owned by the loop
+    std::size_t filled = 0;
+    std::uint64_t skipping = 0;
+    std::size_t messageLength = 0;
+    bool fragmented = false;
+    bool dropping = false;
+    std::uint16_t closeCode = Abnormal;
+    char closeReason[MaxControlPayloadLength + 1] = "";
+
+    alignas(64) char receiveBuffer[BufferSize];
+    alignas(64) char slots[SlotsCount][SlotSize];
+    alignas(64) char recordsBuffer[RecordsBufferSize];
+    std::size_t slotLengths[SlotsCount];
+    char messageBuffer[BufferSize];
+
+    /**
+     * @brief Returns next masking key, xorshift64* seeded from getrandom on connect.
+     * Masking only has to be unpredictable to intermediaries, not cryptographically secure.
+     */
+    void nextMaskKey(std::uint8_t *output) {
+      maskState ^= maskState >> 12;
+      maskState ^= maskState << 25;
+      maskState ^= maskState >> 27;
+      std::uint32_t key = static_cast<std::uint32_t>((maskState * 0x2545f4914f6cdd1dULL) >> 32);
+      memcpy(output, &key, 4);
+    }
+
+    /**
+     * @brief Writes the oldest queued frame (its remaining part). Send mutex has to be held.
+     */
+    bool submitWrite() {
+      io_uring_sqe *sqe = ring.next();
+      if(sqe == nullptr) return false;
+
+      std::size_t slot = queueHead % SlotsCount;
+      Uring::Ring::prepareWriteFixed(sqe, 0, slots[slot] + sendOffset, slotLengths[slot] - sendOffset, 1, Send);
+      sending = true;
+      return ring.submit();
+    }
+
+    /**
+     * @brief Masks the frame into the next free slot and writes it, unless another write is in flight
+     * (it is written when that completes, so frames go out in order).
+     */
+    bool sendFrame(Opcode opcode, const char *payload, std::size_t length) {
+      std::lock_guard<std::mutex> lock(sendMutex);
+
+      if(!running.load(std::memory_order_relaxed) || closeSent) return false;
+      if(queueTail - queueHead == SlotsCount || length > SlotSize - MaxHeaderLength) return false;
+
+      std::size_t slot = queueTail % SlotsCount;
+      std::uint8_t maskKey[4];
+      nextMaskKey(maskKey);
+
+      std::size_t headerLength = encodeHeader(opcode, length, maskKey, slots[slot]);
+      mask(payload, length, maskKey, slots[slot] + headerLength);
+      slotLengths[slot] = headerLength + length;
+      ++queueTail;
+
+      if(opcode == Close) closeSent = true;
+      if(opcode == Ping) pinged = true;
+      return sending || submitWrite();
+    }
+
+    /**
+     * @brief Advances the send queue after write completion, writes next frame if any.
+     *
+     * @return false if the connection is broken
+     */
+    bool completeWrite(int result) {
+      std::lock_guard<std::mutex> lock(sendMutex);
+
+      sending = false;
+      if(result <= 0) return false;
+
+      sendOffset += result;
+      if(sendOffset == slotLengths[queueHead % SlotsCount]) {
+        ++queueHead;
+        sendOffset = 0;
+      }
+
+      return queueHead == queueTail || submitWrite();
+    }
+
+    /**
+     * @brief Checks if peer closed the connection and the close reply was written.
+     */
+    bool isDone() {
+      std::lock_guard<std::mutex> lock(sendMutex);
+      return peerClosed && !sending;
+    }
+
+    bool submitRead() {
+      std::lock_guard<std::mutex> lock(sendMutex);
+
+      io_uring_sqe *sqe = ring.next();
+      if(sqe == nullptr) return false;
+
+      if(session.isOpen()) {
+        Uring::Ring::prepareReadFixed(sqe, 0, recordsBuffer, RecordsBufferSize, 2, Receive);
+      } else {
+        Uring::Ring::prepareReadFixed(sqe, 0, receiveBuffer + filled, BufferSize - 1 - filled, 0, Receive);
+      }
+
+      return ring.submit();
+    }
+
+    /**
+     * @brief Takes bytes received at the end of the receive buffer, skipped payload of too long frame is dropped as it comes.
+     */
+    void append(std::size_t count) {
+      std::size_t skipped = std::min<std::uint64_t>(skipping, count);
+      if(skipped != 0) {
+        memmove(receiveBuffer + filled, receiveBuffer + filled + skipped, count - skipped);
+        skipping -= skipped;
+        count -= skipped;
+      }
+
+      filled += count;
+    }
+
+    /**
+     * @brief Blocking read of plaintext, decrypted over wss://. Used before the ring is set up.
+     */
+    ssize_t receivePlain(char *output, std::size_t size) {
+      if(!session.isOpen()) return recv(fd, output, size, 0);
+
+      std::size_t decrypted;
+      if(session.hasPending()) {
+        if(!session.decrypt(nullptr, 0, output, size, decrypted)) return -1;
+        if(decrypted != 0) return decrypted;
+      }
+
+      while(true) {
+        ssize_t count = recv(fd, recordsBuffer, RecordsBufferSize, 0);
+        if(count <= 0) return count;
+
+        if(!session.decrypt(recordsBuffer, count, output, size, decrypted)) return -1;
+        if(decrypted != 0) return decrypted;
+      }
+    }
+
+    bool submitTick() {
+      std::lock_guard<std::mutex> lock(sendMutex);
+
+      io_uring_sqe *sqe = ring.next();
+      if(sqe == nullptr) return false;
+
+      Uring::Ring::prepareTimeout(sqe, &tickTimeout, Tick);
+      return ring.submit();
+    }
+
+    /**
+     * @brief Calls onMessage with null-terminated payload, the byte after it is restored afterwards.
+     */
+    template<typename OnMessage>
+    static void deliver(OnMessage &onMessage, char *payload, std::size_t length) {
+      char next = payload[length];
+      payload[length] = '\0';
+      onMessage(payload, length);
+      payload[length] = next;
+    }
+
+    /**
+     * @brief Handles complete frame.
+     */
+    template<typename OnMessage, typename OnPong>
+    void handle(const Frame &frame, char *payload, OnMessage &onMessage, OnPong &onPong, std::size_t &received) {
+      std::size_t length = frame.payloadLength;
+
+      switch(frame.opcode) {
+        case Text:
+        case Binary:
+          if(frame.fin) {
+            fragmented = false;
+            ++received;
+            deliver(onMessage, payload, length);
+          } else {
+            memcpy(messageBuffer, payload, length);
+            messageLength = length;
+            fragmented = true;
+            dropping = false;
+          }
+          break;
+
+        case Continuation:
+          if(!fragmented) break;
+
+          if(!dropping && messageLength + length < BufferSize) {
+            memcpy(messageBuffer + messageLength, payload, length);
+            messageLength += length;
+          } else {
+            dropping = true;
+          }
+
+          if(frame.fin) {
+            fragmented = false;
+            if(dropping) break;
+
+            ++received;
+            deliver(onMessage, messageBuffer, messageLength);
+          }
+          break;
+
+        case Ping:
+          sendFrame(Pong, payload, std::min(length, MaxControlPayloadLength));
+          break;
+
+        case Pong:
+          onPong(static_cast<const char*>(payload), length);
+          break;
+
+        case Close: {
+          closeCode = NoStatus;
+          closeReason[0] = '\0';
+          if(length >= 2) {
+            closeCode = static_cast<std::uint16_t>(static_cast<std::uint8_t>(payload[0]) << 8 | static_cast<std::uint8_t>(payload[1]));
+            std::size_t reasonLength = std::min(length - 2, MaxControlPayloadLength);
+            memcpy(closeReason, payload + 2, reasonLength);
+            closeReason[reasonLength] = '\0';
+          }
+
+          // Echo the status code, the connection is done once the reply is written (or right away if we closed first)
+          sendFrame(Close, payload, std::min<std::size_t>(length, 2));
+          std::lock_guard<std::mutex> lock(sendMutex);
+          peerClosed = true;
+          break;
+        }
+
+        default:
+          break;
+      }
+    }
+
+    /**
+     * @brief Handles complete frames in the receive buffer, keeping the incomplete one at its start.
+     */
+    template<typename OnMessage, typename OnPong>
+    void process(OnMessage &onMessage, OnPong &onPong, std::size_t &received) {
+      std::size_t position = 0;
+
+      while(running.load(std::memory_order_relaxed)) {
+        char *start = receiveBuffer + position;
+        std::size_t available = filled - position;
+
+        Frame frame;
+        std::size_t headerLength = parseHeader(start, available, frame);
+        if(headerLength == 0) break;
+
+        if(frame.reserved) {
+          close(ProtocolError);
+          break;
+        }
+
+        // Frame never fits the buffer, its payload is skipped as it is received
+        if(frame.payloadLength > BufferSize - 1 - headerLength) {
+          skipping = frame.payloadLength - (available - headerLength);
+          if(frame.opcode == Text || frame.opcode == Binary || frame.opcode == Continuation) {
+            fragmented = !frame.fin;
+            dropping = true;
+          }
+          position = filled;
+          break;
+        }
+
+        std::size_t frameLength = headerLength + frame.payloadLength;
+        if(available < frameLength) break;
+
+        char *payload = start + headerLength;
+        if(frame.masked) mask(payload, frame.payloadLength, frame.maskKey, payload);
+        handle(frame, payload, onMessage, onPong, received);
+        position += frameLength;
+      }
+
+      memmove(receiveBuffer, receiveBuffer + position, filled - position);
+      filled -= position;
+    }
+
+    /**
+     * @brief Steps of connect, the caller cleans up on failure.
+     */
+    bool open(const char *url, const char *authorization, unsigned pingMilliseconds, bool sqPoll, unsigned sqPollIdleMilliseconds) {
+      ring.close();
+      session.close();
+      if(fd != -1) ::close(fd);
+      fd = -1;
+      kernelTLSUnavailable = false;
+
+      Address address;
+      if(!parseAddress(url, address)) return false;
+
+      addrinfo hints {}, *addresses = nullptr;
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+      if(getaddrinfo(address.host, address.port, &hints, &addresses) != 0) return false;
+
+      for(addrinfo *candidate = addresses; candidate != nullptr; candidate = candidate->ai_next) {
+        fd = socket(candidate->ai_family, candidate->ai_socktype | SOCK_CLOEXEC, candidate->ai_protocol);
+        if(fd == -1) continue;
+        if(::connect(fd, candidate->ai_addr, candidate->ai_addrlen) == 0) break;
+
+        ::close(fd);
+        fd = -1;
+      }
+      freeaddrinfo(addresses);
+      if(fd == -1) return false;
+
+      signal(SIGPIPE, SIG_IGN);
+
+      int noDelay = 1;
+      timeval timeout { static_cast<time_t>(HandshakeTimeoutMilliseconds / 1000), static_cast<suseconds_t>(HandshakeTimeoutMilliseconds % 1000 * 1000) };
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+      setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+      // TLS handshake, then sends are plain writes encrypted by the kernel
+      if(address.secure) {
+        KernelTLS::Status status = session.connect(fd, address.host);
+        if(status != KernelTLS::Status::Offloaded) {
+          kernelTLSUnavailable = status == KernelTLS::Status::Unavailable;
+          session.close();
+          return false;
+        }
+      }
+
+      // Opening handshake, blocking
+
+      std::uint8_t nonce[16];
+      char key[KeyLength + 1];
+      if(getrandom(nonce, sizeof(nonce), 0) != static_cast<ssize_t>(sizeof(nonce)) || getrandom(&maskState, sizeof(maskState), 0) != static_cast<ssize_t>(sizeof(maskState))) return false;
+      maskState |= 1;
+      EVP_EncodeBlock(reinterpret_cast<unsigned char*>(key), nonce, sizeof(nonce));
+
+      std::size_t requestLength = buildHandshake(address, key, authorization, receiveBuffer, BufferSize);
+      for(std::size_t written = 0; written < requestLength;) {
+        ssize_t count = ::send(fd, receiveBuffer + written, requestLength - written, MSG_NOSIGNAL);
+        if(count <= 0) return false;
+        written += count;
+      }
+
+      filled = 0;
+      char *headersEnd = nullptr;
+      while(headersEnd == nullptr) {
+        ssize_t count = receivePlain(receiveBuffer + filled, BufferSize - 1 - filled);
+        if(count <= 0) return false;
+
+        filled += count;
+        receiveBuffer[filled] = '\0';
+        headersEnd = static_cast<char*>(memmem(receiveBuffer, filled, "\r\n\r\n", 4));
+      }
+
+      *headersEnd = '\0';
+      if(!checkHandshake(receiveBuffer, key)) return false;
+
+      // Frames sent right after the response stay in the buffer
+      std::size_t headersLength = headersEnd + 4 - receiveBuffer;
+      memmove(receiveBuffer, headersEnd + 4, filled - headersLength);
+      filled -= headersLength;
+
+      timeout = timeval {};
+      setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+      // Ring with the socket and buffers registered
+
+      iovec buffers[3] = {
+        { receiveBuffer, sizeof(receiveBuffer) },
+        { slots, sizeof(slots) },
+        { recordsBuffer, sizeof(recordsBuffer) }
+      };
+
+      if(!ring.init(RingEntries, sqPoll, sqPollIdleMilliseconds) || !ring.registerFiles(&fd, 1) || !ring.registerBuffers(buffers, 3)) {
+        ring.close();
+        return false;
+      }
+
+      tickTimeout.tv_sec = pingMilliseconds / 1000;
+      tickTimeout.tv_nsec = pingMilliseconds % 1000 * 1000000LL;
+
+      queueHead = queueTail = sendOffset = 0;
+      sending = closeSent = peerClosed = pinged = false;
+      skipping = messageLength = 0;
+      fragmented = dropping = false;
+      closeCode = Abnormal;
+      closeReason[0] = '\0';
+
+      running.store(true);
+      return true;
+    }
+
+    public:
+
+    Client() = default;
+    Client(const Client&) = delete;
+    Client &operator=(const Client&) = delete;
+
+    ~Client() {
+      ring.close();
+      if(fd != -1) ::close(fd);
+    }
+
+    /**
+     * @brief Connects, makes the opening handshake (after TLS handshake over wss://) and sets the ring up.
+     * Writes to a reset connection raise SIGPIPE, so it is ignored process-wide.
+     *
+     * @param url server URL (ws://host[:port][/path] or wss://host[:port][/path])
+     * @param authorization Authorization header value, nullptr or empty if none
+     * @param pingMilliseconds interval of pings sent to the server and of the tick callback of the loop
+     * @param sqPoll submit requests through kernel polling thread
+     * @param sqPollIdleMilliseconds time without submissions after which polling thread sleeps
+     * @return false on failure, also when kernel TLS is unavailable over wss:// (see isKernelTLSUnavailable)
+     */
+    bool connect(const char *url, const char *authorization, unsigned pingMilliseconds, bool sqPoll = false, unsigned sqPollIdleMilliseconds = 1000) {
+      if(open(url, authorization, pingMilliseconds, sqPoll, sqPollIdleMilliseconds)) return true;
+
+      ring.close();
+      session.close();
+      if(fd != -1) ::close(fd);
+      fd = -1;
+      return false;
+    }
+
+    /**
+     * @brief Sends close frame, the loop stops when the server replies (or closes the connection, or a ping interval passes).
+     * Can be called from any thread (and from the callbacks).
+     *
+     * @param code close status code
+     */
+    void close(std::uint16_t code = Normal) {
+      const char payload[2] = { static_cast<char>(code >> 8), static_cast<char>(code & 0xff) };
+      sendFrame(Close, payload, 2);
+    }
+
+    bool isOpen() const {
+      return running.load();
+    }
+
+    /**
+     * @brief Sends text message.
+     *
+     * @param message input message
+     * @param length input message length
+     * @return false if the connection is closed, the message is too long or all send slots are taken
+     */
+    bool send(const char *message, std::size_t length) {
+      return sendFrame(Text, message, length);
+    }
+
+    /**
+     * @brief Sends ping, pongs of it are passed to onPong of the loop.
+     *
+     * @param payload input payload
+     * @param length input payload length, at most MaxControlPayloadLength
+     * @return false if the connection is closed, the payload is too long or all send slots are taken
+     */
+    bool ping(const char *payload, std::size_t length) {
+      return length <= MaxControlPayloadLength && sendFrame(Ping, payload, length);
+    }
+
+    /**
+     * @brief Sends unsolicited pong (unidirectional heartbeat, not answered by the server).
+     *
+     * @param payload input payload
+     * @param length input payload length, at most MaxControlPayloadLength
+     * @return false if the connection is closed, the payload is too long or all send slots are taken
+     */
+    bool pong(const char *payload, std::size_t length) {
+      return length <= MaxControlPayloadLength && sendFrame(Pong, payload, length);
+    }
+
+    /**
+     * @brief Checks if the last connect failed over wss:// because kernel TLS is unavailable (TLS handshake itself succeeded).
+     */
+    bool isKernelTLSUnavailable() const {
+      return kernelTLSUnavailable;
+    }
+
+    /**
+     * @brief Returns close status code received from the server, Abnormal if the connection was closed without close frame.
+     */
+    std::uint16_t getCloseCode() const {
+      return closeCode;
+    }
+
+    /**
+     * @brief Returns close reason received from the server.
+     */
+    const char *getCloseReason() const {
+      return closeReason;
+    }
+
+    /**
+     * @brief Reads messages until the connection is closed by either side. Pings are sent every ping interval.
+     *
+     * @param onMessage called as onMessage(char *message, std::size_t length) for every message (null-terminated, writable)
+     * @param onTick called every ping interval
+     * @return number of received messages
+     */
+    template<typename OnMessage, typename OnTick>
+    std::size_t run(OnMessage onMessage, OnTick onTick) {
+      return run(onMessage, onTick, [](const char*, std::size_t) {});
+    }
+
+    /**
+     * @brief Reads messages until the connection is closed by either side. Empty ping is sent every ping interval,
+     * unless a ping was sent since the previous one (see ping).
+     *
+     * @param onMessage called as onMessage(char *message, std::size_t length) for every message (null-terminated, writable)
+     * @param onTick called every ping interval
+     * @param onPong called as onPong(const char *payload, std::size_t length) for every pong
+     * @return number of received messages
+     */
+    template<typename OnMessage, typename OnTick, typename OnPong>
+    std::size_t run(OnMessage onMessage, OnTick onTick, OnPong onPong) {
+      std::size_t received = 0;
+
+      // Frames received along with the handshake response (and records fed in along with it over wss://)
+      if(filled != 0) process(onMessage, onPong, received);
+
+      std::size_t decrypted;
+      while(session.isOpen() && session.hasPending() && session.decrypt(nullptr, 0, receiveBuffer + filled, BufferSize - 1 - filled, decrypted) && decrypted != 0) {
+        append(decrypted);
+        process(onMessage, onPong, received);
+      }
+
+      bool broken = !submitRead() || !submitTick();
+      io_uring_cqe cqe;
+
+      while(!broken && running.load(std::memory_order_relaxed) && ring.wait(cqe)) {
+        switch(cqe.user_data) {
+          case Receive: {
+            if(cqe.res == -EINTR || cqe.res == -EAGAIN) {
+              broken = !submitRead();
+              break;
+            }
+
+            if(cqe.res <= 0) {
+              broken = true;
+              break;
+            }
+
+            if(!session.isOpen()) {
+              append(cqe.res);
+              process(onMessage, onPong, received);
+              broken = !submitRead();
+              break;
+            }
+
+            // Records are decrypted as long as the receive buffer has room
+            const char *records = recordsBuffer;
+            std::size_t recordsLength = cqe.res, decrypted;
+            do {
+              broken = !session.decrypt(records, recordsLength, receiveBuffer + filled, BufferSize - 1 - filled, decrypted);
+              records = nullptr;
+              recordsLength = 0;
+
+              append(decrypted);
+              process(onMessage, onPong, received);
+            } while(!broken && decrypted != 0 && session.hasPending());
+
+            if(!broken) broken = !submitRead();
+            break;
+          }
+
+          case Send:
+            broken = !completeWrite(cqe.res);
+            break;
+
+          case Tick: {
+            // Server did not reply to close frame in time
+            bool closing;
+            {
+              std::lock_guard<std::mutex> lock(sendMutex);
+              closing = closeSent;
+            }
+            if(closing) {
+              broken = true;
+              break;
+            }
+
+            onTick();
+
+            bool idle;
+            {
+              std::lock_guard<std::mutex> lock(sendMutex);
+              idle = !pinged;
+            }
+            if(idle) sendFrame(Ping, nullptr, 0);
+
+            {
+              std::lock_guard<std::mutex> lock(sendMutex);
+              pinged = false;
+            }
+
+            broken = !submitTick();
+            break;
+          }
+        }
+
+        if(isDone()) break;
+      }
+
+      running.store(false);
+      shutdown(fd, SHUT_RDWR);
+
+      // In-flight requests are cancelled before the buffers can be reused
+      ring.close();
+      session.close();
+      return received;
+    }
+  };
+}
\ No newline at end of file
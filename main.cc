@@ -1,4 +1,12 @@
 #include <charconv>
+#include <chrono>
+#include <atomic>
+#include <csignal>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
 
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
@@ -7,6 +15,25 @@
 #include <utils.hpp>
 #include <transaction.hpp>
 #include <bot.hpp>
+#include <uniswap.hpp>
+#include <pregen.hpp>
+#include <histogram.hpp>
+#include <wallet.hpp>
+#include <pipeline.hpp>
+#include <numa.hpp>
+#include <exit.hpp>
+#include <cancel.hpp>
+#include <shared.hpp>
+#include <signer.hpp>
+#include <feed.hpp>
+#include <websocket.hpp>
+#include <heartbeat.hpp>
+#include <warm.hpp>
+#include <bundle.hpp>
+#include <prearm.hpp>
+#include <rules.hpp>
+#include <telemetry.hpp>
+#include <match.hpp>
 
 // websocketpp includes
 
@@ -24,110 +51,424 @@
 
 struct CustomWSConfig : public AsioClientConfig {
   static const std::size_t connection_read_buffer_size = 1024;
-  static const bool enable_multithreading = false;
+  static const bool enable_multithreading = Config::Pipeline::Enabled || Config::Exit::Enabled;
 };
 
 // Global variables, do not do that at home kids
 
-Utils::Byte privateKey[32];
-Transaction tx;
-char pregenTxs[Config::TransactionPreGen::ArraySize][Config::Size::BloXrouteTransactionMessageString];
+using PreGenStore = std::conditional_t<
+  Config::TransactionPreGen::Compact,
+  PreGen::CompactStore<Config::TransactionPreGen::Capacity>,
+  PreGen::Store<Config::TransactionPreGen::Capacity, Config::Size::BloXrouteTransactionMessageString>
+>;
+Wallet<PreGenStore> wallets[Config::Wallets::Count];
+Shared::Mapping<PreGenStore, TransactionDataBuilder::DataLength, Config::Wallets::Count> sharedPreGen;
+Signer::Channel<Config::Signer::QueueCapacity, Config::Size::BloXrouteTransactionMessageString> signerChannel;
+Pipeline::SignerPool<Config::Pipeline::QueueCapacity, Config::Size::BloXrouteTransactionMessageString> signerPool;
+std::thread senderThread;
+std::atomic<bool> senderRunning { false };
+std::atomic<std::size_t> pendingSigns { 0 };
+std::atomic<bool> closing { false };
+using ExitPosition = Exit::Position<Config::Exit::ArraySize, Config::Size::BloXrouteTransactionMessageString, Config::Exit::TiersCount>;
+ExitPosition exitPositions[Config::Wallets::Count];
+Exit::Trigger exitTrigger;
+std::thread exitThread;
+std::atomic<bool> exitRunning { false };
+std::atomic<bool> exitPending { false };
+using CancelTable = Cancel::Table<Config::Cancel::ArraySize, Config::Size::BloXrouteTransactionMessageString>;
+CancelTable cancelTables[Config::Wallets::Count];
+Cancel::Watcher cancelWatcher;
+std::atomic<bool> cancelled { false };
+PreGen::Stats pregenStats;
+GasPriceHistogram<Config::TransactionPreGen::Adaptive::HistogramCapacity> gasPriceHistogram;
+Telemetry::Metrics<Config::Telemetry::Buckets> telemetry;
+Heartbeat::Monitor<Config::Feed::WebSocket::Heartbeat::Window> heartbeat;
+Heartbeat::Endpoints<std::size(Config::BloXroute::Connection::Addresses)> endpoints;
+bool reconnecting = false;
+char keepWarmPayload[WebSocket::MaxControlPayloadLength];
+Warm::Warmer<Config::Warm::LikelyCount> warmer;
+Numa::Topology topology;
+Bundle::Composer<Config::Size::BundleRequestBody> bundleComposer;
+Bundle::Relay relay;
+PreArm::Watcher preArmWatcher;
+std::atomic<bool> preArming { false };
+std::mutex pregenMutex;
+SPSCQueue<uint64_t, Config::TransactionPreGen::LearnedQueueCapacity> learnedGasPrices;
+char targetToken[ABI::AddressLength + 1];
+char preArmData[TransactionDataBuilder::DataLength + 1];
+Rules::Program<std::size(Config::Rules::List)> filterRules;
 
 websocketpp::client<CustomWSConfig> wsClient;
 websocketpp::connection_hdl wsConnectionHdl;
 websocketpp::client<CustomWSConfig>::timer_ptr wsTimer;
 
+/**
+ * @brief BloXroute Cloud API connection, transaction messages are sent as they are.
+ */
+struct WebSocketFeed {
+  void send(const char *message, std::size_t length) {
+    wsClient.send(wsConnectionHdl, message, length, websocketpp::frame::opcode::text);
+  }
+
+  void close() {
+    wsClient.close(wsConnectionHdl, websocketpp::close::status::normal, "Connection closed by client");
+  }
+
+  void ping(const char *payload, std::size_t length) {
+    wsClient.ping(wsConnectionHdl, std::string(payload, length));
+  }
+
+  void pong(const char *payload, std::size_t length) {
+    wsClient.pong(wsConnectionHdl, std::string(payload, length));
+  }
+};
+
+using NodeFeed = Feed::UnixSocket<Config::Feed::Node::BufferSize>;
+using UringClient = WebSocket::Client<Config::Feed::WebSocket::BufferSize, Config::Size::BloXrouteTransactionMessageString + WebSocket::MaxHeaderLength, Config::Feed::WebSocket::SendSlots>;
+
+/**
+ * @brief BloXroute Cloud API connection over io_uring, falls back to websocketpp (WS_TLS) if kernel TLS is unavailable.
+ */
+struct UringFeed {
+  UringClient client;
+  bool fallback = false;
+
+  void send(const char *message, std::size_t length) {
+    if(fallback) {
+      WebSocketFeed().send(message, length);
+    } else {
+      client.send(message, length);
+    }
+  }
+
+  void close() {
+    if(fallback) {
+      WebSocketFeed().close();
+    } else {
+      client.close();
+    }
+  }
+
+  void ping(const char *payload, std::size_t length) {
+    if(fallback) {
+      WebSocketFeed().ping(payload, length);
+    } else {
+      client.ping(payload, length);
+    }
+  }
+
+  void pong(const char *payload, std::size_t length) {
+    if(fallback) {
+      WebSocketFeed().pong(payload, length);
+    } else {
+      client.pong(payload, length);
+    }
+  }
+};
+
+#ifdef WS_TLS
+  inline constexpr bool KernelTLSFeed = Config::Feed::WebSocket::KernelTLS;
+#else
+  inline constexpr bool KernelTLSFeed = false;
+#endif
+
+std::conditional_t<
+  Config::Feed::Selected == Config::Feed::Source::Node,
+  NodeFeed,
+  std::conditional_t<Config::Feed::WebSocket::Selected == Config::Feed::WebSocket::Transport::Uring || KernelTLSFeed, UringFeed, WebSocketFeed>
+> feed;
+char nodeMessage[Config::Size::BloXrouteTransactionMessageString];
+
+/**
+ * @brief Interval of pings (and of the tick of the WebSocket feed loop).
+ */
+inline constexpr unsigned PingMilliseconds = Config::Feed::WebSocket::Heartbeat::Enabled ? Config::Feed::WebSocket::Heartbeat::IntervalMilliseconds : Config::Feed::WebSocket::PingMilliseconds;
+
 // Forward declare functions
 
 #ifdef WS_TLS
   websocketpp::lib::shared_ptr<websocketpp::lib::asio::ssl::context> onTLSInit(websocketpp::connection_hdl);
 #endif
 
+void runFeed(WebSocketFeed &webSocketFeed);
+void runFeed(NodeFeed &nodeFeed);
+void runFeed(UringFeed &uringFeed);
+void subscribeCloudAPI();
 void onOpen(websocketpp::connection_hdl connectionHdl);
 void onMessage(websocketpp::connection_hdl connectionHdl, websocketpp::client<CustomWSConfig>::message_ptr message);
 void onClose(websocketpp::connection_hdl connectionHdl);
+void onPong(websocketpp::connection_hdl connectionHdl, std::string payload);
+void connectWebSocket(const char *address);
+template<typename WebSocketFeedType> void beat(WebSocketFeedType &webSocketFeed);
+void measurePong(const char *payload, std::size_t length);
+void resetHeartbeat();
+const char *nextEndpoint();
+void warm();
+void pollRelay();
+bool sendBundle(const char *target, std::size_t targetLength, const char *message, std::size_t messageLength);
+void processMessage(char *messageStr);
+void openPosition(std::size_t walletIndex, uint64_t gasPrice, const char *message);
+void runExit();
+void sendCancels();
+std::size_t signRequest(Transaction &transaction, Pipeline::SignRequest &request, char *output);
+void runSender();
+void closeWhenDone();
+void observeGasPrice(const char *message);
+std::vector<uint64_t> configGasPrices();
+void pregenerate(Wallet<PreGenStore> &wallet, const std::vector<uint64_t> &gasPrices);
+void pregenerateDynamicFees(Wallet<PreGenStore> &wallet);
+void rePregenerate();
+void learnGasPrices();
+void preArm(const char *token, PreArm::Signal signal);
+void armTarget(std::string token);
 void sendPing(__attribute__((unused)) websocketpp::lib::error_code const &errorCode);
 void setTimer();
 
 int main () {
-  // Convert private key to buffer
+  // Transaction data is built from config at compile time
 
-  Utils::hexStringToBuffer(Config::Transaction::PrivateKey, privateKey);
-
-  // Generate transaction data
-
-  char data[TransactionDataBuilder::DataLength + 1];
-  TransactionDataBuilder::buildData(
-    Config::Transaction::SwapExactETHForTokens::AmountOutMin, 
-    Config::Transaction::SwapExactETHForTokens::TokenAddress, 
-    Config::Transaction::SwapExactETHForTokens::ReceiverAddress,
-    data
-  );
+  const char *data = TransactionDataBuilder::ConfigData.hex;
+  memcpy(targetToken, Config::BloXroute::Filters::TokenAddress, sizeof(targetToken));
 
   // Print debug info
 
-  uint64_t gasLimit, value;
+  uint64_t gasLimit;
   std::from_chars(Config::Transaction::GasLimit, Config::Transaction::GasLimit + strlen(Config::Transaction::GasLimit), gasLimit, 16);
-  std::from_chars(Config::Transaction::Value, Config::Transaction::Value + strlen(Config::Transaction::Value), value, 16);
   printf("Transaction fields:\n");
-  printf("Nonce: %s\n", Config::Transaction::Nonce);
   printf("Gas price: to be determined\n");
   printf("Gas limit: %" PRIu64 "\n", gasLimit);
   printf("To: 0x%s\n", Config::Transaction::To);
-  printf("Value: %" PRIu64 " wei\n", value);
   printf("Data: 0x%s\n", data);
 
+  printf("\nWallets (sending from %zu of %zu on match):\n", Config::Wallets::SendCount, Config::Wallets::Count);
+  for(std::size_t i = 0; i < Config::Wallets::Count; i++) {
+    uint64_t value;
+    std::from_chars(Config::Wallets::List[i].Value, Config::Wallets::List[i].Value + strlen(Config::Wallets::List[i].Value), value, 16);
+    printf("#%zu nonce: %s, value: %" PRIu64 " wei\n", i, Config::Wallets::List[i].Nonce, value);
+  }
+
+  if constexpr (Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin) {
+    printf("AmountOutMin: derived from liquidity add (%" PRIu64 " bps slippage), pregenerated transactions are disabled\n", Config::Transaction::SwapExactETHForTokens::SlippageBasisPoints);
+  }
+
   printf("\nListener filters:\n");
   printf("Maximum gas price: %s wei\n", Config::BloXroute::Filters::MaxGasPrice);
   printf("Minimum value: %s wei\n", Config::BloXroute::Filters::MinValue);
 
-  // Set transaction fields
+  if constexpr (Config::Rules::Enabled) {
+    filterRules.compile(Config::Rules::List, std::size(Config::Rules::List), targetToken);
+    filterRules.print();
+  }
 
-  tx.setField(Transaction::Field::Nonce, Config::Transaction::Nonce);
-  tx.setField(Transaction::Field::GasLimit, Config::Transaction::GasLimit);
-  tx.setField(Transaction::Field::To, Config::Transaction::To);
-  tx.setField(Transaction::Field::Value, Config::Transaction::Value);
-  tx.setField(Transaction::Field::Data, data);
-  
-  // Pregenerate transactions
+  // Set transaction fields of every wallet
 
-  printf("\nPregenerating transactions...\n");
+  for(std::size_t i = 0; i < Config::Wallets::Count; i++) {
+    Config::Wallets::Wallet walletConfig = Config::Wallets::List[i];
+    if constexpr (Config::Signer::Enabled) walletConfig.PrivateKey = "";
+    wallets[i].init(walletConfig, data);
+  }
 
-  Utils::Byte transactionBuffer[Config::Size::TransactionRawBuffer];
-  char transactionString[Config::Size::TransactionRawBuffer * 2];
+  // Keep memory of the hot path on the NUMA node of the NIC, pregenerated transactions are allocated on it from now on
 
-  for(
-    std::size_t gasPrice = Config::TransactionPreGen::GasPriceGweiFrom * Config::TransactionPreGen::GasPriceGweiDecimals; 
-    gasPrice <= Config::TransactionPreGen::GasPriceGweiTo * Config::TransactionPreGen::GasPriceGweiDecimals; 
-    gasPrice++
-  ) {
-    Utils::Byte gasPriceBuffer[8];
-    std::size_t gasPriceBufferSize = Utils::intToBuffer(
-      gasPrice * (1000000000 / Config::TransactionPreGen::GasPriceGweiDecimals), 
-      gasPriceBuffer
+  if constexpr (Config::Numa::Enabled) {
+    topology = Numa::discover(Config::Numa::Interface);
+    printf("\n");
+    topology.print();
+
+    if(topology.isKnown()) {
+      Numa::preferNode(topology.node);
+      for(Wallet<PreGenStore> &wallet : wallets) wallet.moveToNode(topology.node);
+      Numa::moveMemory(&feed, sizeof(feed), topology.node);
+      if constexpr (Config::Exit::Enabled) Numa::moveMemory(exitPositions, sizeof(exitPositions), topology.node);
+      if constexpr (Config::Cancel::Enabled) Numa::moveMemory(cancelTables, sizeof(cancelTables), topology.node);
+
+      printf("Placed wallets, pregenerated transactions and signing contexts on node %d\n", topology.node);
+    }
+  }
+
+  // Connect to the signer process holding private keys
+
+  if constexpr (Config::Signer::Enabled) {
+    if(!signerChannel.open(Config::Signer::Name) || !signerChannel.isServing()) {
+      printf("\nSigner process is not serving %s, start build/signerd first\n", Config::Signer::Name);
+      exit(1);
+    }
+
+    printf("\nConnected to signer process over %s\n", Config::Signer::Name);
+  }
+
+  // Map transactions pregenerated by the pregen daemon
+
+  if constexpr (Config::SharedPreGen::Enabled && !Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin) {
+    if(sharedPreGen.open(Config::SharedPreGen::Name)) {
+      printf("\nMapped pregenerated transactions from shared memory segment %s (generation %" PRIu64 ")\n", Config::SharedPreGen::Name, sharedPreGen.generation());
+    } else {
+      printf("\nCould not map shared memory segment %s, pregenerating transactions locally\n", Config::SharedPreGen::Name);
+    }
+  }
+
+  // Pregenerate transactions on all cores (skipped when amountOutMin is derived per liquidity add or mapped from shared memory)
+
+  if(!Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin && !sharedPreGen.isOpen() && !Config::Signer::Enabled) {
+    printf("\nPregenerating transactions...\n");
+
+    std::vector<uint64_t> gasPrices = configGasPrices();
+    for(Wallet<PreGenStore> &wallet : wallets) pregenerate(wallet, gasPrices);
+
+    printf(
+      "Successfully pregenerated transactions with gas price from %" PRIu64 " to %" PRIu64 " gwei (%zu per wallet)\n",
+      Config::TransactionPreGen::GasPriceGweiFrom,
+      Config::TransactionPreGen::GasPriceGweiTo,
+      Config::TransactionPreGen::ArraySize   
     );
-    tx.setField(Transaction::Field::GasPrice, gasPriceBuffer, gasPriceBufferSize);
 
-    std::size_t transactionBufferSize = tx.sign(privateKey, transactionBuffer);
+    if constexpr (Config::TransactionPreGen::DynamicFee::Enabled) {
+      namespace DynamicFee = Config::TransactionPreGen::DynamicFee;
+
+      for(Wallet<PreGenStore> &wallet : wallets) pregenerateDynamicFees(wallet);
 
-    Utils::bufferToHexString(transactionBuffer, transactionBufferSize, transactionString, true);
+      printf(
+        "Successfully pregenerated EIP-1559 transactions with max fee from %" PRIu64 " to %" PRIu64 " gwei and priority fee from %" PRIu64 " to %" PRIu64 " gwei (%zu per wallet, %zu kB)\n",
+        DynamicFee::MaxFeeGweiFrom,
+        DynamicFee::MaxFeeGweiTo,
+        DynamicFee::PriorityFeeGweiFrom,
+        DynamicFee::PriorityFeeGweiTo,
+        wallets[0].dynamicFeeTxs.size(),
+        wallets[0].dynamicFeeTxs.memoryUsage() / 1024
+      );
+    }
+  }
+
+  // Pregenerate cancels of the buy, sent if the target transaction gets replaced
 
-    BloXrouteMessageBuilder::buildTransaction(
-      transactionString, 
-      pregenTxs[gasPrice - Config::TransactionPreGen::GasPriceGweiFrom * Config::TransactionPreGen::GasPriceGweiDecimals]
+  if constexpr (Config::Cancel::Enabled) {
+    std::vector<uint64_t> gasPrices;
+    gasPrices.reserve(Config::Cancel::ArraySize);
+    for(
+      uint64_t gasPrice = Config::Cancel::GasPriceGweiFrom * Config::Cancel::GasPriceGweiDecimals;
+      gasPrice <= Config::Cancel::GasPriceGweiTo * Config::Cancel::GasPriceGweiDecimals;
+      gasPrice++
+    ) {
+      gasPrices.push_back(gasPrice * (1000000000 / Config::Cancel::GasPriceGweiDecimals));
+    }
+
+    for(std::size_t i = 0; i < Config::Wallets::Count; i++) {
+      cancelTables[i].init(wallets[i].getNonce(), wallets[i].address);
+      cancelTables[i].generate(gasPrices, wallets[i].privateKey, Config::TransactionPreGen::Threads);
+    }
+
+    printf(
+      "Successfully pregenerated cancels with gas price from %" PRIu64 " to %" PRIu64 " gwei (%zu per wallet)\n",
+      Config::Cancel::GasPriceGweiFrom,
+      Config::Cancel::GasPriceGweiTo,
+      Config::Cancel::ArraySize
     );
   }
 
-  printf(
-    "Successfully pregenerated transactions with gas price from %" PRIu64 " to %" PRIu64 " gwei (%zu in total)\n",
-    Config::TransactionPreGen::GasPriceGweiFrom,
-    Config::TransactionPreGen::GasPriceGweiTo,
-    Config::TransactionPreGen::ArraySize   
-  );
+  for(Wallet<PreGenStore> &wallet : wallets) wallet.arm();
 
-  // Connect to BloXroute Cloud API
+  // Keep the match path primed between liquidity adds, on feed loop ticks
+
+  if constexpr (Config::Warm::Enabled) {
+    warmer.init(
+      targetToken,
+      Config::TransactionPreGen::GasPriceGweiFrom * 1000000000,
+      Config::Warm::IntervalMilliseconds * 1000000ULL,
+      Config::Warm::BudgetMicroseconds * 1000ULL
+    );
 
-  printf("\nConnecting to %s...\n", Config::BloXroute::Connection::Address);
+    printf("\nWarming match path every %u ms (budget %u us)\n", Config::Warm::IntervalMilliseconds, Config::Warm::BudgetMicroseconds);
+  }
+
+  // Keep connection to the relay open, buys are bundled behind target transactions
+
+  if constexpr (Config::Bundle::Enabled) {
+    bool connected = relay.connect(Config::Bundle::RelayUrl);
+    if(!bundleComposer.init(relay.getUrl())) {
+      printf("\nInvalid relay URL %s\n", Config::Bundle::RelayUrl);
+      exit(1);
+    }
+
+    if(connected) printf("\nConnected to relay %s, bundling buys behind target transactions\n", Config::Bundle::RelayUrl);
+    else printf("\nCould not connect to relay %s, retrying on feed loop ticks\n", Config::Bundle::RelayUrl);
+  }
+
+  // Retarget and pre-arm on signals preceding the liquidity add
+
+  if constexpr (Config::PreArm::Enabled) {
+    preArmWatcher.init(Config::PreArm::Deployer, Config::Router::Selected);
+
+    if(Config::PreArm::Deployer[0] != '\0') printf("\nPre-arming on createPair of the target and on deployments, router approves and pair creations of 0x%s\n", Config::PreArm::Deployer);
+    else printf("\nPre-arming on createPair of the target\n");
+  }
+
+  // Start signer pool and sender
+
+  if constexpr (Config::Pipeline::Enabled) {
+    signerPool.start(Config::Pipeline::SignerThreads, Config::Pipeline::SignerFirstCore, signRequest, topology.node);
+    senderRunning.store(true);
+    senderThread = std::thread(runSender);
+
+    printf("\nStarted %zu signer threads\n", Config::Pipeline::SignerThreads);
+  }
+
+  // Exit is pregenerated after the buy and sent on timer, price signal or manual signal (SIGUSR1)
+
+  if constexpr (Config::Exit::Enabled) {
+    exitRunning.store(true);
+    exitThread = std::thread(runExit);
+    signal(SIGUSR1, [](int) { exitTrigger.fire(Exit::Signal::Manual); });
+
+    printf("Exit: sell tier #%zu on timer (%u s), #%zu on removeLiquidityETH, #%zu on SIGUSR1\n", Config::Exit::TimerTier, Config::Exit::TimerSeconds, Config::Exit::PriceSignalTier, Config::Exit::ManualTier);
+  }
+
+  // Re-pregenerate transactions for observed gas prices in the background
+
+  if(Config::TransactionPreGen::Adaptive::Enabled && !Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin && !sharedPreGen.isOpen() && !Config::Signer::Enabled) {
+    if(Config::TransactionPreGen::Adaptive::HistogramPath[0] != '\0' && gasPriceHistogram.load(Config::TransactionPreGen::Adaptive::HistogramPath)) {
+      printf("Loaded %zu observed gas prices from %s\n", gasPriceHistogram.size(), Config::TransactionPreGen::Adaptive::HistogramPath);
+    }
+
+    std::thread(rePregenerate).detach();
+  }
+
+  // Pregenerate transactions for gas prices learned from the stream in the background
+
+  if(Config::TransactionPreGen::LearnFromFeed && !Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin && !sharedPreGen.isOpen() && !Config::Signer::Enabled) {
+    std::thread(learnGasPrices).detach();
+  }
+
+  // Publish decision counters for build/telemetry
+
+  if constexpr (Config::Telemetry::Enabled) {
+    if(telemetry.create(Config::Telemetry::Name, Config::Telemetry::BucketWidth, getpid())) {
+      printf("\nPublishing telemetry in shared memory segment %s\n", Config::Telemetry::Name);
+    } else {
+      printf("\nCould not create shared memory segment %s, telemetry is not published\n", Config::Telemetry::Name);
+    }
+  }
+
+  // Listen on the selected feed until the connection is closed, on CPUs of the NIC node (pinned last, so the threads started above do not inherit it)
+
+  if constexpr (Config::Numa::NetworkCore >= 0) Pipeline::pinThread(Config::Numa::NetworkCore);
+  else Numa::pinThread(topology.cpus);
+
+  runFeed(feed);
+
+  if constexpr (Config::Pipeline::Enabled) {
+    senderRunning.store(false);
+    senderThread.join();
+    signerPool.stop();
+  }
+
+  if constexpr (Config::Exit::Enabled) {
+    exitRunning.store(false);
+    exitThread.join();
+  }
+}
+
+void runFeed(WebSocketFeed&) {
+  // Connect to BloXroute Cloud API
 
   wsClient.init_asio();
   wsClient.clear_access_channels(websocketpp::log::alevel::all);
@@ -140,16 +481,129 @@ int main () {
   wsClient.set_open_handler(onOpen);
   wsClient.set_message_handler(onMessage);
   wsClient.set_close_handler(onClose);
+  wsClient.set_pong_handler(onPong);
+
+  connectWebSocket(Config::BloXroute::Connection::Addresses[endpoints.getCurrent()]);
+
+  wsClient.run();
+}
+
+void connectWebSocket(const char *address) {
+  printf("\nConnecting to %s...\n", address);
 
   websocketpp::lib::error_code errorCode;
-  websocketpp::client<CustomWSConfig>::connection_ptr wsConnection = wsClient.get_connection(Config::BloXroute::Connection::Address, errorCode);
+  websocketpp::client<CustomWSConfig>::connection_ptr wsConnection = wsClient.get_connection(address, errorCode);
   if(errorCode) exit(1);
 
   wsConnection->append_header("Authorization", Config::BloXroute::Connection::AuthToken);
 
   wsClient.connect(wsConnection);
+}
 
-  wsClient.run();
+void runFeed(UringFeed &uringFeed) {
+  // Connect to BloXroute Cloud API over io_uring transport, wss:// with kernel TLS
+
+  UringClient &client = uringFeed.client;
+  const char *address = Config::BloXroute::Connection::Addresses[endpoints.getCurrent()];
+
+  while(true) {
+    printf("\nConnecting to %s...\n", address);
+
+    if(!client.connect(
+      address,
+      Config::BloXroute::Connection::AuthToken,
+      PingMilliseconds,
+      Config::Feed::WebSocket::SqPoll,
+      Config::Feed::WebSocket::SqPollIdleMilliseconds
+    )) {
+      #ifdef WS_TLS
+        if(client.isKernelTLSUnavailable()) {
+          printf("Kernel TLS is unavailable, falling back to websocketpp TLS\n");
+          uringFeed.fallback = true;
+
+          WebSocketFeed webSocketFeed;
+          runFeed(webSocketFeed);
+          return;
+        }
+      #endif
+
+      printf("Could not connect to %s%s\n", address, client.isKernelTLSUnavailable() ? " (kernel TLS is unavailable)" : "");
+      exit(1);
+    }
+
+    if(strncmp(address, "wss://", 6) == 0) printf("Sends are encrypted by the kernel (kTLS)\n");
+
+    resetHeartbeat();
+    subscribeCloudAPI();
+
+    std::size_t received = client.run(
+      [](char *message, std::size_t) {
+        processMessage(message);
+      },
+      [&uringFeed]() {
+        beat(uringFeed);
+        warm();
+        pollRelay();
+
+        // Watching of target transaction may have timed out
+        if constexpr (Config::Cancel::Enabled) closeWhenDone();
+      },
+      [](const char *payload, std::size_t length) {
+        measurePong(payload, length);
+      }
+    );
+
+    if constexpr (Config::Pipeline::Enabled) {
+      signerPool.print();
+    }
+
+    printf("Connection closed, code: %u, reason: %s (%zu messages received)\n", client.getCloseCode(), client.getCloseReason(), received);
+
+    // Degraded connection was closed to move to another endpoint
+    if(!reconnecting || closing.load()) break;
+    reconnecting = false;
+    address = nextEndpoint();
+  }
+}
+
+void runFeed(NodeFeed &nodeFeed) {
+  // Connect to the node IPC endpoint, its stream is filtered locally
+
+  printf("\nConnecting to %s...\n", Config::Feed::Node::Path);
+
+  if(!nodeFeed.connect(Config::Feed::Node::Path, Config::Feed::Node::IdleMilliseconds)) {
+    printf("Could not connect to %s\n", Config::Feed::Node::Path);
+    exit(1);
+  }
+
+  nodeFeed.request(Feed::Node::SubscribeRequest, sizeof(Feed::Node::SubscribeRequest) - 1);
+  printf("Sent subscribe message\n");
+  printf("Listening on node...\n");
+
+  uint64_t maxFeeCap = 0;
+  std::from_chars(Config::BloXroute::Filters::MaxGasPrice, Config::BloXroute::Filters::MaxGasPrice + strlen(Config::BloXroute::Filters::MaxGasPrice), maxFeeCap);
+  const Feed::Node::Filter filter { Config::Router::Selected.Address, maxFeeCap, UInt256::fromDecimalString(Config::BloXroute::Filters::MinValue), Config::Exit::Enabled };
+
+  std::size_t received = nodeFeed.run(
+    [&filter](const char *message, std::size_t length) {
+      // Transactions of the watched target sender pass the filter
+      const char *from = Config::Cancel::Enabled && cancelWatcher.isWatching(Pipeline::now()) ? cancelWatcher.getFrom() : nullptr;
+      if(Feed::Node::normalize(message, length, filter, from, nodeMessage, sizeof(nodeMessage)) != 0) processMessage(nodeMessage);
+    },
+    []() {
+      warm();
+      pollRelay();
+
+      // Watching of target transaction may have timed out
+      if constexpr (Config::Cancel::Enabled) closeWhenDone();
+    }
+  );
+
+  if constexpr (Config::Pipeline::Enabled) {
+    signerPool.print();
+  }
+
+  printf("Connection closed (%zu messages received)\n", received);
 }
 
 #ifdef WS_TLS
@@ -173,70 +627,206 @@ int main () {
 void onOpen(websocketpp::connection_hdl connectionHdl) {
   wsConnectionHdl = connectionHdl;
 
-  char message[256];
-  BloXrouteMessageBuilder::buildSubscribe(Config::BloXroute::Filters::MinValue, Config::BloXroute::Filters::MaxGasPrice, message);
-  wsClient.send(connectionHdl, message, websocketpp::frame::opcode::text);
+  resetHeartbeat();
+  subscribeCloudAPI();
+
+  // Ping connection every ping interval
+  setTimer();
+}
+
+void subscribeCloudAPI() {
+  feed.send(BloXrouteMessageBuilder::ConfigSubscribe.value, BloXrouteMessageBuilder::ConfigSubscribe.length);
   printf("Sent subscribe message\n");
+
+  if constexpr (Config::PreArm::Enabled) {
+    feed.send(PreArm::ConfigSubscribe.value, PreArm::ConfigSubscribe.length);
+    printf("Sent pre-arm subscribe message\n");
+  }
+
   printf("Listening on Cloud API...\n");
+}
 
-  // Ping connection every 30 seconds
-  setTimer();
+void onMessage(websocketpp::connection_hdl, websocketpp::client<CustomWSConfig>::message_ptr message) {
+  processMessage((char*) message->get_payload().c_str());
 }
 
-void onMessage(websocketpp::connection_hdl connectionHdl, websocketpp::client<CustomWSConfig>::message_ptr message) {
-  char *messageStr = (char*) message->get_payload().c_str();
+/**
+ * @brief Sender of matched liquidity adds (see Match), buys are bundled right behind signed target transaction (and raced too, if configured).
+ */
+struct FeedSender {
+  const char *rawTarget = nullptr;
+  std::size_t rawTargetLength = 0;
+  std::size_t bundlesCount = 0;
+
+  bool accepts(const char *message, const Warm::Fees &fees) {
+    if constexpr (Config::Rules::Enabled) {
+      Rules::Fields fields;
+      Rules::extract(message, fees.gasPrice, fields);
+      if(!filterRules.accepts(fields)) return false;
+    }
+
+    if constexpr (Config::Bundle::Enabled) rawTarget = Bundle::extractRawTransaction(message, rawTargetLength);
+    return true;
+  }
+
+  // Raced transaction goes first, it does not wait for the bundle request
+  void send(const char *message, std::size_t length) {
+    if(rawTarget == nullptr || Config::Bundle::Race) feed.send(message, length);
+    if(rawTarget != nullptr && sendBundle(rawTarget, rawTargetLength, message, length)) bundlesCount++;
+  }
+
+  bool isShared() {
+    return sharedPreGen.isOpen();
+  }
+
+  std::size_t readShared(std::size_t walletIndex, uint64_t gasPrice, char *output, uint64_t &pregenGasPrice) {
+    Wallet<PreGenStore> &wallet = wallets[walletIndex];
+    return sharedPreGen.read(
+      walletIndex, wallet.getNonce(), wallet.getData(), gasPrice,
+      Config::TransactionPreGen::Policy, Config::TransactionPreGen::MaxGasPriceBump, output, pregenGasPrice
+    );
+  }
+
+  bool offload(Pipeline::SignRequest &request, char *output, std::size_t &length, Match::Outcome &outcome) {
+    // Private keys are held by the signer process, there is no signing in this process
+    if constexpr (Config::Signer::Enabled) {
+      length = signerChannel.sign(request, output, Config::Signer::TimeoutMicroseconds * 1000ULL);
+      outcome = length != 0 ? Match::Outcome::Signed : Match::Outcome::Failed;
+      return true;
+    }
+
+    pendingSigns.fetch_add(1);
+    if(signerPool.submit(request)) {
+      outcome = Match::Outcome::Queued;
+      return true;
+    }
+    pendingSigns.fetch_sub(1);
+    return false;
+  }
+};
+
+void processMessage(char *messageStr) {
+  telemetry.count(Telemetry::Messages);
+
+  // Target transaction was replaced by the sender, cancel the buy before it lands
+  if constexpr (Config::Cancel::Enabled) {
+    std::uint64_t now = Pipeline::now();
+    if(cancelWatcher.isCancelled(messageStr, now, targetToken)) {
+      printf("\nReceived replacement of target transaction: %s\n", messageStr);
+      sendCancels();
+      return;
+    }
+
+    // Other transactions of the target sender (any method) are streamed for replacements only
+    if(cancelWatcher.isFromSender(messageStr, now)) return;
+  }
+
+  FeedSender sender;
+  Match::Result<Config::Wallets::SendCount> result;
+  Match::Status status = Match::process(messageStr, targetToken, wallets, Config::Wallets::Count, !preArming.load(), sender, telemetry, result);
+
+  if(status == Match::Status::Invalid) {
+    // Liquidity of the token is being removed, sell before it lands
+    if constexpr (Config::Exit::Enabled) {
+      if(exitPending.load() && BloXrouteMessageParser::isRemoveLiquidityETH(messageStr, targetToken)) {
+        char gasPriceStr[Config::Size::TransactionQuantityBuffer * 2 + 1];
+        std::size_t gasPriceStrLength = BloXrouteMessageParser::isDynamicFee(messageStr)
+          ? BloXrouteMessageParser::extractMaxFeePerGas(messageStr, gasPriceStr)
+          : BloXrouteMessageParser::extractGasPrice(messageStr, gasPriceStr);
+
+        uint64_t gasPrice = 0;
+        if(gasPriceStrLength <= 16) std::from_chars(gasPriceStr, gasPriceStr + gasPriceStrLength, gasPrice, 16);
+        exitTrigger.fire(Exit::Signal::Price, gasPrice + Config::Exit::PriceSignalGasPriceBump);
+      }
+    }
 
-  if(!BloXrouteMessageParser::validateTransaction(messageStr, Config::BloXroute::Filters::TokenAddress)) {
     printf("\nReceived message: %s\n", messageStr);
+
+    // Deployer activity or pair creation precedes the liquidity add
+    if constexpr (Config::PreArm::Enabled) {
+      char token[ABI::AddressLength + 1];
+      PreArm::Signal signal = preArmWatcher.detect(messageStr, targetToken, token);
+      if(signal != PreArm::Signal::None) preArm(token, signal);
+    }
+
+    if constexpr (!Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin) {
+      observeGasPrice(messageStr);
+    }
+    if constexpr (Config::Warm::Enabled) warmer.observe(messageStr);
     return;
   }
 
-  // Get gas price from transaction
+  if(status == Match::Status::Filtered) printf("\nReceived message: %s\nRejected by filter rules\n", messageStr);
+  if(status != Match::Status::Matched) return;
 
-  char gasPriceStr[Config::Size::TransactionQuantityBuffer * 2 + 1];
-  std::size_t gasPriceStrLength = BloXrouteMessageParser::extractGasPrice(messageStr, gasPriceStr);
+  const Warm::Fees &fees = result.fees;
 
-  if(gasPriceStrLength <= 16) {
-    uint64_t gasPrice = 0;
-    std::from_chars(gasPriceStr, gasPriceStr + gasPriceStrLength, gasPrice, 16);
+  printf("\nReceived message: %s\n", messageStr);
+  if constexpr (Config::Bundle::Enabled) {
+    if(sender.rawTarget == nullptr) printf("Message has no signed target transaction, not bundled\n");
+    else printf("Sent %zu bundles behind the target transaction to %s\n", sender.bundlesCount, Config::Bundle::RelayUrl);
+  }
+  for(std::size_t i = 0; i < result.count; i++) {
+    const Match::Sent &sent = result.sent[i];
 
-    if(gasPrice % (1000000000 / Config::TransactionPreGen::GasPriceGweiDecimals) == 0) {
-      gasPrice /= (1000000000 / Config::TransactionPreGen::GasPriceGweiDecimals);
+    if(sent.outcome == Match::Outcome::Queued) {
+      printf("Queued transaction of wallet #%zu for signing (gas price %" PRIu64 " wei)\n", sent.wallet, fees.gasPrice);
+      continue;
+    }
 
-      if(
-        gasPrice >= Config::TransactionPreGen::GasPriceGweiFrom * Config::TransactionPreGen::GasPriceGweiDecimals
-        && gasPrice <= Config::TransactionPreGen::GasPriceGweiTo * Config::TransactionPreGen::GasPriceGweiDecimals
-      ) {
-        wsClient.send(connectionHdl, pregenTxs[gasPrice - Config::TransactionPreGen::GasPriceGweiFrom * Config::TransactionPreGen::GasPriceGweiDecimals], websocketpp::frame::opcode::text);
-        printf("\nReceived message: %s\n", messageStr);
-        printf("Sent pregenerated transaction: %s\n", pregenTxs[gasPrice - Config::TransactionPreGen::GasPriceGweiFrom * Config::TransactionPreGen::GasPriceGweiDecimals]);
-        printf("\nClosing connection...\n");
-        wsClient.close(connectionHdl, websocketpp::close::status::normal, "Connection closed by client");
-        return;
-      }
+    if(sent.outcome == Match::Outcome::Failed) {
+      printf("Signer process did not sign transaction of wallet #%zu in time (gas price %" PRIu64 " wei)\n", sent.wallet, fees.gasPrice);
+      continue;
     }
 
-    tx.setField(Transaction::Field::GasPrice, gasPriceStr);
+    if(fees.dynamicFee) {
+      printf(
+        "Sent %s EIP-1559 transaction of wallet #%zu (max fee %" PRIu64 " wei, priority fee %" PRIu64 " wei, observed %" PRIu64 " wei and %" PRIu64 " wei): %s\n",
+        sent.outcome == Match::Outcome::Pregenerated ? "pregenerated" : "signed", sent.wallet, sent.gasPrice, sent.maxPriorityFeePerGas, fees.gasPrice, fees.maxPriorityFeePerGas, sent.message
+      );
+      continue;
+    }
 
-    Utils::Byte transactionBuffer[Config::Size::TransactionRawBuffer]; 
-    std::size_t transactionBufferSize = tx.sign(privateKey, transactionBuffer);
+    printf(
+      "Sent %s transaction of wallet #%zu (gas price %" PRIu64 " wei, observed %" PRIu64 " wei): %s\n",
+      sent.outcome == Match::Outcome::Pregenerated ? "pregenerated" : "signed", sent.wallet, sent.gasPrice, fees.gasPrice, sent.message
+    );
+  }
 
-    char transactionString[Config::Size::TransactionRawBuffer * 2];
-    Utils::bufferToHexString(transactionBuffer, transactionBufferSize, transactionString, true);
+  // Messages were printed, pregenerated stores can be rebuilt from now on
+  Match::release(wallets, result, sharedPreGen.isOpen());
+  for(std::size_t i = 0; i < result.count; i++) {
+    if constexpr (Config::Cancel::Enabled) cancelTables[result.sent[i].wallet].bought(result.sent[i].gasPrice);
+    if constexpr (Config::Exit::Enabled) openPosition(result.sent[i].wallet, fees.gasPrice, messageStr);
+    wallets[result.sent[i].wallet].advanceNonce();
+  }
 
-    char message[Config::Size::BloXrouteTransactionMessageString];
-    BloXrouteMessageBuilder::buildTransaction(transactionString, message);
+  if(result.count != 0) {
+    if constexpr (Config::Exit::Enabled) exitPending.store(true);
 
-    wsClient.send(connectionHdl, message, websocketpp::frame::opcode::text);
-    printf("\nReceived message: %s\n", messageStr);
-    printf("Sent transaction: %s\n", message);
-    printf("\nClosing connection...\n");
-    wsClient.close(connectionHdl, websocketpp::close::status::normal, "Connection closed by client.");
+    // Watch transactions of the target sender for replacement of the liquidity add
+    if constexpr (Config::Cancel::Enabled) {
+      if(cancelWatcher.watch(messageStr, Pipeline::now() + Config::Cancel::WatchSeconds * 1000000000ULL)) {
+        // Node streams all pending transactions, they are filtered locally
+        if constexpr (Config::Feed::Selected == Config::Feed::Source::BloXroute) {
+          char subscribeMessage[512];
+          std::size_t subscribeMessageLength = BloXrouteMessageBuilder::buildSubscribeFrom(cancelWatcher.getFrom(), subscribeMessage);
+          feed.send(subscribeMessage, subscribeMessageLength);
+        }
+        printf("Watching transactions of 0x%s for replacement of target transaction\n", cancelWatcher.getFrom());
+      }
+    }
+
+    closeWhenDone();
   }
 }
 
 void onClose(websocketpp::connection_hdl connectionHdl) {
   wsTimer->cancel();
+
+  if constexpr (Config::Pipeline::Enabled) {
+    signerPool.print();
+  }
   
   websocketpp::client<CustomWSConfig>::connection_ptr connection = wsClient.get_con_from_hdl(connectionHdl);
   printf(
@@ -244,15 +834,466 @@ void onClose(websocketpp::connection_hdl connectionHdl) {
     websocketpp::close::status::get_string(connection->get_remote_close_code()).c_str(),
     connection->get_remote_close_reason().c_str()
   );
+
+  // Degraded connection was closed to move to another endpoint
+  if(reconnecting && !closing.load()) {
+    reconnecting = false;
+    connectWebSocket(nextEndpoint());
+  }
+}
+
+void onPong(websocketpp::connection_hdl, std::string payload) {
+  measurePong(payload.data(), payload.size());
+}
+
+void openPosition(std::size_t walletIndex, uint64_t gasPrice, const char *message) {
+  UInt256 liquidityETH, liquidityToken;
+  bool parsed = Match::extractLiquidity(message, liquidityETH, liquidityToken);
+
+  // Buys ahead of ours leave us fewer tokens than expected, tiers of the expected output would revert
+  UInt256 minimumOutput = parsed && UniswapV2::hasReserves(liquidityETH, liquidityToken)
+    ? UniswapV2::getAmountOutMin(wallets[walletIndex].value, liquidityETH, liquidityToken, Config::Transaction::SwapExactETHForTokens::SlippageBasisPoints)
+    : UInt256::fromHexString(Config::Transaction::SwapExactETHForTokens::AmountOutMin);
+
+  exitPositions[walletIndex].open(
+    wallets[walletIndex].getNonce(),
+    gasPrice,
+    minimumOutput,
+    Config::Exit::Tiers,
+    targetToken,
+    Config::Router::Selected.Address,
+    Config::Transaction::SwapExactETHForTokens::ReceiverAddress
+  );
+}
+
+std::size_t signRequest(Transaction &transaction, Pipeline::SignRequest &request, char *output) {
+  Wallet<PreGenStore> &wallet = wallets[request.wallet];
+  wallet.setFields(transaction, request.nonce);
+
+  if(request.patchAmountOutMin) {
+    transaction.patchField(Transaction::Field::Data, TransactionDataBuilder::AmountOutMinOffset, request.amountOutMin, 32);
+  }
+
+  if(request.dynamicFee) return PreGen::generate(transaction, wallet.privateKey, request.gasPrice, request.maxPriorityFeePerGas, output);
+  return PreGen::generate(transaction, wallet.privateKey, request.gasPrice, output);
+}
+
+void runSender() {
+  if constexpr (Config::Pipeline::SenderCore >= 0) Pipeline::pinThread(Config::Pipeline::SenderCore);
+  else Numa::pinThread(topology.cpus);
+
+  while(senderRunning.load(std::memory_order_relaxed)) {
+    std::size_t sentCount = signerPool.drain([](const auto &signedMessage) {
+      feed.send(signedMessage.message, signedMessage.length);
+      printf("Sent signed transaction of wallet #%zu (gas price %" PRIu64 " wei): %s\n", signedMessage.wallet, signedMessage.gasPrice, signedMessage.message);
+      pendingSigns.fetch_sub(1);
+    });
+
+    if(sentCount == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    signerPool.print();
+    closeWhenDone();
+  }
+}
+
+void runExit() {
+  // Wait for the buy
+
+  while(!exitPending.load()) {
+    if(!exitRunning.load()) return;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  std::vector<uint64_t> gasPrices;
+  gasPrices.reserve(Config::Exit::ArraySize);
+  for(
+    uint64_t gasPrice = Config::Exit::GasPriceGweiFrom * Config::Exit::GasPriceGweiDecimals;
+    gasPrice <= Config::Exit::GasPriceGweiTo * Config::Exit::GasPriceGweiDecimals;
+    gasPrice++
+  ) {
+    gasPrices.push_back(gasPrice * (1000000000 / Config::Exit::GasPriceGweiDecimals));
+  }
+
+  for(std::size_t i = 0; i < Config::Wallets::Count; i++) {
+    if(exitPositions[i].isOpen()) exitPositions[i].generate(gasPrices, wallets[i].privateKey, Config::TransactionPreGen::Threads);
+  }
+
+  printf(
+    "\nPregenerated exit transactions with gas price from %" PRIu64 " to %" PRIu64 " gwei (approve and %zu sell tiers)\n",
+    Config::Exit::GasPriceGweiFrom, Config::Exit::GasPriceGweiTo, Config::Exit::TiersCount
+  );
+
+  if(Config::Exit::TimerSeconds != 0) {
+    exitTrigger.armTimer(Pipeline::now() + Config::Exit::TimerSeconds * 1000000000ULL);
+  }
+
+  // Wait for the trigger, the buy can be cancelled meanwhile
+
+  Exit::Signal signal;
+  while((signal = exitTrigger.poll(Pipeline::now())) == Exit::Signal::None) {
+    if(!exitRunning.load()) return;
+    if(cancelled.load()) {
+      printf("\nBuy was cancelled, exit is not sent\n");
+      exitPending.store(false);
+      closeWhenDone();
+      return;
+    }
+    std::this_thread::yield();
+  }
+
+  std::size_t tier = signal == Exit::Signal::Timer ? Config::Exit::TimerTier
+    : signal == Exit::Signal::Price ? Config::Exit::PriceSignalTier
+    : Config::Exit::ManualTier;
+
+  // Send approve and sell back-to-back, misses are signed on demand
+
+  Transaction tx;
+  char approveBuffer[Config::Size::BloXrouteTransactionMessageString];
+  char sellBuffer[Config::Size::BloXrouteTransactionMessageString];
+
+  for(std::size_t i = 0; i < Config::Wallets::Count; i++) {
+    const ExitPosition &position = exitPositions[i];
+    if(!position.isOpen()) continue;
+
+    uint64_t gasPrice = exitTrigger.gasPrice() != 0 ? exitTrigger.gasPrice() : position.getGasPrice();
+    std::size_t approveLength, sellLength;
+    const char *approveMessage = position.approve(gasPrice, Config::TransactionPreGen::MaxGasPriceBump, tx, wallets[i].privateKey, approveBuffer, approveLength);
+    const char *sellMessage = position.sell(tier, gasPrice, Config::TransactionPreGen::MaxGasPriceBump, tx, wallets[i].privateKey, sellBuffer, sellLength);
+
+    feed.send(approveMessage, approveLength);
+    feed.send(sellMessage, sellLength);
+
+    printf("\nSent exit of wallet #%zu on %s (tier #%zu, gas price %" PRIu64 " wei)\n", i, Exit::signalName(signal), tier, gasPrice);
+    printf("Approve: %s\nSell: %s\n", approveMessage, sellMessage);
+  }
+
+  exitPending.store(false);
+  closeWhenDone();
+}
+
+void sendCancels() {
+  cancelWatcher.stop();
+  cancelled.store(true);
+
+  // Send cancels back-to-back, misses are signed on demand
+
+  Transaction tx;
+  char buffers[Config::Wallets::Count][Config::Size::BloXrouteTransactionMessageString];
+  const char *messages[Config::Wallets::Count];
+  uint64_t gasPrices[Config::Wallets::Count];
+
+  for(std::size_t i = 0; i < Config::Wallets::Count; i++) {
+    messages[i] = nullptr;
+    if(cancelTables[i].getBuyGasPrice() == 0) continue;
+
+    std::size_t length;
+    messages[i] = cancelTables[i].message(Config::Cancel::MaxGasPriceBump, tx, wallets[i].privateKey, buffers[i], length, gasPrices[i]);
+    feed.send(messages[i], length);
+  }
+
+  for(std::size_t i = 0; i < Config::Wallets::Count; i++) {
+    if(messages[i] == nullptr) continue;
+    printf("Sent cancel of wallet #%zu (gas price %" PRIu64 " wei, buy %" PRIu64 " wei): %s\n", i, gasPrices[i], cancelTables[i].getBuyGasPrice(), messages[i]);
+  }
+
+  closeWhenDone();
+}
+
+void closeWhenDone() {
+  // Keep listening while there are transactions being signed, wallets left to send from, exit to send or target transaction watched
+  if(pendingSigns.load() != 0) return;
+  if(exitPending.load()) return;
+  if(cancelWatcher.isWatching(Pipeline::now())) return;
+  for(const Wallet<PreGenStore> &wallet : wallets) {
+    if(wallet.isArmed()) return;
+  }
+
+  if(closing.exchange(true)) return;
+
+  printf("\nClosing connection...\n");
+  feed.close();
+}
+
+void observeGasPrice(const char *message) {
+  // Histogram and learned gas prices are kept for legacy transactions only, and for locally pregenerated ones
+  if(sharedPreGen.isOpen() || Config::Signer::Enabled) return;
+
+  // Fees are read at fixed positions of liquidity add input, other methods (deployments and pair creations of pre-arm stream among them) are skipped
+  Warm::Fees fees;
+  if(!Warm::extractFees(message, fees) || fees.dynamicFee) return;
+
+  uint64_t gasPrice = fees.gasPrice;
+
+  PreGenStore *store = wallets[0].pregenTxs.acquire();
+  const auto *pregenTx = store->lookup(gasPrice, Config::TransactionPreGen::Policy, Config::TransactionPreGen::MaxGasPriceBump);
+
+  gasPriceHistogram.record(gasPrice);
+  pregenStats.record(gasPrice, pregenTx != nullptr ? pregenTx->gasPrice : 0, pregenTx != nullptr);
+  bool pregenerated = pregenTx != nullptr && pregenTx->gasPrice == gasPrice;
+
+  wallets[0].pregenTxs.release();
+
+  // Gas price learned from the stream is pregenerated in the background, signing would hold up reading the next message
+  if(Config::TransactionPreGen::LearnFromFeed && !pregenerated) learnedGasPrices.push(gasPrice);
+}
+
+void learnGasPrices() {
+  std::vector<uint64_t> gasPrices;
+
+  while(true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(Config::TransactionPreGen::LearnIntervalMilliseconds));
+
+    gasPrices.clear();
+    for(uint64_t gasPrice; learnedGasPrices.pop(gasPrice);) gasPrices.push_back(gasPrice);
+    if(gasPrices.empty()) continue;
+
+    std::lock_guard<std::mutex> lock(pregenMutex);
+
+    // Transaction fields are being replaced while pre-arming, stores are pregenerated anew then
+    if(preArming.load()) continue;
+
+    std::size_t learned = 0;
+    for(Wallet<PreGenStore> &wallet : wallets) {
+      Transaction transaction;
+      wallet.setFields(transaction);
+
+      // Learned transactions are added to a copy of the active store, the event loop keeps reading the active one
+      PreGenStore &store = wallet.pregenTxs.back();
+      store = wallet.pregenTxs.front();
+      for(uint64_t gasPrice : gasPrices) {
+        if(!store.full() && !store.contains(gasPrice) && PreGen::generate(store, transaction, wallet.privateKey, gasPrice)) learned++;
+      }
+      wallet.pregenTxs.publish();
+    }
+
+    if(learned != 0) printf("\nPregenerated %zu transactions for learned gas prices (%zu in total)\n", learned, wallets[0].pregenTxs.front().size());
+  }
+}
+
+std::vector<uint64_t> configGasPrices() {
+  std::vector<uint64_t> gasPrices;
+  gasPrices.reserve(Config::TransactionPreGen::ArraySize);
+  for(
+    std::size_t gasPrice = Config::TransactionPreGen::GasPriceGweiFrom * Config::TransactionPreGen::GasPriceGweiDecimals; 
+    gasPrice <= Config::TransactionPreGen::GasPriceGweiTo * Config::TransactionPreGen::GasPriceGweiDecimals; 
+    gasPrice++
+  ) {
+    gasPrices.push_back(gasPrice * (1000000000 / Config::TransactionPreGen::GasPriceGweiDecimals));
+  }
+  return gasPrices;
+}
+
+void pregenerate(Wallet<PreGenStore> &wallet, const std::vector<uint64_t> &gasPrices) {
+  PreGen::generateParallel(
+    wallet.pregenTxs.back(),
+    gasPrices,
+    wallet.privateKey,
+    [&wallet](Transaction &transaction) { wallet.setFields(transaction); },
+    Config::TransactionPreGen::Threads
+  );
+  wallet.pregenTxs.publish();
+}
+
+void pregenerateDynamicFees(Wallet<PreGenStore> &wallet) {
+  namespace DynamicFee = Config::TransactionPreGen::DynamicFee;
+
+  PreGen::FeeAxis maxFeeAxis { DynamicFee::MaxFeeGweiFrom * 1000000000, 1000000000 / DynamicFee::MaxFeeGweiDecimals, DynamicFee::MaxFeeCount };
+  PreGen::FeeAxis priorityFeeAxis { DynamicFee::PriorityFeeGweiFrom * 1000000000, 1000000000 / DynamicFee::PriorityFeeGweiDecimals, DynamicFee::PriorityFeeCount };
+
+  PreGen::generateParallel(
+    wallet.dynamicFeeTxs,
+    maxFeeAxis,
+    priorityFeeAxis,
+    wallet.privateKey,
+    [&wallet](Transaction &transaction) { wallet.setFields(transaction); },
+    Config::TransactionPreGen::Threads
+  );
+}
+
+void rePregenerate() {
+  while(true) {
+    std::this_thread::sleep_for(std::chrono::seconds(Config::TransactionPreGen::Adaptive::IntervalSeconds));
+    if(gasPriceHistogram.samples() < Config::TransactionPreGen::Adaptive::MinSamples) continue;
+
+    std::vector<uint64_t> gasPrices = allocateGasPrices(
+      gasPriceHistogram,
+      Config::TransactionPreGen::Adaptive::Budget,
+      Config::TransactionPreGen::GasPriceGweiFrom * 1000000000,
+      Config::TransactionPreGen::GasPriceGweiTo * 1000000000
+    );
+
+    {
+      std::lock_guard<std::mutex> lock(pregenMutex);
+      for(Wallet<PreGenStore> &wallet : wallets) pregenerate(wallet, gasPrices);
+    }
+
+    printf("\nRe-pregenerated transactions for %zu observed gas prices\n", gasPrices.size());
+    pregenStats.print();
+
+    if(Config::TransactionPreGen::Adaptive::HistogramPath[0] != '\0') {
+      gasPriceHistogram.save(Config::TransactionPreGen::Adaptive::HistogramPath);
+    }
+  }
+}
+
+void preArm(const char *token, PreArm::Signal signal) {
+  // Target is already armed, its next warming round is brought forward
+  if(memcmp(token, targetToken, ABI::AddressLength) == 0) {
+    if constexpr (Config::Warm::Enabled) warmer.setTarget(targetToken);
+    printf("Received %s of the target token, it is armed already\n", PreArm::signalName(signal));
+    return;
+  }
+
+  // Signer process builds transactions of the configured token only
+  if constexpr (Config::Signer::Enabled) {
+    printf("Received %s of token 0x%s, not pre-armed (signer process signs for the configured token)\n", PreArm::signalName(signal), token);
+    return;
+  }
+
+  // Retargeted before the first buy only, one target at a time
+  if(preArming.load()) {
+    printf("Received %s of token 0x%s, not pre-armed (another token is being pre-armed)\n", PreArm::signalName(signal), token);
+    return;
+  }
+  for(const Wallet<PreGenStore> &wallet : wallets) {
+    if(!wallet.isArmed()) {
+      printf("Received %s of token 0x%s, not pre-armed (wallets are sending)\n", PreArm::signalName(signal), token);
+      return;
+    }
+  }
+
+  // Wallets stay armed, the new target is signed on demand until its transactions are pregenerated
+  preArming.store(true);
+
+  memcpy(targetToken, token, ABI::AddressLength);
+  TransactionDataBuilder::buildData(
+    Config::Transaction::SwapExactETHForTokens::AmountOutMin,
+    targetToken,
+    Config::Transaction::SwapExactETHForTokens::ReceiverAddress,
+    preArmData
+  );
+  for(Wallet<PreGenStore> &wallet : wallets) wallet.setData(preArmData);
+  if constexpr (Config::Warm::Enabled) warmer.setTarget(targetToken);
+  if constexpr (Config::Rules::Enabled) filterRules.compile(Config::Rules::List, std::size(Config::Rules::List), targetToken);
+
+  printf("Received %s of token 0x%s, pre-arming it\n", PreArm::signalName(signal), token);
+  std::thread(armTarget, std::string(token)).detach();
+}
+
+void armTarget(std::string token) {
+  uint64_t start = Pipeline::now();
+
+  {
+    std::lock_guard<std::mutex> lock(pregenMutex);
+
+    // Transactions of the previous target are replaced, for gas prices observed so far if there are enough of them
+    if(!Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin && !sharedPreGen.isOpen()) {
+      std::vector<uint64_t> gasPrices = Config::TransactionPreGen::Adaptive::Enabled && gasPriceHistogram.samples() >= Config::TransactionPreGen::Adaptive::MinSamples
+        ? allocateGasPrices(
+            gasPriceHistogram,
+            Config::TransactionPreGen::Adaptive::Budget,
+            Config::TransactionPreGen::GasPriceGweiFrom * 1000000000,
+            Config::TransactionPreGen::GasPriceGweiTo * 1000000000
+          )
+        : configGasPrices();
+
+      for(Wallet<PreGenStore> &wallet : wallets) pregenerate(wallet, gasPrices);
+      if constexpr (Config::TransactionPreGen::DynamicFee::Enabled) {
+        for(Wallet<PreGenStore> &wallet : wallets) pregenerateDynamicFees(wallet);
+      }
+    }
+  }
+
+  preArming.store(false);
+
+  printf("\nPre-armed token 0x%s in %.3f ms\n", token.c_str(), (Pipeline::now() - start) / 1e6);
 }
 
 void sendPing(websocketpp::lib::error_code const &errorCode) {
   if(errorCode) return;
 
-  wsClient.ping(wsConnectionHdl, "");
+  WebSocketFeed webSocketFeed;
+  beat(webSocketFeed);
+  warm();
+  pollRelay();
   setTimer();
+
+  // Watching of target transaction may have timed out
+  if constexpr (Config::Cancel::Enabled) closeWhenDone();
 }
 
 void setTimer() {
-  wsTimer = wsClient.set_timer(30000, sendPing);
+  wsTimer = wsClient.set_timer(PingMilliseconds, sendPing);
+}
+
+template<typename WebSocketFeedType>
+void beat(WebSocketFeedType &webSocketFeed) {
+  if constexpr (!Config::Feed::WebSocket::Heartbeat::Enabled) {
+    webSocketFeed.ping(nullptr, 0);
+    return;
+  }
+
+  // Degraded connection is left for the endpoint with the shortest round trip, unless it is being closed anyway
+  if(Config::Feed::WebSocket::Heartbeat::Reconnect && !reconnecting && heartbeat.isDegraded() && !closing.load()) {
+    printf("\nConnection degraded (median round trip %.3f ms, %u pings lost), reconnecting...\n", heartbeat.median() / 1e6, heartbeat.getLost());
+    reconnecting = true;
+    webSocketFeed.close();
+    return;
+  }
+
+  unsigned lost = heartbeat.getLost();
+  char payload[Heartbeat::PayloadLength];
+  webSocketFeed.ping(payload, heartbeat.ping(Pipeline::now(), payload));
+  if(heartbeat.getLost() > lost) telemetry.count(Telemetry::PongLost, heartbeat.getLost() - lost);
+
+  // Frame of its own keeps the send path and the connection warm
+  if constexpr (Config::Feed::WebSocket::Heartbeat::KeepWarm) webSocketFeed.pong(keepWarmPayload, sizeof(keepWarmPayload));
+}
+
+void measurePong(const char *payload, std::size_t length) {
+  uint64_t roundTrip;
+  if(heartbeat.pong(payload, length, Pipeline::now(), roundTrip)) telemetry.recordRoundTrip(roundTrip);
+}
+
+void resetHeartbeat() {
+  heartbeat.reset(
+    Config::Feed::WebSocket::Heartbeat::PongTimeoutMilliseconds * 1000000ULL,
+    Config::Feed::WebSocket::Heartbeat::MaxRoundTripMicroseconds * 1000ULL,
+    Config::Feed::WebSocket::Heartbeat::MaxLostPongs
+  );
+}
+
+const char *nextEndpoint() {
+  // Endpoint left for lost pings is the least preferred
+  uint64_t roundTrip = heartbeat.getLost() != 0 ? UINT64_MAX : heartbeat.median();
+  telemetry.count(Telemetry::Reconnects);
+  return Config::BloXroute::Connection::Addresses[endpoints.next(roundTrip)];
+}
+
+bool sendBundle(const char *target, std::size_t targetLength, const char *message, std::size_t messageLength) {
+  constexpr std::size_t PrefixLength = BloXrouteMessageBuilder::TransactionOffset;
+  constexpr std::size_t SuffixLength = sizeof(BloXrouteMessageBuilder::TransactionSuffix) - 1;
+
+  // Signed transaction is spliced straight from the transaction message
+  std::size_t requestLength = 0;
+  const char *request = bundleComposer.compose(target, targetLength, message + PrefixLength, messageLength - PrefixLength - SuffixLength, requestLength);
+  return request != nullptr && relay.send(request, requestLength);
+}
+
+void pollRelay() {
+  if constexpr (!Config::Bundle::Enabled) return;
+
+  if(relay.poll() != 0) printf("Relay responded with status %d: %s\n", relay.getLastStatus(), relay.getLastBody());
+}
+
+void warm() {
+  if constexpr (!Config::Warm::Enabled) return;
+  if(!warmer.isDue(Pipeline::now())) return;
+
+  // Locally pregenerated transactions are looked up only (not while being replaced by pre-arming), the signing context is the one of on demand signing
+  bool lookups = !Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin && !sharedPreGen.isOpen() && !Config::Signer::Enabled && !preArming.load();
+  warmer.run(wallets, Config::Wallets::Count, Config::Wallets::SendCount, lookups, Config::Warm::DryRunSign && !Config::Signer::Enabled, Pipeline::now);
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+
+#include <config.hpp>
+#include <utils.hpp>
+#include <transaction.hpp>
+#include <bot.hpp>
+#include <pregen.hpp>
+#include <wallet.hpp>
+#include <shared.hpp>
+#include <numa.hpp>
+
+// Pregen daemon: signs pregenerated transactions once and publishes them in shared memory for all bot processes
+// built with the same configuration. Reads update commands from stdin:
+//   nonce <wallet> <nonce>  - republish wallet transactions for given (decimal) nonce
+//   token <address>         - republish transactions of all wallets for new target token
+//   quit                    - remove the segment and exit
+
+using PreGenStore = std::conditional_t<
+  Config::TransactionPreGen::Compact,
+  PreGen::CompactStore<Config::TransactionPreGen::Capacity>,
+  PreGen::Store<Config::TransactionPreGen::Capacity, Config::Size::BloXrouteTransactionMessageString>
+>;
+using SharedMapping = Shared::Mapping<PreGenStore, TransactionDataBuilder::DataLength, Config::Wallets::Count>;
+
+Wallet<PreGenStore> wallets[Config::Wallets::Count];
+uint64_t nonces[Config::Wallets::Count];
+SharedMapping mapping;
+std::unique_ptr<PreGenStore> staging;
+std::vector<uint64_t> gasPrices;
+char token[41];
+char data[TransactionDataBuilder::DataLength + 1];
+
+void initWallets();
+void publish(std::size_t walletIndex);
+
+int main() {
+  static_assert(!Config::Transaction::SwapExactETHForTokens::DynamicAmountOutMin, "Transactions with amountOutMin derived per liquidity add cannot be pregenerated");
+
+  strncpy(token, Config::Transaction::SwapExactETHForTokens::TokenAddress, 40);
+  token[40] = '\0';
+  initWallets();
+  for(std::size_t i = 0; i < Config::Wallets::Count; i++) nonces[i] = wallets[i].getNonce();
+
+  // Segment is read by the bot process on the NUMA node of the NIC, its pages are touched here first
+  if constexpr (Config::Numa::Enabled) {
+    Numa::Topology topology = Numa::discover(Config::Numa::Interface);
+    topology.print();
+
+    if(topology.isKnown()) {
+      Numa::preferNode(topology.node);
+      for(Wallet<PreGenStore> &wallet : wallets) wallet.moveToNode(topology.node);
+    }
+  }
+
+  if(!mapping.create(Config::SharedPreGen::Name)) {
+    printf("Could not create shared memory segment %s\n", Config::SharedPreGen::Name);
+    return 1;
+  }
+
+  printf("Created shared memory segment %s (%zu MB)\n", Config::SharedPreGen::Name, sizeof(SharedMapping::SegmentType) / (1024 * 1024));
+
+  gasPrices.reserve(Config::TransactionPreGen::ArraySize);
+  for(
+    std::size_t gasPrice = Config::TransactionPreGen::GasPriceGweiFrom * Config::TransactionPreGen::GasPriceGweiDecimals;
+    gasPrice <= Config::TransactionPreGen::GasPriceGweiTo * Config::TransactionPreGen::GasPriceGweiDecimals;
+    gasPrice++
+  ) {
+    gasPrices.push_back(gasPrice * (1000000000 / Config::TransactionPreGen::GasPriceGweiDecimals));
+  }
+
+  staging = std::make_unique<PreGenStore>();
+  for(std::size_t i = 0; i < Config::Wallets::Count; i++) publish(i);
+
+  // Handle update commands
+
+  char line[128];
+  while(fgets(line, sizeof(line), stdin) != nullptr) {
+    char address[64];
+    std::size_t walletIndex;
+    uint64_t nonce;
+
+    if(sscanf(line, "nonce %zu %" SCNu64, &walletIndex, &nonce) == 2 && walletIndex < Config::Wallets::Count) {
+      nonces[walletIndex] = nonce;
+      publish(walletIndex);
+    } else if(sscanf(line, "token %63s", address) == 1) {
+      const char *addressStart = strncmp(address, "0x", 2) == 0 ? address + 2 : address;
+      if(strlen(addressStart) != 40) {
+        printf("Invalid token address: %s\n", address);
+        continue;
+      }
+
+      memcpy(token, addressStart, 41);
+      initWallets();
+      for(std::size_t i = 0; i < Config::Wallets::Count; i++) publish(i);
+    } else if(strncmp(line, "quit", 4) == 0) {
+      break;
+    } else {
+      printf("Unknown command: %s", line);
+    }
+  }
+
+  SharedMapping::unlink(Config::SharedPreGen::Name);
+}
+
+void initWallets() {
+  TransactionDataBuilder::buildData(
+    Config::Transaction::SwapExactETHForTokens::AmountOutMin,
+    token,
+    Config::Transaction::SwapExactETHForTokens::ReceiverAddress,
+    data
+  );
+
+  for(std::size_t i = 0; i < Config::Wallets::Count; i++) {
+    wallets[i].init(Config::Wallets::List[i], data);
+  }
+}
+
+void publish(std::size_t walletIndex) {
+  Wallet<PreGenStore> &wallet = wallets[walletIndex];
+  uint64_t nonce = nonces[walletIndex];
+
+  PreGen::generateParallel(
+    *staging,
+    gasPrices,
+    wallet.privateKey,
+    [&wallet, nonce](Transaction &transaction) { wallet.setFields(transaction, nonce); },
+    Config::TransactionPreGen::Threads
+  );
+  mapping.publish(walletIndex, nonce, wallet.getData(), *staging);
+
+  printf(
+    "Published %zu transactions of wallet #%zu (nonce %" PRIu64 ", token 0x%s, generation %" PRIu64 ")\n",
+    staging->size(), walletIndex, nonce, token, mapping.generation()
+  );
+}
\ No newline at end of file
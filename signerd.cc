@@ -0,0 +1,111 @@
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#include <unistd.h>
+
+#include <config.hpp>
+#include <utils.hpp>
+#include <transaction.hpp>
+#include <bot.hpp>
+#include <pregen.hpp>
+#include <wallet.hpp>
+#include <pipeline.hpp>
+#include <numa.hpp>
+#include <signer.hpp>
+
+// Signer process: holds private keys and signs transactions requested by the bot process over shared memory.
+// Runs until SIGINT or SIGTERM.
+
+using SignerWallet = Wallet<PreGen::Store<1, Config::Size::BloXrouteTransactionMessageString>>;
+
+SignerWallet wallets[Config::Wallets::Count];
+Signer::Channel<Config::Signer::QueueCapacity, Config::Size::BloXrouteTransactionMessageString> channel;
+std::atomic<bool> running { true };
+Numa::Topology topology;
+
+bool loadWallets(const char *data);
+std::size_t signRequest(Transaction &transaction, Pipeline::SignRequest &request, char *output);
+
+int main() {
+  if(!loadWallets(TransactionDataBuilder::ConfigData.hex)) return 1;
+
+  // Sign on the NUMA node of the NIC, the bot process sends from
+  if constexpr (Config::Numa::Enabled) {
+    topology = Numa::discover(Config::Numa::Interface);
+    topology.print();
+
+    if(topology.isKnown()) {
+      Numa::preferNode(topology.node);
+      for(SignerWallet &wallet : wallets) wallet.moveToNode(topology.node);
+    }
+  }
+
+  if(!channel.create(Config::Signer::Name)) {
+    printf("Could not create shared memory channel %s\n", Config::Signer::Name);
+    return 1;
+  }
+
+  signal(SIGINT, [](int) { running.store(false); });
+  signal(SIGTERM, [](int) { running.store(false); });
+
+  if constexpr (Config::Signer::Core >= 0) Pipeline::pinThread(Config::Signer::Core);
+  else Numa::pinThread(topology.cpus);
+  printf("Serving %zu wallets over %s\n", Config::Wallets::Count, Config::Signer::Name);
+
+  std::size_t served = channel.serve(getpid(), running, signRequest);
+
+  Signer::Channel<Config::Signer::QueueCapacity, Config::Size::BloXrouteTransactionMessageString>::unlink(Config::Signer::Name);
+  printf("Signed %zu transactions\n", served);
+}
+
+bool loadWallets(const char *data) {
+  if(Config::Signer::KeyFile[0] == '\0') {
+    for(std::size_t i = 0; i < Config::Wallets::Count; i++) wallets[i].init(Config::Wallets::List[i], data);
+    return true;
+  }
+
+  FILE *file = fopen(Config::Signer::KeyFile, "r");
+  if(file == nullptr) {
+    printf("Could not open key file %s\n", Config::Signer::KeyFile);
+    return false;
+  }
+
+  char line[128];
+  std::size_t loaded = 0;
+  while(loaded < Config::Wallets::Count && fgets(line, sizeof(line), file) != nullptr) {
+    line[strcspn(line, "\r\n")] = '\0';
+    const char *privateKey = strncmp(line, "0x", 2) == 0 ? line + 2 : line;
+    if(strlen(privateKey) != 64) continue;
+
+    Config::Wallets::Wallet walletConfig = Config::Wallets::List[loaded];
+    walletConfig.PrivateKey = privateKey;
+    wallets[loaded++].init(walletConfig, data);
+  }
+
+  // Do not leave key material in the stack buffer
+  memset(line, 0, sizeof(line));
+  fclose(file);
+
+  if(loaded != Config::Wallets::Count) {
+    printf("Key file %s has %zu of %zu private keys\n", Config::Signer::KeyFile, loaded, Config::Wallets::Count);
+    return false;
+  }
+
+  return true;
+}
+
+std::size_t signRequest(Transaction &transaction, Pipeline::SignRequest &request, char *output) {
+  if(request.wallet >= Config::Wallets::Count) return 0;
+
+  SignerWallet &wallet = wallets[request.wallet];
+  wallet.setFields(transaction, request.nonce);
+
+  if(request.patchAmountOutMin) {
+    transaction.patchField(Transaction::Field::Data, TransactionDataBuilder::AmountOutMinOffset, request.amountOutMin, 32);
+  }
+
+  if(request.dynamicFee) return PreGen::generate(transaction, wallet.privateKey, request.gasPrice, request.maxPriorityFeePerGas, output);
+  return PreGen::generate(transaction, wallet.privateKey, request.gasPrice, output);
+}
\ No newline at end of file
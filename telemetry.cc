@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+
+#include <config.hpp>
+#include <telemetry.hpp>
+
+// Telemetry reader: maps the bot's metrics segment read-only and prints counters, gas price distributions and feed round trips.
+// Usage: telemetry [interval seconds], interval 0 prints once, defaults to 1.
+
+using Metrics = Telemetry::Metrics<Config::Telemetry::Buckets>;
+
+Metrics metrics;
+Metrics::SnapshotType current, previous;
+
+void print(const Metrics::SnapshotType &snapshot, const Metrics::SnapshotType &last, unsigned interval);
+
+int main(int argc, char **argv) {
+  unsigned interval = argc > 1 ? static_cast<unsigned>(atoi(argv[1])) : 1;
+
+  if(!metrics.open(Config::Telemetry::Name)) {
+    printf("Could not map telemetry segment %s, is the bot running with the same configuration?\n", Config::Telemetry::Name);
+    return 1;
+  }
+
+  metrics.snapshot(previous);
+  if(interval == 0) {
+    print(previous, Metrics::SnapshotType {}, 0);
+    return 0;
+  }
+
+  while(true) {
+    std::this_thread::sleep_for(std::chrono::seconds(interval));
+    metrics.snapshot(current);
+    print(current, previous, interval);
+    previous = current;
+  }
+}
+
+void print(const Metrics::SnapshotType &snapshot, const Metrics::SnapshotType &last, unsigned interval) {
+  printf("\nBot process %" PRIu64 "\n", snapshot.writer);
+
+  for(std::size_t i = 0; i < Telemetry::CountersCount; i++) {
+    if(interval == 0) {
+      printf("%-16s %12" PRIu64 "\n", Telemetry::CounterNames[i], snapshot.counters[i]);
+    } else {
+      printf("%-16s %12" PRIu64 " %10.1f/s\n", Telemetry::CounterNames[i], snapshot.counters[i], static_cast<double>(snapshot.counters[i] - last.counters[i]) / interval);
+    }
+  }
+
+  std::uint64_t lookups = snapshot.counters[Telemetry::PregenHit] + snapshot.counters[Telemetry::PregenMiss];
+  if(lookups != 0) printf("Pregen hit rate: %.2f%%\n", 100.0 * snapshot.counters[Telemetry::PregenHit] / lookups);
+
+  // Only non-empty buckets, the last one is open ended
+  for(std::size_t i = 0; i < Telemetry::DistributionsCount; i++) {
+    printf("%s (gwei):\n", Telemetry::DistributionNames[i]);
+
+    for(std::size_t j = 0; j < Config::Telemetry::Buckets; j++) {
+      if(snapshot.distributions[i][j] == 0) continue;
+
+      double from = static_cast<double>(j * snapshot.bucketWidth) / 1e9;
+      if(j == Config::Telemetry::Buckets - 1) {
+        printf("  %10.3f+         %12" PRIu64 "\n", from, snapshot.distributions[i][j]);
+      } else {
+        printf("  %10.3f-%-10.3f %9" PRIu64 "\n", from, static_cast<double>((j + 1) * snapshot.bucketWidth) / 1e9, snapshot.distributions[i][j]);
+      }
+    }
+  }
+
+  // Power of two buckets, the first one from 0, the last one open ended
+  std::uint64_t roundTrips = 0;
+  for(std::size_t i = 0; i < Telemetry::RoundTripBuckets; i++) roundTrips += snapshot.roundTrips[i];
+  if(roundTrips == 0) return;
+
+  printf("round trip (us):\n");
+  for(std::size_t i = 0; i < Telemetry::RoundTripBuckets; i++) {
+    if(snapshot.roundTrips[i] == 0) continue;
+
+    std::uint64_t from = i == 0 ? 0 : std::uint64_t(1) << i;
+    if(i == Telemetry::RoundTripBuckets - 1) {
+      printf("  %10" PRIu64 "+         %12" PRIu64 "\n", from, snapshot.roundTrips[i]);
+    } else {
+      printf("  %10" PRIu64 "-%-10" PRIu64 " %9" PRIu64 "\n", from, std::uint64_t(1) << (i + 1), snapshot.roundTrips[i]);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <gmock/gmock.h>
+
+#include <abi.hpp>
+
+static constexpr auto swap = ABI::swapExactETHForTokens(ABI::Selector::SwapExactETHForTokens, "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2");
+
+static_assert(swap.Length == 4 + 7 * 32);
+static_assert(swap.byteOffset(ABI::AmountOutMin) == 4);
+static_assert(!swap.has(ABI::AmountTokenDesired));
+
+TEST(ABI, build) {
+  constexpr auto calldata = ABI::build("aabbccdd", { ABI::argument(ABI::Token), ABI::maximum(ABI::Deadline), ABI::constant("1f") });
+
+  ASSERT_STREQ(calldata.hex, "aabbccdd0000000000000000000000000000000000000000000000000000000000000000ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff000000000000000000000000000000000000000000000000000000000000001f");
+  ASSERT_EQ(calldata.wordOffset(ABI::Token), 8UL);
+  ASSERT_EQ(calldata.addressOffset(ABI::Token), 32UL);
+  ASSERT_EQ(calldata.wordOffset(ABI::Deadline), 72UL);
+  ASSERT_EQ(calldata.wordOffset(ABI::To), ABI::NoOffset);
+}
+
+TEST(ABI, swapExactETHForTokens) {
+  ASSERT_STREQ(swap.hex, "7ff36ab5000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000800000000000000000000000000000000000000000000000000000000000000000ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff0000000000000000000000000000000000000000000000000000000000000002000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc20000000000000000000000000000000000000000000000000000000000000000");
+  ASSERT_EQ(swap.addressOffset(ABI::To), 8UL + 3 * 64 - 40);
+  ASSERT_EQ(swap.addressOffset(ABI::Token), 8UL + 7 * 64 - 40);
+
+  constexpr auto feeOnTransfer = ABI::swapExactETHForTokens(ABI::Selector::SwapExactETHForTokensSupportingFeeOnTransferTokens, "bb4cdb9cbd36b01bd1cbaebf2de08d9173bc095c");
+  ASSERT_EQ(memcmp(feeOnTransfer.hex, "b6f9de95", 8), 0);
+  ASSERT_EQ(memcmp(feeOnTransfer.hex + feeOnTransfer.addressOffset(ABI::Token) - 64, "bb4cdb9cbd36b01bd1cbaebf2de08d9173bc095c", 40), 0);
+  ASSERT_EQ(memcmp(feeOnTransfer.offsets, swap.offsets, sizeof(swap.offsets)), 0);
+}
+
+TEST(ABI, addLiquidity) {
+  constexpr auto addLiquidityETH = ABI::addLiquidityETH();
+  ASSERT_EQ(addLiquidityETH.HexLength, 8UL + 6 * 64);
+  ASSERT_EQ(addLiquidityETH.addressOffset(ABI::Token), 32UL);
+  ASSERT_EQ(addLiquidityETH.wordOffset(ABI::AmountTokenDesired), 72UL);
+
+  constexpr auto addLiquidity = ABI::addLiquidity();
+  ASSERT_EQ(addLiquidity.HexLength, 8UL + 8 * 64);
+  ASSERT_EQ(addLiquidity.addressOffset(ABI::TokenA), 32UL);
+  ASSERT_EQ(addLiquidity.addressOffset(ABI::TokenB), 96UL);
+  ASSERT_EQ(addLiquidity.wordOffset(ABI::AmountADesired), 136UL);
+  ASSERT_EQ(addLiquidity.wordOffset(ABI::AmountBDesired), 200UL);
+  ASSERT_EQ(memcmp(addLiquidity.hex, "e8e33700", 8), 0);
+}
+
+TEST(ABI, exit) {
+  constexpr auto sell = ABI::swapExactTokensForETH(ABI::Selector::SwapExactTokensForETH, "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2");
+  ASSERT_EQ(sell.HexLength, 8UL + 8 * 64);
+  ASSERT_EQ(sell.byteOffset(ABI::AmountIn), 4UL);
+  ASSERT_EQ(sell.byteOffset(ABI::AmountOutMin), 36UL);
+  ASSERT_EQ(sell.addressOffset(ABI::Token), 8UL + 7 * 64 - 40);
+  ASSERT_EQ(memcmp(sell.hex + 8 + 8 * 64 - 40, "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2", 40), 0);
+
+  constexpr auto approve = ABI::approve();
+  ASSERT_STREQ(approve.hex, "095ea7b30000000000000000000000000000000000000000000000000000000000000000ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+  ASSERT_EQ(approve.addressOffset(ABI::Spender), 32UL);
+}
\ No newline at end of file
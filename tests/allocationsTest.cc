@@ -0,0 +1,158 @@
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+#define ALLOCATIONS_HOOKS
+#include <allocations.hpp>
+
+#include <bot.hpp>
+#include <feed.hpp>
+#include <match.hpp>
+#include <pregen.hpp>
+#include <telemetry.hpp>
+#include <wallet.hpp>
+
+using TestWallet = Wallet<PreGen::Store<64, Config::Size::BloXrouteTransactionMessageString>>;
+
+static const char TestToken[] = "dac17f958d2ee523a2206206994597c13d831ec7";
+static const std::string Input = "0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb";
+
+static std::string message(const std::string &fees, const std::string &input = Input) {
+  return "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"" + input + "\"," + fees + ",\"value\":\"0x46114844c27ec9\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+}
+
+/**
+ * @brief Sink standing in for the feed, copies sent message like a socket write would.
+ * Nothing is read from shared memory or handed to signers.
+ */
+struct Sink {
+  char buffer[Config::Size::BloXrouteTransactionMessageString];
+  std::size_t sent = 0;
+
+  bool accepts(const char *, const Warm::Fees &) {
+    return true;
+  }
+
+  void send(const char *message, std::size_t length) {
+    memcpy(buffer, message, length);
+    ++sent;
+  }
+
+  bool isShared() {
+    return false;
+  }
+
+  std::size_t readShared(std::size_t, std::uint64_t, char *, std::uint64_t &) {
+    return 0;
+  }
+
+  bool offload(Pipeline::SignRequest &, char *, std::size_t &, Match::Outcome &) {
+    return false;
+  }
+};
+
+/**
+ * @brief Match-and-send path of processMessage (main.cc) from received frame to sent transaction.
+ */
+static void onMessage(char *messageStr, TestWallet &wallet, Telemetry::Metrics<8> &telemetry, Sink &sink) {
+  telemetry.count(Telemetry::Messages);
+
+  Match::Result<1> result;
+  if(Match::process(messageStr, TestToken, &wallet, 1, true, sink, telemetry, result) != Match::Status::Matched) return;
+
+  Match::release(&wallet, result, false);
+  if(result.count != 0) wallet.advanceNonce();
+}
+
+TEST(Allocations, hooks) {
+  Allocations::Counts counts;
+
+  {
+    Allocations::Scope scope;
+    std::string shortString = "short";
+    ASSERT_EQ(scope.get().allocations, 0UL);
+
+    std::string longString(100, 'x');
+    delete new int(1);
+    free(malloc(10));
+    ASSERT_EQ(scope.lap().allocations, 3UL);
+
+    std::vector<int> vector(4);
+    counts = scope.get();
+  }
+  ASSERT_EQ(counts.allocations, 1UL);
+  ASSERT_EQ(counts.bytes, 4 * sizeof(int));
+
+  // Nothing is counted outside of scope
+  std::string untracked(100, 'x');
+  ASSERT_EQ(Allocations::counts.allocations, 1UL);
+
+  // Thrown exceptions are allocated
+  Allocations::Scope scope;
+  try {
+    Utils::hexCharToByte('x');
+  } catch(...) {}
+  ASSERT_GT(scope.get().allocations, 0UL);
+}
+
+TEST(Allocations, hotPath) {
+  static TestWallet wallet;
+  static Telemetry::Metrics<8> telemetry;
+  static Sink sink;
+
+  wallet.init({ "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", "0", Config::Transaction::Value }, TransactionDataBuilder::ConfigData.hex);
+
+  auto setup = [](Transaction &tx) { wallet.setFields(tx); };
+
+  std::vector<std::uint64_t> gasPrices;
+  for(std::uint64_t i = 0; i < 32; i++) gasPrices.push_back((200 + i) * 1000000000);
+  PreGen::generateParallel(wallet.pregenTxs.back(), gasPrices, wallet.privateKey, setup, 2);
+  wallet.pregenTxs.publish();
+  PreGen::generateParallel(wallet.dynamicFeeTxs, { 100000000000, 10000000000, 8 }, { 1000000000, 1000000000, 4 }, wallet.privateKey, setup, 2);
+
+  // Recorded messages, normalized node notification and invalid ones included
+  std::vector<std::string> messages = {
+    message("\"gasPrice\":\"0x355176b200\""),                                         // pregenerated hit
+    message("\"gasPrice\":\"0x3b9aca00\""),                                           // miss, signed on demand
+    message("\"maxFeePerGas\":\"0x22ecb25c00\",\"maxPriorityFeePerGas\":\"0x77359400\""), // pregenerated EIP-1559 hit
+    message("\"maxFeePerGas\":\"0x3b9aca00\",\"maxPriorityFeePerGas\":\"0x3b9aca00\""),   // EIP-1559 miss
+    message("\"gasPrice\":\"0x1000000000000000000\""),                                // fee too long
+    message("\"gasPrice\":\"0x355176b200\"", "0xc9c65396" + Input.substr(10, 128)),        // pair creation of pre-arm stream
+    message("\"gasPrice\":\"0x355176b200\"", "0x60806040" + std::string(8000, 'f')),      // deployment of pre-arm stream
+    "{\"jsonrpc\": \"2.0\", \"id\": null, \"result\": \"736d201d-540a-45c4-9bb3-a9f932ee885e\"}",
+  };
+
+  const std::string notification =
+    "{\"jsonrpc\":\"2.0\",\"method\":\"eth_subscription\",\"params\":{\"subscription\":\"0xcd0c3e8af590364c09d0fa6a1210faf5\",\"result\":{"
+    "\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"gas\":\"0x3d090\",\"gasPrice\":\"0x355176b200\",\"input\":\"" + Input + "\",\"nonce\":\"0x1a\","
+    "\"to\":\"0x7a250d5630b4cf539739df2c5dacb4c659f2488d\",\"value\":\"0x46114844c27ec9\"}}}";
+  const Feed::Node::Filter filter { "7a250d5630B4cF539739dF2C5dAcb4c659F2488D", 1000000000000, UInt256(0), false };
+  char normalized[Config::Size::BloXrouteTransactionMessageString];
+
+  for(std::string &recorded : messages) {
+    wallet.arm();
+
+    Allocations::Scope scope;
+    onMessage(recorded.data(), wallet, telemetry, sink);
+    ASSERT_EQ(scope.get().allocations, 0UL) << recorded;
+  }
+
+  {
+    wallet.arm();
+
+    Allocations::Scope scope;
+    ASSERT_NE(Feed::Node::normalize(notification.c_str(), notification.size(), filter, nullptr, normalized, sizeof(normalized)), 0UL);
+    onMessage(normalized, wallet, telemetry, sink);
+    ASSERT_EQ(scope.get().allocations, 0UL);
+  }
+
+  Telemetry::Metrics<8>::SnapshotType snapshot;
+  telemetry.snapshot(snapshot);
+  ASSERT_EQ(snapshot.counters[Telemetry::Messages], 9UL);
+  ASSERT_EQ(snapshot.counters[Telemetry::PregenHit], 3UL);
+  ASSERT_EQ(snapshot.counters[Telemetry::PregenMiss], 2UL);
+  ASSERT_EQ(snapshot.counters[Telemetry::FeeTooLong], 1UL);
+  ASSERT_EQ(snapshot.counters[Telemetry::Invalid], 3UL);
+  ASSERT_EQ(sink.sent, 5UL);
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <gmock/gmock.h>
 
+#include <string>
+
 #include <config.hpp>
 #include <bot.hpp>
 
@@ -29,11 +31,156 @@ TEST(BloXrouteMessageParser, extractGasPrice) {
   ASSERT_STREQ(output, "36b7176e00");
 }
 
+TEST(BloXrouteMessageParser, extractAmountTokenDesired) {
+  char output[65];
+
+  std::size_t outputLength = BloXrouteMessageParser::extractAmountTokenDesired("{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x46114844c27ec9\"}}}}", output);
+  ASSERT_EQ(outputLength, 64UL);
+  ASSERT_STREQ(output, "0000000000000000000000000000000000000000000000000000000001e4324d");
+}
+
+TEST(BloXrouteMessageParser, extractValue) {
+  char output[Config::Size::TransactionQuantityBuffer * 2 + 1];
+  std::size_t outputLength;
+
+  outputLength = BloXrouteMessageParser::extractValue("{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x46114844c27ec9\"}}}}", output);
+  ASSERT_EQ(outputLength, 14UL);
+  ASSERT_STREQ(output, "46114844c27ec9");
+
+  outputLength = BloXrouteMessageParser::extractValue("{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x355176b200\"}}}}", output);
+  ASSERT_EQ(outputLength, 0UL);
+  ASSERT_STREQ(output, "");
+
+  outputLength = BloXrouteMessageParser::extractLiquidityETH("{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x46114844c27ec9\"}}}}", output);
+  ASSERT_EQ(outputLength, 14UL);
+  ASSERT_STREQ(output, "46114844c27ec9");
+}
+
+TEST(BloXrouteMessageParser, extractDynamicFee) {
+  const char *legacyMessage = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x46114844c27ec9\"}}}}";
+  const char *dynamicFeeMessage = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"value\":\"0x46114844c27ec9\",\"maxFeePerGas\":\"0x22ecb25c00\",\"maxPriorityFeePerGas\":\"0x77359400\"}}}}";
+  char output[Config::Size::TransactionQuantityBuffer * 2 + 1];
+
+  ASSERT_FALSE(BloXrouteMessageParser::isDynamicFee(legacyMessage));
+  ASSERT_EQ(BloXrouteMessageParser::extractMaxFeePerGas(legacyMessage, output), 0UL);
+  ASSERT_EQ(BloXrouteMessageParser::extractMaxPriorityFeePerGas(legacyMessage, output), 0UL);
+
+  ASSERT_TRUE(BloXrouteMessageParser::isDynamicFee(dynamicFeeMessage));
+  ASSERT_EQ(BloXrouteMessageParser::extractMaxFeePerGas(dynamicFeeMessage, output), 10UL);
+  ASSERT_STREQ(output, "22ecb25c00");
+  ASSERT_EQ(BloXrouteMessageParser::extractMaxPriorityFeePerGas(dynamicFeeMessage, output), 8UL);
+  ASSERT_STREQ(output, "77359400");
+
+  // Value right after input (no gas price)
+  ASSERT_EQ(BloXrouteMessageParser::extractValue(dynamicFeeMessage, output), 14UL);
+  ASSERT_STREQ(output, "46114844c27ec9");
+}
+
+TEST(BloXrouteMessageParser, addLiquidity) {
+  const char *wrappedNativeFirstMessage = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xe8e33700000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000046114844c27ec90000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c687000000000000000000000000000000000000000000000000004500000000000000000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x36b7176e00\",\"value\":\"0x0\"}}}}";
+  const char *tokenFirstMessage = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xe8e33700000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec7000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc20000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000046114844c27ec90000000000000000000000000000000000000000000000000000000001e1c687000000000000000000000000000000000000000000000000004500000000000000000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x36b7176e00\",\"value\":\"0x0\"}}}}";
+  const char *otherPairMessage = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xe8e33700000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec7000000000000000000000000a0b86991c6218b36c1d19d4a2e9eb0ce3606eb480000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000046114844c27ec90000000000000000000000000000000000000000000000000000000001e1c687000000000000000000000000000000000000000000000000004500000000000000000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x36b7176e00\",\"value\":\"0x0\"}}}}";
+  char output[65];
+
+  ASSERT_TRUE(BloXrouteMessageParser::isAddLiquidity(wrappedNativeFirstMessage));
+  ASSERT_TRUE(BloXrouteMessageParser::validateTransaction(wrappedNativeFirstMessage, "dac17f958d2ee523a2206206994597c13d831ec7", "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2"));
+  ASSERT_TRUE(BloXrouteMessageParser::validateTransaction(tokenFirstMessage, "dac17f958d2ee523a2206206994597c13d831ec7", "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2"));
+  ASSERT_FALSE(BloXrouteMessageParser::validateTransaction(otherPairMessage, "dac17f958d2ee523a2206206994597c13d831ec7", "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2"));
+
+  for(const char *message : { wrappedNativeFirstMessage, tokenFirstMessage }) {
+    BloXrouteMessageParser::extractGasPrice(message, output);
+    ASSERT_STREQ(output, "36b7176e00");
+
+    ASSERT_EQ(BloXrouteMessageParser::extractAmountTokenDesired(message, output, "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2"), 64UL);
+    ASSERT_STREQ(output, "0000000000000000000000000000000000000000000000000000000001e4324d");
+
+    ASSERT_EQ(BloXrouteMessageParser::extractLiquidityETH(message, output, "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2"), 64UL);
+    ASSERT_STREQ(output, "0000000000000000000000000000000000000000000000000046114844c27ec9");
+
+    ASSERT_FALSE(BloXrouteMessageParser::isDynamicFee(message));
+  }
+}
+
+TEST(BloXrouteMessageParser, isRemoveLiquidityETH) {
+  const char *message = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0x02751cec000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x0\"}}}}";
+  char output[Config::Size::TransactionQuantityBuffer * 2 + 1];
+
+  ASSERT_TRUE(BloXrouteMessageParser::isRemoveLiquidityETH(message, "dac17f958d2ee523a2206206994597c13d831ec7"));
+  ASSERT_FALSE(BloXrouteMessageParser::isRemoveLiquidityETH(message, "cac17f958d2ee523a2206206994597c13d831ec7"));
+  ASSERT_FALSE(BloXrouteMessageParser::validateTransaction(message, "dac17f958d2ee523a2206206994597c13d831ec7"));
+
+  BloXrouteMessageParser::extractGasPrice(message, output);
+  ASSERT_STREQ(output, "355176b200");
+}
+
+TEST(BloXrouteMessageParser, extractFromAndNonce) {
+  const char *legacyMessage = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x46114844c27ec9\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+  const char *cancelMessage = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0x\",\"value\":\"0x0\",\"maxFeePerGas\":\"0x3b9aca0000\",\"maxPriorityFeePerGas\":\"0x77359400\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+  char output[Config::Size::TransactionQuantityBuffer * 2 + 1];
+
+  ASSERT_EQ(BloXrouteMessageParser::extractFrom(legacyMessage, output), 40UL);
+  ASSERT_STREQ(output, "64177643cf0e8e96dd0205983aadeafbd871dfc9");
+  ASSERT_EQ(BloXrouteMessageParser::extractNonce(legacyMessage, output), 2UL);
+  ASSERT_STREQ(output, "1a");
+  BloXrouteMessageParser::extractFeeCap(legacyMessage, output);
+  ASSERT_STREQ(output, "355176b200");
+
+  // Fields of transaction with empty input are found too
+  BloXrouteMessageParser::extractFrom(cancelMessage, output);
+  ASSERT_STREQ(output, "64177643cf0e8e96dd0205983aadeafbd871dfc9");
+  BloXrouteMessageParser::extractNonce(cancelMessage, output);
+  ASSERT_STREQ(output, "1a");
+  BloXrouteMessageParser::extractFeeCap(cancelMessage, output);
+  ASSERT_STREQ(output, "3b9aca0000");
+}
+
+TEST(BloXrouteMessageParser, foreignInput) {
+  const std::string prefix = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"";
+  const std::string fields = "\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x0\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+  const std::string addLiquidityETH = "0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb";
+
+  // Pair creation (shorter than liquidity add), deployment (longer) and truncated liquidity add
+  const std::string createPair = prefix + "0xc9c65396000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec7000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2" + fields;
+  const std::string deployment = prefix + "0x60806040" + std::string(8000, 'f') + fields;
+  const std::string truncated = prefix + addLiquidityETH.substr(0, 200) + fields;
+
+  for(const std::string &message : { createPair, deployment, truncated }) {
+    ASSERT_TRUE(BloXrouteMessageParser::isTransaction(message.c_str()));
+    ASSERT_FALSE(BloXrouteMessageParser::isInputComplete(message.c_str()));
+    ASSERT_FALSE(BloXrouteMessageParser::validateTransaction(message.c_str(), "dac17f958d2ee523a2206206994597c13d831ec7"));
+  }
+  ASSERT_TRUE(BloXrouteMessageParser::isInputComplete((prefix + addLiquidityETH + fields).c_str()));
+
+  // Values longer than the output or unterminated are not copied
+  char output[Config::Size::TransactionQuantityBuffer * 2 + 1];
+  const std::string longValue = prefix + addLiquidityETH + "\",\"gasPrice\":\"0x" + std::string(100, 'f') + "\",\"value\":\"0x" + std::string(100, 'f');
+
+  ASSERT_EQ(BloXrouteMessageParser::extractGasPrice(longValue.c_str(), output), 0UL);
+  ASSERT_STREQ(output, "");
+  ASSERT_EQ(BloXrouteMessageParser::extractValue(longValue.c_str(), output), 0UL);
+  ASSERT_STREQ(output, "");
+  ASSERT_EQ(BloXrouteMessageParser::extractNonce(deployment.c_str(), output), 2UL);
+  ASSERT_STREQ(output, "1a");
+}
+
 TEST(BloXrouteMessageBuilder, buildSubscribe) {
   char output[512];
 
-  BloXrouteMessageBuilder::buildSubscribe("5000000000000000000", "500000000000", output);
-  ASSERT_STREQ(output, "{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":[\"tx_contents.input\",\"tx_contents.gas_price\"],\"filters\":\"method_id = f305d719 and to = 0x7a250d5630B4cF539739dF2C5dAcb4c659F2488D and value >= 5000000000000000000 and gas_price <= 500000000000\"}]}");
+  BloXrouteMessageBuilder::buildSubscribe("7a250d5630B4cF539739dF2C5dAcb4c659F2488D", "5000000000000000000", "500000000000", output);
+  ASSERT_STREQ(output, "{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":[\"tx_contents.input\",\"tx_contents.gas_price\",\"tx_contents.value\",\"tx_contents.max_fee_per_gas\",\"tx_contents.max_priority_fee_per_gas\",\"tx_contents.from\",\"tx_contents.nonce\"],\"filters\":\"to = 0x7a250d5630B4cF539739dF2C5dAcb4c659F2488D and ((method_id = f305d719 and value >= 5000000000000000000) or method_id = e8e33700) and (gas_price <= 500000000000 or max_fee_per_gas <= 500000000000)\"}]}");
+
+  BloXrouteMessageBuilder::buildSubscribe("7a250d5630B4cF539739dF2C5dAcb4c659F2488D", "0", "500000000000", output, true);
+  ASSERT_STREQ(output, "{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":[\"tx_contents.input\",\"tx_contents.gas_price\",\"tx_contents.value\",\"tx_contents.max_fee_per_gas\",\"tx_contents.max_priority_fee_per_gas\",\"tx_contents.from\",\"tx_contents.nonce\"],\"filters\":\"to = 0x7a250d5630B4cF539739dF2C5dAcb4c659F2488D and ((method_id = f305d719 and value >= 0) or method_id = e8e33700 or method_id = 02751cec or method_id = af2979eb) and (gas_price <= 500000000000 or max_fee_per_gas <= 500000000000)\"}]}");
+
+  BloXrouteMessageBuilder::buildSubscribe("7a250d5630B4cF539739dF2C5dAcb4c659F2488D", "0", "500000000000", output, false, true);
+  ASSERT_STREQ(output, "{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":[\"tx_contents.input\",\"tx_contents.gas_price\",\"tx_contents.value\",\"tx_contents.max_fee_per_gas\",\"tx_contents.max_priority_fee_per_gas\",\"tx_contents.from\",\"tx_contents.nonce\",\"raw_tx\"],\"filters\":\"to = 0x7a250d5630B4cF539739dF2C5dAcb4c659F2488D and ((method_id = f305d719 and value >= 0) or method_id = e8e33700) and (gas_price <= 500000000000 or max_fee_per_gas <= 500000000000)\"}]}");
+}
+
+TEST(BloXrouteMessageBuilder, buildSubscribeFrom) {
+  char output[512];
+
+  BloXrouteMessageBuilder::buildSubscribeFrom("64177643cf0e8e96dd0205983aadeafbd871dfc9", output);
+  ASSERT_STREQ(output, "{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":[\"tx_contents.input\",\"tx_contents.gas_price\",\"tx_contents.value\",\"tx_contents.max_fee_per_gas\",\"tx_contents.max_priority_fee_per_gas\",\"tx_contents.from\",\"tx_contents.nonce\"],\"filters\":\"from = 0x64177643cf0e8e96dd0205983aadeafbd871dfc9\"}]}");
 }
 
 TEST(BloXrouteMessageBuilder, buildTransaction) {
@@ -41,4 +188,13 @@ TEST(BloXrouteMessageBuilder, buildTransaction) {
 
   BloXrouteMessageBuilder::buildTransaction("f85d8080827c6d94f0109fc8df283027b6285cc889f5aa624eac1f558080269f22f17b38af35286ffbb0c6376c86ec91c20ecbad93f84913a0cc15e7580cd99f83d6e12e82e3544cb4439964d5087da78f74cefeec9a450b16ae179fd8fe20", output);
   ASSERT_STREQ(output, "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"f85d8080827c6d94f0109fc8df283027b6285cc889f5aa624eac1f558080269f22f17b38af35286ffbb0c6376c86ec91c20ecbad93f84913a0cc15e7580cd99f83d6e12e82e3544cb4439964d5087da78f74cefeec9a450b16ae179fd8fe20\"}}");
+}
+
+TEST(BloXrouteMessageBuilder, sealTransaction) {
+  char output[512];
+
+  BloXrouteMessageBuilder::prepareTransaction(output);
+  memcpy(output + BloXrouteMessageBuilder::TransactionOffset, "f85d80", 6);
+  ASSERT_EQ(BloXrouteMessageBuilder::sealTransaction(output, 6), 54UL);
+  ASSERT_STREQ(output, "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"f85d80\"}}");
 }
\ No newline at end of file
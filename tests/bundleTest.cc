@@ -0,0 +1,248 @@
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <bundle.hpp>
+
+static const std::string Target = "f8ab1a8505d21dba0083030d40947a250d5630b4cf539739df2c5dacb4c659f2488d80b844f305d719";
+static const std::string Transaction = "f86c1a8522ecb25c0083030d40947a250d5630b4cf539739df2c5dacb4c659f2488d880de0b6b3a7640000";
+
+/**
+ * @brief Relay stand-in on loopback: answers every eth_sendBundle request with HTTP 200, closes the connection after
+ * the given number of requests.
+ */
+class StandInRelay {
+  int listener = -1;
+  std::thread thread;
+  std::atomic<bool> running { true };
+
+  void serve(std::size_t requestsPerConnection) {
+    while(running.load()) {
+      int fd = accept(listener, nullptr, nullptr);
+      if(fd == -1) return;
+      accepted++;
+
+      std::string buffer;
+      std::size_t served = 0;
+      char chunk[4096];
+      while(served < requestsPerConnection) {
+        std::size_t headersEnd = buffer.find("\r\n\r\n");
+        std::size_t lengthPosition = buffer.find("Content-Length: ");
+        if(headersEnd != std::string::npos && lengthPosition != std::string::npos) {
+          std::size_t contentLength = std::stoul(buffer.substr(lengthPosition + 16));
+          if(buffer.size() >= headersEnd + 4 + contentLength) {
+            requests.push_back(buffer.substr(0, headersEnd + 4 + contentLength));
+            connections.push_back(accepted.load());
+            buffer.erase(0, headersEnd + 4 + contentLength);
+
+            const char response[] = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 63\r\n\r\n{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":{\"bundleHash\":\"0x0123456789\"}}";
+            if(send(fd, response, sizeof(response) - 1, MSG_NOSIGNAL) <= 0) break;
+            served++;
+            continue;
+          }
+        }
+
+        ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+        if(count <= 0) break;
+        buffer.append(chunk, count);
+      }
+
+      close(fd);
+    }
+  }
+
+  public:
+
+  std::atomic<std::size_t> accepted { 0 };
+  std::vector<std::string> requests;
+  std::vector<std::size_t> connections;
+  int port = 0;
+
+  explicit StandInRelay(std::size_t requestsPerConnection) {
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    listen(listener, 4);
+
+    socklen_t addressLength = sizeof(address);
+    getsockname(listener, reinterpret_cast<sockaddr*>(&address), &addressLength);
+    port = ntohs(address.sin_port);
+
+    thread = std::thread([this, requestsPerConnection]() { serve(requestsPerConnection); });
+  }
+
+  ~StandInRelay() {
+    running.store(false);
+    shutdown(listener, SHUT_RDWR);
+    close(listener);
+    thread.join();
+  }
+
+  std::string url() const {
+    return "http://127.0.0.1:" + std::to_string(port) + "/relay";
+  }
+};
+
+/**
+ * @brief Polls the relay until the responses are read.
+ */
+static std::size_t awaitResponses(Bundle::Relay &relay, std::size_t count) {
+  std::size_t responses = 0;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while(responses < count && std::chrono::steady_clock::now() < deadline) {
+    responses += relay.poll();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return responses;
+}
+
+TEST(Bundle, extractRawTransaction) {
+  std::string message = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x0\"}";
+
+  std::size_t length = 0;
+  ASSERT_EQ(Bundle::extractRawTransaction((message + "}}}").c_str(), length), nullptr);
+
+  std::string withRaw = message + ",\"rawTx\":\"0x" + Target + "\"}}}";
+  const char *raw = Bundle::extractRawTransaction(withRaw.c_str(), length);
+  ASSERT_NE(raw, nullptr);
+  ASSERT_EQ(std::string(raw, length), Target);
+
+  // Odd length or unterminated values are not transactions
+  ASSERT_EQ(Bundle::extractRawTransaction((message + ",\"rawTx\":\"0xf8a\"}}}").c_str(), length), nullptr);
+  ASSERT_EQ(Bundle::extractRawTransaction((message + ",\"rawTx\":\"0xf8ab").c_str(), length), nullptr);
+}
+
+TEST(Bundle, parseUrl) {
+  Bundle::Url url;
+  ASSERT_TRUE(Bundle::parseUrl("https://rpc.beaverbuild.org/", url));
+  ASSERT_STREQ(url.host, "rpc.beaverbuild.org");
+  ASSERT_STREQ(url.port, "443");
+  ASSERT_STREQ(url.path, "/");
+  ASSERT_TRUE(url.secure);
+
+  ASSERT_TRUE(Bundle::parseUrl("http://127.0.0.1:8545", url));
+  ASSERT_STREQ(url.port, "8545");
+  ASSERT_STREQ(url.path, "/");
+  ASSERT_FALSE(url.secure);
+
+  ASSERT_FALSE(Bundle::parseUrl("ws://127.0.0.1/", url));
+  ASSERT_FALSE(Bundle::parseUrl("http://:80/", url));
+}
+
+TEST(Bundle, compose) {
+  static Bundle::Composer<1024> composer;
+  Bundle::Url url;
+  ASSERT_TRUE(Bundle::parseUrl("http://relay.local/bundle", url));
+  ASSERT_TRUE(composer.init(url));
+
+  const std::string body = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"eth_sendBundle\",\"params\":[{\"txs\":[\"0x" + Target + "\",\"0x" + Transaction + "\"]}]}";
+  const std::string headers = "POST /bundle HTTP/1.1\r\nHost: relay.local\r\nContent-Type: application/json\r\nConnection: keep-alive\r\nContent-Length: ";
+
+  std::size_t length = 0;
+  const char *request = composer.compose(Target.c_str(), Target.size(), Transaction.c_str(), Transaction.size(), length);
+  ASSERT_NE(request, nullptr);
+  ASSERT_EQ(std::string(request, length), headers + std::to_string(body.size()) + "\r\n\r\n" + body);
+
+  // Shorter transactions, fewer digits
+  request = composer.compose("f8", 2, "f9", 2, length);
+  std::string shortBody = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"eth_sendBundle\",\"params\":[{\"txs\":[\"0xf8\",\"0xf9\"]}]}";
+  ASSERT_EQ(std::string(request, length), headers + std::to_string(shortBody.size()) + "\r\n\r\n" + shortBody);
+
+  composer.setBlockNumber(0x10d4f2c);
+  request = composer.compose(Target.c_str(), Target.size(), Transaction.c_str(), Transaction.size(), length);
+  ASSERT_THAT(std::string(request, length), testing::EndsWith("\"0x" + Transaction + "\"],\"blockNumber\":\"0x10d4f2c\"}]}"));
+
+  std::string longTarget(1024, 'f');
+  ASSERT_EQ(composer.compose(longTarget.c_str(), longTarget.size(), Transaction.c_str(), Transaction.size(), length), nullptr);
+}
+
+TEST(Bundle, parseResponse) {
+  Bundle::Response response;
+  std::string ok = "HTTP/1.1 200 OK\r\ncontent-length: 5\r\nConnection: keep-alive\r\n\r\nhello";
+  ASSERT_EQ(Bundle::parseResponse(ok.c_str(), ok.size(), response), ok.size());
+  ASSERT_EQ(response.status, 200);
+  ASSERT_EQ(std::string(response.body, response.bodyLength), "hello");
+  ASSERT_FALSE(response.close);
+
+  // Incomplete headers or body
+  ASSERT_EQ(Bundle::parseResponse(ok.c_str(), 20, response), 0UL);
+  ASSERT_EQ(Bundle::parseResponse(ok.c_str(), ok.size() - 1, response), 0UL);
+
+  // Pipelined responses are parsed one by one
+  std::string two = ok + "HTTP/1.1 429 Too Many Requests\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+  ASSERT_EQ(Bundle::parseResponse(two.c_str() + ok.size(), two.size() - ok.size(), response), two.size() - ok.size());
+  ASSERT_EQ(response.status, 429);
+  ASSERT_TRUE(response.close);
+
+  std::string chunked = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n6;ext=1\r\n world\r\n0\r\n\r\n";
+  ASSERT_EQ(Bundle::parseResponse(chunked.c_str(), chunked.size(), response), chunked.size());
+  ASSERT_EQ(std::string(response.body, response.bodyLength), "hello");
+  ASSERT_EQ(Bundle::parseResponse(chunked.c_str(), chunked.size() - 2, response), 0UL);
+
+  std::string noHeaders = "HTTP/1.1 204 No Content\r\n\r\n";
+  ASSERT_EQ(Bundle::parseResponse(noHeaders.c_str(), noHeaders.size(), response), noHeaders.size());
+  ASSERT_EQ(response.status, 204);
+
+  for(std::string malformed : { "SMTP/1.1 200 OK\r\n\r\n", "HTTP/1.1 2x0 OK\r\n\r\n", "HTTP/1.1 200 OK\r\nContent-Length: x\r\n\r\n", "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n" }) {
+    ASSERT_EQ(Bundle::parseResponse(malformed.c_str(), malformed.size(), response), Bundle::Malformed) << malformed;
+  }
+}
+
+TEST(Bundle, keepAlive) {
+  StandInRelay standIn(2);
+  static Bundle::Composer<1024> composer;
+  Bundle::Relay relay;
+
+  ASSERT_TRUE(relay.connect(standIn.url().c_str()));
+  ASSERT_TRUE(composer.init(relay.getUrl()));
+
+  // Requests on one connection, answered in order
+  std::size_t length = 0;
+  const char *request = composer.compose(Target.c_str(), Target.size(), Transaction.c_str(), Transaction.size(), length);
+  ASSERT_TRUE(relay.send(request, length));
+  ASSERT_TRUE(relay.send(request, length));
+  ASSERT_EQ(relay.getPending(), 2UL);
+  ASSERT_EQ(awaitResponses(relay, 2), 2UL);
+  ASSERT_EQ(relay.getPending(), 0UL);
+  ASSERT_EQ(relay.getLastStatus(), 200);
+  ASSERT_STREQ(relay.getLastBody(), "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":{\"bundleHash\":\"0x0123456789\"}}");
+
+  // Stand-in closed the connection after two requests, poll reconnects before the next one
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while(standIn.accepted.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+    relay.poll();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(standIn.accepted.load(), 2UL);
+  ASSERT_TRUE(relay.isConnected());
+
+  ASSERT_TRUE(relay.send(request, length));
+  ASSERT_EQ(awaitResponses(relay, 1), 1UL);
+
+  ASSERT_EQ(standIn.requests.size(), 3UL);
+  ASSERT_EQ(standIn.connections, (std::vector<std::size_t> { 1, 1, 2 }));
+  ASSERT_EQ(standIn.requests[0], std::string(request, length));
+  ASSERT_EQ(standIn.requests[2], std::string(request, length));
+
+  // Connection dropped without poll noticing, send fails fast and poll reconnects
+  relay.close();
+  ASSERT_FALSE(relay.isConnected());
+  ASSERT_FALSE(relay.send(request, length));
+  ASSERT_EQ(relay.poll(), 0UL);
+  ASSERT_TRUE(relay.isConnected());
+  ASSERT_TRUE(relay.send(request, length));
+  ASSERT_EQ(awaitResponses(relay, 1), 1UL);
+  ASSERT_EQ(standIn.accepted.load(), 3UL);
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include <cancel.hpp>
+
+using TestTable = Cancel::Table<4, Config::Size::BloXrouteTransactionMessageString>;
+
+static constexpr char TestPrivateKey[] = "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318";
+static constexpr char TestAddress[] = "2c7536e3605d9c16a7a3d7b1898e529396a65c23";
+static constexpr char TestToken[] = "dac17f958d2ee523a2206206994597c13d831ec7";
+
+static constexpr char TargetMessage[] = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x174876e800\",\"value\":\"0x46114844c27ec9\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+static constexpr char BumpMessage[] = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb\",\"gasPrice\":\"0x199c82cc00\",\"value\":\"0x46114844c27ec9\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+static constexpr char CancelMessage[] = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0x\",\"value\":\"0x0\",\"maxFeePerGas\":\"0x199c82cc00\",\"maxPriorityFeePerGas\":\"0x77359400\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+static constexpr char OtherNonceMessage[] = "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0x\",\"value\":\"0x0\",\"gasPrice\":\"0x199c82cc00\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1b\"}}}}";
+
+TEST(Cancel, replacementGasPrice) {
+  ASSERT_EQ(Cancel::replacementGasPrice(100000000000), 110000000000UL);
+  ASSERT_EQ(Cancel::replacementGasPrice(1000000001), 1100000002UL);
+  ASSERT_EQ(Cancel::replacementGasPrice(100, 25), 125UL);
+}
+
+TEST(Cancel, table) {
+  static TestTable table;
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer(TestPrivateKey, privateKey);
+
+  table.init(26, TestAddress);
+  ASSERT_EQ(table.generate({ 110000000000, 111000000000 }, privateKey, 2), 2UL);
+  ASSERT_EQ(table.getBuyGasPrice(), 0UL);
+
+  // Cancel is a zero value self-transfer with the buy nonce
+  Transaction expectedTx;
+  expectedTx.setField(Transaction::Field::Nonce, "1a");
+  expectedTx.setField(Transaction::Field::GasLimit, Config::Cancel::GasLimit);
+  expectedTx.setField(Transaction::Field::To, TestAddress);
+  char expectedMessage[Config::Size::BloXrouteTransactionMessageString];
+  PreGen::generate(expectedTx, privateKey, 110000000000, expectedMessage);
+  ASSERT_STREQ(table.txs.find(110000000000)->message, expectedMessage);
+
+  // Pregenerated cancel with the nearest gas price at or above the replacement one is sent
+  Transaction tx;
+  char buffer[Config::Size::BloXrouteTransactionMessageString];
+  std::size_t length;
+  std::uint64_t gasPrice;
+
+  table.bought(100000000000);
+  const char *message = table.message(1000000000, tx, privateKey, buffer, length, gasPrice);
+  ASSERT_EQ(message, table.txs.find(110000000000)->message);
+  ASSERT_EQ(gasPrice, 110000000000UL);
+  ASSERT_EQ(length, strlen(expectedMessage));
+
+  table.bought(100500000000);
+  message = table.message(1000000000, tx, privateKey, buffer, length, gasPrice);
+  ASSERT_EQ(message, table.txs.find(111000000000)->message);
+
+  // Misses are signed on demand
+  table.bought(200000000000);
+  message = table.message(1000000000, tx, privateKey, buffer, length, gasPrice);
+  ASSERT_EQ(message, buffer);
+  ASSERT_EQ(gasPrice, 220000000000UL);
+
+  PreGen::generate(expectedTx, privateKey, 220000000000, expectedMessage);
+  ASSERT_STREQ(message, expectedMessage);
+}
+
+TEST(Cancel, watcher) {
+  Cancel::Watcher watcher;
+
+  ASSERT_FALSE(watcher.isWatching(0));
+  ASSERT_TRUE(watcher.watch(TargetMessage, 100));
+  ASSERT_STREQ(watcher.getFrom(), "64177643cf0e8e96dd0205983aadeafbd871dfc9");
+  ASSERT_TRUE(watcher.isWatching(99));
+  ASSERT_FALSE(watcher.isWatching(100));
+
+  // Target itself and other nonces of the sender are not replacements
+  ASSERT_FALSE(watcher.isReplacement(TargetMessage));
+  ASSERT_FALSE(watcher.isReplacement(OtherNonceMessage));
+
+  // Fee bump of the liquidity add is a replacement, but does not cancel the target
+  ASSERT_TRUE(watcher.isReplacement(BumpMessage));
+  ASSERT_FALSE(watcher.isCancelled(BumpMessage, 0, TestToken));
+
+  ASSERT_TRUE(watcher.isReplacement(CancelMessage));
+  ASSERT_TRUE(watcher.isCancelled(CancelMessage, 0, TestToken));
+  ASSERT_FALSE(watcher.isCancelled(CancelMessage, 100, TestToken));
+
+  // Any transaction of the sender is recognized while watching
+  ASSERT_TRUE(watcher.isFromSender(OtherNonceMessage, 0));
+  ASSERT_TRUE(watcher.isFromSender(CancelMessage, 0));
+  ASSERT_FALSE(watcher.isFromSender(OtherNonceMessage, 100));
+  std::string otherSender = OtherNonceMessage;
+  otherSender.replace(otherSender.find("64177643"), 8, "74177643");
+  ASSERT_FALSE(watcher.isFromSender(otherSender.c_str(), 0));
+
+  watcher.stop();
+  ASSERT_FALSE(watcher.isCancelled(CancelMessage, 0, TestToken));
+  ASSERT_FALSE(watcher.isFromSender(CancelMessage, 0));
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <gmock/gmock.h>
+
+#include <exit.hpp>
+
+using TestPosition = Exit::Position<4, Config::Size::BloXrouteTransactionMessageString, 2>;
+
+static constexpr std::uint64_t TestTiers[] = { 100, 50 };
+static constexpr char TestToken[] = "c242eb8e4e27eae6a2a728a41201152f19595c83";
+static constexpr char TestRouter[] = "7a250d5630B4cF539739dF2C5dAcb4c659F2488D";
+static constexpr char TestReceiver[] = "86f779f4c6288158a4330db68acd5b55a4450323";
+static constexpr char TestPrivateKey[] = "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318";
+
+TEST(Exit, buildApproveData) {
+  char output[Exit::ApproveTemplate.HexLength + 1];
+
+  ASSERT_EQ(Exit::buildApproveData(TestRouter, output), 136UL);
+  ASSERT_STREQ(output, "095ea7b30000000000000000000000007a250d5630B4cF539739dF2C5dAcb4c659F2488Dffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+}
+
+TEST(Exit, buildSellData) {
+  char output[Exit::SellTemplate.HexLength + 1];
+
+  ASSERT_EQ(Exit::buildSellData(TestToken, TestReceiver, output), 8UL + 8 * 64);
+  ASSERT_STREQ(output, "18cbafe50000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000a000000000000000000000000086f779f4c6288158a4330db68acd5b55a4450323ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff0000000000000000000000000000000000000000000000000000000000000002000000000000000000000000c242eb8e4e27eae6a2a728a41201152f19595c83000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2");
+}
+
+TEST(Exit, tierAmount) {
+  ASSERT_EQ(Exit::tierAmount(UInt256(1000), 100), UInt256(1000));
+  ASSERT_EQ(Exit::tierAmount(UInt256(1000), 25), UInt256(250));
+  ASSERT_EQ(Exit::tierAmount(UInt256::fromHexString("1bc16d674ec80000"), 50), UInt256::fromHexString("de0b6b3a7640000"));
+}
+
+TEST(Exit, trigger) {
+  Exit::Trigger trigger;
+
+  ASSERT_EQ(trigger.poll(100), Exit::Signal::None);
+
+  // Timer fires once its deadline passes
+  trigger.armTimer(200);
+  ASSERT_EQ(trigger.poll(199), Exit::Signal::None);
+  ASSERT_EQ(trigger.poll(200), Exit::Signal::Timer);
+  ASSERT_EQ(trigger.gasPrice(), 0UL);
+
+  // Only the first signal wins
+  ASSERT_FALSE(trigger.fire(Exit::Signal::Manual));
+  ASSERT_EQ(trigger.signal(), Exit::Signal::Timer);
+
+  Exit::Trigger priceTrigger;
+  ASSERT_TRUE(priceTrigger.fire(Exit::Signal::Price, 123000000000));
+  ASSERT_FALSE(priceTrigger.fire(Exit::Signal::Manual, 1));
+  ASSERT_EQ(priceTrigger.poll(0), Exit::Signal::Price);
+  ASSERT_EQ(priceTrigger.gasPrice(), 123000000000UL);
+}
+
+TEST(Exit, position) {
+  static TestPosition position;
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer(TestPrivateKey, privateKey);
+
+  ASSERT_FALSE(position.isOpen());
+  position.open(7, 100000000000, UInt256(1000), TestTiers, TestToken, TestRouter, TestReceiver);
+  ASSERT_TRUE(position.isOpen());
+  ASSERT_FALSE(position.isReady());
+  ASSERT_EQ(position.getAmount(0), UInt256(1000));
+  ASSERT_EQ(position.getAmount(1), UInt256(500));
+
+  ASSERT_EQ(position.generate({ 100000000000, 200000000000 }, privateKey, 2), 6UL);
+  ASSERT_TRUE(position.isReady());
+  ASSERT_EQ(position.approveTxs.size(), 2UL);
+  ASSERT_EQ(position.sellTxs[1].size(), 2UL);
+
+  // Approve has nonce + 1, sell has nonce + 2 and tier amount patched in
+  Transaction expectedTx;
+  char approveData[Exit::ApproveTemplate.HexLength + 1], sellData[Exit::SellTemplate.HexLength + 1];
+  Exit::buildApproveData(TestRouter, approveData);
+  Exit::buildSellData(TestToken, TestReceiver, sellData);
+  memcpy(sellData + Exit::SellTemplate.wordOffset(ABI::AmountIn) + 61, "1f4", 3);
+
+  expectedTx.setField(Transaction::Field::Nonce, "8");
+  expectedTx.setField(Transaction::Field::GasLimit, Config::Exit::ApproveGasLimit);
+  expectedTx.setField(Transaction::Field::To, TestToken);
+  expectedTx.setField(Transaction::Field::Data, approveData);
+  char expectedApprove[Config::Size::BloXrouteTransactionMessageString];
+  PreGen::generate(expectedTx, privateKey, 200000000000, expectedApprove);
+  ASSERT_STREQ(position.approveTxs.find(200000000000)->message, expectedApprove);
+
+  expectedTx.setField(Transaction::Field::Nonce, "9");
+  expectedTx.setField(Transaction::Field::GasLimit, Config::Exit::SellGasLimit);
+  expectedTx.setField(Transaction::Field::To, TestRouter);
+  expectedTx.setField(Transaction::Field::Data, sellData);
+  char expectedSell[Config::Size::BloXrouteTransactionMessageString];
+  PreGen::generate(expectedTx, privateKey, 100000000000, expectedSell);
+  ASSERT_STREQ(position.sellTxs[1].find(100000000000)->message, expectedSell);
+
+  // Nearest higher gas price is sent, misses are signed on demand
+  Transaction tx;
+  char buffer[Config::Size::BloXrouteTransactionMessageString];
+  std::size_t length;
+
+  const char *message = position.sell(1, 99000000000, 1000000000, tx, privateKey, buffer, length);
+  ASSERT_EQ(message, position.sellTxs[1].find(100000000000)->message);
+  ASSERT_EQ(length, strlen(expectedSell));
+
+  message = position.sell(1, 100000000000, 0, tx, privateKey, buffer, length);
+  ASSERT_STREQ(message, expectedSell);
+
+  message = position.approve(300000000000, 1000000000, tx, privateKey, buffer, length);
+  ASSERT_EQ(message, buffer);
+  ASSERT_EQ(length, strlen(buffer));
+
+  message = position.sell(1, 150000000000, 0, tx, privateKey, buffer, length);
+  ASSERT_EQ(message, buffer);
+}
\ No newline at end of file
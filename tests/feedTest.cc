@@ -0,0 +1,156 @@
+#include <gmock/gmock.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <feed.hpp>
+
+static const std::string Input = "f305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb";
+static const std::string Router = "7a250d5630b4cf539739df2c5dacb4c659f2488d";
+static const std::string From = "64177643cf0e8e96dd0205983aadeafbd871dfc9";
+
+static const Feed::Node::Filter TestFilter { "7a250d5630B4cF539739dF2C5dAcb4c659F2488D", 1000000000000, UInt256(1000), false };
+
+static std::string notification(const std::string &input, const std::string &to, const std::string &fees, const std::string &value = "46114844c27ec9") {
+  return
+      "{\"jsonrpc\":\"2.0\",\"method\":\"eth_subscription\",\"params\":{\"subscription\":\"0xcd0c3e8af590364c09d0fa6a1210faf5\",\"result\":{"
+      "\"blockHash\":null,\"blockNumber\":null,\"from\":\"0x" + From + "\",\"gas\":\"0x3d090\"," + fees + ","
+      "\"hash\":\"0x4e8f1a8a0bc87a4fb4fb1dd2e8e04f0b20eeb3ed03bd1da7cef8cf2de1ecb2d0\",\"input\":\"0x" + input + "\",\"nonce\":\"0x1a\","
+      "\"to\":\"0x" + to + "\",\"transactionIndex\":null,\"value\":\"0x" + value + "\",\"type\":\"0x0\",\"chainId\":\"0x1\","
+      "\"v\":\"0x25\",\"r\":\"0x1b5e176d927f8e9ab405058b2d2457392da3e20f328b16ddabcebc33eaac5fea\",\"s\":\"0x4ba69724e8f69de52f0125ad8b3c5c2cef33019bac3249e2c0a2192766d1721c\"}}}";
+}
+
+static std::size_t normalize(const std::string &message, char *output, const char *from = nullptr) {
+  return Feed::Node::normalize(message.c_str(), message.size(), TestFilter, from, output, Config::Size::BloXrouteTransactionMessageString);
+}
+
+TEST(Feed, normalize) {
+  char output[Config::Size::BloXrouteTransactionMessageString];
+  char field[Config::Size::TransactionQuantityBuffer * 2 + 1];
+
+  std::size_t outputLength = normalize(notification(Input, Router, "\"gasPrice\":\"0x355176b200\""), output);
+  ASSERT_EQ(outputLength, strlen(output));
+  ASSERT_EQ(std::string(output), std::string(Feed::Node::Prefix) + Input + "\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x46114844c27ec9\",\"from\":\"0x" + From + "\",\"nonce\":\"0x1a\"}}}}");
+
+  // Goes through the same parser as BloXroute messages
+  ASSERT_TRUE(BloXrouteMessageParser::validateTransaction(output, "dac17f958d2ee523a2206206994597c13d831ec7"));
+  ASSERT_FALSE(BloXrouteMessageParser::isDynamicFee(output));
+  BloXrouteMessageParser::extractGasPrice(output, field);
+  ASSERT_STREQ(field, "355176b200");
+  BloXrouteMessageParser::extractValue(output, field);
+  ASSERT_STREQ(field, "46114844c27ec9");
+  BloXrouteMessageParser::extractNonce(output, field);
+  ASSERT_STREQ(field, "1a");
+
+  // EIP-1559 transaction
+  normalize(notification(Input, Router, "\"gasPrice\":\"0x2e90edd000\",\"maxFeePerGas\":\"0x2e90edd000\",\"maxPriorityFeePerGas\":\"0x77359400\""), output);
+  ASSERT_TRUE(BloXrouteMessageParser::isDynamicFee(output));
+  BloXrouteMessageParser::extractMaxFeePerGas(output, field);
+  ASSERT_STREQ(field, "2e90edd000");
+  BloXrouteMessageParser::extractMaxPriorityFeePerGas(output, field);
+  ASSERT_STREQ(field, "77359400");
+
+  // Fee cap takes place of missing gas price
+  normalize(notification(Input, Router, "\"maxFeePerGas\":\"0x2e90edd000\",\"maxPriorityFeePerGas\":\"0x77359400\""), output);
+  BloXrouteMessageParser::extractGasPrice(output, field);
+  ASSERT_STREQ(field, "2e90edd000");
+}
+
+TEST(Feed, normalizeFilter) {
+  char output[Config::Size::BloXrouteTransactionMessageString];
+  const std::string swapInput = "7ff36ab5" + Input.substr(8);
+
+  // Other router, other method, fee cap and value out of range
+  ASSERT_EQ(normalize(notification(Input, "d9e1ce17f2641f24ae83637ab66a2cca9c378b9f", "\"gasPrice\":\"0x355176b200\""), output), 0UL);
+  ASSERT_EQ(normalize(notification(swapInput, Router, "\"gasPrice\":\"0x355176b200\""), output), 0UL);
+  ASSERT_EQ(normalize(notification(Input, Router, "\"gasPrice\":\"0xe8d4a51001\""), output), 0UL);
+  ASSERT_EQ(normalize(notification(Input, Router, "\"gasPrice\":\"0x355176b200\"", "3e7"), output), 0UL);
+  ASSERT_NE(normalize(notification(Input, Router, "\"gasPrice\":\"0x355176b200\"", "3e8"), output), 0UL);
+
+  // Response to the subscribe request
+  ASSERT_EQ(normalize("{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0xcd0c3e8af590364c09d0fa6a1210faf5\"}", output), 0UL);
+
+  // Any transaction of watched sender passes, input is cut
+  const std::string longInput = swapInput + std::string(2000, '0');
+  ASSERT_NE(normalize(notification(longInput, "dac17f958d2ee523a2206206994597c13d831ec7", "\"gasPrice\":\"0xe8d4a51001\""), output, From.c_str()), 0UL);
+  ASSERT_EQ(strlen(output), sizeof(Feed::Node::Prefix) - 1 + Feed::Node::MaxInputLength + strlen("\",\"gasPrice\":\"0xe8d4a51001\",\"value\":\"0x46114844c27ec9\",\"from\":\"0x") + 40 + strlen("\",\"nonce\":\"0x1a\"}}}}"));
+}
+
+TEST(Feed, unixSocket) {
+  const std::string path = "/tmp/uniswap-sniper-feed-test-" + std::to_string(getpid()) + ".ipc";
+  const std::string message = notification(Input, Router, "\"gasPrice\":\"0x355176b200\"");
+
+  sockaddr_un address {};
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, path.c_str());
+  unlink(path.c_str());
+
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  ASSERT_EQ(bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+  ASSERT_EQ(listen(listener, 1), 0);
+
+  // Stand-in node: answers the subscription, streams notifications (split and oversized ones too) and reads sent transaction
+  std::string serverReceived;
+  std::thread server([&]() {
+    int client = accept(listener, nullptr, nullptr);
+    char buffer[4096];
+
+    auto readLines = [&](std::size_t lines) {
+      while(std::count(serverReceived.begin(), serverReceived.end(), '\n') < static_cast<std::ptrdiff_t>(lines)) {
+        ssize_t count = read(client, buffer, sizeof(buffer));
+        if(count <= 0) return;
+        serverReceived.append(buffer, count);
+      }
+    };
+
+    auto writeString = [&](const std::string &data) {
+      ASSERT_EQ(write(client, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    };
+
+    readLines(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    writeString("{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0xcd0c3e8af590364c09d0fa6a1210faf5\"}\n" + message.substr(0, 100));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    writeString(message.substr(100) + "\n" + std::string(5000, 'x') + "\n");
+    writeString(message + "\n");
+
+    readLines(2);
+    close(client);
+  });
+
+  static Feed::UnixSocket<2048> feed;
+  ASSERT_FALSE(feed.connect("/tmp/uniswap-sniper-feed-test-missing.ipc", 10));
+  ASSERT_TRUE(feed.connect(path.c_str(), 10));
+  ASSERT_TRUE(feed.request(Feed::Node::SubscribeRequest, sizeof(Feed::Node::SubscribeRequest) - 1));
+
+  char transaction[] = "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"f86b1a\"}}";
+  std::vector<std::string> messages;
+  std::size_t idle = 0;
+
+  std::size_t received = feed.run(
+    [&](const char *line, std::size_t length) {
+      messages.emplace_back(line, length);
+      if(messages.size() == 3) feed.send(transaction, strlen(transaction));
+    },
+    [&]() { ++idle; }
+  );
+
+  server.join();
+  close(listener);
+  unlink(path.c_str());
+
+  ASSERT_EQ(received, 3UL);
+  ASSERT_EQ(messages[0], "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0xcd0c3e8af590364c09d0fa6a1210faf5\"}");
+  ASSERT_EQ(messages[1], message);
+  ASSERT_EQ(messages[2], message);
+  ASSERT_GT(idle, 0UL);
+  ASSERT_FALSE(feed.isOpen());
+
+  ASSERT_EQ(serverReceived, std::string(Feed::Node::SubscribeRequest) + "\n{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"eth_sendRawTransaction\",\"params\":[\"0xf86b1a\"]}\n");
+}
\ No newline at end of file
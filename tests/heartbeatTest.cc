@@ -0,0 +1,120 @@
+#include <gmock/gmock.h>
+
+#include <cstdint>
+
+#include <heartbeat.hpp>
+
+static constexpr std::uint64_t Millisecond = 1000000;
+
+TEST(Heartbeat, roundTrip) {
+  Heartbeat::Monitor<4> monitor;
+  monitor.reset(1000 * Millisecond, 0, 0);
+
+  char first[Heartbeat::PayloadLength], second[Heartbeat::PayloadLength];
+  ASSERT_EQ(monitor.ping(100 * Millisecond, first), Heartbeat::PayloadLength);
+  ASSERT_EQ(monitor.ping(200 * Millisecond, second), Heartbeat::PayloadLength);
+
+  // Pongs out of order, the older one is stale once the newer is answered
+  std::uint64_t roundTrip = 0;
+  ASSERT_TRUE(monitor.pong(second, sizeof(second), 203 * Millisecond, roundTrip));
+  ASSERT_EQ(roundTrip, 3 * Millisecond);
+  ASSERT_FALSE(monitor.pong(first, sizeof(first), 204 * Millisecond, roundTrip));
+  ASSERT_FALSE(monitor.pong(second, sizeof(second), 205 * Millisecond, roundTrip));
+
+  // Foreign payloads
+  ASSERT_FALSE(monitor.pong("", 0, 205 * Millisecond, roundTrip));
+  char forged[Heartbeat::PayloadLength];
+  monitor.ping(300 * Millisecond, forged);
+  forged[8] ^= 1;
+  ASSERT_FALSE(monitor.pong(forged, sizeof(forged), 301 * Millisecond, roundTrip));
+
+  ASSERT_EQ(monitor.getSamples(), 1);
+  ASSERT_EQ(monitor.median(), 3 * Millisecond);
+  ASSERT_FALSE(monitor.isDegraded());
+}
+
+TEST(Heartbeat, degradedRoundTrip) {
+  Heartbeat::Monitor<4> monitor;
+  monitor.reset(1000 * Millisecond, 5 * Millisecond, 0);
+
+  // Judged on full window only, by its median
+  std::uint64_t time = 0, roundTrip;
+  for(std::uint64_t delay : { 10, 10, 1 }) {
+    char payload[Heartbeat::PayloadLength];
+    monitor.ping(time, payload);
+    ASSERT_TRUE(monitor.pong(payload, sizeof(payload), time + delay * Millisecond, roundTrip));
+    time += 100 * Millisecond;
+  }
+  ASSERT_FALSE(monitor.isDegraded());
+
+  for(std::uint64_t delay : { 20, 1, 1, 1 }) {
+    char payload[Heartbeat::PayloadLength];
+    monitor.ping(time, payload);
+    ASSERT_TRUE(monitor.pong(payload, sizeof(payload), time + delay * Millisecond, roundTrip));
+    time += 100 * Millisecond;
+
+    if(delay == 20) {
+      ASSERT_TRUE(monitor.isDegraded());
+    }
+  }
+
+  // Oldest round trips left the window
+  ASSERT_EQ(monitor.median(), 1 * Millisecond);
+  ASSERT_FALSE(monitor.isDegraded());
+
+  monitor.reset(1000 * Millisecond, 5 * Millisecond, 0);
+  ASSERT_EQ(monitor.median(), 0);
+  ASSERT_EQ(monitor.getSamples(), 0);
+}
+
+TEST(Heartbeat, lostPongs) {
+  Heartbeat::Monitor<4> monitor;
+  monitor.reset(250 * Millisecond, 0, 3);
+
+  // Pings every 100 ms, never answered: each one counts as lost once older than the timeout
+  char payload[Heartbeat::PayloadLength];
+  for(std::uint64_t i = 0; i < 5; i++) monitor.ping(i * 100 * Millisecond, payload);
+  ASSERT_EQ(monitor.getLost(), 2);
+  ASSERT_FALSE(monitor.isDegraded());
+
+  monitor.ping(500 * Millisecond, payload);
+  ASSERT_EQ(monitor.getLost(), 3);
+  ASSERT_TRUE(monitor.isDegraded());
+
+  // Answer resets lost count, late pong of lost ping is ignored
+  char answered[Heartbeat::PayloadLength];
+  std::uint64_t roundTrip;
+  monitor.ping(600 * Millisecond, answered);
+  ASSERT_TRUE(monitor.pong(answered, sizeof(answered), 601 * Millisecond, roundTrip));
+  ASSERT_EQ(monitor.getLost(), 0);
+  ASSERT_FALSE(monitor.pong(payload, sizeof(payload), 602 * Millisecond, roundTrip));
+
+  // More pings in flight than the window tracks, the oldest ones are given up on
+  Heartbeat::Monitor<2> small;
+  small.reset(1000 * Millisecond, 0, 0);
+  char first[Heartbeat::PayloadLength], last[Heartbeat::PayloadLength];
+  small.ping(0, first);
+  small.ping(1 * Millisecond, payload);
+  small.ping(2 * Millisecond, last);
+  ASSERT_EQ(small.getLost(), 1);
+  ASSERT_FALSE(small.pong(first, sizeof(first), 3 * Millisecond, roundTrip));
+  ASSERT_TRUE(small.pong(last, sizeof(last), 3 * Millisecond, roundTrip));
+  ASSERT_EQ(roundTrip, 1 * Millisecond);
+}
+
+TEST(Heartbeat, endpoints) {
+  Heartbeat::Endpoints<3> endpoints;
+  ASSERT_EQ(endpoints.getCurrent(), 0);
+
+  // Not yet measured endpoints first, in order
+  ASSERT_EQ(endpoints.next(5 * Millisecond), 1);
+  ASSERT_EQ(endpoints.next(UINT64_MAX), 2);
+
+  // Then the shortest round trip, never the current one
+  ASSERT_EQ(endpoints.next(3 * Millisecond), 0);
+  ASSERT_EQ(endpoints.next(9 * Millisecond), 2);
+  ASSERT_EQ(endpoints.next(1 * Millisecond), 0);
+
+  Heartbeat::Endpoints<1> single;
+  ASSERT_EQ(single.next(UINT64_MAX), 0);
+}
\ No newline at end of file
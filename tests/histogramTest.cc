@@ -0,0 +1,74 @@
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <unistd.h>
+
+#include <histogram.hpp>
+
+TEST(GasPriceHistogram, record) {
+  static GasPriceHistogram<4> histogram;
+
+  ASSERT_TRUE(histogram.record(100000000000));
+  ASSERT_TRUE(histogram.record(100000000000));
+  ASSERT_TRUE(histogram.record(0, 5));
+  ASSERT_TRUE(histogram.record(123456789012));
+  ASSERT_TRUE(histogram.record(1));
+  ASSERT_FALSE(histogram.record(2));
+
+  ASSERT_EQ(histogram.count(100000000000), 2UL);
+  ASSERT_EQ(histogram.count(0), 5UL);
+  ASSERT_EQ(histogram.count(2), 0UL);
+  ASSERT_EQ(histogram.samples(), 9UL);
+  ASSERT_EQ(histogram.size(), 4UL);
+}
+
+TEST(GasPriceHistogram, top) {
+  static GasPriceHistogram<16> histogram;
+
+  histogram.record(300, 1);
+  histogram.record(100, 3);
+  histogram.record(200, 3);
+  histogram.record(400, 7);
+
+  auto top = histogram.top(3);
+  ASSERT_EQ(top.size(), 3UL);
+  ASSERT_EQ(top[0].first, 400UL);
+  ASSERT_EQ(top[0].second, 7UL);
+  ASSERT_EQ(top[1].first, 100UL);
+  ASSERT_EQ(top[1].second, 3UL);
+  ASSERT_EQ(top[2].first, 200UL);
+  ASSERT_EQ(top[2].second, 3UL);
+
+  ASSERT_EQ(histogram.top(10).size(), 4UL);
+}
+
+TEST(GasPriceHistogram, saveAndLoad) {
+  static GasPriceHistogram<16> histogram;
+  static GasPriceHistogram<16> loadedHistogram;
+
+  histogram.record(100, 3);
+  histogram.record(200, 1);
+
+  char path[] = "/tmp/gasPriceHistogramXXXXXX";
+  close(mkstemp(path));
+
+  ASSERT_TRUE(histogram.save(path));
+  ASSERT_TRUE(loadedHistogram.load(path));
+  ASSERT_EQ(loadedHistogram.count(100), 3UL);
+  ASSERT_EQ(loadedHistogram.count(200), 1UL);
+  ASSERT_EQ(loadedHistogram.samples(), 4UL);
+
+  remove(path);
+  ASSERT_FALSE(loadedHistogram.load(path));
+}
+
+TEST(GasPriceHistogram, allocateGasPrices) {
+  static GasPriceHistogram<16> histogram;
+
+  histogram.record(150, 1);
+  histogram.record(250, 2);
+
+  ASSERT_THAT(allocateGasPrices(histogram, 5, 100, 400), ::testing::ElementsAre(250, 150, 100, 250, 400));
+  ASSERT_THAT(allocateGasPrices(histogram, 3, 100, 400), ::testing::ElementsAre(250, 150, 100));
+  ASSERT_THAT(allocateGasPrices(histogram, 1, 100, 400), ::testing::ElementsAre(250));
+}
\ No newline at end of file
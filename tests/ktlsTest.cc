@@ -0,0 +1,216 @@
+#include <gmock/gmock.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/ec.h>
+#include <openssl/x509.h>
+
+#include <ktls.hpp>
+#include <websocket.hpp>
+
+// Loopback TLS stand-in server with self-signed certificate
+
+static SSL_CTX *serverContext() {
+  EVP_PKEY *key = EVP_EC_gen("P-256");
+  X509 *certificate = X509_new();
+  ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+  X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+  X509_gmtime_adj(X509_getm_notAfter(certificate), 3600);
+  X509_set_pubkey(certificate, key);
+
+  X509_NAME *name = X509_get_subject_name(certificate);
+  X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  X509_set_issuer_name(certificate, name);
+  X509_sign(certificate, key, EVP_sha256());
+
+  SSL_CTX *context = SSL_CTX_new(TLS_server_method());
+  SSL_CTX_use_certificate(context, certificate);
+  SSL_CTX_use_PrivateKey(context, key);
+
+  X509_free(certificate);
+  EVP_PKEY_free(key);
+  return context;
+}
+
+static void connectLoopback(int &clientFd, int &serverFd) {
+  int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addressLength = sizeof(address);
+  bind(listenFd, reinterpret_cast<sockaddr*>(&address), addressLength);
+  listen(listenFd, 1);
+  getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength);
+
+  clientFd = socket(AF_INET, SOCK_STREAM, 0);
+  connect(clientFd, reinterpret_cast<sockaddr*>(&address), addressLength);
+  serverFd = accept(listenFd, nullptr, nullptr);
+  close(listenFd);
+}
+
+TEST(KernelTLS, session) {
+  int clientFd, serverFd;
+  connectLoopback(clientFd, serverFd);
+
+  SSL_CTX *context = serverContext();
+  std::string received;
+  bool accepted = false;
+
+  std::thread server([&]() {
+    SSL *ssl = SSL_new(context);
+    SSL_set_fd(ssl, serverFd);
+    accepted = SSL_accept(ssl) == 1;
+
+    // Two records, the second one is decrypted from what is left fed in
+    SSL_write(ssl, "hello ", 6);
+    SSL_write(ssl, "over TLS", 8);
+
+    char buffer[64];
+    int count;
+    while((count = SSL_read(ssl, buffer, sizeof(buffer))) > 0) received.append(buffer, count);
+
+    SSL_free(ssl);
+    close(serverFd);
+  });
+
+  KernelTLS::Session session;
+  KernelTLS::Status status = session.connect(clientFd, "localhost");
+  ASSERT_NE(status, KernelTLS::Status::Failed);
+  ASSERT_TRUE(session.isOpen());
+
+  // Output smaller than the records, the rest stays pending
+  std::string plaintext;
+  char records[4096], output[4];
+  while(plaintext.size() < 14) {
+    std::size_t decrypted;
+    ssize_t count = recv(clientFd, records, sizeof(records), 0);
+    ASSERT_GT(count, 0);
+
+    ASSERT_TRUE(session.decrypt(records, count, output, sizeof(output), decrypted));
+    plaintext.append(output, decrypted);
+
+    while(decrypted != 0 && session.hasPending()) {
+      ASSERT_TRUE(session.decrypt(nullptr, 0, output, sizeof(output), decrypted));
+      plaintext.append(output, decrypted);
+    }
+  }
+
+  ASSERT_EQ(plaintext, "hello over TLS");
+
+  // Offloaded sends are plain writes of plaintext
+  if(status == KernelTLS::Status::Offloaded) {
+    ASSERT_EQ(send(clientFd, "ping", 4, 0), 4);
+  }
+
+  shutdown(clientFd, SHUT_RDWR);
+  server.join();
+  close(clientFd);
+  SSL_CTX_free(context);
+
+  ASSERT_TRUE(accepted);
+  ASSERT_EQ(received, status == KernelTLS::Status::Offloaded ? "ping" : "");
+}
+
+TEST(KernelTLS, handshakeFailure) {
+  int clientFd, serverFd;
+  connectLoopback(clientFd, serverFd);
+
+  // Not a TLS server
+  ASSERT_EQ(send(serverFd, "HTTP/1.1 400 Bad Request\r\n\r\n", 28, 0), 28);
+  close(serverFd);
+
+  KernelTLS::Session session;
+  ASSERT_EQ(session.connect(clientFd, "localhost"), KernelTLS::Status::Failed);
+  close(clientFd);
+}
+
+TEST(KernelTLS, webSocketClient) {
+  static WebSocket::Client<4096, 256, 4> client;
+
+  int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addressLength = sizeof(address);
+  bind(listenFd, reinterpret_cast<sockaddr*>(&address), addressLength);
+  listen(listenFd, 1);
+  getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength);
+
+  SSL_CTX *context = serverContext();
+  std::string reply;
+
+  std::thread server([&]() {
+    int fd = accept(listenFd, nullptr, nullptr);
+    SSL *ssl = SSL_new(context);
+    SSL_set_fd(ssl, fd);
+
+    std::string request;
+    char buffer[1024];
+    int count = 0;
+    if(SSL_accept(ssl) == 1) {
+      while(request.find("\r\n\r\n") == std::string::npos && (count = SSL_read(ssl, buffer, sizeof(buffer))) > 0) request.append(buffer, count);
+    }
+
+    // Kernel TLS is unavailable, the client gives up after TLS handshake
+    if(count > 0) {
+      char accept[WebSocket::AcceptLength + 1];
+      WebSocket::acceptKey(request.c_str() + request.find("Sec-WebSocket-Key: ") + 19, accept);
+      std::string response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: " + std::string(accept) + "\r\n\r\n";
+
+      char header[WebSocket::MaxHeaderLength];
+      response.append(header, WebSocket::encodeHeader(WebSocket::Text, 5, nullptr, header)).append("hello");
+      SSL_write(ssl, response.data(), response.size());
+
+      // Masked reply, then close
+      while((count = SSL_read(ssl, buffer, sizeof(buffer))) > 0) {
+        reply.append(buffer, count);
+        WebSocket::Frame frame;
+        std::size_t headerLength = WebSocket::parseHeader(reply.data(), reply.size(), frame);
+        if(headerLength != 0 && reply.size() >= headerLength + frame.payloadLength) {
+          WebSocket::mask(reply.data() + headerLength, frame.payloadLength, frame.maskKey, reply.data() + headerLength);
+          reply = reply.substr(headerLength, frame.payloadLength);
+          break;
+        }
+      }
+
+      std::string closeFrame = std::string(header, WebSocket::encodeHeader(WebSocket::Close, 2, nullptr, header)) + "\x03\xe8";
+      SSL_write(ssl, closeFrame.data(), closeFrame.size());
+      while(SSL_read(ssl, buffer, sizeof(buffer)) > 0);
+    }
+
+    SSL_free(ssl);
+    close(fd);
+  });
+
+  bool connected = client.connect(("wss://127.0.0.1:" + std::to_string(ntohs(address.sin_port))).c_str(), nullptr, 60000);
+  std::vector<std::string> messages;
+  if(connected) {
+    client.run(
+      [&messages](char *message, std::size_t length) {
+        messages.emplace_back(message, length);
+        client.send("reply", 5);
+      },
+      []() {}
+    );
+  }
+
+  server.join();
+  close(listenFd);
+  SSL_CTX_free(context);
+
+  if(!connected) {
+    ASSERT_TRUE(client.isKernelTLSUnavailable());
+    GTEST_SKIP() << "Kernel TLS is unavailable";
+  }
+
+  ASSERT_THAT(messages, testing::ElementsAre("hello"));
+  ASSERT_EQ(reply, "reply");
+  ASSERT_EQ(client.getCloseCode(), WebSocket::Normal);
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include <config.hpp>
+#include <bot.hpp>
+#include <match.hpp>
+#include <uint256.hpp>
+#include <uniswap.hpp>
+
+static const std::string Input = "0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb";
+
+static std::string message(const std::string &input, const std::string &value) {
+  return "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"" + input + "\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x" + value + "\",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+}
+
+TEST(Match, calculateAmountOutMin) {
+  const UInt256 value = UInt256::fromHexString("de0b6b3a7640000");
+  Utils::Byte output[32], expected[32];
+
+  Match::calculateAmountOutMin(value, message(Input, "46114844c27ec9").c_str(), output);
+  UniswapV2::getAmountOutMin(value, UInt256(0x46114844c27ec9), UInt256(0x1e4324d), Config::Transaction::SwapExactETHForTokens::SlippageBasisPoints).toBuffer(expected);
+  ASSERT_EQ(memcmp(output, expected, 32), 0);
+
+  // Liquidity that cannot be priced (malformed or zero) keeps the configured minimum
+  UInt256::fromHexString(Config::Transaction::SwapExactETHForTokens::AmountOutMin).toBuffer(expected);
+
+  std::string malformed = Input;
+  malformed[BloXrouteMessageParser::AmountTokenDesiredPosition - BloXrouteMessageParser::InputPosition + 60] = 'z';
+  UInt256 liquidityETH, liquidityToken;
+  ASSERT_FALSE(Match::extractLiquidity(message(malformed, "46114844c27ec9").c_str(), liquidityETH, liquidityToken));
+  Match::calculateAmountOutMin(value, message(malformed, "46114844c27ec9").c_str(), output);
+  ASSERT_EQ(memcmp(output, expected, 32), 0);
+
+  Match::calculateAmountOutMin(value, message(Input, "0").c_str(), output);
+  ASSERT_EQ(memcmp(output, expected, 32), 0);
+}
\ No newline at end of file
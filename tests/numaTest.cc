@@ -0,0 +1,127 @@
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <numa.hpp>
+
+/**
+ * @brief Writes file in fake sysfs or procfs tree.
+ */
+static void writeFile(const std::string &path, const char *content) {
+  FILE *file = fopen(path.c_str(), "w");
+  fputs(content, file);
+  fclose(file);
+}
+
+TEST(Numa, parseList) {
+  std::vector<int> values;
+  ASSERT_TRUE(Numa::parseList("0-3,8,10-11\n", values));
+  ASSERT_EQ(values, (std::vector<int> { 0, 1, 2, 3, 8, 10, 11 }));
+
+  values.clear();
+  ASSERT_TRUE(Numa::parseList("5", values));
+  ASSERT_EQ(values, (std::vector<int> { 5 }));
+
+  values.clear();
+  ASSERT_TRUE(Numa::parseList("\n", values));
+  ASSERT_TRUE(values.empty());
+
+  for(const char *malformed : { "a", "1-", "3-1", "1,,2", "1;2", "-1" }) {
+    values.clear();
+    ASSERT_FALSE(Numa::parseList(malformed, values)) << malformed;
+  }
+}
+
+TEST(Numa, formatList) {
+  ASSERT_EQ(Numa::formatList({ 0, 1, 2, 3, 8, 10, 11 }), "0-3,8,10-11");
+  ASSERT_EQ(Numa::formatList({ 4 }), "4");
+  ASSERT_EQ(Numa::formatList({}), "");
+}
+
+TEST(Numa, discovery) {
+  char root[] = "/tmp/numaTestXXXXXX";
+  ASSERT_NE(mkdtemp(root), nullptr);
+  const std::string base = root;
+
+  // Default route is the one with zero destination and mask
+  writeFile(base + "/route",
+    "Iface\tDestination\tGateway \tFlags\tRefCnt\tUse\tMetric\tMask\t\tMTU\tWindow\tIRTT\n"
+    "eth1\t0000A8C0\t00000000\t0001\t0\t0\t0\t00FFFFFF\t0\t0\t0\n"
+    "eth0\t00000000\t0100A8C0\t0003\t0\t0\t0\t00000000\t0\t0\t0\n"
+  );
+  ASSERT_EQ(Numa::defaultInterface((base + "/route").c_str()), "eth0");
+  writeFile(base + "/route", "Iface\tDestination\tGateway \tFlags\tRefCnt\tUse\tMetric\tMask\t\tMTU\tWindow\tIRTT\n");
+  ASSERT_EQ(Numa::defaultInterface((base + "/route").c_str()), "");
+  ASSERT_EQ(Numa::defaultInterface((base + "/missing").c_str()), "");
+
+  // Physical interface has its node, virtual one has none (or -1 on machines without NUMA)
+  mkdir((base + "/net").c_str(), 0700);
+  mkdir((base + "/net/eth0").c_str(), 0700);
+  mkdir((base + "/net/eth0/device").c_str(), 0700);
+  writeFile(base + "/net/eth0/device/numa_node", "1\n");
+  mkdir((base + "/net/eth1").c_str(), 0700);
+  mkdir((base + "/net/eth1/device").c_str(), 0700);
+  writeFile(base + "/net/eth1/device/numa_node", "-1\n");
+  mkdir((base + "/net/lo").c_str(), 0700);
+
+  ASSERT_EQ(Numa::interfaceNode("eth0", (base + "/net").c_str()), 1);
+  ASSERT_EQ(Numa::interfaceNode("eth1", (base + "/net").c_str()), Numa::UnknownNode);
+  ASSERT_EQ(Numa::interfaceNode("lo", (base + "/net").c_str()), Numa::UnknownNode);
+
+  mkdir((base + "/node").c_str(), 0700);
+  mkdir((base + "/node/node1").c_str(), 0700);
+  writeFile(base + "/node/node1/cpulist", "8-11,24-27\n");
+
+  ASSERT_EQ(Numa::nodeCpus(1, (base + "/node").c_str()), (std::vector<int> { 8, 9, 10, 11, 24, 25, 26, 27 }));
+  ASSERT_TRUE(Numa::nodeCpus(0, (base + "/node").c_str()).empty());
+  ASSERT_TRUE(Numa::nodeCpus(Numa::UnknownNode, (base + "/node").c_str()).empty());
+
+  for(const char *path : {
+    "/route", "/net/eth0/device/numa_node", "/net/eth0/device", "/net/eth0", "/net/eth1/device/numa_node", "/net/eth1/device", "/net/eth1",
+    "/net/lo", "/net", "/node/node1/cpulist", "/node/node1", "/node", ""
+  }) {
+    remove((base + path).c_str());
+  }
+}
+
+TEST(Numa, placement) {
+  std::vector<int> cpus = Numa::nodeCpus(0);
+  if(cpus.empty()) GTEST_SKIP() << "NUMA node 0 is not exposed";
+
+  // Unknown node leaves everything as it was
+  ASSERT_TRUE(Numa::pinThread({}));
+  ASSERT_TRUE(Numa::preferNode(Numa::UnknownNode));
+
+  Numa::Topology unknown;
+  ASSERT_FALSE(unknown.isKnown());
+
+  // Memory on the node is zeroed and usable, already touched memory can be moved
+  const std::size_t length = 3 * sysconf(_SC_PAGESIZE) + 100;
+  char *memory = static_cast<char*>(Numa::allocate(length, 0));
+  ASSERT_NE(memory, nullptr);
+  for(std::size_t i = 0; i < length; i++) ASSERT_EQ(memory[i], 0);
+  memset(memory, 0xab, length);
+  ASSERT_TRUE(Numa::moveMemory(memory + 10, length - 20, 0));
+  ASSERT_EQ(static_cast<unsigned char>(memory[length - 1]), 0xab);
+  Numa::release(memory, length);
+
+  ASSERT_TRUE(Numa::preferNode(0));
+  ASSERT_TRUE(Numa::preferLocal());
+
+  cpu_set_t original;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(original), &original), 0);
+  ASSERT_TRUE(Numa::pinThread(cpus));
+
+  cpu_set_t pinned;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(pinned), &pinned), 0);
+  ASSERT_EQ(CPU_COUNT(&pinned), static_cast<int>(cpus.size()));
+  for(int cpu : cpus) ASSERT_TRUE(CPU_ISSET(cpu, &pinned));
+
+  pthread_setaffinity_np(pthread_self(), sizeof(original), &original);
+}
\ No newline at end of file
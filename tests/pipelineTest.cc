@@ -0,0 +1,79 @@
+#include <gmock/gmock.h>
+
+#include <pipeline.hpp>
+#include <pregen.hpp>
+
+TEST(Pipeline, stageStats) {
+  Pipeline::StageStats stats;
+
+  stats.record(100, 300);
+  stats.record(1000, 1100);
+  stats.record(50, 50);
+
+  ASSERT_EQ(stats.count.load(), 3UL);
+  ASSERT_EQ(stats.averageNs(), 100UL);
+  ASSERT_EQ(stats.maxNs.load(), 200UL);
+}
+
+// Checked against Transaction.signWith62bitRS test
+TEST(Pipeline, signerPool) {
+  Pipeline::SignerPool<4, Config::Size::BloXrouteTransactionMessageString> pool;
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  pool.start(2, -1, [&privateKey](Transaction &tx, Pipeline::SignRequest &request, char *output) {
+    tx.setField(Transaction::Field::Nonce, "0");
+    tx.setField(Transaction::Field::GasLimit, "7C6D");
+    tx.setField(Transaction::Field::To, "F0109fC8DF283027b6285cc889F5aA624EaC1F55");
+    tx.setField(Transaction::Field::Data, "");
+    tx.setField(Transaction::Field::Value, "0");
+    return PreGen::generate(tx, privateKey, request.gasPrice, output);
+  });
+
+  Pipeline::SignRequest request {};
+  for(std::size_t wallet = 0; wallet < 6; wallet++) {
+    request.wallet = wallet;
+    request.receivedAt = Pipeline::now();
+    ASSERT_TRUE(pool.submit(request));
+  }
+
+  std::size_t received = 0;
+  bool wallets[6] = {};
+  while(received < 6) {
+    received += pool.drain([&wallets](const auto &signedMessage) {
+      ASSERT_STREQ(signedMessage.message, "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"f85d8080827c6d94f0109fc8df283027b6285cc889f5aa624eac1f558080269f22f17b38af35286ffbb0c6376c86ec91c20ecbad93f84913a0cc15e7580cd99f83d6e12e82e3544cb4439964d5087da78f74cefeec9a450b16ae179fd8fe20\"}}");
+      ASSERT_EQ(signedMessage.length, 238UL);
+      wallets[signedMessage.wallet] = true;
+    });
+  }
+
+  for(bool wallet : wallets) ASSERT_TRUE(wallet);
+  ASSERT_EQ(pool.signing.count.load(), 6UL);
+  ASSERT_EQ(pool.total.count.load(), 6UL);
+  ASSERT_EQ(pool.resultsDepth(), 0UL);
+
+  pool.stop();
+}
+
+TEST(Pipeline, submitFull) {
+  Pipeline::SignerPool<2, 32> pool;
+
+  // Signers wait until released, so queues fill up
+  std::atomic<bool> released { false };
+  pool.start(1, -1, [&released](Transaction &, Pipeline::SignRequest &, char *) -> std::size_t {
+    while(!released.load()) std::this_thread::yield();
+    return 0;
+  });
+
+  Pipeline::SignRequest request {};
+  std::size_t submitted = 0;
+  while(pool.submit(request)) submitted++;
+
+  // Queue capacity, plus the request being signed
+  ASSERT_GE(submitted, 2UL);
+  ASSERT_LE(submitted, 3UL);
+
+  released.store(true);
+  pool.stop();
+}
\ No newline at end of file
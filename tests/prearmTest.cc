@@ -0,0 +1,106 @@
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include <prearm.hpp>
+
+static constexpr char Deployer[] = "6ac7ea33f8831ea9dcc53393aaa88b25a785dbf0";
+static constexpr char Other[] = "64177643cf0e8e96dd0205983aadeafbd871dfc9";
+static constexpr char Token[] = "dac17f958d2ee523a2206206994597c13d831ec7";
+static constexpr char Target[] = "48bef6bd05bd23b5e6800cf0406e524b517af250";
+static constexpr char WrappedNative[] = "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2";
+static constexpr char Router[] = "7a250d5630b4cf539739df2c5dacb4c659f2488d";
+static constexpr char Factory[] = "5c69bee701ef814a2b6a3edd4b1652cb9cc5aa6f";
+
+static std::string word(const char *address) {
+  return std::string(24, '0') + address;
+}
+
+static std::string message(const std::string &input, const char *from, const char *nonce, const std::string &to) {
+  return "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0x" + input + "\",\"gasPrice\":\"0x174876e800\",\"value\":\"0x0\",\"from\":\"0x" + from + "\",\"nonce\":\"0x" + nonce + "\",\"to\":" + to + "}}}}";
+}
+
+static std::string address(const char *value) {
+  return std::string("\"0x") + value + "\"";
+}
+
+TEST(PreArm, contractAddress) {
+  char output[41];
+
+  PreArm::contractAddress(Deployer, 0, output);
+  ASSERT_STREQ(output, "cd234a471b72ba2f1ccf0a70fcaba648a5eecd8d");
+
+  PreArm::contractAddress(Deployer, 1, output);
+  ASSERT_STREQ(output, "343c43a37d37dff08ae8c4a11544c718abb4fcf8");
+}
+
+TEST(PreArm, deployment) {
+  PreArm::Watcher watcher;
+  watcher.init(Deployer, Config::Router::UniswapV2);
+  char token[41];
+
+  // Created contract is derived from the deployer and nonce
+  ASSERT_EQ(watcher.detect(message("6080604052", Deployer, "1", "null").c_str(), Target, token), PreArm::Signal::Deployment);
+  ASSERT_STREQ(token, "343c43a37d37dff08ae8c4a11544c718abb4fcf8");
+
+  ASSERT_EQ(watcher.detect(message("6080604052", Other, "1", "null").c_str(), Target, token), PreArm::Signal::None);
+  ASSERT_EQ(watcher.detect(message("", Deployer, "2", address(Other)).c_str(), Target, token), PreArm::Signal::None);
+
+  // Stream messages lack the receiver
+  std::string streamMessage = message("6080604052", Deployer, "1", "null");
+  streamMessage.erase(streamMessage.find(",\"to\":null"), 10);
+  ASSERT_EQ(watcher.detect(streamMessage.c_str(), Target, token), PreArm::Signal::None);
+
+  // Deployments are not watched without the deployer
+  watcher.init("", Config::Router::UniswapV2);
+  ASSERT_EQ(watcher.detect(message("6080604052", Deployer, "1", "null").c_str(), Target, token), PreArm::Signal::None);
+}
+
+TEST(PreArm, approve) {
+  PreArm::Watcher watcher;
+  watcher.init(Deployer, Config::Router::UniswapV2);
+  char token[41];
+
+  std::string input = std::string(ABI::Selector::Approve) + word(Router) + std::string(64, 'f');
+  ASSERT_EQ(watcher.detect(message(input, Deployer, "2", address("DAC17F958D2EE523A2206206994597C13D831EC7")).c_str(), Target, token), PreArm::Signal::Approve);
+  ASSERT_STREQ(token, Token);
+
+  // Other spender or sender
+  ASSERT_EQ(watcher.detect(message(std::string(ABI::Selector::Approve) + word(Other) + std::string(64, 'f'), Deployer, "2", address(Token)).c_str(), Target, token), PreArm::Signal::None);
+  ASSERT_EQ(watcher.detect(message(input, Other, "2", address(Token)).c_str(), Target, token), PreArm::Signal::None);
+}
+
+TEST(PreArm, createPair) {
+  PreArm::Watcher watcher;
+  watcher.init(Deployer, Config::Router::UniswapV2);
+  char token[41];
+
+  // Pair with wrapped native in either order, by the deployer
+  ASSERT_EQ(watcher.detect(message(std::string(ABI::Selector::CreatePair) + word(Token) + word(WrappedNative), Deployer, "3", address(Factory)).c_str(), Target, token), PreArm::Signal::CreatePair);
+  ASSERT_STREQ(token, Token);
+  ASSERT_EQ(watcher.detect(message(std::string(ABI::Selector::CreatePair) + word(WrappedNative) + word(Token), Deployer, "3", address(Factory)).c_str(), Target, token), PreArm::Signal::CreatePair);
+  ASSERT_STREQ(token, Token);
+
+  // By anyone for the target only
+  ASSERT_EQ(watcher.detect(message(std::string(ABI::Selector::CreatePair) + word(Token) + word(WrappedNative), Other, "3", address(Factory)).c_str(), Target, token), PreArm::Signal::None);
+  ASSERT_EQ(watcher.detect(message(std::string(ABI::Selector::CreatePair) + word(Target) + word(WrappedNative), Other, "3", address(Factory)).c_str(), Target, token), PreArm::Signal::CreatePair);
+  ASSERT_STREQ(token, Target);
+
+  // Pair without wrapped native, other factory
+  ASSERT_EQ(watcher.detect(message(std::string(ABI::Selector::CreatePair) + word(Token) + word(Target), Deployer, "3", address(Factory)).c_str(), Target, token), PreArm::Signal::None);
+  ASSERT_EQ(watcher.detect(message(std::string(ABI::Selector::CreatePair) + word(Token) + word(WrappedNative), Deployer, "3", address(Other)).c_str(), Target, token), PreArm::Signal::None);
+}
+
+TEST(PreArm, subscribe) {
+  ASSERT_STREQ(
+    PreArm::subscribe(Deployer, Factory).value,
+    "{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":[\"tx_contents.input\",\"tx_contents.gas_price\",\"tx_contents.value\",\"tx_contents.max_fee_per_gas\",\"tx_contents.max_priority_fee_per_gas\",\"tx_contents.from\",\"tx_contents.nonce\",\"tx_contents.to\"],"
+    "\"filters\":\"from = 0x6ac7ea33f8831ea9dcc53393aaa88b25a785dbf0 or (to = 0x5c69bee701ef814a2b6a3edd4b1652cb9cc5aa6f and method_id = c9c65396)\"}]}"
+  );
+
+  ASSERT_STREQ(
+    PreArm::subscribe("", Factory).value,
+    "{\"method\":\"subscribe\",\"params\":[\"newTxs\",{\"include\":[\"tx_contents.input\",\"tx_contents.gas_price\",\"tx_contents.value\",\"tx_contents.max_fee_per_gas\",\"tx_contents.max_priority_fee_per_gas\",\"tx_contents.from\",\"tx_contents.nonce\",\"tx_contents.to\"],"
+    "\"filters\":\"to = 0x5c69bee701ef814a2b6a3edd4b1652cb9cc5aa6f and method_id = c9c65396\"}]}"
+  );
+}
\ No newline at end of file
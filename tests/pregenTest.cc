@@ -0,0 +1,360 @@
+#include <gmock/gmock.h>
+
+#include <unistd.h>
+
+#include <pregen.hpp>
+
+using TestStore = PreGen::Store<4, 32>;
+
+TEST(PreGen, insert) {
+  static TestStore store;
+
+  ASSERT_TRUE(store.insert(300, "c", 1));
+  ASSERT_TRUE(store.insert(100, "a", 1));
+  ASSERT_TRUE(store.insert(200, "b", 1));
+  ASSERT_EQ(store.size(), 3UL);
+
+  // Replacing does not take new slot
+  ASSERT_TRUE(store.insert(200, "bb", 2));
+  ASSERT_EQ(store.size(), 3UL);
+  ASSERT_STREQ(store.find(200)->message, "bb");
+  ASSERT_EQ(store.find(200)->length, 2UL);
+
+  ASSERT_TRUE(store.insert(50, "z", 1));
+  ASSERT_TRUE(store.full());
+  ASSERT_FALSE(store.insert(400, "d", 1));
+
+  // Message has to fit with null terminator
+  store.clear();
+  ASSERT_FALSE(store.insert(100, "0123456789012345678901234567890123456789", 40));
+}
+
+TEST(PreGen, find) {
+  static TestStore store;
+  store.insert(300, "c", 1);
+  store.insert(100, "a", 1);
+  store.insert(200, "b", 1);
+
+  ASSERT_TRUE(store.contains(100));
+  ASSERT_FALSE(store.contains(150));
+  ASSERT_STREQ(store.find(100)->message, "a");
+  ASSERT_STREQ(store.find(300)->message, "c");
+  ASSERT_EQ(store.find(150), nullptr);
+  ASSERT_EQ(store.find(301), nullptr);
+}
+
+TEST(PreGen, findAtOrAbove) {
+  static TestStore store;
+  store.insert(300, "c", 1);
+  store.insert(100, "a", 1);
+  store.insert(200, "b", 1);
+
+  ASSERT_STREQ(store.findAtOrAbove(100, 0)->message, "a");
+  ASSERT_STREQ(store.findAtOrAbove(101, 99)->message, "b");
+  ASSERT_STREQ(store.findAtOrAbove(0, 1000)->message, "a");
+  ASSERT_EQ(store.findAtOrAbove(101, 98), nullptr);
+  ASSERT_EQ(store.findAtOrAbove(301, 1000), nullptr);
+}
+
+TEST(PreGen, lookup) {
+  static TestStore store;
+  store.insert(100, "a", 1);
+  store.insert(200, "b", 1);
+
+  ASSERT_STREQ(store.lookup(100, Config::TransactionPreGen::MissPolicy::SignOnDemand, 1000)->message, "a");
+  ASSERT_EQ(store.lookup(150, Config::TransactionPreGen::MissPolicy::SignOnDemand, 1000), nullptr);
+  ASSERT_STREQ(store.lookup(150, Config::TransactionPreGen::MissPolicy::NearestAbove, 1000)->message, "b");
+  ASSERT_EQ(store.lookup(150, Config::TransactionPreGen::MissPolicy::NearestAbove, 10), nullptr);
+}
+
+// Checked against Transaction.signWith62bitRS test
+TEST(PreGen, generate) {
+  static PreGen::Store<1, Config::Size::BloXrouteTransactionMessageString> store;
+  Transaction tx;
+
+  tx.setField(Transaction::Field::Nonce, "0");
+  tx.setField(Transaction::Field::GasLimit, "7C6D");
+  tx.setField(Transaction::Field::To, "F0109fC8DF283027b6285cc889F5aA624EaC1F55");
+  tx.setField(Transaction::Field::Data, "");
+  tx.setField(Transaction::Field::Value, "0");
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  ASSERT_TRUE(PreGen::generate(store, tx, privateKey, 0));
+
+  const auto *entry = store.find(0);
+  ASSERT_NE(entry, nullptr);
+  ASSERT_STREQ(entry->message, "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"f85d8080827c6d94f0109fc8df283027b6285cc889f5aa624eac1f558080269f22f17b38af35286ffbb0c6376c86ec91c20ecbad93f84913a0cc15e7580cd99f83d6e12e82e3544cb4439964d5087da78f74cefeec9a450b16ae179fd8fe20\"}}");
+  ASSERT_EQ(entry->length, 238UL);
+}
+
+TEST(PreGen, rebuildIndex) {
+  static TestStore store;
+  store.insert(100, "x", 1);
+
+  const char *messages[] = { "c", "a", "b" };
+  const std::uint64_t gasPrices[] = { 300, 100, 200 };
+  for(std::size_t i = 0; i < 3; i++) {
+    auto *entry = store.slot(i);
+    entry->gasPrice = gasPrices[i];
+    entry->length = 1;
+    strcpy(entry->message, messages[i]);
+  }
+  store.rebuildIndex(3);
+
+  ASSERT_EQ(store.size(), 3UL);
+  ASSERT_STREQ(store.find(100)->message, "a");
+  ASSERT_STREQ(store.find(200)->message, "b");
+  ASSERT_STREQ(store.findAtOrAbove(201, 1000)->message, "c");
+}
+
+TEST(PreGen, generateParallel) {
+  static PreGen::Store<64, Config::Size::BloXrouteTransactionMessageString> store;
+
+  auto setup = [](Transaction &tx) {
+    tx.setField(Transaction::Field::Nonce, "0");
+    tx.setField(Transaction::Field::GasLimit, "7C6D");
+    tx.setField(Transaction::Field::To, "F0109fC8DF283027b6285cc889F5aA624EaC1F55");
+    tx.setField(Transaction::Field::Data, "");
+    tx.setField(Transaction::Field::Value, "0");
+  };
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  std::vector<std::uint64_t> gasPrices;
+  for(std::uint64_t i = 0; i < 50; i++) gasPrices.push_back((50 - i) * 1000000000);
+  gasPrices.push_back(0);
+  gasPrices.push_back(0);
+
+  ASSERT_EQ(PreGen::generateParallel(store, gasPrices, privateKey, setup, 4), 51UL);
+  ASSERT_EQ(store.size(), 51UL);
+
+  // Every message matches the one signed on a single thread
+  Transaction tx;
+  setup(tx);
+  char message[Config::Size::BloXrouteTransactionMessageString];
+  for(std::uint64_t gasPrice : gasPrices) {
+    std::size_t messageLength = PreGen::generate(tx, privateKey, gasPrice, message);
+    const auto *entry = store.find(gasPrice);
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->length, messageLength);
+    ASSERT_EQ(memcmp(entry->message, message, messageLength), 0);
+  }
+
+  // Gas prices exceeding capacity are dropped, the highest ones first
+  for(std::uint64_t i = 0; i < 20; i++) gasPrices.push_back(1000000000000 + i);
+  ASSERT_EQ(PreGen::generateParallel(store, gasPrices, privateKey, setup), 64UL);
+  ASSERT_NE(store.find(50000000000), nullptr);
+  ASSERT_EQ(store.find(1000000000019), nullptr);
+}
+
+static void setupCompact(Transaction &tx) {
+  tx.setField(Transaction::Field::Nonce, "0");
+  tx.setField(Transaction::Field::GasLimit, "7C6D");
+  tx.setField(Transaction::Field::To, "F0109fC8DF283027b6285cc889F5aA624EaC1F55");
+  tx.setField(Transaction::Field::Data, "7ff36ab5");
+  tx.setField(Transaction::Field::Value, "0");
+}
+
+TEST(PreGen, compactStore) {
+  static PreGen::CompactStore<4> store;
+  Transaction tx;
+  setupCompact(tx);
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  // Gas prices of different encoded lengths, assembled messages match the ones generated as a whole
+  const std::uint64_t gasPrices[] = { 0, 100, 1000000000, 500000000000 };
+  for(std::uint64_t gasPrice : gasPrices) ASSERT_TRUE(PreGen::generate(store, tx, privateKey, gasPrice));
+  ASSERT_TRUE(store.full());
+
+  char expected[Config::Size::BloXrouteTransactionMessageString];
+  char message[Config::Size::BloXrouteTransactionMessageString];
+  for(std::uint64_t gasPrice : gasPrices) {
+    std::size_t expectedLength = PreGen::generate(tx, privateKey, gasPrice, expected);
+    const auto *entry = store.find(gasPrice);
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->gasPrice, gasPrice);
+
+    std::size_t length = 0;
+    const char *output = store.message(*entry, message, length);
+    ASSERT_EQ(length, expectedLength);
+    ASSERT_STREQ(output, expected);
+  }
+
+  ASSERT_EQ(store.findAtOrAbove(101, 1000000000)->gasPrice, 1000000000UL);
+  ASSERT_EQ(store.lookup(150, Config::TransactionPreGen::MissPolicy::SignOnDemand, 1000000000), nullptr);
+
+  // Transaction of another nonce does not match the template
+  store.clear();
+  ASSERT_TRUE(PreGen::generate(store, tx, privateKey, 100));
+  tx.setField(Transaction::Field::Nonce, "1");
+  ASSERT_FALSE(PreGen::generate(store, tx, privateKey, 200));
+  ASSERT_EQ(store.size(), 1UL);
+}
+
+TEST(PreGen, compactGather) {
+  static PreGen::CompactStore<4> store;
+  Transaction tx;
+  setupCompact(tx);
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+  ASSERT_TRUE(PreGen::generate(store, tx, privateKey, 123456789));
+
+  const auto *entry = store.find(123456789);
+  iovec iov[PreGen::CompactStore<4>::GatherCount];
+  std::size_t length = store.gather(*entry, iov);
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_EQ(writev(fds[1], iov, PreGen::CompactStore<4>::GatherCount), static_cast<ssize_t>(length));
+
+  char gathered[Config::Size::BloXrouteTransactionMessageString] = {};
+  ASSERT_EQ(read(fds[0], gathered, sizeof(gathered)), static_cast<ssize_t>(length));
+  close(fds[0]);
+  close(fds[1]);
+
+  char assembled[Config::Size::BloXrouteTransactionMessageString];
+  ASSERT_EQ(store.assemble(*entry, assembled), length);
+  ASSERT_STREQ(gathered, assembled);
+}
+
+TEST(PreGen, generateParallelCompact) {
+  static PreGen::CompactStore<64> store;
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  std::vector<std::uint64_t> gasPrices;
+  for(std::uint64_t i = 0; i < 50; i++) gasPrices.push_back((50 - i) * 1000000000);
+  gasPrices.push_back(0);
+  gasPrices.push_back(0);
+
+  ASSERT_EQ(PreGen::generateParallel(store, gasPrices, privateKey, setupCompact, 4), 51UL);
+
+  Transaction tx;
+  setupCompact(tx);
+  char expected[Config::Size::BloXrouteTransactionMessageString];
+  char message[Config::Size::BloXrouteTransactionMessageString];
+  for(std::uint64_t gasPrice : gasPrices) {
+    std::size_t expectedLength = PreGen::generate(tx, privateKey, gasPrice, expected);
+    const auto *entry = store.find(gasPrice);
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(store.copy(*entry, message), expectedLength);
+    ASSERT_STREQ(message, expected);
+  }
+}
+
+TEST(PreGen, feeAxis) {
+  PreGen::FeeAxis axis { 100, 10, 5 };
+
+  ASSERT_EQ(axis.at(0), 100UL);
+  ASSERT_EQ(axis.at(4), 140UL);
+  ASSERT_EQ(axis.ceilIndex(0), 0UL);
+  ASSERT_EQ(axis.ceilIndex(100), 0UL);
+  ASSERT_EQ(axis.ceilIndex(101), 1UL);
+  ASSERT_EQ(axis.ceilIndex(110), 1UL);
+  ASSERT_EQ(axis.ceilIndex(140), 4UL);
+  ASSERT_EQ(axis.ceilIndex(141), 5UL);
+}
+
+TEST(PreGen, feeGrid) {
+  PreGen::FeeGrid grid;
+  grid.reset({ 100, 10, 3 }, { 1, 1, 2 }, 4);
+
+  ASSERT_EQ(grid.size(), 6UL);
+  for(std::size_t cell = 0; cell < grid.size(); cell++) {
+    char message[] = { static_cast<char>('a' + cell), '\0' };
+    ASSERT_TRUE(grid.set(cell, message, 1));
+  }
+  ASSERT_FALSE(grid.set(5, "long", 4));
+
+  // Exact match
+  PreGen::FeeGrid::Entry entry = grid.lookup(110, 2, Config::TransactionPreGen::MissPolicy::SignOnDemand, 0, 0);
+  ASSERT_STREQ(entry.message, "d");
+  ASSERT_EQ(entry.length, 1UL);
+  ASSERT_EQ(entry.maxFeePerGas, 110UL);
+  ASSERT_EQ(entry.maxPriorityFeePerGas, 2UL);
+  ASSERT_EQ(grid.lookup(111, 2, Config::TransactionPreGen::MissPolicy::SignOnDemand, 100, 100).message, nullptr);
+
+  // Nearest above on both axes, within bumps
+  entry = grid.lookup(101, 0, Config::TransactionPreGen::MissPolicy::NearestAbove, 9, 1);
+  ASSERT_STREQ(entry.message, "c");
+  ASSERT_EQ(grid.lookup(101, 0, Config::TransactionPreGen::MissPolicy::NearestAbove, 8, 1).message, nullptr);
+  ASSERT_EQ(grid.lookup(101, 0, Config::TransactionPreGen::MissPolicy::NearestAbove, 9, 0).message, nullptr);
+
+  // Out of grid and empty cell
+  ASSERT_EQ(grid.lookup(121, 1, Config::TransactionPreGen::MissPolicy::NearestAbove, 100, 100).message, nullptr);
+  ASSERT_EQ(grid.lookup(100, 3, Config::TransactionPreGen::MissPolicy::NearestAbove, 100, 100).message, nullptr);
+  ASSERT_EQ(grid.lookup(120, 2, Config::TransactionPreGen::MissPolicy::NearestAbove, 100, 100).message, nullptr);
+}
+
+TEST(PreGen, generateParallelFeeGrid) {
+  PreGen::FeeGrid grid;
+
+  auto setup = [](Transaction &tx) {
+    tx.setField(Transaction::Field::Nonce, "1a");
+    tx.setField(Transaction::Field::GasLimit, "30d40");
+    tx.setField(Transaction::Field::To, "7a250d5630B4cF539739dF2C5dAcb4c659F2488D");
+    tx.setField(Transaction::Field::Data, "7ff36ab5");
+    tx.setField(Transaction::Field::Value, "de0b6b3a7640000");
+  };
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  ASSERT_EQ(PreGen::generateParallel(grid, { 149000000000, 1000000000, 3 }, { 1000000000, 500000000, 3 }, privateKey, setup, 2), 9UL);
+  ASSERT_LT(grid.memoryUsage(), 9 * Config::Size::BloXrouteTransactionMessageString / 2);
+
+  // Checked against Transaction.signDynamicFee test
+  PreGen::FeeGrid::Entry entry = grid.lookup(150000000000, 2000000000, Config::TransactionPreGen::MissPolicy::SignOnDemand, 0, 0);
+  ASSERT_NE(entry.message, nullptr);
+  ASSERT_STREQ(entry.message, "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"02f878011a84773594008522ecb25c0083030d40947a250d5630b4cf539739df2c5dacb4c659f2488d880de0b6b3a7640000847ff36ab5c001a0891f646e342f309a79ca52bf9aae7ef6b315a081b2a99e5c1e85d0d353ced350a04c55f48df2d0f437dc83750b727f394fdf1aed646ed45173efab6e7e9f2ae980\"}}");
+}
+
+TEST(PreGen, doubleBuffer) {
+  static PreGen::DoubleBuffer<TestStore> stores;
+
+  stores.back().insert(100, "a", 1);
+  stores.publish();
+  ASSERT_STREQ(stores.acquire()->find(100)->message, "a");
+  stores.release();
+
+  stores.back().insert(200, "b", 1);
+  ASSERT_EQ(stores.acquire()->find(200), nullptr);
+  stores.release();
+
+  stores.publish();
+  ASSERT_STREQ(stores.acquire()->find(200)->message, "b");
+  ASSERT_EQ(stores.acquire()->find(100), nullptr);
+  stores.release();
+
+  ASSERT_STREQ(stores.back().find(100)->message, "a");
+
+  // Active store copied and extended in the back one
+  stores.back() = stores.front();
+  stores.back().insert(300, "c", 1);
+  ASSERT_EQ(stores.front().find(300), nullptr);
+  stores.publish();
+  ASSERT_STREQ(stores.acquire()->find(200)->message, "b");
+  ASSERT_STREQ(stores.acquire()->find(300)->message, "c");
+  stores.release();
+}
+
+TEST(PreGen, stats) {
+  PreGen::Stats stats;
+
+  stats.record(100000000000, 100000000000, true);
+  stats.record(100005000000, 100010000000, true);
+  stats.record(99000000000, 0, false);
+  stats.record(100010000000, 0, false);
+
+  ASSERT_EQ(stats.observed.load(), 4UL);
+  ASSERT_EQ(stats.exactHits.load(), 1UL);
+  ASSERT_EQ(stats.nearestHits.load(), 1UL);
+  ASSERT_EQ(stats.uniformGridHits.load(), 2UL);
+}
\ No newline at end of file
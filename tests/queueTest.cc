@@ -0,0 +1,64 @@
+#include <gmock/gmock.h>
+
+#include <thread>
+
+#include <queue.hpp>
+
+TEST(SPSCQueue, pushPop) {
+  SPSCQueue<int, 4> queue;
+  int item;
+
+  ASSERT_TRUE(queue.empty());
+  ASSERT_FALSE(queue.pop(item));
+
+  for(int i = 0; i < 4; i++) ASSERT_TRUE(queue.push(i));
+  ASSERT_FALSE(queue.push(4));
+  ASSERT_EQ(queue.size(), 4UL);
+
+  ASSERT_TRUE(queue.pop(item));
+  ASSERT_EQ(item, 0);
+  ASSERT_TRUE(queue.push(4));
+
+  for(int i = 1; i <= 4; i++) {
+    ASSERT_TRUE(queue.pop(item));
+    ASSERT_EQ(item, i);
+  }
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueue, frontDrop) {
+  SPSCQueue<int, 4> queue;
+
+  ASSERT_EQ(queue.front(), nullptr);
+
+  queue.push(1);
+  queue.push(2);
+  ASSERT_EQ(*queue.front(), 1);
+  ASSERT_EQ(queue.size(), 2UL);
+
+  queue.drop();
+  ASSERT_EQ(*queue.front(), 2);
+  queue.drop();
+  ASSERT_EQ(queue.front(), nullptr);
+}
+
+TEST(SPSCQueue, concurrent) {
+  static SPSCQueue<std::uint64_t, 64> queue;
+  constexpr std::uint64_t count = 100000;
+
+  std::thread producer([]() {
+    for(std::uint64_t i = 0; i < count; i++) {
+      while(!queue.push(i)) std::this_thread::yield();
+    }
+  });
+
+  // Items arrive complete and in order
+  std::uint64_t item;
+  for(std::uint64_t i = 0; i < count; i++) {
+    while(!queue.pop(item)) std::this_thread::yield();
+    ASSERT_EQ(item, i);
+  }
+
+  producer.join();
+  ASSERT_TRUE(queue.empty());
+}
\ No newline at end of file
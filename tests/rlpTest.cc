@@ -121,4 +121,68 @@ TEST(RLP, encodeList) {
   ASSERT_EQ(output[2], 0xb6);
   ASSERT_TRUE(memcmp(input[0].buffer, output + 3, 54) == 0);
   ASSERT_EQ(output[57], 0x80);
+}
+
+TEST(RLP, encodeEncodedItem) {
+  Utils::Byte emptyList[] = { 0xc0 };
+  Utils::Byte item[] = { 0x01 };
+  RLP::Item input[] = {{ .buffer = item, .length = 1 }, { .buffer = emptyList, .length = 1, .encoded = true }};
+  Utils::Byte output[16];
+
+  // Encoded item is copied as is
+  std::size_t outputLength = RLP::encodeItem(input + 1, output);
+  ASSERT_EQ(outputLength, 1UL);
+  ASSERT_EQ(output[0], 0xc0);
+
+  outputLength = RLP::encodeList(input, 2, output);
+  ASSERT_EQ(outputLength, 3UL);
+  ASSERT_EQ(output[0], 0xc2);
+  ASSERT_EQ(output[1], 0x01);
+  ASSERT_EQ(output[2], 0xc0);
+}
+
+TEST(RLP, itemLength) {
+  const Utils::Byte singleByte[] = { 0x7f };
+  ASSERT_EQ(RLP::itemLength(singleByte), 1UL);
+
+  const Utils::Byte shortString[] = { 0x82, 0x7c, 0x6d };
+  ASSERT_EQ(RLP::itemLength(shortString), 3UL);
+
+  const Utils::Byte longString[] = { 0xb9, 0x01, 0x00 };
+  ASSERT_EQ(RLP::itemLength(longString), 259UL);
+
+  const Utils::Byte shortList[] = { 0xc2, 0x01, 0xc0 };
+  ASSERT_EQ(RLP::itemLength(shortList), 3UL);
+
+  const Utils::Byte longList[] = { 0xf8, 0x5d };
+  ASSERT_EQ(RLP::itemLength(longList), 95UL);
+}
+
+TEST(RLP, encodeListHex) {
+  Utils::Byte single[] = { 0x01 };
+  Utils::Byte quantity[] = { 0x7c, 0x6d };
+  Utils::Byte data[60];
+  for(std::size_t i = 0; i < sizeof(data); i++) data[i] = i;
+  Utils::Byte encoded[] = { 0xc0 };
+
+  // Long payload, long string, empty, single byte and already encoded items
+  RLP::Item items[] = {
+    { single, 1 }, { quantity, 2 }, { nullptr, 0 }, { data, sizeof(data) }, { encoded, 1, true }
+  };
+
+  Utils::Byte output[128];
+  char expected[257];
+  std::size_t outputLength = RLP::encodeList(items, 5, output);
+  Utils::bufferToHexString(output, outputLength, expected, true);
+
+  char outputString[257];
+  std::size_t outputStringLength = RLP::encodeListHex(items, 5, outputString);
+  outputString[outputStringLength] = '\0';
+  ASSERT_EQ(outputStringLength, 2 * outputLength);
+  ASSERT_STREQ(outputString, expected);
+
+  for(const RLP::Item &item : items) {
+    RLP::Item copy = item;
+    ASSERT_EQ(RLP::encodedLength(item), RLP::encodeItem(&copy, output));
+  }
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <rules.hpp>
+
+static constexpr char Token[] = "dac17f958d2ee523a2206206994597c13d831ec7";
+static constexpr char Other[] = "cac17f958d2ee523a2206206994597c13d831ec7";
+static constexpr char Sender[] = "64177643cf0e8e96dd0205983aadeafbd871dfc9";
+
+static const std::string Input = "f305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb";
+
+static std::string message(const std::string &input, const char *value) {
+  return "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"0x" + input + "\",\"gasPrice\":\"0x355176b200\",\"value\":\"0x" + value + "\",\"from\":\"0x" + Sender + "\",\"nonce\":\"0x1a\"}}}}";
+}
+
+static Rules::Fields fields(double liquidity, double gasPrice, double ratio, const char *sender = Sender) {
+  Rules::Fields output;
+  output.values[Rules::Liquidity] = liquidity;
+  output.values[Rules::GasPrice] = gasPrice;
+  output.values[Rules::TokenRatio] = ratio;
+  output.sender = Rules::Key::fromHex(sender);
+  return output;
+}
+
+TEST(Rules, key) {
+  Rules::Key key = Rules::Key::fromHex("64177643CF0E8E96dd0205983aadeafbd871dfc9");
+  ASSERT_EQ(key.high, 0x64177643cf0e8e96UL);
+  ASSERT_EQ(key.middle, 0xdd0205983aadeafbUL);
+  ASSERT_EQ(key.low, 0xd871dfc9UL);
+
+  ASSERT_TRUE(Rules::equal(key, Rules::Key::fromHex(Sender)));
+  ASSERT_TRUE(Rules::less(Rules::Key::fromHex(Other), Rules::Key::fromHex(Token)));
+  ASSERT_FALSE(Rules::less(key, key));
+}
+
+TEST(Rules, extract) {
+  Rules::Fields output;
+
+  // addLiquidityETH: 0.0197 ETH for 31732301 token units
+  Rules::extract(message(Input, "46114844c27ec9").c_str(), 0x355176b200, output);
+  ASSERT_DOUBLE_EQ(output.values[Rules::Liquidity], 19722250458660553.0);
+  ASSERT_DOUBLE_EQ(output.values[Rules::GasPrice], 229000000000.0);
+  ASSERT_DOUBLE_EQ(output.values[Rules::TokenRatio], 31732301.0 / 19722250458660553.0 * 1e18);
+  ASSERT_TRUE(Rules::equal(output.sender, Rules::Key::fromHex(Sender)));
+
+  // Without liquidity the ratio is infinite
+  Rules::extract(message(Input, "0").c_str(), 0x355176b200, output);
+  ASSERT_EQ(output.values[Rules::Liquidity], 0.0);
+  ASSERT_TRUE(std::isinf(output.values[Rules::TokenRatio]));
+
+  // addLiquidity with wrapped native as tokenB
+  std::string input = std::string(ABI::Selector::AddLiquidity)
+    + std::string(24, '0') + Token + std::string(24, '0') + Config::Router::Selected.WrappedNative
+    + std::string(56, '0') + "000003e8" + std::string(48, '0') + "0de0b6b3a7640000" + std::string(64 * 4, '0');
+  Rules::extract(message(input, "0").c_str(), 0x355176b200, output);
+  ASSERT_DOUBLE_EQ(output.values[Rules::Liquidity], 1e18);
+  ASSERT_DOUBLE_EQ(output.values[Rules::TokenRatio], 1000.0);
+}
+
+TEST(Rules, compile) {
+  static Rules::Program<4> program;
+  const Config::Rules::Rule rules[] = {
+    Config::Rules::minLiquidity("", 1e18),
+    Config::Rules::minLiquidity(Token, 2e18),
+    Config::Rules::minLiquidity(Other, 5e18),
+    Config::Rules::maxGasPrice(Token, 500e9),
+    Config::Rules::maxGasPrice("", 300e9),
+    Config::Rules::tokenRatio(Token, 1e3, 1e9),
+    Config::Rules::blacklist(Sender, Other),
+  };
+
+  // Bounds of the target are intersected, rules of other targets are left out
+  ASSERT_EQ(program.compile(rules, std::size(rules), Token), 5UL);
+  ASSERT_TRUE(program.accepts(fields(2e18, 300e9, 1e3)));
+  ASSERT_FALSE(program.accepts(fields(1.9e18, 300e9, 1e3)));
+  ASSERT_FALSE(program.accepts(fields(2e18, 301e9, 1e3)));
+  ASSERT_FALSE(program.accepts(fields(2e18, 300e9, 999)));
+  ASSERT_FALSE(program.accepts(fields(2e18, 300e9, 1.1e9)));
+  ASSERT_FALSE(program.accepts(fields(0, 300e9, std::numeric_limits<double>::infinity())));
+
+  // Retarget, sender is blacklisted for the other token only
+  ASSERT_EQ(program.compile(rules, std::size(rules), Other), 4UL);
+  ASSERT_TRUE(program.accepts(fields(5e18, 300e9, 1, Token)));
+  ASSERT_FALSE(program.accepts(fields(5e18, 300e9, 1)));
+  ASSERT_FALSE(program.accepts(fields(2e18, 300e9, 1, Token)));
+
+  // No rules accept everything
+  ASSERT_EQ(program.compile(rules, 0, Token), 0UL);
+  ASSERT_TRUE(program.accepts(fields(0, 1e30, std::numeric_limits<double>::infinity())));
+}
+
+TEST(Rules, blacklist) {
+  std::vector<std::string> addresses;
+  char address[41];
+  for(std::size_t i = 0; i < 40; i++) {
+    snprintf(address, sizeof(address), "%016zx%016zx%08zx", (i * 0x9e3779b97f4a7c15) & ~1UL, i % 3, i);
+    addresses.push_back(address);
+  }
+
+  // Every length of the blacklist, every listed sender is rejected and the ones between them are not
+  for(std::size_t count = 1; count <= 33; count++) {
+    static Rules::Program<33> program;
+    std::vector<Config::Rules::Rule> rules;
+    for(std::size_t i = 0; i < count; i++) rules.push_back(Config::Rules::blacklist(addresses[i].c_str()));
+    ASSERT_EQ(program.compile(rules.data(), rules.size(), Token), count);
+
+    for(std::size_t i = 0; i < addresses.size(); i++) {
+      ASSERT_EQ(program.accepts(fields(1, 1, 1, addresses[i].c_str())), i >= count) << count << " " << i;
+
+      std::string between = addresses[i];
+      between[15] = '1';
+      ASSERT_TRUE(program.accepts(fields(1, 1, 1, between.c_str())));
+    }
+  }
+
+  // Senders above capacity are dropped
+  static Rules::Program<2> small;
+  const Config::Rules::Rule rules[] = {
+    Config::Rules::blacklist(addresses[0].c_str()),
+    Config::Rules::blacklist(addresses[1].c_str()),
+    Config::Rules::blacklist(addresses[2].c_str()),
+  };
+  ASSERT_EQ(small.compile(rules, 3, Token), 2UL);
+  ASSERT_TRUE(small.accepts(fields(1, 1, 1, addresses[2].c_str())));
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include <gmock/gmock.h>
+
+#include <string>
+#include <thread>
+
+#include <shared.hpp>
+
+using TestStore = PreGen::Store<4, 32>;
+using TestMapping = Shared::Mapping<TestStore, 8, 2>;
+
+static const std::string TestName = "/uniswap-sniper-test-" + std::to_string(getpid());
+
+static constexpr auto NearestAbove = Config::TransactionPreGen::MissPolicy::NearestAbove;
+
+TEST(Shared, publishAndRead) {
+  static TestStore store;
+  TestMapping writer, reader;
+  char output[32];
+  uint64_t gasPrice = 0;
+
+  ASSERT_FALSE(reader.open(TestName.c_str()));
+  ASSERT_TRUE(writer.create(TestName.c_str()));
+  ASSERT_TRUE(reader.open(TestName.c_str()));
+  ASSERT_EQ(reader.generation(), 0UL);
+
+  // Nothing is published yet
+  ASSERT_EQ(reader.read(0, 0, "", 100, NearestAbove, 10, output, gasPrice), 0UL);
+
+  store.insert(100, "first100", 8);
+  store.insert(110, "first110", 8);
+  writer.publish(0, 5, "aabbccdd", store);
+  ASSERT_EQ(reader.generation(), 1UL);
+
+  ASSERT_EQ(reader.read(0, 5, "aabbccdd", 105, NearestAbove, 10, output, gasPrice), 8UL);
+  ASSERT_STREQ(output, "first110");
+  ASSERT_EQ(gasPrice, 110UL);
+
+  // Nonce, transaction data and other wallets have to match
+  ASSERT_EQ(reader.read(0, 6, "aabbccdd", 100, NearestAbove, 10, output, gasPrice), 0UL);
+  ASSERT_EQ(reader.read(0, 5, "aabbccde", 100, NearestAbove, 10, output, gasPrice), 0UL);
+  ASSERT_EQ(reader.read(1, 5, "aabbccdd", 100, NearestAbove, 10, output, gasPrice), 0UL);
+
+  // Update is visible without remapping
+  store.clear();
+  store.insert(100, "second100", 9);
+  writer.publish(0, 6, "aabbccdd", store);
+  ASSERT_EQ(reader.read(0, 6, "aabbccdd", 100, NearestAbove, 10, output, gasPrice), 9UL);
+  ASSERT_STREQ(output, "second100");
+  ASSERT_EQ(reader.read(0, 5, "aabbccdd", 100, NearestAbove, 10, output, gasPrice), 0UL);
+
+  // Segment of different layout is rejected
+  Shared::Mapping<TestStore, 8, 3> otherReader;
+  ASSERT_FALSE(otherReader.open(TestName.c_str()));
+
+  TestMapping::unlink(TestName.c_str());
+}
+
+TEST(Shared, concurrentPublish) {
+  static TestStore stores[2];
+  TestMapping writer, reader;
+
+  stores[0].insert(100, "nonce0", 6);
+  stores[1].insert(100, "nonce1", 6);
+
+  ASSERT_TRUE(writer.create(TestName.c_str()));
+  ASSERT_TRUE(reader.open(TestName.c_str()));
+  writer.publish(0, 0, "aabbccdd", stores[0]);
+
+  std::atomic<bool> done { false };
+  std::thread publisher([&]() {
+    for(uint64_t nonce = 1; nonce <= 4; nonce++) writer.publish(0, nonce, "aabbccdd", stores[nonce % 2]);
+    done.store(true);
+  });
+
+  // Reader sees either a consistent message of the nonce or none
+  char output[32];
+  uint64_t gasPrice;
+  std::size_t hits = 0;
+  while(!done.load()) {
+    uint64_t nonce = reader.generation() - 1;
+    if(reader.read(0, nonce, "aabbccdd", 100, NearestAbove, 0, output, gasPrice) == 0) continue;
+
+    ASSERT_EQ(output[5], nonce % 2 == 0 ? '0' : '1');
+    ++hits;
+  }
+  publisher.join();
+
+  ASSERT_GT(hits, 0UL);
+  TestMapping::unlink(TestName.c_str());
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <gmock/gmock.h>
+
+#include <string>
+#include <thread>
+
+#include <signer.hpp>
+
+using TestChannel = Signer::Channel<4, Config::Size::BloXrouteTransactionMessageString>;
+
+static const std::string TestName = "/uniswap-sniper-signer-test-" + std::to_string(getpid());
+static constexpr char TestPrivateKey[] = "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318";
+
+static std::size_t testSign(Transaction &tx, Pipeline::SignRequest &request, char *output) {
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer(TestPrivateKey, privateKey);
+
+  Utils::Byte nonceBuffer[8];
+  std::size_t nonceBufferSize = Utils::intToBuffer(request.nonce, nonceBuffer);
+  tx.setField(Transaction::Field::Nonce, nonceBuffer, nonceBufferSize);
+  tx.setField(Transaction::Field::GasLimit, "7C6D");
+  tx.setField(Transaction::Field::To, "F0109fC8DF283027b6285cc889F5aA624EaC1F55");
+
+  return PreGen::generate(tx, privateKey, request.gasPrice, output);
+}
+
+TEST(Signer, sign) {
+  static TestChannel server, client;
+  std::atomic<bool> running { true };
+
+  ASSERT_FALSE(client.open(TestName.c_str()));
+  ASSERT_TRUE(server.create(TestName.c_str()));
+  ASSERT_TRUE(client.open(TestName.c_str()));
+  ASSERT_FALSE(client.isServing());
+
+  std::thread signer([&]() { server.serve(1, running, testSign); });
+  while(!client.isServing()) std::this_thread::yield();
+
+  Pipeline::SignRequest request {};
+  request.wallet = 0;
+  request.nonce = 0;
+  request.gasPrice = 0;
+  request.receivedAt = 1;
+
+  // Checked against Transaction.signWith62bitRS test
+  char output[Config::Size::BloXrouteTransactionMessageString];
+  ASSERT_EQ(client.sign(request, output, 1000000000), 238UL);
+  ASSERT_STREQ(output, "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"f85d8080827c6d94f0109fc8df283027b6285cc889f5aa624eac1f558080269f22f17b38af35286ffbb0c6376c86ec91c20ecbad93f84913a0cc15e7580cd99f83d6e12e82e3544cb4439964d5087da78f74cefeec9a450b16ae179fd8fe20\"}}");
+
+  // Response of abandoned request is skipped
+  Pipeline::SignRequest abandoned = request;
+  abandoned.receivedAt = 2;
+  abandoned.gasPrice = 1000000000;
+  ASSERT_TRUE(client.submit(abandoned));
+
+  char expected[Config::Size::BloXrouteTransactionMessageString];
+  Transaction tx;
+  request.receivedAt = 3;
+  request.nonce = 1;
+  std::size_t expectedLength = testSign(tx, request, expected);
+  ASSERT_EQ(client.sign(request, output, 1000000000), expectedLength);
+  ASSERT_STREQ(output, expected);
+
+  running.store(false);
+  signer.join();
+  ASSERT_FALSE(client.isServing());
+
+  // Nobody serves the channel anymore
+  request.receivedAt = 4;
+  ASSERT_EQ(client.sign(request, output, 1000000), 0UL);
+
+  TestChannel::unlink(TestName.c_str());
+}
+
+TEST(Signer, layout) {
+  static TestChannel server;
+  static Signer::Channel<8, Config::Size::BloXrouteTransactionMessageString> client;
+
+  ASSERT_TRUE(server.create(TestName.c_str()));
+  ASSERT_FALSE(client.open(TestName.c_str()));
+
+  TestChannel::unlink(TestName.c_str());
+}
\ No newline at end of file
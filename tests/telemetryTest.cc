@@ -0,0 +1,66 @@
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include <telemetry.hpp>
+
+using TestMetrics = Telemetry::Metrics<8>;
+
+static const std::string TestName = "/uniswap-sniper-telemetry-test-" + std::to_string(getpid());
+
+TEST(Telemetry, publish) {
+  static TestMetrics writer, reader, other;
+  TestMetrics::SnapshotType snapshot;
+
+  ASSERT_FALSE(reader.open(TestName.c_str()));
+
+  // Writes before the segment is created stay process-local
+  writer.count(Telemetry::Messages, 5);
+  ASSERT_TRUE(writer.create(TestName.c_str(), 1000000000, 42));
+  ASSERT_TRUE(reader.open(TestName.c_str()));
+
+  reader.snapshot(snapshot);
+  ASSERT_EQ(snapshot.writer, 42UL);
+  ASSERT_EQ(snapshot.bucketWidth, 1000000000UL);
+  ASSERT_EQ(snapshot.counters[Telemetry::Messages], 0UL);
+
+  writer.count(Telemetry::Messages);
+  writer.count(Telemetry::Messages);
+  writer.count(Telemetry::PregenHit);
+  writer.record(Telemetry::MissedGasPrice, 0);
+  writer.record(Telemetry::MissedGasPrice, 2500000000);
+  writer.record(Telemetry::MissedGasPrice, 2999999999);
+  writer.record(Telemetry::MissedGasPrice, 100000000000);
+
+  reader.snapshot(snapshot);
+  ASSERT_EQ(snapshot.counters[Telemetry::Messages], 2UL);
+  ASSERT_EQ(snapshot.counters[Telemetry::PregenHit], 1UL);
+  ASSERT_EQ(snapshot.counters[Telemetry::PregenMiss], 0UL);
+  ASSERT_EQ(snapshot.distributions[Telemetry::MissedGasPrice][0], 1UL);
+  ASSERT_EQ(snapshot.distributions[Telemetry::MissedGasPrice][2], 2UL);
+  ASSERT_EQ(snapshot.distributions[Telemetry::MissedGasPrice][7], 1UL); // open ended
+  ASSERT_EQ(snapshot.distributions[Telemetry::HitOverpay][0], 0UL);
+
+  // Round trips in power of two microsecond buckets
+  writer.recordRoundTrip(999);
+  writer.recordRoundTrip(1500);
+  writer.recordRoundTrip(150000);
+  writer.recordRoundTrip(3600000000000);
+
+  reader.snapshot(snapshot);
+  ASSERT_EQ(snapshot.roundTrips[0], 2UL);
+  ASSERT_EQ(snapshot.roundTrips[7], 1UL);
+  ASSERT_EQ(snapshot.roundTrips[Telemetry::RoundTripBuckets - 1], 1UL); // open ended
+
+  // Layout mismatch is rejected
+  static Telemetry::Metrics<16> mismatched;
+  ASSERT_FALSE(mismatched.open(TestName.c_str()));
+
+  TestMetrics::unlink(TestName.c_str());
+  ASSERT_FALSE(other.open(TestName.c_str()));
+
+  // Existing mappings stay valid after unlink
+  writer.count(Telemetry::Messages);
+  reader.snapshot(snapshot);
+  ASSERT_EQ(snapshot.counters[Telemetry::Messages], 3UL);
+}
\ No newline at end of file
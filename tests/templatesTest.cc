@@ -0,0 +1,80 @@
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include <wallet.hpp>
+
+static const char TestPrivateKey[] = "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318";
+
+static std::string encode(const char *hex, bool quantity) {
+  Utils::Byte buffer[Config::Size::TransactionDataBuffer];
+  Utils::Byte output[Config::Size::TransactionDataBuffer + 9];
+  RLP::Item item { buffer, Utils::hexStringToBuffer(hex, buffer, quantity) };
+  return std::string(reinterpret_cast<char*>(output), RLP::encodeItem(&item, output));
+}
+
+TEST(Templates, encodedFields) {
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(Templates::GasLimit.value), Templates::GasLimit.length), encode(Config::Transaction::GasLimit, true));
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(Templates::To.value), Templates::To.length), encode(Config::Transaction::To, false));
+
+  constexpr auto zeroes = RLP::encodeBytes(Utils::hexStringToBytes<8>("0000", true));
+  static_assert(zeroes.length == 1 && zeroes.value[0] == 0x80);
+
+  constexpr auto single = RLP::encodeBytes(Utils::hexStringToBytes<8>("7f"));
+  static_assert(single.length == 1 && single.value[0] == 0x7f);
+
+  constexpr auto odd = RLP::encodeBytes(Utils::hexStringToBytes<8>("30d40", true));
+  static_assert(odd.length == 4 && odd.value[0] == 0x83 && odd.value[1] == 0x03 && odd.value[3] == 0x40);
+
+  // Long string gets length of length header
+  constexpr auto longString = RLP::encodeBytes(Utils::hexStringToBytes<64>("00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"));
+  static_assert(longString.length == 60 && longString.value[0] == 0xb8 && longString.value[1] == 58);
+}
+
+TEST(Templates, messages) {
+  char data[TransactionDataBuilder::DataLength + 1];
+  TransactionDataBuilder::buildData(
+    Config::Transaction::SwapExactETHForTokens::AmountOutMin,
+    Config::Transaction::SwapExactETHForTokens::TokenAddress,
+    Config::Transaction::SwapExactETHForTokens::ReceiverAddress,
+    data
+  );
+  ASSERT_STREQ(TransactionDataBuilder::ConfigData.hex, data);
+
+  char message[512];
+  std::size_t messageLength = BloXrouteMessageBuilder::buildSubscribe(Config::Router::Selected.Address, Config::BloXroute::Filters::MinValue, Config::BloXroute::Filters::MaxGasPrice, message, Config::Exit::Enabled, Config::Bundle::Enabled);
+  ASSERT_EQ(BloXrouteMessageBuilder::ConfigSubscribe.length, messageLength);
+  ASSERT_STREQ(BloXrouteMessageBuilder::ConfigSubscribe.value, message);
+}
+
+TEST(Templates, encodedSigning) {
+  static Wallet<PreGen::Store<4, Config::Size::BloXrouteTransactionMessageString>> wallet;
+  wallet.init({ TestPrivateKey, "1a", Config::Transaction::Value }, TransactionDataBuilder::ConfigData.hex);
+
+  static Transaction expectedTx;
+  Utils::Byte nonceBuffer[8];
+  expectedTx.setField(Transaction::Field::Nonce, nonceBuffer, Utils::intToBuffer(26, nonceBuffer));
+  expectedTx.setField(Transaction::Field::GasLimit, Config::Transaction::GasLimit);
+  expectedTx.setField(Transaction::Field::To, Config::Transaction::To);
+  expectedTx.setField(Transaction::Field::Value, Config::Transaction::Value);
+  expectedTx.setField(Transaction::Field::Data, TransactionDataBuilder::ConfigData.hex);
+
+  char message[Config::Size::BloXrouteTransactionMessageString];
+  char expectedMessage[Config::Size::BloXrouteTransactionMessageString];
+  PreGen::generate(wallet.tx, wallet.privateKey, 1000000000, message);
+  PreGen::generate(expectedTx, wallet.privateKey, 1000000000, expectedMessage);
+  ASSERT_STREQ(message, expectedMessage);
+
+  PreGen::generate(wallet.tx, wallet.privateKey, 2000000000, 1000000000, message);
+  PreGen::generate(expectedTx, wallet.privateKey, 2000000000, 1000000000, expectedMessage);
+  ASSERT_STREQ(message, expectedMessage);
+
+  // Patches land after the RLP header of encoded data
+  Utils::Byte amountOutMin[32] = {};
+  amountOutMin[31] = 0x2a;
+  wallet.tx.patchField(Transaction::Field::Data, TransactionDataBuilder::AmountOutMinOffset, amountOutMin, 32);
+  expectedTx.patchField(Transaction::Field::Data, TransactionDataBuilder::AmountOutMinOffset, amountOutMin, 32);
+  PreGen::generate(wallet.tx, wallet.privateKey, 1000000000, message);
+  PreGen::generate(expectedTx, wallet.privateKey, 1000000000, expectedMessage);
+  ASSERT_STREQ(message, expectedMessage);
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <gmock/gmock.h>
 
+#include <vector>
+
 #include <transaction.hpp>
 #include <utils.hpp>
 
@@ -58,4 +60,127 @@ TEST(Transaction, signWith62bitRS) {
   ASSERT_EQ(transactionLength, 95UL);
   Utils::Byte expectedOutput[] = { 248, 93, 128, 128, 130, 124, 109, 148, 240, 16, 159, 200, 223, 40, 48, 39, 182, 40, 92, 200, 137, 245, 170, 98, 78, 172, 31, 85, 128, 128, 38, 159, 34, 241, 123, 56, 175, 53, 40, 111, 251, 176, 198, 55, 108, 134, 236, 145, 194, 14, 203, 173, 147, 248, 73, 19, 160, 204, 21, 231, 88, 12, 217, 159, 131, 214, 225, 46, 130, 227, 84, 76, 180, 67, 153, 100, 213, 8, 125, 167, 143, 116, 206, 254, 236, 154, 69, 11, 22, 174, 23, 159, 216, 254, 32 };
   ASSERT_TRUE(memcmp(transaction, expectedOutput, 95) == 0);
+}
+
+// Checked against independent RLP encoder (EIP-155 with chain ID 5)
+TEST(Transaction, signWithChainId) {
+  Transaction tx;
+
+  tx.setField(Transaction::Field::ChainId, "5");
+  tx.setField(Transaction::Field::Nonce, "1");
+  tx.setField(Transaction::Field::GasPrice, "3B9ACA00");
+  tx.setField(Transaction::Field::GasLimit, "5208");
+  tx.setField(Transaction::Field::To, "F0109fC8DF283027b6285cc889F5aA624EaC1F55");
+  tx.setField(Transaction::Field::Data, "");
+  tx.setField(Transaction::Field::Value, "1");
+
+  Utils::Byte transaction[512];
+  std::size_t transactionLength = tx.sign("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", transaction);
+
+  char transactionString[1025];
+  Utils::bufferToHexString(transaction, transactionLength, transactionString, true);
+  ASSERT_STREQ(transactionString, "f86301843b9aca0082520894f0109fc8df283027b6285cc889f5aa624eac1f5501802da00fa428801183494f9e79ee7143700e87754e875c039de2c67f1f69236956db6da03999469e44b577437a534a0643e2d76a322c70d8569dc6c02ac9bcf863e48dae");
+}
+
+// Checked against independent RLP encoder (EIP-1559)
+TEST(Transaction, signDynamicFee) {
+  Transaction tx;
+  tx.setType(Transaction::Type::DynamicFee);
+
+  tx.setField(Transaction::Field::Nonce, "0");
+  tx.setField(Transaction::Field::MaxPriorityFeePerGas, "0");
+  tx.setField(Transaction::Field::MaxFeePerGas, "0");
+  tx.setField(Transaction::Field::GasLimit, "7C6D");
+  tx.setField(Transaction::Field::To, "F0109fC8DF283027b6285cc889F5aA624EaC1F55");
+  tx.setField(Transaction::Field::Data, "");
+  tx.setField(Transaction::Field::Value, "0");
+
+  Utils::Byte transaction[512];
+  char transactionString[1025];
+  std::size_t transactionLength = tx.sign("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", transaction);
+
+  Utils::bufferToHexString(transaction, transactionLength, transactionString, true);
+  ASSERT_STREQ(transactionString, "02f86201808080827c6d94f0109fc8df283027b6285cc889f5aa624eac1f558080c080a0d9294c657311698ee657dc03700be9f83695b2124072bbbc7daee375b07be5e7a017b95bee006027ef4aff317d3ebb0a62b5cfd6e78fca27477a9a7bc03f4aab1d");
+
+  tx.setField(Transaction::Field::Nonce, "1a");
+  tx.setField(Transaction::Field::MaxPriorityFeePerGas, "77359400");
+  tx.setField(Transaction::Field::MaxFeePerGas, "22ecb25c00");
+  tx.setField(Transaction::Field::GasLimit, "30d40");
+  tx.setField(Transaction::Field::To, "7a250d5630B4cF539739dF2C5dAcb4c659F2488D");
+  tx.setField(Transaction::Field::Data, "7ff36ab5");
+  tx.setField(Transaction::Field::Value, "de0b6b3a7640000");
+
+  // Signing again resets previous signature
+  transactionLength = tx.sign("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", transaction);
+
+  Utils::bufferToHexString(transaction, transactionLength, transactionString, true);
+  ASSERT_STREQ(transactionString, "02f878011a84773594008522ecb25c0083030d40947a250d5630b4cf539739df2c5dacb4c659f2488d880de0b6b3a7640000847ff36ab5c001a0891f646e342f309a79ca52bf9aae7ef6b315a081b2a99e5c1e85d0d353ced350a04c55f48df2d0f437dc83750b727f394fdf1aed646ed45173efab6e7e9f2ae980");
+}
+
+// Single pass hex encoding matches hex encoded binary transaction
+TEST(Transaction, signHex) {
+  Transaction tx;
+  tx.setField(Transaction::Field::Nonce, "1a");
+  tx.setField(Transaction::Field::GasPrice, "22ecb25c00");
+  tx.setField(Transaction::Field::MaxPriorityFeePerGas, "77359400");
+  tx.setField(Transaction::Field::MaxFeePerGas, "22ecb25c00");
+  tx.setField(Transaction::Field::GasLimit, "30d40");
+  tx.setField(Transaction::Field::To, "7a250d5630B4cF539739dF2C5dAcb4c659F2488D");
+  tx.setField(Transaction::Field::Data, "7ff36ab50000000000000000000000000000000000000000000000000000000000000001");
+  tx.setField(Transaction::Field::Value, "de0b6b3a7640000");
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  for(Transaction::Type type : { Transaction::Type::Legacy, Transaction::Type::DynamicFee }) {
+    tx.setType(type);
+
+    Utils::Byte transaction[512];
+    char expected[1025];
+    Utils::bufferToHexString(transaction, tx.sign(privateKey, transaction), expected, true);
+
+    char transactionString[1025];
+    std::size_t transactionStringLength = tx.signHex(privateKey, transactionString);
+    transactionString[transactionStringLength] = '\0';
+    ASSERT_STREQ(transactionString, expected);
+  }
+}
+
+TEST(Transaction, moveContext) {
+  // Moved context memory has to outlive the transaction
+  std::vector<unsigned char> first, second;
+  Transaction tx;
+  tx.setField(Transaction::Field::Nonce, "1a");
+  tx.setField(Transaction::Field::GasPrice, "22ecb25c00");
+  tx.setField(Transaction::Field::GasLimit, "30d40");
+  tx.setField(Transaction::Field::To, "7a250d5630B4cF539739dF2C5dAcb4c659F2488D");
+  tx.setField(Transaction::Field::Value, "de0b6b3a7640000");
+
+  Utils::Byte privateKey[32];
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+
+  char expected[1025];
+  expected[tx.signHex(privateKey, expected)] = '\0';
+
+  // Signs the same from moved context, moved again
+  first.resize(tx.contextSize());
+  second.resize(tx.contextSize());
+  tx.moveContext(first.data());
+  tx.moveContext(second.data());
+
+  char transactionString[1025];
+  transactionString[tx.signHex(privateKey, transactionString)] = '\0';
+  ASSERT_STREQ(transactionString, expected);
+}
+
+TEST(Transaction, getAddress) {
+  Transaction tx;
+  Utils::Byte privateKey[32], address[20];
+  char addressString[41];
+
+  Utils::hexStringToBuffer("4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", privateKey);
+  ASSERT_EQ(tx.getAddress(privateKey, address), 20UL);
+
+  Utils::bufferToHexString(address, 20, addressString, true);
+  ASSERT_STREQ(addressString, "2c7536e3605d9c16a7a3d7b1898e529396a65c23");
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <gmock/gmock.h>
+
+#include <uint256.hpp>
+
+TEST(UInt256, fromHexString) {
+  UInt256 x = UInt256::fromHexString("1234567890abcdef1234567890abcdef1234567890abcdef");
+  ASSERT_EQ(x.limbs[0], 0x1234567890abcdefULL);
+  ASSERT_EQ(x.limbs[1], 0x1234567890abcdefULL);
+  ASSERT_EQ(x.limbs[2], 0x1234567890abcdefULL);
+  ASSERT_EQ(x.limbs[3], 0ULL);
+
+  ASSERT_TRUE(UInt256::fromHexString("") == UInt256(0));
+  ASSERT_TRUE(UInt256::fromHexString("00000000000000000000000000000000000000000000000000000001e4324d") == UInt256(0x1e4324d));
+  ASSERT_THROW(UInt256::fromHexString("0x12"), std::invalid_argument);
+
+  UInt256 y(7);
+  ASSERT_TRUE(UInt256::tryFromHexString("1e4324d", 7, y));
+  ASSERT_TRUE(y == UInt256(0x1e4324d));
+  ASSERT_FALSE(UInt256::tryFromHexString("0x12", 4, y));
+  ASSERT_TRUE(y == UInt256(0x1e4324d));
+}
+
+TEST(UInt256, fromDecimalString) {
+  ASSERT_TRUE(UInt256::fromDecimalString("0") == UInt256(0));
+  ASSERT_TRUE(UInt256::fromDecimalString("1000000000000") == UInt256(1000000000000ULL));
+  ASSERT_TRUE(UInt256::fromDecimalString("20000000000000000000") == UInt256::fromHexString("1158e460913d00000"));
+  ASSERT_TRUE(UInt256::fromDecimalString("") == UInt256(0));
+}
+
+TEST(UInt256, toBuffer) {
+  Utils::Byte output[32];
+
+  ASSERT_EQ(UInt256::fromHexString("1cdcc708f12769b25").toBuffer(output), 32UL);
+  Utils::Byte expectedOutput[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0xcd, 0xcc, 0x70, 0x8f, 0x12, 0x76, 0x9b, 0x25 };
+  ASSERT_TRUE(memcmp(output, expectedOutput, 32) == 0);
+}
+
+TEST(UInt256, compare) {
+  UInt256 a = UInt256::fromHexString("100000000000000000");
+  UInt256 b = UInt256::fromHexString("ffffffffffffffff");
+
+  ASSERT_TRUE(b < a);
+  ASSERT_TRUE(a > b);
+  ASSERT_TRUE(a >= a);
+  ASSERT_TRUE(a <= a);
+  ASSERT_TRUE(a != b);
+  ASSERT_EQ(a.bitLength(), 69UL);
+  ASSERT_EQ(b.bitLength(), 64UL);
+  ASSERT_EQ(UInt256().bitLength(), 0UL);
+}
+
+TEST(UInt256, arithmetic) {
+  UInt256 x = UInt256::fromHexString("1234567890abcdef1234567890abcdef1234567890abcdef");
+  UInt256 y = UInt256::fromHexString("fedcba9876543210fedcba98765");
+
+  ASSERT_TRUE(x * y == UInt256::fromHexString("7d74247acc913f050ef13b50f1b987500ef13a2ef7b8da78917d16d62528484b"));
+  ASSERT_TRUE(x / y == UInt256::fromHexString("124924923f07fffeeb43e"));
+  ASSERT_TRUE((x * y) / (y + 1) == UInt256::fromHexString("7e0384a47d7b0995b247ae9b5a0d440e4fcdf"));
+  ASSERT_TRUE(x / UInt256(0x10) == (x >> 4));
+  ASSERT_TRUE((x << 4) >> 4 == x);
+  ASSERT_TRUE(x - x == UInt256(0));
+  ASSERT_TRUE(UInt256(0) - UInt256(1) + UInt256(1) == UInt256(0));
+  ASSERT_TRUE(x / UInt256(0) == UInt256(0));
+  ASSERT_TRUE(y / x == UInt256(0));
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include <gmock/gmock.h>
+
+#include <uniswap.hpp>
+
+TEST(UniswapV2, getAmountOut) {
+  // 1 ETH into pool of 5 ETH and 1e9 tokens (18 decimals)
+  UInt256 amountOut = UniswapV2::getAmountOut(
+    UInt256::fromHexString("de0b6b3a7640000"),
+    UInt256::fromHexString("4563918244f40000"),
+    UInt256::fromHexString("33b2e3c9fd0803ce8000000")
+  );
+  ASSERT_TRUE(amountOut == UInt256::fromHexString("8984c34265a4068a342a2c"));
+
+  ASSERT_TRUE(UniswapV2::getAmountOut(UInt256(0), UInt256(1000), UInt256(1000)) == UInt256(0));
+  ASSERT_TRUE(UniswapV2::getAmountOut(UInt256(1000), UInt256(1000), UInt256(0)) == UInt256(0));
+}
+
+TEST(UniswapV2, hasReserves) {
+  ASSERT_TRUE(UniswapV2::hasReserves(UInt256(1000), UInt256(1000)));
+  ASSERT_FALSE(UniswapV2::hasReserves(UInt256(0), UInt256(1000)));
+  ASSERT_FALSE(UniswapV2::hasReserves(UInt256(1000), UInt256(0)));
+
+  // Empty input reserve prices the whole output reserve
+  ASSERT_TRUE(UniswapV2::getAmountOut(UInt256(1000), UInt256(0), UInt256(1000)) == UInt256(1000));
+}
+
+TEST(UniswapV2, applySlippage) {
+  ASSERT_TRUE(UniswapV2::applySlippage(UInt256(10000), 0) == UInt256(10000));
+  ASSERT_TRUE(UniswapV2::applySlippage(UInt256(10000), 1000) == UInt256(9000));
+  ASSERT_TRUE(UniswapV2::applySlippage(UInt256(10000), 10000) == UInt256(0));
+}
+
+TEST(UniswapV2, getAmountOutMin) {
+  UInt256 amountOutMin = UniswapV2::getAmountOutMin(
+    UInt256::fromHexString("de0b6b3a7640000"),
+    UInt256::fromHexString("4563918244f40000"),
+    UInt256::fromHexString("33b2e3c9fd0803ce8000000"),
+    1000
+  );
+  ASSERT_TRUE(amountOutMin == UInt256::fromHexString("7bc449555b7a05e2c88c5a"));
+}
\ No newline at end of file
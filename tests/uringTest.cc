@@ -0,0 +1,66 @@
+#include <gmock/gmock.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+
+#include <uring.hpp>
+
+TEST(Uring, fixedReadWrite) {
+  int pipeFds[2];
+  ASSERT_EQ(pipe(pipeFds), 0);
+
+  Uring::Ring ring;
+  ASSERT_TRUE(ring.init(4));
+  ASSERT_TRUE(ring.registerFiles(pipeFds, 2));
+
+  alignas(64) static char buffer[4096];
+  iovec buffers[1] = { { buffer, sizeof(buffer) } };
+  ASSERT_TRUE(ring.registerBuffers(buffers, 1));
+
+  // Written from the first half of the buffer, read into the second one
+  memcpy(buffer, "registered", 10);
+  Uring::Ring::prepareWriteFixed(ring.next(), 1, buffer, 10, 0, 1);
+  ASSERT_TRUE(ring.submit());
+
+  io_uring_cqe cqe;
+  ASSERT_TRUE(ring.wait(cqe));
+  ASSERT_EQ(cqe.user_data, 1);
+  ASSERT_EQ(cqe.res, 10);
+
+  Uring::Ring::prepareReadFixed(ring.next(), 0, buffer + 2048, 2048, 0, 2);
+  ASSERT_TRUE(ring.submit());
+  ASSERT_TRUE(ring.wait(cqe));
+  ASSERT_EQ(cqe.user_data, 2);
+  ASSERT_EQ(cqe.res, 10);
+  ASSERT_EQ(memcmp(buffer + 2048, "registered", 10), 0);
+
+  ASSERT_FALSE(ring.peek(cqe));
+
+  close(pipeFds[0]);
+  close(pipeFds[1]);
+}
+
+TEST(Uring, timeout) {
+  Uring::Ring ring;
+  ASSERT_TRUE(ring.init(4));
+
+  __kernel_timespec timeout { 0, 1000000 };
+  Uring::Ring::prepareTimeout(ring.next(), &timeout, 7);
+  ASSERT_TRUE(ring.submit());
+
+  io_uring_cqe cqe;
+  ASSERT_TRUE(ring.wait(cqe));
+  ASSERT_EQ(cqe.user_data, 7);
+  ASSERT_EQ(cqe.res, -ETIME);
+}
+
+TEST(Uring, queueFull) {
+  Uring::Ring ring;
+  ASSERT_TRUE(ring.init(2));
+
+  ASSERT_NE(ring.next(), nullptr);
+  ASSERT_NE(ring.next(), nullptr);
+  ASSERT_EQ(ring.next(), nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <gmock/gmock.h>
+
+#include <wallet.hpp>
+
+using TestWallet = Wallet<PreGen::Store<4, Config::Size::BloXrouteTransactionMessageString>>;
+
+// Checked against Transaction.signWith62bitRS test
+TEST(Wallet, init) {
+  static TestWallet wallet;
+  wallet.init({ "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", "0", "0" }, "");
+  wallet.tx.setField(Transaction::Field::GasLimit, "7C6D");
+  wallet.tx.setField(Transaction::Field::To, "F0109fC8DF283027b6285cc889F5aA624EaC1F55");
+
+  ASSERT_STREQ(wallet.address, "2c7536e3605d9c16a7a3d7b1898e529396a65c23");
+  ASSERT_EQ(wallet.getNonce(), 0UL);
+  ASSERT_EQ(wallet.value, UInt256(0));
+
+  std::size_t messageLength = PreGen::generate(wallet.tx, wallet.privateKey, 0, wallet.message);
+  ASSERT_EQ(messageLength, 238UL);
+  ASSERT_STREQ(wallet.message, "{\"method\":\"blxr_tx\",\"params\":{\"transaction\":\"f85d8080827c6d94f0109fc8df283027b6285cc889f5aa624eac1f558080269f22f17b38af35286ffbb0c6376c86ec91c20ecbad93f84913a0cc15e7580cd99f83d6e12e82e3544cb4439964d5087da78f74cefeec9a450b16ae179fd8fe20\"}}");
+}
+
+TEST(Wallet, claim) {
+  static TestWallet wallet;
+  wallet.init({ "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", "1a", "de0b6b3a7640000" }, "");
+
+  ASSERT_EQ(wallet.getNonce(), 26UL);
+  ASSERT_EQ(wallet.value, UInt256(1000000000000000000));
+
+  // Wallet is not armed until pregenerated
+  ASSERT_FALSE(wallet.claim());
+
+  wallet.arm();
+  ASSERT_TRUE(wallet.claim());
+  ASSERT_FALSE(wallet.claim());
+
+  wallet.advanceNonce();
+  ASSERT_EQ(wallet.getNonce(), 27UL);
+}
+
+TEST(Wallet, setData) {
+  static TestWallet wallet;
+  wallet.init({ "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", "1a", "de0b6b3a7640000" }, TransactionDataBuilder::ConfigData.hex);
+
+  char data[TransactionDataBuilder::DataLength + 1];
+  TransactionDataBuilder::buildData("0", "dac17f958d2ee523a2206206994597c13d831ec7", Config::Transaction::SwapExactETHForTokens::ReceiverAddress, data);
+
+  // Nonce and value are kept, transaction fields are set with the new data
+  wallet.setData(data);
+  ASSERT_STREQ(wallet.getData(), data);
+  ASSERT_EQ(wallet.getNonce(), 26UL);
+
+  static TestWallet expectedWallet;
+  expectedWallet.init({ "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", "1a", "de0b6b3a7640000" }, data);
+
+  char message[Config::Size::BloXrouteTransactionMessageString];
+  char expectedMessage[Config::Size::BloXrouteTransactionMessageString];
+  PreGen::generate(wallet.tx, wallet.privateKey, 100000000000, message);
+  PreGen::generate(expectedWallet.tx, expectedWallet.privateKey, 100000000000, expectedMessage);
+  ASSERT_STREQ(message, expectedMessage);
+  ASSERT_NE(strstr(message, "dac17f958d2ee523a2206206994597c13d831ec7"), nullptr);
+
+  // Back to the previous data, its buffer is reused
+  wallet.setData(TransactionDataBuilder::ConfigData.hex);
+  ASSERT_STREQ(wallet.getData(), TransactionDataBuilder::ConfigData.hex);
+
+  Transaction transaction;
+  wallet.setFields(transaction);
+  PreGen::generate(transaction, wallet.privateKey, 100000000000, message);
+  ASSERT_EQ(strstr(message, "dac17f958d2ee523a2206206994597c13d831ec7"), nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <config.hpp>
+#include <bot.hpp>
+#include <pregen.hpp>
+#include <wallet.hpp>
+#include <warm.hpp>
+
+static constexpr char Token[] = "dac17f958d2ee523a2206206994597c13d831ec7";
+static constexpr std::uint64_t Gwei = 1000000000;
+
+static const std::string Input = "0xf305d719000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec70000000000000000000000000000000000000000000000000000000001e4324d0000000000000000000000000000000000000000000000000000000001e1c6870000000000000000000000000000000000000000000000000046114844c27ec900000000000000000000000064177643cf0e8e96dd0205983aadeafbd871dfc900000000000000000000000000000000000000000000000000000000605ca9eb";
+
+static std::string liquidityAdd(const std::string &input, const std::string &fees) {
+  return "{\"jsonrpc\":\"2.0\",\"id\":null,\"method\":\"subscribe\",\"params\":{\"subscription\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\",\"result\":{\"txContents\":{\"input\":\"" + input + "\"," + fees + ",\"from\":\"0x64177643cf0e8e96dd0205983aadeafbd871dfc9\",\"nonce\":\"0x1a\"}}}}";
+}
+
+using TestStore = PreGen::Store<8, Config::Size::BloXrouteTransactionMessageString>;
+using TestWallet = Wallet<TestStore>;
+
+static void initWallet(TestWallet &wallet, const std::vector<std::uint64_t> &gasPrices) {
+  wallet.init(Config::Wallets::List[0], TransactionDataBuilder::ConfigData.hex);
+  PreGen::generateParallel(wallet.pregenTxs.back(), gasPrices, wallet.privateKey, [&wallet](Transaction &tx) { wallet.setFields(tx); }, 1);
+  wallet.pregenTxs.publish();
+}
+
+TEST(Warm, message) {
+  char message[Warm::MessageCapacity];
+
+  // Goes through the same parsing as the stream messages
+  std::size_t length = Warm::buildMessage(Token, { 0x355176b200, 0, false }, message);
+  ASSERT_EQ(length, strlen(message));
+  ASSERT_TRUE(BloXrouteMessageParser::validateTransaction(message, Token));
+  ASSERT_FALSE(BloXrouteMessageParser::validateTransaction(message, "cac17f958d2ee523a2206206994597c13d831ec7"));
+  ASSERT_FALSE(BloXrouteMessageParser::isDynamicFee(message));
+
+  char gasPriceStr[65];
+  ASSERT_EQ(BloXrouteMessageParser::extractGasPrice(message, gasPriceStr), 10);
+  ASSERT_STREQ(gasPriceStr, "355176b200");
+
+  Warm::buildMessage(Token, { 100 * Gwei, 2 * Gwei, true }, message);
+  ASSERT_TRUE(BloXrouteMessageParser::validateTransaction(message, Token));
+  ASSERT_TRUE(BloXrouteMessageParser::isDynamicFee(message));
+
+  Warm::Fees fees;
+  ASSERT_TRUE(Warm::extractFees(message, fees));
+  ASSERT_EQ(fees, (Warm::Fees { 100 * Gwei, 2 * Gwei, true }));
+
+  // Stream messages alike
+  ASSERT_TRUE(Warm::extractFees(liquidityAdd(Input, "\"gasPrice\":\"0x355176b200\",\"value\":\"0x0\"").c_str(), fees));
+  ASSERT_EQ(fees, (Warm::Fees { 0x355176b200, 0, false }));
+  ASSERT_FALSE(Warm::extractFees(liquidityAdd("0x7ff36ab5" + Input.substr(10), "\"gasPrice\":\"0x355176b200\",\"value\":\"0x0\"").c_str(), fees));
+
+  // Input of other length than the selector implies (truncated or of other method), fees are not at their positions
+  ASSERT_FALSE(Warm::extractFees(liquidityAdd(Input.substr(0, 138), "\"gasPrice\":\"0x355176b200\",\"value\":\"0x0\"").c_str(), fees));
+  ASSERT_FALSE(Warm::extractFees(liquidityAdd(Input + std::string(4000, '0'), "\"gasPrice\":\"0x355176b200\",\"value\":\"0x0\"").c_str(), fees));
+  ASSERT_FALSE(Warm::extractFees(liquidityAdd(Input, "\"gasPrice\":\"0x" + std::string(100, 'f') + "\",\"value\":\"0x0\"").c_str(), fees));
+}
+
+TEST(Warm, observe) {
+  static Warm::Warmer<2> warmer;
+  warmer.init(Token, 200 * Gwei, 0, 0);
+
+  // Distinct liquidity add fees only, the oldest ones are overwritten
+  ASSERT_TRUE(warmer.observe(liquidityAdd(Input, "\"gasPrice\":\"0x2e90edd000\",\"value\":\"0x0\"").c_str()));
+  ASSERT_FALSE(warmer.observe(liquidityAdd(Input, "\"gasPrice\":\"0x2e90edd000\",\"value\":\"0x1\"").c_str()));
+  ASSERT_TRUE(warmer.observe(liquidityAdd(Input, "\"value\":\"0x0\",\"maxFeePerGas\":\"0x2e90edd000\",\"maxPriorityFeePerGas\":\"0x77359400\"").c_str()));
+  ASSERT_EQ(warmer.getLikely(), 2);
+
+  ASSERT_TRUE(warmer.observe(liquidityAdd(Input, "\"gasPrice\":\"0x2ecbd3e600\",\"value\":\"0x0\"").c_str()));
+  ASSERT_TRUE(warmer.observe(liquidityAdd(Input, "\"gasPrice\":\"0x2e90edd000\",\"value\":\"0x0\"").c_str()));
+  ASSERT_EQ(warmer.getLikely(), 2);
+
+  ASSERT_FALSE(warmer.observe(liquidityAdd("0x7ff36ab5" + Input.substr(10), "\"gasPrice\":\"0x2e90edd000\",\"value\":\"0x0\"").c_str()));
+  ASSERT_FALSE(warmer.observe("{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"736d201d-540a-45c4-9bb3-a9f932ee885e\"}"));
+}
+
+TEST(Warm, run) {
+  static TestWallet wallets[3];
+  for(TestWallet &wallet : wallets) initWallet(wallet, { 200 * Gwei, 201 * Gwei, 202 * Gwei });
+  wallets[1].arm();
+  wallets[2].arm();
+
+  static Warm::Warmer<4> warmer;
+  warmer.init(Token, 200 * Gwei, 100000000, 1000000);
+  std::uint64_t time = 0;
+  auto clock = [&time]() { return time; };
+
+  // Synthetic match of the fallback gas price, armed wallets up to the send count, nothing is claimed
+  Warm::Round round = warmer.run(wallets, 3, 1, true, true, clock);
+  ASSERT_EQ(round.matches, 1);
+  ASSERT_EQ(round.touched, 1);
+  ASSERT_EQ(round.signs, 1);
+  ASSERT_FALSE(wallets[0].isArmed());
+  ASSERT_TRUE(wallets[1].isArmed());
+  ASSERT_EQ(wallets[1].getNonce(), wallets[2].getNonce());
+
+  // Dry-run sign leaves the wallet message and the pregenerated stores as they were
+  std::size_t pregenLength;
+  const TestStore *store = wallets[1].pregenTxs.acquire();
+  const char *pregenMessage = store->message(*store->lookup(201 * Gwei, Config::TransactionPreGen::MissPolicy::NearestAbove, 0), nullptr, pregenLength);
+  std::string pregenTx(pregenMessage, pregenLength);
+  std::string walletMessage(wallets[1].message);
+  wallets[1].pregenTxs.release();
+
+  // Observed fees, the first one is signed, the others are looked up within the budget (the last one was not pregenerated)
+  ASSERT_TRUE(warmer.observe(liquidityAdd(Input, "\"gasPrice\":\"0x2ecc889a00\",\"value\":\"0x0\"").c_str()));
+  ASSERT_TRUE(warmer.observe(liquidityAdd(Input, "\"gasPrice\":\"0x2f08236400\",\"value\":\"0x0\"").c_str()));
+  ASSERT_TRUE(warmer.observe(liquidityAdd(Input, "\"gasPrice\":\"0x3a35294400\",\"value\":\"0x0\"").c_str()));
+  ASSERT_FALSE(warmer.isDue(time + 99999999));
+  ASSERT_TRUE(warmer.isDue(time + 100000000));
+
+  round = warmer.run(wallets, 3, 2, true, true, clock);
+  ASSERT_EQ(round.matches, 3);
+  ASSERT_EQ(round.touched, 2 * 2);
+  ASSERT_EQ(round.signs, 2);
+
+  store = wallets[1].pregenTxs.acquire();
+  pregenMessage = store->message(*store->lookup(201 * Gwei, Config::TransactionPreGen::MissPolicy::NearestAbove, 0), nullptr, pregenLength);
+  ASSERT_EQ(std::string(pregenMessage, pregenLength), pregenTx);
+  ASSERT_EQ(std::string(wallets[1].message), walletMessage);
+  wallets[1].pregenTxs.release();
+
+  ASSERT_TRUE(wallets[1].claim());
+  ASSERT_TRUE(wallets[2].claim());
+
+  // Budget ran out after the first match, claimed wallets are not warmed
+  round = warmer.run(wallets, 3, 2, true, true, [&time]() { return time += 2000000; });
+  ASSERT_EQ(round.matches, 1);
+  ASSERT_EQ(round.touched, 0);
+  ASSERT_EQ(round.signs, 0);
+
+  // Observed fees are kept for the new target, its round is due right away
+  ASSERT_FALSE(warmer.isDue(time));
+  warmer.setTarget("cac17f958d2ee523a2206206994597c13d831ec7");
+  ASSERT_TRUE(warmer.isDue(time));
+  ASSERT_EQ(warmer.getLikely(), 3);
+}
\ No newline at end of file
@@ -0,0 +1,304 @@
+#include <gmock/gmock.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <websocket.hpp>
+
+// Minimal loopback server side of the protocol
+
+static int listenLoopback(int &port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addressLength = sizeof(address);
+
+  bind(fd, reinterpret_cast<sockaddr*>(&address), addressLength);
+  listen(fd, 1);
+  getsockname(fd, reinterpret_cast<sockaddr*>(&address), &addressLength);
+  port = ntohs(address.sin_port);
+  return fd;
+}
+
+static std::string acceptUpgrade(int listenFd, int &fd) {
+  fd = accept(listenFd, nullptr, nullptr);
+
+  std::string request;
+  char buffer[1024];
+  while(request.find("\r\n\r\n") == std::string::npos) {
+    ssize_t count = recv(fd, buffer, sizeof(buffer), 0);
+    if(count <= 0) return request;
+    request.append(buffer, count);
+  }
+
+  std::size_t keyStart = request.find("Sec-WebSocket-Key: ") + 19;
+  char accept[WebSocket::AcceptLength + 1];
+  WebSocket::acceptKey(request.c_str() + keyStart, accept);
+
+  std::string response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nsec-websocket-accept: " + std::string(accept) + "\r\n\r\n";
+  send(fd, response.data(), response.size(), 0);
+  return request;
+}
+
+static void sendFrame(int fd, WebSocket::Opcode opcode, const std::string &payload, bool fin = true) {
+  char header[WebSocket::MaxHeaderLength];
+  std::size_t headerLength = WebSocket::encodeHeader(opcode, payload.size(), nullptr, header);
+  if(!fin) header[0] &= 0x7f;
+
+  std::string frame = std::string(header, headerLength) + payload;
+  send(fd, frame.data(), frame.size(), 0);
+}
+
+static WebSocket::Frame receiveFrame(int fd, std::string &payload) {
+  std::string input;
+  char buffer[4096];
+  WebSocket::Frame frame {};
+
+  while(true) {
+    std::size_t headerLength = WebSocket::parseHeader(input.data(), input.size(), frame);
+    if(headerLength != 0 && input.size() >= headerLength + frame.payloadLength) {
+      payload = input.substr(headerLength, frame.payloadLength);
+      if(frame.masked) WebSocket::mask(payload.data(), payload.size(), frame.maskKey, payload.data());
+      return frame;
+    }
+
+    ssize_t count = recv(fd, buffer, sizeof(buffer), 0);
+    if(count <= 0) return WebSocket::Frame {};
+    input.append(buffer, count);
+  }
+}
+
+TEST(WebSocket, acceptKey) {
+  // RFC 6455 section 1.3
+  char accept[WebSocket::AcceptLength + 1];
+  WebSocket::acceptKey("dGhlIHNhbXBsZSBub25jZQ==", accept);
+  ASSERT_STREQ(accept, "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+
+  ASSERT_TRUE(WebSocket::checkHandshake("HTTP/1.1 101 Switching Protocols\r\nSec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=", "dGhlIHNhbXBsZSBub25jZQ=="));
+  ASSERT_FALSE(WebSocket::checkHandshake("HTTP/1.1 101 Switching Protocols\r\nSec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=", "AAAAAAAAAAAAAAAAAAAAAA=="));
+  ASSERT_FALSE(WebSocket::checkHandshake("HTTP/1.1 403 Forbidden\r\nSec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=", "dGhlIHNhbXBsZSBub25jZQ=="));
+}
+
+TEST(WebSocket, parseAddress) {
+  WebSocket::Address address;
+
+  ASSERT_TRUE(WebSocket::parseAddress("ws://localhost:3000", address));
+  ASSERT_STREQ(address.host, "localhost");
+  ASSERT_STREQ(address.port, "3000");
+  ASSERT_STREQ(address.path, "/");
+  ASSERT_FALSE(address.secure);
+
+  ASSERT_TRUE(WebSocket::parseAddress("wss://api.blxrbdn.com/ws", address));
+  ASSERT_STREQ(address.host, "api.blxrbdn.com");
+  ASSERT_STREQ(address.port, "443");
+  ASSERT_STREQ(address.path, "/ws");
+  ASSERT_TRUE(address.secure);
+
+  ASSERT_FALSE(WebSocket::parseAddress("http://localhost:3000", address));
+  ASSERT_FALSE(WebSocket::parseAddress("ws://:3000", address));
+  ASSERT_FALSE(WebSocket::parseAddress("ws://localhost:1234567", address));
+}
+
+TEST(WebSocket, frameHeader) {
+  const std::uint8_t maskKey[4] = { 0x37, 0xfa, 0x21, 0x3d };
+  char header[WebSocket::MaxHeaderLength];
+  WebSocket::Frame frame;
+
+  // RFC 6455 section 5.7, masked "Hello"
+  ASSERT_EQ(WebSocket::encodeHeader(WebSocket::Text, 5, maskKey, header), 6);
+  char payload[5];
+  WebSocket::mask("Hello", 5, maskKey, payload);
+  ASSERT_EQ(std::string(header, 6) + std::string(payload, 5), std::string("\x81\x85\x37\xfa\x21\x3d\x7f\x9f\x4d\x51\x58", 11));
+
+  ASSERT_EQ(WebSocket::parseHeader(header, 6, frame), 6);
+  ASSERT_TRUE(frame.fin);
+  ASSERT_FALSE(frame.reserved);
+  ASSERT_EQ(frame.opcode, WebSocket::Text);
+  ASSERT_TRUE(frame.masked);
+  ASSERT_EQ(frame.payloadLength, 5);
+  ASSERT_EQ(memcmp(frame.maskKey, maskKey, 4), 0);
+
+  // Extended lengths, incomplete headers
+  for(std::uint64_t length : { 125ULL, 126ULL, 65535ULL, 65536ULL, 1ULL << 40 }) {
+    std::size_t headerLength = WebSocket::encodeHeader(WebSocket::Binary, length, nullptr, header);
+    ASSERT_EQ(headerLength, length < 126 ? 2 : length <= 65535 ? 4 : 10);
+    ASSERT_EQ(WebSocket::parseHeader(header, headerLength - 1, frame), 0);
+    ASSERT_EQ(WebSocket::parseHeader(header, headerLength, frame), headerLength);
+    ASSERT_EQ(frame.payloadLength, length);
+    ASSERT_FALSE(frame.masked);
+  }
+}
+
+TEST(WebSocket, mask) {
+  const std::uint8_t maskKey[4] = { 0x01, 0x80, 0xff, 0x5a };
+  std::string input = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+  // Word-wise masking matches byte-wise definition for every length, and unmasks in place
+  for(std::size_t length = 0; length <= input.size(); length++) {
+    std::string masked(length, '\0');
+    WebSocket::mask(input.data(), length, maskKey, masked.data());
+    for(std::size_t i = 0; i < length; i++) ASSERT_EQ(masked[i], static_cast<char>(input[i] ^ maskKey[i % 4]));
+
+    WebSocket::mask(masked.data(), length, maskKey, masked.data());
+    ASSERT_EQ(masked, input.substr(0, length));
+  }
+}
+
+TEST(WebSocket, client) {
+  static WebSocket::Client<4096, 256, 4> client;
+
+  int port;
+  int listenFd = listenLoopback(port);
+  std::string request, pong, reply, closeReply;
+  WebSocket::Frame pongFrame {}, replyFrame {}, closeFrame {};
+
+  std::thread server([&]() {
+    int fd;
+    request = acceptUpgrade(listenFd, fd);
+
+    sendFrame(fd, WebSocket::Text, "hello");
+    replyFrame = receiveFrame(fd, reply);
+
+    sendFrame(fd, WebSocket::Ping, "p");
+    pongFrame = receiveFrame(fd, pong);
+
+    // Fragmented message, too long message is skipped
+    sendFrame(fd, WebSocket::Text, "frag", false);
+    sendFrame(fd, WebSocket::Continuation, "ment");
+    sendFrame(fd, WebSocket::Text, std::string(10000, 'x'));
+    sendFrame(fd, WebSocket::Text, "after");
+
+    sendFrame(fd, WebSocket::Close, "\x03\xe8" "bye");
+    closeFrame = receiveFrame(fd, closeReply);
+    close(fd);
+  });
+
+  ASSERT_TRUE(client.connect(("ws://127.0.0.1:" + std::to_string(port) + "/stream").c_str(), "token", 60000));
+
+  std::vector<std::string> messages;
+  std::size_t received = client.run(
+    [&messages](char *message, std::size_t length) {
+      ASSERT_EQ(strlen(message), length);
+      messages.emplace_back(message, length);
+      if(messages.size() == 1) client.send("reply", 5);
+    },
+    []() {}
+  );
+
+  server.join();
+  close(listenFd);
+
+  ASSERT_THAT(request, testing::StartsWith("GET /stream HTTP/1.1\r\n"));
+  ASSERT_THAT(request, testing::HasSubstr("\r\nAuthorization: token\r\n"));
+  ASSERT_THAT(request, testing::HasSubstr("\r\nSec-WebSocket-Version: 13\r\n"));
+
+  ASSERT_EQ(received, 3);
+  ASSERT_THAT(messages, testing::ElementsAre("hello", "fragment", "after"));
+
+  // Client frames are masked
+  ASSERT_TRUE(replyFrame.masked);
+  ASSERT_EQ(replyFrame.opcode, WebSocket::Text);
+  ASSERT_EQ(reply, "reply");
+  ASSERT_EQ(pongFrame.opcode, WebSocket::Pong);
+  ASSERT_EQ(pong, "p");
+  ASSERT_EQ(closeFrame.opcode, WebSocket::Close);
+  ASSERT_EQ(closeReply, "\x03\xe8");
+
+  ASSERT_EQ(client.getCloseCode(), WebSocket::Normal);
+  ASSERT_STREQ(client.getCloseReason(), "bye");
+  ASSERT_FALSE(client.isOpen());
+  ASSERT_FALSE(client.send("late", 4));
+}
+
+TEST(WebSocket, clientClose) {
+  static WebSocket::Client<4096, 256, 4> client;
+
+  int port;
+  int listenFd = listenLoopback(port);
+  std::string closePayload;
+  WebSocket::Frame closeFrame {};
+
+  std::thread server([&]() {
+    int fd;
+    acceptUpgrade(listenFd, fd);
+
+    sendFrame(fd, WebSocket::Text, "done");
+    closeFrame = receiveFrame(fd, closePayload);
+    sendFrame(fd, WebSocket::Close, closePayload);
+    close(fd);
+  });
+
+  ASSERT_TRUE(client.connect(("ws://127.0.0.1:" + std::to_string(port)).c_str(), nullptr, 60000));
+
+  std::size_t received = client.run(
+    [](char *, std::size_t) { client.close(); },
+    []() {}
+  );
+
+  server.join();
+  close(listenFd);
+
+  ASSERT_EQ(received, 1);
+  ASSERT_EQ(closeFrame.opcode, WebSocket::Close);
+  ASSERT_TRUE(closeFrame.masked);
+  ASSERT_EQ(closePayload, "\x03\xe8");
+  ASSERT_EQ(client.getCloseCode(), WebSocket::Normal);
+}
+
+TEST(WebSocket, clientRejectsTLS) {
+  static WebSocket::Client<4096, 256, 4> client;
+
+  ASSERT_FALSE(client.connect("wss://127.0.0.1:1", nullptr, 60000));
+}
+
+TEST(WebSocket, clientHeartbeat) {
+  static WebSocket::Client<4096, 256, 4> client;
+
+  int port;
+  int listenFd = listenLoopback(port);
+  std::string ping, pong, closePayload;
+  WebSocket::Frame pingFrame {}, pongFrame {};
+
+  std::thread server([&]() {
+    int fd;
+    acceptUpgrade(listenFd, fd);
+
+    sendFrame(fd, WebSocket::Text, "go");
+    pingFrame = receiveFrame(fd, ping);
+    sendFrame(fd, WebSocket::Pong, ping);
+    pongFrame = receiveFrame(fd, pong);
+
+    sendFrame(fd, WebSocket::Close, "\x03\xe8");
+    receiveFrame(fd, closePayload);
+    close(fd);
+  });
+
+  ASSERT_TRUE(client.connect(("ws://127.0.0.1:" + std::to_string(port)).c_str(), nullptr, 60000));
+
+  std::vector<std::string> pongs;
+  client.run(
+    [](char *, std::size_t) {
+      client.ping("beat", 4);
+      client.pong("warm", 4);
+    },
+    []() {},
+    [&pongs](const char *payload, std::size_t length) { pongs.emplace_back(payload, length); }
+  );
+
+  server.join();
+  close(listenFd);
+
+  // Payload of the ping comes back with its pong, unsolicited pong is just sent
+  ASSERT_EQ(pingFrame.opcode, WebSocket::Ping);
+  ASSERT_EQ(ping, "beat");
+  ASSERT_THAT(pongs, testing::ElementsAre("beat"));
+  ASSERT_EQ(pongFrame.opcode, WebSocket::Pong);
+  ASSERT_EQ(pong, "warm");
+}
\ No newline at end of file